@@ -1,4 +1,5 @@
 #include "GdbMonitor.h"
+#include "SeerSessionLog.h"
 #include <QtCore/QtCore>
 #include <QtCore/QProcess>
 #include <QtCore/QLoggingCategory>
@@ -8,7 +9,8 @@
 static QLoggingCategory LC("seer.gdbmonitor");
 
 GdbMonitor::GdbMonitor (QObject* parent) : QObject(parent) {
-    _process = 0;
+    _process    = 0;
+    _sessionLog = 0;
 }
 
 GdbMonitor::~GdbMonitor () {
@@ -44,6 +46,11 @@ void GdbMonitor::handleReadyReadStandardError () {
 
         QByteArray buf = p->readLine();
 
+        // Keep the raw line for the session log, if there is one.
+        if (_sessionLog) {
+            _sessionLog->write(SeerSessionLog::GdbError, buf);
+        }
+
         // Chop off trailing RETURN character.
         if (buf[buf.size()-1] == '\n') {
             buf.chop(1);
@@ -70,6 +77,11 @@ void GdbMonitor::handleReadyReadStandardOutput () {
 
         QByteArray buf = p->readLine();
 
+        // Keep the raw line for the session log, if there is one.
+        if (_sessionLog) {
+            _sessionLog->write(SeerSessionLog::GdbOutput, buf);
+        }
+
         // Chop off trailing RETURN character.
         if (buf[buf.size()-1] == '\n') {
             buf.chop(1);
@@ -172,3 +184,7 @@ QProcess* GdbMonitor::process () {
     return _process;
 }
 
+void GdbMonitor::setSessionLog (SeerSessionLog* sessionLog) {
+    _sessionLog = sessionLog;
+}
+
@@ -4,6 +4,8 @@
 #include <QtCore/QObject>
 #include <QtCore/QtCore>
 
+class SeerSessionLog;
+
 class GdbMonitor : public QObject {
 
     Q_OBJECT
@@ -14,6 +16,7 @@ class GdbMonitor : public QObject {
 
         void            setProcess                      (QProcess* process);
         QProcess*       process                         ();
+        void            setSessionLog                   (SeerSessionLog* sessionLog);
 
     signals:
         void            allTextOutput                   (const QString& text);
@@ -36,6 +39,7 @@ class GdbMonitor : public QObject {
 
     private:
         QProcess*       _process;
+        SeerSessionLog* _sessionLog;
 };
 
 #endif
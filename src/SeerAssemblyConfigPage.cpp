@@ -79,6 +79,8 @@ QString SeerAssemblyConfigPage::disassemblyMode () const {
         return "function";
     }else if (pcLengthRadioButton->isChecked()) {
         return "length";
+    }else if (pcWindowRadioButton->isChecked()) {
+        return "window";
     }else{
         return "unknown";
     }
@@ -150,6 +152,8 @@ void SeerAssemblyConfigPage::setDisassemblyMode (const QString& mode, int bytes)
         pcFunctionRadioButton->setChecked(true);
     }else if (mode == "length") {
         pcLengthRadioButton->setChecked(true);
+    }else if (mode == "window") {
+        pcWindowRadioButton->setChecked(true);
     }else{
         pcFunctionRadioButton->setChecked(true);
     }
@@ -300,6 +300,16 @@ bool SeerConfigDialog::editorHighlighterEnabled () const {
     return _editorConfigPage->highlighterEnabled();
 }
 
+void SeerConfigDialog::setEditorMiniMapEnabled (bool flag) {
+
+    _editorConfigPage->setMiniMapEnabled(flag);
+}
+
+bool SeerConfigDialog::editorMiniMapEnabled () const {
+
+    return _editorConfigPage->miniMapEnabled();
+}
+
 void SeerConfigDialog::setSourceAlternateDirectories (const QStringList& alternateDirectories) {
 
     _sourceConfigPage->setAlternateDirectories(alternateDirectories);
@@ -1,4 +1,5 @@
 #include "SeerConsoleWidget.h"
+#include "SeerSessionLog.h"
 #include <QtWidgets/QPlainTextEdit>
 #include <QtWidgets/QCheckBox>
 #include <QtWidgets/QFileDialog>
@@ -9,6 +10,7 @@
 #include <QtPrintSupport/QPrintDialog>
 #include <QtGui/QFont>
 #include <QtGui/QIcon>
+#include <QtGui/QTextDocument>
 #include <QtCore/QTextStream>
 #include <QtCore/QSettings>
 #include <QtCore/QDebug>
@@ -18,6 +20,7 @@
 #include <termios.h>
 #include <sys/ioctl.h>
 #include <stdio.h>
+#include <string.h>
 
 SeerConsoleWidget::SeerConsoleWidget (QWidget* parent) : QWidget(parent) {
 
@@ -25,7 +28,10 @@ SeerConsoleWidget::SeerConsoleWidget (QWidget* parent) : QWidget(parent) {
     _ttyDeviceName = "";
     _ptsFD         = -1;
     _ptsListener   = 0;
+    _sessionLog    = 0;
     _mode          = "normal";
+    _pendingBytes  = 0;
+    _droppedBytes  = 0;
 
     // Set up UI.
     setupUi(this);
@@ -45,9 +51,15 @@ SeerConsoleWidget::SeerConsoleWidget (QWidget* parent) : QWidget(parent) {
     textEdit->setFont(font);
     textEdit->setLineWrapMode(QPlainTextEdit::NoWrap); // No wrap
     wrapTextCheckBox->setCheckState(Qt::Unchecked); // No wrap
+    textEdit->setUndoRedoEnabled(false); // Output can't be undone. Don't keep a history of it.
 
     _cursor = QTextCursor(textEdit->document());
 
+    // Show what was read at most once per frame.
+    _renderTimer = new QTimer(this);
+    _renderTimer->setSingleShot(true);
+    _renderTimer->setInterval(RenderInterval);
+
     // Create psuedo terminal for console.
     createConsole();
     connectConsole();
@@ -61,6 +73,7 @@ SeerConsoleWidget::SeerConsoleWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(fontButton,        &QPushButton::clicked,      this,  &SeerConsoleWidget::handleFontButton);
     QObject::connect(wrapTextCheckBox,  &QCheckBox::clicked,        this,  &SeerConsoleWidget::handleWrapTextCheckBox);
     QObject::connect(stdinLineEdit,     &QLineEdit::returnPressed,  this,  &SeerConsoleWidget::handleStdinLineEdit);
+    QObject::connect(_renderTimer,      &QTimer::timeout,           this,  &SeerConsoleWidget::handleRenderTimer);
 
     // Restore window settings.
     readSettings();
@@ -77,11 +90,14 @@ const QString& SeerConsoleWidget::ttyDeviceName () const {
 
 void SeerConsoleWidget::handleText (const char* buffer, int count) {
 
+    // Plain output at the end of the console. Add it in one go.
+    if (_cursor.atEnd() && memchr(buffer, '\r', count) == 0) {
+        _cursor.insertText(QString::fromLatin1(buffer, count));
+        return;
+    }
+
     // parse off lines
     const char* start = buffer;
-    
-    // Write text to stderr on console.
-    write (2, start, count);    
 
     while (count > 0) {
 
@@ -115,9 +131,72 @@ void SeerConsoleWidget::handleText (const char* buffer, int count) {
             _cursor.movePosition(QTextCursor::End);
             _cursor.insertText(QString('\n'));
         }
+    }
+}
+
+void SeerConsoleWidget::handleRenderTimer () {
+
+    if (_pendingChunks.size() == 0 && _droppedBytes == 0) {
+        return;
+    }
+
+    // Take up to a frame's worth of output, oldest first.
+    QByteArray text;
+
+    while (_pendingChunks.size() > 0 && text.size() < FrameLimit) {
+
+        QByteArray chunk = _pendingChunks.takeFirst();
+
+        _pendingBytes -= chunk.size();
+
+        text.append(chunk);
+    }
+
+    // The tty turns '\n' into "\r\n". Undo that, so most output takes the fast path in handleText().
+    text.replace("\r\n", "\n");
+
+    _cursor.beginEditBlock();
+
+    // Say so if output was lost.
+    if (_droppedBytes > 0) {
+
+        _cursor.movePosition(QTextCursor::End);
+        _cursor.insertText(QString("\n[Seer: %1 bytes of output were dropped. The program wrote faster than the console can show it.]\n").arg(_droppedBytes));
+
+        _droppedBytes = 0;
+    }
+
+    handleText(text.constData(), text.size());
+
+    _cursor.endEditBlock();
+
+    trimScrollback();
+
+    textEdit->verticalScrollBar()->setValue(textEdit->verticalScrollBar()->maximum());
+
+    // More next frame.
+    if (_pendingChunks.size() > 0) {
+        _renderTimer->start();
+    }
+}
+
+void SeerConsoleWidget::trimScrollback () {
+
+    // The line limit is done by the document. Limit the characters too, for programs
+    // that write very long lines. Take off a quarter more, so this isn't done every frame.
+    QTextDocument* document = textEdit->document();
 
-        textEdit->verticalScrollBar()->setValue(textEdit->verticalScrollBar()->maximum());
+    int count = document->characterCount();
+
+    if (count <= ScrollbackLimit) {
+        return;
     }
+
+    QTextCursor cursor(document);
+
+    cursor.setPosition(count - ScrollbackLimit + ScrollbackLimit / 4, QTextCursor::KeepAnchor);
+    cursor.movePosition(QTextCursor::NextBlock, QTextCursor::KeepAnchor);
+    cursor.removeSelectedText();
 }
 
 void SeerConsoleWidget::handleChangeWindowTitle (QString title) {
@@ -130,6 +209,11 @@ void SeerConsoleWidget::handleChangeWindowTitle (QString title) {
 }
 
 void SeerConsoleWidget::handleClearButton () {
+
+    _pendingChunks.clear();
+    _pendingBytes = 0;
+    _droppedBytes = 0;
+
     textEdit->clear();
     _cursor.movePosition(QTextCursor::End);
 }
@@ -246,9 +330,14 @@ void SeerConsoleWidget::handleConsoleOutput (int socketfd) {
 
     Q_UNUSED(socketfd);
 
-    char buffer[1024];
+    //
+    // Drain the tty. Keep what was read until the next frame. If the program writes
+    // faster than that, drop the oldest output and say so later.
+    //
+    char buffer[ReadSize];
+    int  total = 0;
 
-    while (1) {
+    while (total < PendingLimit) {
         int n = read(_ptsFD, buffer, sizeof(buffer));
 
         if (n < 0) {
@@ -266,8 +355,37 @@ void SeerConsoleWidget::handleConsoleOutput (int socketfd) {
             break;
         }
 
-        handleText(buffer, n);
-        break;
+        if (n == 0) {
+            break;
+        }
+
+        total += n;
+
+        // The session log gets everything, even what the console may drop.
+        if (_sessionLog && _sessionLog->isEnabled()) {
+            _sessionLog->write(SeerSessionLog::Console, QByteArray(buffer, n));
+        }
+
+        // Top up the last chunk, so small reads don't each hold a chunk.
+        if (_pendingChunks.size() > 0 && _pendingChunks.last().size() < ReadSize) {
+            _pendingChunks.last().append(buffer, n);
+        }else{
+            _pendingChunks.append(QByteArray(buffer, n));
+        }
+
+        _pendingBytes += n;
+
+        while (_pendingBytes > PendingLimit && _pendingChunks.size() > 1) {
+
+            _pendingBytes -= _pendingChunks.first().size();
+            _droppedBytes += _pendingChunks.first().size();
+
+            _pendingChunks.removeFirst();
+        }
+    }
+
+    if (_pendingBytes > 0 && _renderTimer->isActive() == false) {
+        _renderTimer->start();
     }
 }
 
@@ -408,6 +526,11 @@ QString SeerConsoleWidget::mode () const {
     return _mode;
 }
 
+void SeerConsoleWidget::setSessionLog (SeerSessionLog* sessionLog) {
+
+    _sessionLog = sessionLog;
+}
+
 void SeerConsoleWidget::writeSettings() {
 
     QSettings settings;
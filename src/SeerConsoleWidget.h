@@ -4,9 +4,14 @@
 #include <QtGui/QTextCursor>
 #include <QtGui/QResizeEvent>
 #include <QtCore/QString>
+#include <QtCore/QByteArray>
+#include <QtCore/QList>
+#include <QtCore/QTimer>
 #include <QtCore/QSocketNotifier>
 #include "ui_SeerConsoleWidget.h"
 
+class SeerSessionLog;
+
 class SeerConsoleWidget : public QWidget, protected Ui::SeerConsoleWidgetForm {
 
     Q_OBJECT
@@ -25,6 +30,8 @@ class SeerConsoleWidget : public QWidget, protected Ui::SeerConsoleWidgetForm {
         void                setMode                     (const QString& mode);
         QString             mode                        () const;
 
+        void                setSessionLog               (SeerSessionLog* sessionLog);
+
     public slots:
         void                handleChangeWindowTitle     (QString title);
 
@@ -36,6 +43,7 @@ class SeerConsoleWidget : public QWidget, protected Ui::SeerConsoleWidgetForm {
         void                handleWrapTextCheckBox      ();
         void                handleStdinLineEdit         ();
         void                handleConsoleOutput         (int socketfd);
+        void                handleRenderTimer           ();
 
     protected:
         void                handleText                  (const char* buffer, int count);
@@ -44,6 +52,7 @@ class SeerConsoleWidget : public QWidget, protected Ui::SeerConsoleWidgetForm {
         void                writeSettings               ();
         void                readSettings                ();
         void                resizeEvent                 (QResizeEvent* event);
+        void                trimScrollback              ();
 
     private:
         QString             _mode;
@@ -51,5 +60,18 @@ class SeerConsoleWidget : public QWidget, protected Ui::SeerConsoleWidgetForm {
         QString             _ttyDeviceName;
         int                 _ptsFD;
         QSocketNotifier*    _ptsListener;
+        SeerSessionLog*     _sessionLog;
+
+        // Output read from the tty, not shown yet. Oldest chunks are dropped past PendingLimit.
+        QList<QByteArray>   _pendingChunks;
+        qint64              _pendingBytes;
+        qint64              _droppedBytes;
+        QTimer*             _renderTimer;
+
+        static const int    ReadSize        = 64 * 1024;            // Bytes per read() of the tty.
+        static const int    PendingLimit    = 8 * 1024 * 1024;      // Bytes waiting to be shown.
+        static const int    FrameLimit      = 1024 * 1024;          // Bytes shown per frame.
+        static const int    ScrollbackLimit = 16 * 1024 * 1024;     // Characters kept in the console.
+        static const int    RenderInterval  = 16;                   // Milliseconds between frames.
 };
 
@@ -34,6 +34,7 @@ SeerEditorConfigPage::SeerEditorConfigPage(QWidget* parent) : QWidget(parent) {
     QObject::connect(fontNameComboBox,            &QFontComboBox::currentFontChanged,       this, &SeerEditorConfigPage::handleFontChanged);
     QObject::connect(fontDialogButton,            &QToolButton::clicked,                    this, &SeerEditorConfigPage::handleFontDialog);
     QObject::connect(highlighterEnabledCheckBox,  &QToolButton::clicked,                    this, &SeerEditorConfigPage::handleEnabledChanged);
+    QObject::connect(miniMapEnabledCheckBox,      &QToolButton::clicked,                    this, &SeerEditorConfigPage::handleMiniMapEnabledChanged);
     QObject::connect(highlighterSuffixesLineEdit, &QHistoryLineEdit::lostFocus,             this, &SeerEditorConfigPage::handleHighlighterChanged);
     QObject::connect(themeApplyToolButton,        &QToolButton::clicked,                    this, &SeerEditorConfigPage::handleApplyTheme);
 
@@ -166,12 +167,25 @@ bool SeerEditorConfigPage::highlighterEnabled () const {
     return editorWidget->sourceArea()->highlighterEnabled();
 }
 
+void SeerEditorConfigPage::setMiniMapEnabled (bool flag) {
+
+    miniMapEnabledCheckBox->setChecked(flag);
+
+    editorWidget->sourceArea()->enableMiniMapArea(flag);
+}
+
+bool SeerEditorConfigPage::miniMapEnabled () const {
+
+    return editorWidget->sourceArea()->miniMapAreaEnabled();
+}
+
 void SeerEditorConfigPage::reset () {
 
     setEditorFont(QFont("monospace", 10));
     setEditorTabSize(4);
     setHighlighterSettings(SeerHighlighterSettings::populateForCPP(""));
     setHighlighterEnabled(true);
+    setMiniMapEnabled(false);
 }
 
 void SeerEditorConfigPage::handleFontSizeChanged (const QString& text) {
@@ -287,6 +301,11 @@ void SeerEditorConfigPage::handleEnabledChanged () {
     setHighlighterEnabled(highlighterEnabledCheckBox->isChecked());
 }
 
+void SeerEditorConfigPage::handleMiniMapEnabledChanged () {
+
+    setMiniMapEnabled(miniMapEnabledCheckBox->isChecked());
+}
+
 void SeerEditorConfigPage::handleApplyTheme () {
 
     setHighlighterSettings(SeerHighlighterSettings::populateForCPP(themeComboBox->currentText()));
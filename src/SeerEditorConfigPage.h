@@ -26,6 +26,9 @@ class SeerEditorConfigPage : public QWidget, public Ui::SeerEditorConfigPage {
         void                                setHighlighterEnabled           (bool flag);
         bool                                highlighterEnabled              () const;
 
+        void                                setMiniMapEnabled               (bool flag);
+        bool                                miniMapEnabled                  () const;
+
         void                                reset                           ();
 
     protected slots:
@@ -34,6 +37,7 @@ class SeerEditorConfigPage : public QWidget, public Ui::SeerEditorConfigPage {
         void                                handleFontDialog                ();
         void                                handleHighlighterChanged        ();
         void                                handleEnabledChanged            ();
+        void                                handleMiniMapEnabledChanged     ();
         void                                handleApplyTheme                ();
 
     private:
@@ -20,6 +20,7 @@ SeerEditorManagerWidget::SeerEditorManagerWidget (QWidget* parent) : QWidget(par
     _editorFont                = QFont("monospace", 10);                      // Default font.
     _editorHighlighterSettings = SeerHighlighterSettings::populateForCPP(""); // Default syntax highlighting.
     _editorHighlighterEnabled  = true;
+    _editorMiniMapEnabled      = false;
     _editorKeySettings         = SeerKeySettings::populate();                 // Default key settings.
     _editorTabSize             = 4;
     _assemblyWidget            = 0;
@@ -28,6 +29,7 @@ SeerEditorManagerWidget::SeerEditorManagerWidget (QWidget* parent) : QWidget(par
     _showOffsetColumn          = false;
     _showOpcodeColumn          = false;
     _showSourceLines           = false;
+    _assemblyDisassemblyWindow = 0;
     _notifyAssemblyTabShown    = true;
 
     // Setup UI
@@ -229,6 +231,20 @@ bool SeerEditorManagerWidget::assemblyShowSourceLines () const {
     return _showSourceLines;
 }
 
+void SeerEditorManagerWidget::setAssemblyDisassemblyWindow (int bytes) {
+
+    _assemblyDisassemblyWindow = bytes;
+
+    if (assemblyWidgetTab() != 0) {
+        assemblyWidgetTab()->assemblyArea()->setDisassemblyWindow(_assemblyDisassemblyWindow);
+    }
+}
+
+int SeerEditorManagerWidget::assemblyDisassemblyWindow () const {
+
+    return _assemblyDisassemblyWindow;
+}
+
 SeerEditorManagerFiles SeerEditorManagerWidget::openedFiles () const {
 
     SeerEditorManagerFiles files;
@@ -329,6 +345,32 @@ bool SeerEditorManagerWidget::editorHighlighterEnabled () const {
     return _editorHighlighterEnabled;
 }
 
+void SeerEditorManagerWidget::setEditorMiniMapEnabled (bool flag) {
+
+    _editorMiniMapEnabled = flag;
+
+    // Set the code widgets.
+    SeerEditorManagerEntries::iterator b = beginEntry();
+    SeerEditorManagerEntries::iterator e = endEntry();
+
+    while (b != e) {
+        b->widget->sourceArea()->enableMiniMapArea(_editorMiniMapEnabled);
+        b++;
+    }
+
+    // Don't forget about the assembly widget.
+    SeerEditorWidgetAssembly* assemblyWidget = assemblyWidgetTab();
+
+    if (assemblyWidget) {
+        assemblyWidget->assemblyArea()->enableMiniMapArea(editorMiniMapEnabled());
+    }
+}
+
+bool SeerEditorManagerWidget::editorMiniMapEnabled () const {
+
+    return _editorMiniMapEnabled;
+}
+
 void SeerEditorManagerWidget::setEditorAlternateDirectories (const QStringList alternateDirectories) {
 
     _editorAlternateDirectories = alternateDirectories;
@@ -565,10 +607,18 @@ void SeerEditorManagerWidget::handleText (const QString& text) {
             }
 
             // Parse through the frame list and set the current lines that are in the frame list.
+            // Only the frames near the top. A deep recursion would otherwise mark the same
+            // few lines thousands of times.
+            const int   maxframes  = 100;
             QStringList frame_list = Seer::parse(newtext, "frame=", '{', '}', false);
 
             for ( const auto& frame_text : frame_list  ) {
                 QString level_text    = Seer::parseFirst(frame_text, "level=",    '"', '"', false);
+
+                if (level_text.toInt() >= maxframes) {
+                    break;
+                }
+
                 QString addr_text     = Seer::parseFirst(frame_text, "addr=",     '"', '"', false);
                 QString func_text     = Seer::parseFirst(frame_text, "func=",     '"', '"', false);
                 QString file_text     = Seer::parseFirst(frame_text, "file=",     '"', '"', false);
@@ -593,6 +643,15 @@ void SeerEditorManagerWidget::handleText (const QString& text) {
             assemblyWidget->handleText(text);
         }
 
+    }else if (text.startsWith("=library-loaded,") || text.startsWith("=library-unloaded,") || text.startsWith("=thread-group-started,")) {
+
+        // Get the AssemblyWidget. Its cached listings may be out of date.
+        SeerEditorWidgetAssembly* assemblyWidget = assemblyWidgetTab();
+
+        if (assemblyWidget) {
+            assemblyWidget->assemblyArea()->handleText(text);
+        }
+
     }else if (text.startsWith("^done,asm_insns=")) {
 
         // Get the AssemblyWidget.
@@ -634,6 +693,18 @@ void SeerEditorManagerWidget::handleText (const QString& text) {
             assemblyWidget->handleText(text);
         }
 
+    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,asm_insns=")) || text.contains(QRegularExpression("^([0-9]+)\\^done,lines="))) {
+
+        // 14^done,asm_insns=[...]
+        // 15^done,lines=[{pc="0x0000000000401136",line="5"},...]
+
+        // More of a windowed listing for the AssemblyWidget. It ignores ids it didn't ask for.
+        SeerEditorWidgetAssembly* assemblyWidget = assemblyWidgetTab();
+
+        if (assemblyWidget) {
+            assemblyWidget->assemblyArea()->handleText(text);
+        }
+
     }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
 
         // 12^error,msg="No symbol \"return\" in current context."
@@ -645,6 +716,12 @@ void SeerEditorManagerWidget::handleText (const QString& text) {
             static_cast<SeerEditorWidgetSource*>(w)->sourceArea()->handleText(text);
         }
 
+        SeerEditorWidgetAssembly* assemblyWidget = assemblyWidgetTab();
+
+        if (assemblyWidget) {
+            assemblyWidget->assemblyArea()->handleText(text);
+        }
+
     }else{
         // Ignore others.
         return;
@@ -791,6 +868,7 @@ SeerEditorWidgetSource* SeerEditorManagerWidget::createEditorWidgetTab (const QS
     editorWidget->sourceArea()->setEditorTabSize(editorTabSize());
     editorWidget->sourceArea()->setHighlighterSettings(editorHighlighterSettings());
     editorWidget->sourceArea()->setHighlighterEnabled(editorHighlighterEnabled());
+    editorWidget->sourceArea()->enableMiniMapArea(editorMiniMapEnabled());
     editorWidget->sourceArea()->setAlternateDirectories(editorAlternateDirectories());
     editorWidget->setKeySettings(editorKeySettings());
 
@@ -850,6 +928,7 @@ SeerEditorWidgetSource* SeerEditorManagerWidget::createEditorWidgetTab (const QS
     editorWidget->sourceArea()->setEditorTabSize(editorTabSize());
     editorWidget->sourceArea()->setHighlighterSettings(editorHighlighterSettings());
     editorWidget->sourceArea()->setHighlighterEnabled(editorHighlighterEnabled());
+    editorWidget->sourceArea()->enableMiniMapArea(editorMiniMapEnabled());
     editorWidget->sourceArea()->setAlternateDirectories(editorAlternateDirectories());
     editorWidget->setKeySettings(editorKeySettings());
 
@@ -946,6 +1025,8 @@ SeerEditorWidgetAssembly* SeerEditorManagerWidget::createAssemblyWidgetTab () {
     assemblyWidget->assemblyArea()->setEditorTabSize(editorTabSize());
     assemblyWidget->assemblyArea()->setHighlighterSettings(editorHighlighterSettings());
     assemblyWidget->assemblyArea()->setHighlighterEnabled(editorHighlighterEnabled());
+    assemblyWidget->assemblyArea()->enableMiniMapArea(editorMiniMapEnabled());
+    assemblyWidget->assemblyArea()->setDisassemblyWindow(assemblyDisassemblyWindow());
 
     assemblyWidget->setShowAddressColumn(assemblyShowAddressColumn());
     assemblyWidget->setShowOffsetColumn(assemblyShowOffsetColumn());
@@ -968,6 +1049,8 @@ SeerEditorWidgetAssembly* SeerEditorManagerWidget::createAssemblyWidgetTab () {
     QObject::connect(assemblyWidget->assemblyArea(), &SeerEditorWidgetAssemblyArea::runToAddress,                   this, &SeerEditorManagerWidget::handleRunToAddress);
     QObject::connect(assemblyWidget->assemblyArea(), &SeerEditorWidgetAssemblyArea::requestAssembly,                this, &SeerEditorManagerWidget::handleRequestAssembly);
     QObject::connect(assemblyWidget->assemblyArea(), &SeerEditorWidgetAssemblyArea::requestSourceAndAssembly,       this, &SeerEditorManagerWidget::handleRequestSourceAndAssembly);
+    QObject::connect(assemblyWidget->assemblyArea(), &SeerEditorWidgetAssemblyArea::requestSourceAndAssemblyRange,  this, &SeerEditorManagerWidget::handleRequestSourceAndAssemblyRange);
+    QObject::connect(assemblyWidget->assemblyArea(), &SeerEditorWidgetAssemblyArea::requestSourceLines,             this, &SeerEditorManagerWidget::handleRequestSourceLines);
     QObject::connect(assemblyWidget->assemblyArea(), &SeerEditorWidgetAssemblyArea::addMemoryVisualize,             this, &SeerEditorManagerWidget::handleAddMemoryVisualizer);
     QObject::connect(assemblyWidget->assemblyArea(), &SeerEditorWidgetAssemblyArea::addArrayVisualize,              this, &SeerEditorManagerWidget::handleAddArrayVisualizer);
     QObject::connect(assemblyWidget->assemblyArea(), &SeerEditorWidgetAssemblyArea::addStructVisualize,             this, &SeerEditorManagerWidget::handleAddStructVisualizer);
@@ -1250,6 +1333,18 @@ void SeerEditorManagerWidget::handleRequestSourceAndAssembly (QString address) {
     emit refreshStackFrames();
 }
 
+void SeerEditorManagerWidget::handleRequestSourceAndAssemblyRange (int id, QString address, int count) {
+
+    // rethrow
+    emit requestSourceAndAssemblyRange (id, address, count);
+}
+
+void SeerEditorManagerWidget::handleRequestSourceLines (int id, QString fullname) {
+
+    // rethrow
+    emit requestSourceLines (id, fullname);
+}
+
 void SeerEditorManagerWidget::handleAssemblyConfigChanged () {
 
     // Tell the assembly tab to refresh.
@@ -43,6 +43,8 @@ class SeerEditorManagerWidget : public QWidget, protected Ui::SeerEditorManagerW
         bool                                            assemblyShowOpcodeColumn            () const;
         void                                            setAssemblyShowSourceLines          (bool flag);
         bool                                            assemblyShowSourceLines             () const;
+        void                                            setAssemblyDisassemblyWindow        (int bytes);
+        int                                             assemblyDisassemblyWindow           () const;
 
 
         SeerEditorManagerFiles                          openedFiles                         () const;
@@ -53,6 +55,8 @@ class SeerEditorManagerWidget : public QWidget, protected Ui::SeerEditorManagerW
         const SeerHighlighterSettings&                  editorHighlighterSettings           () const;
         void                                            setEditorHighlighterEnabled         (bool flag);
         bool                                            editorHighlighterEnabled            () const;
+        void                                            setEditorMiniMapEnabled             (bool flag);
+        bool                                            editorMiniMapEnabled                () const;
         void                                            setEditorAlternateDirectories       (const QStringList alternateDirectories);
         const QStringList&                              editorAlternateDirectories          () const;
         void                                            setEditorIgnoreDirectories          (const QStringList ignoreDirectories);
@@ -85,6 +89,8 @@ class SeerEditorManagerWidget : public QWidget, protected Ui::SeerEditorManagerW
         void                                            handleAddStructVisualizer           (QString expression);
         void                                            handleRequestAssembly               (QString address);
         void                                            handleRequestSourceAndAssembly      (QString address);
+        void                                            handleRequestSourceAndAssemblyRange (int id, QString address, int count);
+        void                                            handleRequestSourceLines            (int id, QString fullname);
         void                                            handleAssemblyConfigChanged         ();
 
     private slots:
@@ -113,6 +119,8 @@ class SeerEditorManagerWidget : public QWidget, protected Ui::SeerEditorManagerW
         void                                            addStructVisualize                  (QString expression);
         void                                            requestAssembly                     (QString address);
         void                                            requestSourceAndAssembly            (QString address);
+        void                                            requestSourceAndAssemblyRange       (int id, QString address, int count);
+        void                                            requestSourceLines                  (int id, QString fullname);
         void                                            showMessage                         (QString message, int time);
         void                                            assemblyTabShown                    (bool shown);
 
@@ -128,6 +136,7 @@ class SeerEditorManagerWidget : public QWidget, protected Ui::SeerEditorManagerW
         SeerEditorManagerEntries                        _entries;
         SeerHighlighterSettings                         _editorHighlighterSettings;
         bool                                            _editorHighlighterEnabled;
+        bool                                            _editorMiniMapEnabled;
         QFont                                           _editorFont;
         QStringList                                     _editorAlternateDirectories;
         QStringList                                     _editorIgnoreDirectories;
@@ -140,6 +149,7 @@ class SeerEditorManagerWidget : public QWidget, protected Ui::SeerEditorManagerW
         bool                                            _showOffsetColumn;
         bool                                            _showOpcodeColumn;
         bool                                            _showSourceLines;
+        int                                             _assemblyDisassemblyWindow;
         bool                                            _notifyAssemblyTabShown;
 };
 
@@ -61,6 +61,7 @@ SeerEditorWidgetAssembly::SeerEditorWidgetAssembly(QWidget* parent) : QWidget(pa
     QObject::connect(searchUpToolButton,                &QToolButton::clicked,                          this,  &SeerEditorWidgetAssembly::handleSearchUpToolButton);
     QObject::connect(searchLineNumberLineEdit,          &QLineEdit::returnPressed,                      this,  &SeerEditorWidgetAssembly::handleSearchLineNumberLineEdit);
     QObject::connect(searchCloseToolButton,             &QToolButton::clicked,                          this,  &SeerEditorWidgetAssembly::handleSearchCloseToolButton);
+    QObject::connect(assemblyArea(),                    &SeerPlainTextEdit::findMatchesChanged,         this,  &SeerEditorWidgetAssembly::handleFindMatchesChanged);
     QObject::connect(refreshToolButton,                 &QToolButton::clicked,                          this,  &SeerEditorWidgetAssembly::reloadAssembly);
     QObject::connect(refreshToolButton,                 &QToolButton::clicked,                          this,  &SeerEditorWidgetAssembly::reloadRegisters);
     QObject::connect(showAddressCheckBox,               &QCheckBox::stateChanged,                       this,  &SeerEditorWidgetAssembly::handleShowAddressColumn);
@@ -380,9 +381,8 @@ void SeerEditorWidgetAssembly::handleSearchTextLineEdit () {
         return;
     }
 
-    int nMatches = assemblyArea()->findText(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
-
-    matchesLabel->setText(QString("(%1)").arg(nMatches));
+    // The matches are found in the background. The label follows along.
+    assemblyArea()->findText(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
 }
 
 void SeerEditorWidgetAssembly::handleSearchDownToolButton () {
@@ -393,7 +393,7 @@ void SeerEditorWidgetAssembly::handleSearchDownToolButton () {
         return;
     }
 
-    assemblyArea()->find(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
+    assemblyArea()->findNext(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
 }
 
 void SeerEditorWidgetAssembly::handleSearchUpToolButton () {
@@ -404,7 +404,28 @@ void SeerEditorWidgetAssembly::handleSearchUpToolButton () {
         return;
     }
 
-    assemblyArea()->find(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()) | QTextDocument::FindBackward);
+    assemblyArea()->findPrevious(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
+}
+
+void SeerEditorWidgetAssembly::handleFindMatchesChanged () {
+
+    if (assemblyArea()->findPattern() == "") {
+        matchesLabel->setText("");
+        return;
+    }
+
+    // "(3 of 120)" once a match is selected. A trailing '+' while still searching.
+    QString count = QString::number(assemblyArea()->findMatchCount());
+
+    if (assemblyArea()->findMatchDone() == false) {
+        count += "+";
+    }
+
+    if (assemblyArea()->findMatchCurrent() >= 0) {
+        matchesLabel->setText(QString("(%1 of %2)").arg(assemblyArea()->findMatchCurrent()+1).arg(count));
+    }else{
+        matchesLabel->setText(QString("(%1)").arg(count));
+    }
 }
 
 void SeerEditorWidgetAssembly::handleSearchCloseToolButton () {
@@ -15,6 +15,7 @@
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QVector>
+#include <QtCore/QPair>
 #include <QtCore/QMap>
 
 class SeerEditorWidgetAssemblyLineNumberArea;
@@ -23,6 +24,38 @@ class SeerEditorWidgetAssemblyBreakPointArea;
 class SeerEditorWidgetAssemblyOpcodeArea;
 class SeerEditorWidgetAssemblyMiniMapArea;
 
+//
+// The assembly for one function (or address range), ready to be shown.
+// Kept in a small cache so revisiting a function doesn't go back to gdb.
+//
+struct SeerEditorWidgetAssemblyListing {
+    QString                                         text;
+    QVector<QPair<qulonglong,int>>                  addressLines;           // (address,lineno). Sorted by address.
+    QVector<QPair<qulonglong,int>>                  offsetLines;            // (offset,lineno). Sorted by offset.
+    QVector<QString>                                lineAddresses;          // Indexed by lineno-1. "" for source lines.
+    QVector<qulonglong>                             lineOffsets;            // Indexed by lineno-1.
+    QVector<QString>                                lineOpcodes;            // Indexed by lineno-1.
+    QVector<int>                                    sourceLinePositions;    // Where each source line starts.
+    QVector<int>                                    assemblyLinePositions;  // Where each assembly line starts.
+    int                                             maxAddressLength = 0;
+    qulonglong                                      maxOffset        = 0;
+    int                                             maxOpcodeLength  = 0;
+};
+
+//
+// One instruction of a windowed listing, with the source line it came from.
+//
+struct SeerEditorWidgetAssemblyInstruction {
+    QString                                         address;
+    QString                                         funcName;
+    QString                                         offset;
+    QString                                         opcodes;
+    QString                                         inst;
+    QString                                         file;
+    QString                                         fullname;
+    int                                             line = 0;
+};
+
 class SeerEditorWidgetAssemblyArea : public SeerPlainTextEdit {
 
     Q_OBJECT
@@ -68,8 +101,6 @@ class SeerEditorWidgetAssemblyArea : public SeerPlainTextEdit {
         bool                                        setCurrentLine                      (const QString& address);
         void                                        scrollToLine                        (const QString& address);
 
-        int                                         findText                            (const QString& text, QTextDocument::FindFlags flags);
-        void                                        clearFindText                       ();
 
         void                                        clearBreakpoints                    ();
         void                                        addBreakpoint                       (int number, const QString& address, bool enabled);
@@ -94,6 +125,15 @@ class SeerEditorWidgetAssemblyArea : public SeerPlainTextEdit {
 
         QString                                     sourceForLine                       (const QString& fullname, const QString& file, int line);
 
+        int                                         lineForAddress                      (qulonglong address) const;
+        int                                         lineForOffset                       (qulonglong offset) const;
+        QString                                     addressForLine                      (int lineno) const;
+
+        void                                        clearAssemblyCache                  ();
+
+        void                                        setDisassemblyWindow                (int bytes);
+        int                                         disassemblyWindow                   () const;
+
         void                                        setEditorFont                       (const QFont& font);
         const QFont&                                editorFont                          () const;
         void                                        setEditorTabSize                    (int spaces);
@@ -112,6 +152,8 @@ class SeerEditorWidgetAssemblyArea : public SeerPlainTextEdit {
         void                                        addStructVisualize                  (QString expression);
         void                                        requestAssembly                     (QString address);
         void                                        requestSourceAndAssembly            (QString address);
+        void                                        requestSourceAndAssemblyRange       (int id, QString address, int count);
+        void                                        requestSourceLines                  (int id, QString fullname);
         void                                        showSearchBar                       (bool flag);
         void                                        highlighterSettingsChanged          ();
 
@@ -124,17 +166,38 @@ class SeerEditorWidgetAssemblyArea : public SeerPlainTextEdit {
         void                                        contextMenuEvent                    (QContextMenuEvent* event);
 
     private slots:
-        void                                        refreshExtraSelections              ();
+        void                                        refreshExtraSelections              () override;
 
         void                                        updateTextArea                      ();
+        void                                        showListing                         (const SeerEditorWidgetAssemblyListing& listing);
         void                                        updateMarginAreasWidth              (int newBlockCount);
         void                                        updateLineNumberArea                (const QRect& rect, int dy);
         void                                        updateOffsetArea                    (const QRect& rect, int dy);
         void                                        updateBreakPointArea                (const QRect& rect, int dy);
         void                                        updateOpcodeArea                    (const QRect& rect, int dy);
         void                                        updateMiniMapArea                   (const QRect& rect, int dy);
+        void                                        updateMiniMapAreaGeometry           ();
+        void                                        handleWindowScroll                  (int value);
 
     private:
+        enum WindowRequest {
+            WindowNone,
+            WindowForward,
+            WindowBackward,
+            WindowLines
+        };
+
+        void                                        appendSourceLine                    (SeerEditorWidgetAssemblyListing& listing, QStringList& lines, int& position, const QString& fullname, const QString& file, int line);
+        void                                        appendAssemblyLine                  (SeerEditorWidgetAssemblyListing& listing, QStringList& lines, int& position, const QString& address, const QString& offset, const QString& opcodes, const QString& inst);
+
+        QMap<qulonglong,SeerEditorWidgetAssemblyInstruction> parseWindowInstructions    (const QString& text) const;
+        int                                         mergeWindowInstructions             (const QMap<qulonglong,SeerEditorWidgetAssemblyInstruction>& instructions, bool& foreign);
+        void                                        startWindow                         ();
+        void                                        showWindow                          (bool keepView);
+        void                                        extendWindowForward                 ();
+        void                                        extendWindowBackward                ();
+        void                                        handleWindowText                    (const QString& text);
+
         bool                                        _enableLineNumberArea;
         bool                                        _enableOffsetArea;
         bool                                        _enableBreakPointArea;
@@ -144,7 +207,6 @@ class SeerEditorWidgetAssemblyArea : public SeerPlainTextEdit {
         QVector<int>                                _breakpointsNumbers;
         QVector<QString>                            _breakpointsAddresses;
         QVector<bool>                               _breakpointsEnableds;
-        QList<QTextEdit::ExtraSelection>            _findExtraSelections;
         QList<QTextEdit::ExtraSelection>            _currentLinesExtraSelections;
         QList<QTextEdit::ExtraSelection>            _sourceLinesExtraSelections;
 
@@ -154,20 +216,30 @@ class SeerEditorWidgetAssemblyArea : public SeerPlainTextEdit {
         SeerEditorWidgetAssemblyOpcodeArea*         _opcodeArea;
         SeerEditorWidgetAssemblyMiniMapArea*        _miniMapArea;
 
-        QPixmap*                                    _miniMapPixmap;
         SeerHighlighterSettings                     _sourceHighlighterSettings;
         bool                                        _sourceHighlighterEnabled;
+        QTextCharFormat                             _marginFormat;
+        QTextCharFormat                             _assemblyTextFormat;
 
         QString                                     _currentAddress;
-        QMap<qulonglong,int>                        _addressLineMap;
-        QMap<qulonglong,int>                        _offsetLineMap;
-        QMap<int,QString>                           _lineAddressMap;
-        QMap<int,qulonglong>                        _lineOffsetMap;
-        QMap<int,QString>                           _lineOpcodeMap;
+        SeerEditorWidgetAssemblyListing             _listing;
+        QList<SeerEditorWidgetAssemblyListing>      _listingCache;          // Most recently used first.
 
         // Text from asm_insns command.
         QString                                     _asm_insns_text;
 
+        // Windowed listing. Only part of a (large) function, extended while scrolling.
+        int                                         _disassemblyWindow;     // Bytes per request. 0 when not windowed.
+        int                                         _windowId;              // Id of the request in flight. 0 if none.
+        WindowRequest                               _windowRequest;
+        QMap<qulonglong,SeerEditorWidgetAssemblyInstruction> _windowInstructions;
+        QString                                     _windowFunction;
+        bool                                        _windowAtStart;
+        bool                                        _windowAtEnd;
+        bool                                        _windowUpdating;
+        QString                                     _windowLinesFullname;
+        QVector<qulonglong>                         _windowLineAddresses;   // From the line table. Sorted.
+
         // Source lines for assembly file.
         QStringList                                 _fileLines;
         QString                                     _fileFullname;
@@ -321,6 +393,7 @@ class SeerEditorWidgetAssembly : public QWidget, protected Ui::SeerEditorWidgetA
         void                                        handleSearchDownToolButton          ();
         void                                        handleSearchUpToolButton            ();
         void                                        handleSearchCloseToolButton         ();
+        void                                        handleFindMatchesChanged            ();
         void                                        handleTextSearchShortcut            ();
         void                                        handleShowAddressColumn             ();
         void                                        handleShowOffsetColumn              ();
@@ -25,6 +25,7 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QDebug>
+#include <algorithm>
 
 //
 // Assembly Area
@@ -39,12 +40,12 @@ SeerEditorWidgetAssemblyArea::SeerEditorWidgetAssemblyArea(QWidget* parent) : Se
     _enableMiniMapArea    = false;
     _enableSourceLines    = false;
     _sourceTabSize        = 4;
-
-    _addressLineMap.clear();
-    _offsetLineMap.clear();
-    _lineAddressMap.clear();
-    _lineOffsetMap.clear();
-    _lineOpcodeMap.clear();
+    _disassemblyWindow    = 0;
+    _windowId             = 0;
+    _windowRequest        = WindowNone;
+    _windowAtStart        = false;
+    _windowAtEnd          = false;
+    _windowUpdating       = false;
 
     QFont font("monospace");
     font.setStyleHint(QFont::Monospace);
@@ -59,13 +60,12 @@ SeerEditorWidgetAssemblyArea::SeerEditorWidgetAssemblyArea(QWidget* parent) : Se
     _breakPointArea = new SeerEditorWidgetAssemblyBreakPointArea(this);
     _opcodeArea     = new SeerEditorWidgetAssemblyOpcodeArea(this);
     _miniMapArea    = new SeerEditorWidgetAssemblyMiniMapArea(this);
-    _miniMapPixmap  = 0;
 
     enableLineNumberArea(true);
     enableOffsetArea(true);
     enableBreakPointArea(true);
     enableOpcodeArea(true);
-    enableMiniMapArea(false);   // Doesn't work yet. Need to work on the "mini" part.
+    enableMiniMapArea(false);
     enableSourceLines(true);
 
     QObject::connect(this, &SeerEditorWidgetAssemblyArea::blockCountChanged,                this, &SeerEditorWidgetAssemblyArea::updateMarginAreasWidth);
@@ -75,6 +75,8 @@ SeerEditorWidgetAssemblyArea::SeerEditorWidgetAssemblyArea(QWidget* parent) : Se
     QObject::connect(this, &SeerEditorWidgetAssemblyArea::updateRequest,                    this, &SeerEditorWidgetAssemblyArea::updateOpcodeArea);
     QObject::connect(this, &SeerEditorWidgetAssemblyArea::updateRequest,                    this, &SeerEditorWidgetAssemblyArea::updateMiniMapArea);
     QObject::connect(this, &SeerEditorWidgetAssemblyArea::highlighterSettingsChanged,       this, &SeerEditorWidgetAssemblyArea::handleHighlighterSettingsChanged);
+    QObject::connect(this, &SeerEditorWidgetAssemblyArea::miniMapChanged,                   _miniMapArea, QOverload<>::of(&QWidget::update));
+    QObject::connect(verticalScrollBar(), &QScrollBar::valueChanged,                         this, &SeerEditorWidgetAssemblyArea::handleWindowScroll);
 
     setCurrentLine("");
 
@@ -163,7 +165,13 @@ void SeerEditorWidgetAssemblyArea::enableMiniMapArea (bool flag) {
 
     _enableMiniMapArea = flag;
 
+    // Start (or stop) building the minimap rendering.
+    enableMiniMap(flag);
+
+    _miniMapArea->setVisible(flag);
+
     updateMarginAreasWidth(0);
+    updateMiniMapAreaGeometry();
 }
 
 bool SeerEditorWidgetAssemblyArea::miniMapAreaEnabled () const {
@@ -195,18 +203,15 @@ void SeerEditorWidgetAssemblyArea::updateTextArea () {
 
     QApplication::setOverrideCursor(Qt::BusyCursor);
 
-    // Clear the existing document.
-    document()->clear();
-
-    // Clear mappings.
-    _addressLineMap.clear();
-    _offsetLineMap.clear();
-    _lineAddressMap.clear();
-    _lineOffsetMap.clear();
-    _lineOpcodeMap.clear();
+    //
+    // Build the whole text in one buffer and give it to the document once.
+    // Keep track of where each line starts so the selections don't need
+    // to look up blocks afterwards.
+    //
+    SeerEditorWidgetAssemblyListing listing;
 
-    // Clear 'source line' selections.
-    _sourceLinesExtraSelections.clear();
+    QStringList lines;
+    int         position = 0;
 
     // Get the list of source and assembly lines.
     QString asm_insns_text = Seer::parseFirst(_asm_insns_text, "asm_insns=", '[', ']', false);
@@ -219,8 +224,6 @@ void SeerEditorWidgetAssemblyArea::updateTextArea () {
         //qDebug() << "src_and_asm_text mode.";
 
         // Loop through the asm list and print each line.
-        int lineno = 1;
-
         for ( const auto& src_and_asm_text : src_and_asm_list ) {
 
             // Get the strings, with padding.
@@ -230,35 +233,7 @@ void SeerEditorWidgetAssemblyArea::updateTextArea () {
 
             // Print source line?
             if (sourceLinesEnabled() == true) {
-
-                // Get source for 'line'
-                QString sourceLine = sourceForLine(fullname_text, file_text, line_text.toInt());
-
-                sourceLine = Seer::expandTabs(sourceLine, editorTabSize(), false); // Expand tabs.
-                sourceLine = sourceLine.simplified(); // Remove blank spaces at front and end of line.
-
-                // Write source line to the document.
-                appendPlainText(sourceLine);
-
-                // Highlight it.
-                QTextCharFormat sourceLinesFormat = highlighterSettings().get("Text");
-
-                QTextBlock  block  = document()->findBlockByLineNumber(lineno-1);
-                QTextCursor cursor = textCursor();
-
-                cursor.setPosition(block.position());
-                setTextCursor(cursor);
-
-                QTextEdit::ExtraSelection selection;
-                selection.format.setForeground(sourceLinesFormat.foreground());
-                selection.format.setBackground(sourceLinesFormat.background());
-                selection.format.setProperty(QTextFormat::FullWidthSelection, true);
-                selection.cursor = textCursor();
-                selection.cursor.clearSelection();
-
-                _sourceLinesExtraSelections.append(selection);
-
-                lineno++;
+                appendSourceLine(listing, lines, position, fullname_text, file_text, line_text.toInt());
             }
 
             // Get the list of assembly lines.
@@ -277,35 +252,7 @@ void SeerEditorWidgetAssemblyArea::updateTextArea () {
 
                 inst_text = Seer::expandTabs(inst_text, editorTabSize(), true); // Expand tabs.
 
-                // Write assembly line to the document.
-                appendPlainText(inst_text);
-
-                // Highlight it.
-                QTextCharFormat sourceLinesFormat = highlighterSettings().get("Assembly Text");
-
-                QTextBlock  block  = document()->findBlockByLineNumber(lineno-1);
-                QTextCursor cursor = textCursor();
-
-                cursor.setPosition(block.position());
-                setTextCursor(cursor);
-
-                QTextEdit::ExtraSelection selection;
-                selection.format.setForeground(sourceLinesFormat.foreground());
-                selection.format.setBackground(sourceLinesFormat.background());
-                selection.format.setProperty(QTextFormat::FullWidthSelection, true);
-                selection.cursor = textCursor();
-                selection.cursor.clearSelection();
-
-                _sourceLinesExtraSelections.append(selection);
-
-                // Add to maps
-                _addressLineMap.insert(address_text.toULongLong(0,0), lineno);
-                _offsetLineMap.insert(offset_num.toULongLong(0,0), lineno);
-                _lineAddressMap.insert(lineno, address_text);
-                _lineOffsetMap.insert(lineno,  offset_num.toULongLong(0,0));
-                _lineOpcodeMap.insert(lineno,  opcodes_text);
-
-                lineno++;
+                appendAssemblyLine(listing, lines, position, address_text, offset_num, opcodes_text, inst_text);
             }
         }
 
@@ -314,8 +261,6 @@ void SeerEditorWidgetAssemblyArea::updateTextArea () {
         //qDebug() << "asm_text mode.";
 
         // Loop through the asm list and print each line.
-        int lineno = 1;
-
         for ( const auto& asm_text : asm_list  ) {
 
             // Get the strings, with padding.
@@ -324,43 +269,129 @@ void SeerEditorWidgetAssemblyArea::updateTextArea () {
             QString opcodes_text = Seer::parseFirst(asm_text, "opcodes=", '"', '"', false);
             QString inst_text    = Seer::parseFirst(asm_text, "inst=",    '"', '"', false);
 
-            inst_text = Seer::expandTabs(inst_text, editorTabSize(), true); // Expand tabs.
+            inst_text = QString(" ") + Seer::expandTabs(inst_text, editorTabSize(), true); // Expand tabs.
 
-            // Write assembly line to the document.
-            appendPlainText(QString(" ") + inst_text);
+            appendAssemblyLine(listing, lines, position, address_text, offset_num, opcodes_text, inst_text);
+        }
 
-            // Highlight it.
-            QTextCharFormat sourceLinesFormat = highlighterSettings().get("Assembly Text");
+    }else{
+        qDebug() << "src_and_asm_text and asm_text are both empty.";
+    }
 
-            QTextBlock  block  = document()->findBlockByLineNumber(lineno-1);
-            QTextCursor cursor = textCursor();
+    // With source lines, gdb lists the instructions in source order. Sort the maps for lookups.
+    std::sort(listing.addressLines.begin(), listing.addressLines.end());
+    std::sort(listing.offsetLines.begin(),  listing.offsetLines.end());
 
-            cursor.setPosition(block.position());
-            setTextCursor(cursor);
+    listing.text = lines.join('\n');
 
-            QTextEdit::ExtraSelection selection;
-            selection.format.setForeground(sourceLinesFormat.foreground());
-            selection.format.setBackground(sourceLinesFormat.background());
-            selection.format.setProperty(QTextFormat::FullWidthSelection, true);
-            selection.cursor = textCursor();
-            selection.cursor.clearSelection();
+    // Remember it. Drop any older listing that covers the same addresses.
+    if (listing.addressLines.size() > 0) {
 
-            _sourceLinesExtraSelections.append(selection);
+        qulonglong low  = listing.addressLines.first().first;
+        qulonglong high = listing.addressLines.last().first;
 
-            // Add to maps
-            _addressLineMap.insert(address_text.toULongLong(0,0), lineno);
-            _offsetLineMap.insert(offset_num.toULongLong(0,0), lineno);
-            _lineAddressMap.insert(lineno, address_text);
-            _lineOffsetMap.insert(lineno,  offset_num.toULongLong(0,0));
-            _lineOpcodeMap.insert(lineno,  opcodes_text);
+        for (int i=_listingCache.size()-1; i>=0; i--) {
 
-            lineno++;
+            const SeerEditorWidgetAssemblyListing& cached = _listingCache[i];
+
+            if (cached.addressLines.first().first <= high && cached.addressLines.last().first >= low) {
+                _listingCache.removeAt(i);
+            }
         }
 
-    }else{
-        qDebug() << "src_and_asm_text and asm_text are both empty.";
+        _listingCache.prepend(listing);
+
+        while (_listingCache.size() > 16) {
+            _listingCache.removeLast();
+        }
     }
 
+    showListing(listing);
+
+    // Set the cursor back.
+    QApplication::restoreOverrideCursor();
+}
+
+void SeerEditorWidgetAssemblyArea::appendSourceLine (SeerEditorWidgetAssemblyListing& listing, QStringList& lines, int& position, const QString& fullname, const QString& file, int line) {
+
+    // Get source for 'line'
+    QString sourceLine = sourceForLine(fullname, file, line);
+
+    sourceLine = Seer::expandTabs(sourceLine, editorTabSize(), false); // Expand tabs.
+    sourceLine = sourceLine.simplified(); // Remove blank spaces at front and end of line.
+
+    // Write source line to the buffer. Highlight it later.
+    lines.append(sourceLine);
+    listing.sourceLinePositions.append(position);
+    position += sourceLine.length() + 1;
+
+    // Source lines have no address.
+    listing.lineAddresses.append("");
+    listing.lineOffsets.append(0);
+    listing.lineOpcodes.append("");
+}
+
+void SeerEditorWidgetAssemblyArea::appendAssemblyLine (SeerEditorWidgetAssemblyListing& listing, QStringList& lines, int& position, const QString& address, const QString& offset, const QString& opcodes, const QString& inst) {
+
+    // Write assembly line to the buffer. Highlight it later.
+    lines.append(inst);
+    listing.assemblyLinePositions.append(position);
+    position += inst.length() + 1;
+
+    // Add to maps
+    int        lineno = lines.size();
+    qulonglong offnum = offset.toULongLong(0,0);
+
+    listing.addressLines.append(qMakePair(address.toULongLong(0,0), lineno));
+    listing.offsetLines.append(qMakePair(offnum, lineno));
+    listing.lineAddresses.append(address);
+    listing.lineOffsets.append(offnum);
+    listing.lineOpcodes.append(opcodes);
+
+    listing.maxAddressLength = qMax(listing.maxAddressLength, address.length());
+    listing.maxOffset        = qMax(listing.maxOffset,        offnum);
+    listing.maxOpcodeLength  = qMax(listing.maxOpcodeLength,  opcodes.length());
+}
+
+void SeerEditorWidgetAssemblyArea::showListing (const SeerEditorWidgetAssemblyListing& listing) {
+
+    _listing = listing;
+
+    // Replace the document's text.
+    setPlainText(_listing.text);
+
+    // Highlight the source and assembly lines.
+    _sourceLinesExtraSelections.clear();
+
+    QTextCharFormat sourceLinesFormat = highlighterSettings().get("Text");
+
+    for (int linePosition : _listing.sourceLinePositions) {
+
+        QTextEdit::ExtraSelection selection;
+        selection.format.setForeground(sourceLinesFormat.foreground());
+        selection.format.setBackground(sourceLinesFormat.background());
+        selection.format.setProperty(QTextFormat::FullWidthSelection, true);
+        selection.cursor = QTextCursor(document());
+        selection.cursor.setPosition(linePosition);
+
+        _sourceLinesExtraSelections.append(selection);
+    }
+
+    for (int linePosition : _listing.assemblyLinePositions) {
+
+        QTextEdit::ExtraSelection selection;
+        selection.format.setForeground(_assemblyTextFormat.foreground());
+        selection.format.setBackground(_assemblyTextFormat.background());
+        selection.format.setProperty(QTextFormat::FullWidthSelection, true);
+        selection.cursor = QTextCursor(document());
+        selection.cursor.setPosition(linePosition);
+
+        _sourceLinesExtraSelections.append(selection);
+    }
+
+    // The margins depend on the new maps.
+    updateMarginAreasWidth(0);
+
     // Refresh all the extra selections.
     refreshExtraSelections();
 
@@ -369,9 +400,6 @@ void SeerEditorWidgetAssemblyArea::updateTextArea () {
 
     // Move to the line that has our address.
     setCurrentLine(_currentAddress);
-
-    // Set the cursor back.
-    QApplication::restoreOverrideCursor();
 }
 
 void SeerEditorWidgetAssemblyArea::updateMarginAreasWidth (int newBlockCount) {
@@ -390,17 +418,7 @@ int SeerEditorWidgetAssemblyArea::lineNumberAreaWidth () {
         return 0;
     }
 
-    int chars  = 1;
-
-    QMap<int,QString>::iterator b = _lineAddressMap.begin();
-    QMap<int,QString>::iterator e = _lineAddressMap.end();
-
-    while (b != e) {
-
-        chars = qMax(chars, b->length());
-
-        b++;
-    }
+    int chars  = qMax(1, _listing.maxAddressLength);
 
     int space = 3 + fontMetrics().horizontalAdvance(QLatin1Char('9')) * chars;
 
@@ -413,19 +431,7 @@ int SeerEditorWidgetAssemblyArea::offsetAreaWidth () {
         return 0;
     }
 
-    qulonglong offset  = 0;
-
-    QMap<int,qulonglong>::iterator b = _lineOffsetMap.begin();
-    QMap<int,qulonglong>::iterator e = _lineOffsetMap.end();
-
-    while (b != e) {
-
-        offset = qMax(offset, b.value());
-
-        b++;
-    }
-
-    QString tmp = QString("<+%1>").arg(offset);
+    QString tmp = QString("<+%1>").arg(_listing.maxOffset);
 
 
     int space = 3 + fontMetrics().horizontalAdvance(QLatin1Char('9')) * tmp.length();
@@ -450,17 +456,7 @@ int SeerEditorWidgetAssemblyArea::opcodeAreaWidth () {
         return 0;
     }
 
-    int chars  = 1;
-
-    QMap<int,QString>::iterator b = _lineOpcodeMap.begin();
-    QMap<int,QString>::iterator e = _lineOpcodeMap.end();
-
-    while (b != e) {
-
-        chars = qMax(chars, b->length());
-
-        b++;
-    }
+    int chars  = qMax(1, _listing.maxOpcodeLength);
 
     int space = 3 + fontMetrics().horizontalAdvance(QLatin1Char('9')) * chars;
 
@@ -552,14 +548,16 @@ void SeerEditorWidgetAssemblyArea::updateMiniMapArea (const QRect& rect, int dy)
         return;
     }
 
+    // The minimap itself doesn't scroll. Only its view box moves.
     if (dy) {
-        _miniMapArea->scroll(0, dy);
-    }else{
-        _miniMapArea->update(0, rect.y(), _miniMapArea->width(), rect.height());
+        _miniMapArea->update();
     }
 
+    // The scrollbar may have come or gone.
     if (rect.contains(viewport()->rect())) {
         updateMarginAreasWidth(0);
+        updateMiniMapAreaGeometry();
+        _miniMapArea->update();
     }
 }
 
@@ -569,33 +567,32 @@ void SeerEditorWidgetAssemblyArea::lineNumberAreaPaintEvent (QPaintEvent* event)
         return;
     }
 
-    QTextCharFormat format = highlighterSettings().get("Margin");
+    countMarginFrame();
 
     QPainter painter(_lineNumberArea);
-    painter.fillRect(event->rect(), format.background().color());
-    painter.setPen(format.foreground().color());
+    painter.fillRect(event->rect(), _marginFormat.background().color());
+    painter.setPen(_marginFormat.foreground().color());
 
     QFont font = painter.font();
-    font.setItalic(format.fontItalic());
-    font.setWeight(QFont::Weight(format.fontWeight()));
+    font.setItalic(_marginFormat.fontItalic());
+    font.setWeight(QFont::Weight(_marginFormat.fontWeight()));
     painter.setFont(font);
 
+    // Walk the visible blocks. Only the first block's geometry is computed.
+    // The rest are found by adding each block's height.
     QTextBlock block       = firstVisibleBlock();
     int        blockNumber = block.blockNumber();
     int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
     int        bottom      = top + qRound(blockBoundingRect(block).height());
+    int        lineHeight  = fontMetrics().height();
+    int        areaWidth   = _lineNumberArea->width();
+    int        rectTop     = event->rect().top();
+    int        rectBottom  = event->rect().bottom();
 
-    while (block.isValid() && top <= event->rect().bottom()) {
-
-        if (block.isVisible() && bottom >= event->rect().top()) {
-
-            QString address;
-
-            if (_lineAddressMap.contains(blockNumber+1)) {
-                address = _lineAddressMap[blockNumber+1];
-            }
+    while (block.isValid() && top <= rectBottom) {
 
-            painter.drawText(0, top, _lineNumberArea->width(), fontMetrics().height(), Qt::AlignLeft, address);
+        if (block.isVisible() && bottom >= rectTop) {
+            painter.drawText(0, top, areaWidth, lineHeight, Qt::AlignLeft, _listing.lineAddresses.value(blockNumber));
         }
 
         block  = block.next();
@@ -612,33 +609,31 @@ void SeerEditorWidgetAssemblyArea::offsetAreaPaintEvent (QPaintEvent* event) {
         return;
     }
 
-    QTextCharFormat format = highlighterSettings().get("Margin");
-
     QPainter painter(_offsetArea);
-    painter.fillRect(event->rect(), format.background().color());
-    painter.setPen(format.foreground().color());
+    painter.fillRect(event->rect(), _marginFormat.background().color());
+    painter.setPen(_marginFormat.foreground().color());
 
     QFont font = painter.font();
-    font.setItalic(format.fontItalic());
-    font.setWeight(QFont::Weight(format.fontWeight()));
+    font.setItalic(_marginFormat.fontItalic());
+    font.setWeight(QFont::Weight(_marginFormat.fontWeight()));
     painter.setFont(font);
 
     QTextBlock block       = firstVisibleBlock();
     int        blockNumber = block.blockNumber();
     int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
     int        bottom      = top + qRound(blockBoundingRect(block).height());
+    int        lineHeight  = fontMetrics().height();
+    int        areaWidth   = _offsetArea->width();
+    int        rectTop     = event->rect().top();
+    int        rectBottom  = event->rect().bottom();
 
-    while (block.isValid() && top <= event->rect().bottom()) {
-
-        if (block.isVisible() && bottom >= event->rect().top()) {
+    while (block.isValid() && top <= rectBottom) {
 
-            QString offset;
+        if (block.isVisible() && bottom >= rectTop) {
 
-            if (_lineOffsetMap.contains(blockNumber+1)) {
-                offset = QString("<+%1>").arg(_lineOffsetMap[blockNumber+1]);
+            if (blockNumber < _listing.lineAddresses.size() && _listing.lineAddresses[blockNumber] != "") {
+                painter.drawText(0, top, areaWidth, lineHeight, Qt::AlignRight, QString("<+%1>").arg(_listing.lineOffsets[blockNumber]));
             }
-
-            painter.drawText(0, top, _offsetArea->width(), fontMetrics().height(), Qt::AlignRight, offset);
         }
 
         block  = block.next();
@@ -655,56 +650,33 @@ void SeerEditorWidgetAssemblyArea::breakPointAreaPaintEvent (QPaintEvent* event)
         return;
     }
 
-    QTextCharFormat format = highlighterSettings().get("Margin");
-
     QPainter painter(_breakPointArea);
-    painter.fillRect(event->rect(), format.background().color());
-    painter.setPen(format.foreground().color());
+    painter.fillRect(event->rect(), _marginFormat.background().color());
 
-    QFont font = painter.font();
-    font.setItalic(format.fontItalic());
-    font.setWeight(QFont::Weight(format.fontWeight()));
-    painter.setFont(font);
+    // Nothing more to draw if there are no breakpoints.
+    if (_breakpointsAddresses.size() == 0) {
+        return;
+    }
 
     QTextBlock block       = firstVisibleBlock();
     int        blockNumber = block.blockNumber();
     int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
     int        bottom      = top + qRound(blockBoundingRect(block).height());
+    int        lineHeight  = fontMetrics().height();
+    int        markerLeft  = _breakPointArea->width() - 20;
+    int        rectTop     = event->rect().top();
+    int        rectBottom  = event->rect().bottom();
 
-    while (block.isValid() && top <= event->rect().bottom()) {
-
-        if (block.isVisible() && bottom >= event->rect().top()) {
-
-            QString address = _lineAddressMap[blockNumber+1];
-
-            if (address != "" && hasBreakpointAddress(address) == true) {
-                if (breakpointAddressEnabled(address)) {
-                    QRect rect(_breakPointArea->width() - 20, top, fontMetrics().height(), fontMetrics().height());
-
-                    QPainterPath path;
-                    path.addEllipse(rect);
-
-                    QPointF bias = QPointF(rect.width() * .25 * 1.0, rect.height() * .25 * -1.0);
+    while (block.isValid() && top <= rectBottom) {
 
-                    QRadialGradient gradient(rect.center(), rect.width() / 2.0, rect.center() + bias);
-                    gradient.setColorAt(0.0, QColor(Qt::white));
-                    gradient.setColorAt(0.9, QColor(Qt::red));
-                    gradient.setColorAt(1.0, QColor(Qt::transparent));
-                    painter.fillPath(path,QBrush(gradient));
+        if (block.isVisible() && bottom >= rectTop) {
 
-                }else{
-                    QRect rect(_breakPointArea->width() - 20, top, fontMetrics().height(), fontMetrics().height());
+            if (blockNumber < _listing.lineAddresses.size() && _listing.lineAddresses[blockNumber] != "") {
 
-                    QPainterPath path;
-                    path.addEllipse(rect);
+                int i = _breakpointsAddresses.indexOf(_listing.lineAddresses[blockNumber]);
 
-                    QPointF bias = QPointF(rect.width() * .25 * 1.0, rect.height() * .25 * -1.0);
-
-                    QRadialGradient gradient(rect.center(), rect.width() / 2.0, rect.center() + bias);
-                    gradient.setColorAt(0.0, QColor(Qt::white));
-                    gradient.setColorAt(0.9, QColor(Qt::darkGray));
-                    gradient.setColorAt(1.0, Qt::transparent);
-                    painter.fillPath(path,QBrush(gradient));
+                if (i >= 0) {
+                    painter.drawPixmap(markerLeft, top, breakpointMarker(_breakpointsEnableds[i], lineHeight));
                 }
             }
         }
@@ -723,33 +695,28 @@ void SeerEditorWidgetAssemblyArea::opcodeAreaPaintEvent (QPaintEvent* event) {
         return;
     }
 
-    QTextCharFormat format = highlighterSettings().get("Assembly Text");
-
     QPainter painter(_opcodeArea);
-    painter.fillRect(event->rect(), format.background().color());
-    painter.setPen(format.foreground().color());
+    painter.fillRect(event->rect(), _assemblyTextFormat.background().color());
+    painter.setPen(_assemblyTextFormat.foreground().color());
 
     QFont font = painter.font();
-    font.setItalic(format.fontItalic());
-    font.setWeight(QFont::Weight(format.fontWeight()));
+    font.setItalic(_assemblyTextFormat.fontItalic());
+    font.setWeight(QFont::Weight(_assemblyTextFormat.fontWeight()));
     painter.setFont(font);
 
     QTextBlock block       = firstVisibleBlock();
     int        blockNumber = block.blockNumber();
     int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
     int        bottom      = top + qRound(blockBoundingRect(block).height());
+    int        lineHeight  = fontMetrics().height();
+    int        areaWidth   = _opcodeArea->width();
+    int        rectTop     = event->rect().top();
+    int        rectBottom  = event->rect().bottom();
 
-    while (block.isValid() && top <= event->rect().bottom()) {
-
-        if (block.isVisible() && bottom >= event->rect().top()) {
-
-            QString opcode;
+    while (block.isValid() && top <= rectBottom) {
 
-            if (_lineOpcodeMap.contains(blockNumber+1)) {
-                opcode = _lineOpcodeMap[blockNumber+1];
-            }
-
-            painter.drawText(0, top, _opcodeArea->width(), fontMetrics().height(), Qt::AlignLeft, opcode);
+        if (block.isVisible() && bottom >= rectTop) {
+            painter.drawText(0, top, areaWidth, lineHeight, Qt::AlignLeft, _listing.lineOpcodes.value(blockNumber));
         }
 
         block  = block.next();
@@ -762,111 +729,51 @@ void SeerEditorWidgetAssemblyArea::opcodeAreaPaintEvent (QPaintEvent* event) {
 
 void SeerEditorWidgetAssemblyArea::miniMapAreaPaintEvent (QPaintEvent* event) {
 
-    //
-    // This doesn't work yet.
-    // There is nothing 'mini' about the view. Need to shrink the text somehow.
-    // Then add a 'focus' box that can be interacted with to scroll through the text.
-    //
+    Q_UNUSED(event);
 
     if (miniMapAreaEnabled() == false) {
         return;
     }
 
-    qDebug() << "Top:" << event->rect().top() << " Right:" << event->rect().right() << " Width:" << event->rect().width() << " Height:" << event->rect().height();
-
-    if (_miniMapPixmap == 0) {
-
-        int pixmapWidth  = 0;
-        int pixmapHeight = 0;
-
-        QFont font("monospace");
-        font.setStyleHint(QFont::Monospace);
-      //font.setPointSize(2);
+    // Gather the lines to mark on top of the minimap rendering.
+    QVector<int> enabledBreakpointLines;
+    QVector<int> disabledBreakpointLines;
+    QVector<int> currentLines;
 
-        QFontMetrics fm(font);
+    for (int i=0; i<_breakpointsAddresses.size(); i++) {
 
-        {
-            QTextBlock block = document()->begin();
-
-            while (block.isValid()) {
-
-                if (fm.horizontalAdvance(block.text()) > pixmapWidth) {
-                    pixmapWidth = fm.horizontalAdvance(block.text());
-                }
+        int lineno = lineForAddress(_breakpointsAddresses[i].toULongLong(0,0));
 
-                pixmapHeight += fm.height();
-
-                block = block.next();
-            }
+        if (lineno < 1) {
+            continue;
         }
 
-        qDebug() << "PIXMAP = " << pixmapWidth << " x " << pixmapHeight;
-
-        QTextCharFormat format = highlighterSettings().get("Margin");
-
-        _miniMapPixmap = new QPixmap(pixmapWidth, pixmapHeight);
-        _miniMapPixmap->fill(format.background().color());
-
-        QPainter painter(_miniMapPixmap);
-        painter.setPen(format.foreground().color());
-        painter.setFont(font);
-
-        QTextBlock block       = document()->begin();
-        int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
-        int        bottom      = top + qRound(blockBoundingRect(block).height());
-
-        while (block.isValid()) {
-
-            painter.drawText(0, top, block.text());
-
-            block = block.next();
-            top    = bottom;
-            bottom = top + qRound(blockBoundingRect(block).height());
+        if (_breakpointsEnableds[i]) {
+            enabledBreakpointLines.append(lineno);
+        }else{
+            disabledBreakpointLines.append(lineno);
         }
     }
 
-
-    /*
-    QRectF target(10.0, 20.0, 80.0, 60.0);
-    QRectF source(0.0, 0.0, 70.0, 40.0);
-
-    QRect target(event->rect());
-    QRect source(event->rect());
-
-    QPainter painter(_miniMapPixmap);
-    painter.drawPixmap(0, 0, *_miniMapPixmap);
-    //painter.drawPixmap(target, *_miniMapPixmap, source);
+    for (const auto& selection : _currentLinesExtraSelections) {
+        currentLines.append(selection.cursor.blockNumber()+1);
+    }
 
     QPainter painter(_miniMapArea);
-    painter.drawPixmap(0, 0, *_miniMapPixmap);
-    */
-
-    QFont font("monospace");
-    font.setStyleHint(QFont::Monospace);
-  //font.setPointSize(2);
 
-    QTextCharFormat format = highlighterSettings().get("Margin");
-
-    QPainter painter(_miniMapArea);
-    painter.fillRect(event->rect(), format.background().color());
-    painter.setPen(format.foreground().color());
-    painter.setFont(font);
+    paintMiniMap(painter, _miniMapArea->rect(), enabledBreakpointLines, disabledBreakpointLines, currentLines);
+}
 
-    QTextBlock block       = firstVisibleBlock();
-    int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
-    int        bottom      = top + qRound(blockBoundingRect(block).height());
+void SeerEditorWidgetAssemblyArea::updateMiniMapAreaGeometry () {
 
-    while (block.isValid() && top <= event->rect().bottom()) {
+    if (miniMapAreaEnabled() == false) {
+        return;
+    }
 
-        if (block.isVisible() && bottom >= event->rect().top()) {
-            painter.drawText(0, top, _miniMapArea->width(), painter.fontMetrics().height(), Qt::AlignLeft, block.text());
-        }
+    QRect cr             = contentsRect();
+    int   scrollBarWidth = verticalScrollBar()->isVisible() ? verticalScrollBar()->width() : 0;
 
-        block  = block.next();
-        top    = bottom;
-        bottom = top + qRound(blockBoundingRect(block).height());
-      //bottom = top + painter.fontMetrics().height();
-    }
+    _miniMapArea->setGeometry (QRect(cr.right() - miniMapAreaWidth() - scrollBarWidth, cr.top(), miniMapAreaWidth(), cr.height()));
 }
 
 void SeerEditorWidgetAssemblyArea::resizeEvent (QResizeEvent* e) {
@@ -900,9 +807,7 @@ void SeerEditorWidgetAssemblyArea::resizeEvent (QResizeEvent* e) {
         leftbias += opcodeAreaWidth();
     }
 
-    if (miniMapAreaEnabled()) {
-        _miniMapArea->setGeometry (QRect(cr.right() - miniMapAreaWidth() - verticalScrollBar()->width(), cr.top(), miniMapAreaWidth(), cr.height()));
-    }
+    updateMiniMapAreaGeometry();
 }
 
 void SeerEditorWidgetAssemblyArea::contextMenuEvent (QContextMenuEvent* event) {
@@ -929,23 +834,422 @@ void SeerEditorWidgetAssemblyArea::refreshExtraSelections () {
     extraSelections.append(_currentLinesExtraSelections);
 
     // Append the 'searched text' extra selections.
-    extraSelections.append(_findExtraSelections);
+    extraSelections.append(findExtraSelections());
 
     // Give the editor the list of selections.
     // This will remove the old selections and select the new ones.
     setExtraSelections(extraSelections);
+
+    // The minimap shows them too.
+    if (miniMapAreaEnabled()) {
+        _miniMapArea->update();
+    }
 }
 
 void SeerEditorWidgetAssemblyArea::setAddress (const QString& address, bool force) {
 
-    // Emit the signal to load the assembly for address 'address' if
-    // it's not already loaded.
-    if (_addressLineMap.contains(address.toULongLong(0,0)) == false || force == true) {
+    qulonglong addr = address.toULongLong(0,0);
+
+    // A forced reload means the listings may be stale (new mode, refresh button, etc.).
+    if (force == true) {
+        clearAssemblyCache();
+    }
+
+    // Already showing it.
+    if (force == false && lineForAddress(addr) > 0) {
+        return;
+    }
+
+    // Hack to keep track of address when the assembly hasn't been loaded yet.
+    _currentAddress = address;
+
+    // Forget any request for more of the old window.
+    _windowId = 0;
+
+    // Recently shown? Show it again without asking gdb. Windowed listings aren't cached.
+    for (int i=0; i<_listingCache.size(); i++) {
+
+        const SeerEditorWidgetAssemblyListing& cached = _listingCache[i];
+
+        if (addr < cached.addressLines.first().first || addr > cached.addressLines.last().first) {
+            continue;
+        }
+
+        _listingCache.move(i, 0);
+
+        showListing(_listingCache.first());
+
+        return;
+    }
+
+    // Emit the signal to load the assembly for address 'address'.
+    emit requestSourceAndAssembly(address);
+}
+
+void SeerEditorWidgetAssemblyArea::clearAssemblyCache () {
+
+    _listingCache.clear();
+}
+
+void SeerEditorWidgetAssemblyArea::setDisassemblyWindow (int bytes) {
+
+    if (bytes < 0) {
+        bytes = 0;
+    }
+
+    _disassemblyWindow = bytes;
+
+    // Start over with the next listing.
+    _windowId = 0;
+    _windowInstructions.clear();
+
+    clearAssemblyCache();
+}
+
+int SeerEditorWidgetAssemblyArea::disassemblyWindow () const {
+
+    return _disassemblyWindow;
+}
+
+QMap<qulonglong,SeerEditorWidgetAssemblyInstruction> SeerEditorWidgetAssemblyArea::parseWindowInstructions (const QString& text) const {
+
+    // Same format as updateTextArea(). Key the instructions by address.
+    QMap<qulonglong,SeerEditorWidgetAssemblyInstruction> instructions;
+
+    QString asm_insns_text = Seer::parseFirst(text, "asm_insns=", '[', ']', false);
+
+    QStringList src_and_asm_list = Seer::parse(asm_insns_text, "src_and_asm_line=", '{', '}', false);
+
+    // No debug info gives a plain list of instructions. Treat it as one group without a source line.
+    if (src_and_asm_list.size() == 0) {
+        src_and_asm_list.append(QString("line_asm_insn=[") + asm_insns_text + "]");
+    }
+
+    for ( const auto& src_and_asm_text : src_and_asm_list ) {
+
+        QString line_text     = Seer::parseFirst(src_and_asm_text, "line=",     '"', '"', false);
+        QString file_text     = Seer::parseFirst(src_and_asm_text, "file=",     '"', '"', false);
+        QString fullname_text = Seer::parseFirst(src_and_asm_text, "fullname=", '"', '"', false);
+
+        QString line_asm_insn_text = Seer::parseFirst(src_and_asm_text, "line_asm_insn=", '[', ']', false);
+
+        QStringList asm_list = Seer::parse(line_asm_insn_text, "", '{', '}', false);
+
+        for ( const auto& asm_text : asm_list  ) {
+
+            SeerEditorWidgetAssemblyInstruction instruction;
+
+            instruction.address  = Seer::parseFirst(asm_text, "address=",   '"', '"', false);
+            instruction.funcName = Seer::parseFirst(asm_text, "func-name=", '"', '"', false);
+            instruction.offset   = Seer::parseFirst(asm_text, "offset=",    '"', '"', false);
+            instruction.opcodes  = Seer::parseFirst(asm_text, "opcodes=",   '"', '"', false);
+            instruction.inst     = Seer::parseFirst(asm_text, "inst=",      '"', '"', false);
+            instruction.file     = file_text;
+            instruction.fullname = fullname_text;
+            instruction.line     = line_text.toInt();
+
+            instructions.insert(instruction.address.toULongLong(0,0), instruction);
+        }
+    }
+
+    return instructions;
+}
+
+int SeerEditorWidgetAssemblyArea::mergeWindowInstructions (const QMap<qulonglong,SeerEditorWidgetAssemblyInstruction>& instructions, bool& foreign) {
+
+    // Add the instructions of our function that we don't have yet.
+    // Note if gdb went past the function into another one.
+    int added = 0;
+
+    foreign = false;
 
-        // Hack to keep track of address when the assembly hasn't been loaded yet.
-        _currentAddress = address;
+    QMap<qulonglong,SeerEditorWidgetAssemblyInstruction>::const_iterator b = instructions.begin();
+    QMap<qulonglong,SeerEditorWidgetAssemblyInstruction>::const_iterator e = instructions.end();
 
-        emit requestSourceAndAssembly(address);
+    for (; b != e; ++b) {
+
+        if (b.value().funcName != _windowFunction) {
+            foreign = true;
+            continue;
+        }
+
+        if (_windowInstructions.contains(b.key())) {
+            continue;
+        }
+
+        _windowInstructions.insert(b.key(), b.value());
+
+        added++;
+    }
+
+    return added;
+}
+
+void SeerEditorWidgetAssemblyArea::startWindow () {
+
+    //
+    // The first window starts at the $PC. See SeerGdbWidget::handleGdbGetSourceAndAssembly().
+    // Take the function of the first instruction as the function being shown.
+    //
+    QMap<qulonglong,SeerEditorWidgetAssemblyInstruction> instructions = parseWindowInstructions(_asm_insns_text);
+
+    _windowId       = 0;
+    _windowRequest  = WindowNone;
+    _windowFunction = (instructions.size() > 0 ? instructions.first().funcName : QString());
+    _windowAtStart  = false;
+    _windowAtEnd    = false;
+
+    _windowInstructions.clear();
+
+    bool foreign = false;
+
+    mergeWindowInstructions(instructions, foreign);
+
+    _windowAtEnd = foreign;
+
+    showWindow(false);
+
+    // Fill the view. This also adds the instructions before the $PC.
+    handleWindowScroll(verticalScrollBar()->value());
+}
+
+void SeerEditorWidgetAssemblyArea::showWindow (bool keepView) {
+
+    _windowUpdating = true;
+
+    // Remember the address at the top of the view, so it stays there.
+    QString topAddress;
+    int     topDelta = 0;
+
+    if (keepView) {
+
+        int topLine = firstVisibleBlock().blockNumber() + 1;
+
+        for (int lineno=topLine; lineno<=document()->blockCount(); lineno++) {
+
+            topAddress = addressForLine(lineno);
+
+            if (topAddress != "") {
+                topDelta = lineno - topLine;
+                break;
+            }
+        }
+    }
+
+    //
+    // Build the listing in address order. Show a source line whenever the
+    // source line changes from one instruction to the next.
+    //
+    SeerEditorWidgetAssemblyListing listing;
+
+    QStringList lines;
+    int         position     = 0;
+    QString     lastFullname;
+    int         lastLine     = 0;
+
+    for (const SeerEditorWidgetAssemblyInstruction& instruction : _windowInstructions) {
+
+        if (instruction.line > 0 && (instruction.line != lastLine || instruction.fullname != lastFullname)) {
+
+            if (sourceLinesEnabled() == true) {
+                appendSourceLine(listing, lines, position, instruction.fullname, instruction.file, instruction.line);
+            }
+
+            lastFullname = instruction.fullname;
+            lastLine     = instruction.line;
+        }
+
+        QString inst_text = Seer::expandTabs(instruction.inst, editorTabSize(), true); // Expand tabs.
+
+        if (instruction.line == 0) {
+            inst_text = QString(" ") + inst_text;
+        }
+
+        appendAssemblyLine(listing, lines, position, instruction.address, instruction.offset, instruction.opcodes, inst_text);
+    }
+
+    std::sort(listing.offsetLines.begin(), listing.offsetLines.end());
+
+    listing.text = lines.join('\n');
+
+    showListing(listing);
+
+    if (topAddress != "") {
+
+        int lineno = lineForAddress(topAddress.toULongLong(0,0));
+
+        if (lineno > 0) {
+            verticalScrollBar()->setValue(lineno - 1 - topDelta);
+        }
+    }
+
+    _windowUpdating = false;
+}
+
+void SeerEditorWidgetAssemblyArea::extendWindowForward () {
+
+    if (_disassemblyWindow <= 0 || _windowId != 0 || _windowAtEnd == true || _windowInstructions.size() == 0) {
+        return;
+    }
+
+    // Start at the last instruction we have. It's a known instruction boundary.
+    qulonglong lastAddress = _windowInstructions.lastKey();
+
+    _windowId      = Seer::createID();
+    _windowRequest = WindowForward;
+
+    emit requestSourceAndAssemblyRange(_windowId, QString("0x%1").arg(lastAddress, 0, 16), _disassemblyWindow);
+}
+
+void SeerEditorWidgetAssemblyArea::extendWindowBackward () {
+
+    if (_disassemblyWindow <= 0 || _windowId != 0 || _windowAtStart == true || _windowInstructions.size() == 0) {
+        return;
+    }
+
+    //
+    // Going backwards, gdb has to start on an instruction boundary or it decodes garbage.
+    // The function's start is one, from the symbol's offset. So is every address in the
+    // line table. Use the line table entry that is about one window back.
+    //
+    // Never ask for more than one window. Without a boundary that close, stop going back.
+    //
+    qulonglong                                 firstAddress = _windowInstructions.firstKey();
+    const SeerEditorWidgetAssemblyInstruction& first        = _windowInstructions.first();
+    qulonglong                                 offset       = first.offset.toULongLong(0,0);
+
+    // At the start of the function. Or no symbol to go by.
+    if (offset == 0 || offset > firstAddress) {
+        _windowAtStart = true;
+        return;
+    }
+
+    qulonglong functionStart = firstAddress - offset;
+    qulonglong startAddress  = functionStart;
+
+    if (offset > qulonglong(_disassemblyWindow) && first.fullname != "") {
+
+        // Get the line table for the file first.
+        if (first.fullname != _windowLinesFullname) {
+
+            _windowLinesFullname = first.fullname;
+            _windowLineAddresses.clear();
+
+            _windowId      = Seer::createID();
+            _windowRequest = WindowLines;
+
+            emit requestSourceLines(_windowId, _windowLinesFullname);
+
+            return;
+        }
+
+        qulonglong low = firstAddress - _disassemblyWindow;
+
+        QVector<qulonglong>::const_iterator i = std::lower_bound(_windowLineAddresses.cbegin(), _windowLineAddresses.cend(), low);
+
+        if (i != _windowLineAddresses.cend() && *i < firstAddress) {
+            startAddress = *i;
+        }else if (i != _windowLineAddresses.cbegin() && *(i-1) > functionStart) {
+            startAddress = *(i-1);
+        }
+    }
+
+    // No debug info, or a line that's bigger than a window. The only boundary is too far back.
+    if (firstAddress - startAddress > qulonglong(_disassemblyWindow)) {
+        _windowAtStart = true;
+        return;
+    }
+
+    _windowId      = Seer::createID();
+    _windowRequest = WindowBackward;
+
+    emit requestSourceAndAssemblyRange(_windowId, QString("0x%1").arg(startAddress, 0, 16), int(firstAddress - startAddress));
+}
+
+void SeerEditorWidgetAssemblyArea::handleWindowText (const QString& text) {
+
+    WindowRequest request = _windowRequest;
+
+    _windowId      = 0;
+    _windowRequest = WindowNone;
+
+    if (request == WindowLines) {
+
+        // 15^done,lines=[{pc="0x0000000000401136",line="5"},{pc="0x000000000040113e",line="6"},...]
+        if (text.contains("^done,lines=")) {
+
+            QString     lines_text = Seer::parseFirst(text, "lines=", '[', ']', false);
+            QStringList lines_list = Seer::parse(lines_text, "", '{', '}', false);
+
+            for ( const auto& line_text : lines_list ) {
+
+                qulonglong pc = Seer::parseFirst(line_text, "pc=", '"', '"', false).toULongLong(0,0);
+
+                if (pc != 0) {
+                    _windowLineAddresses.append(pc);
+                }
+            }
+
+            std::sort(_windowLineAddresses.begin(), _windowLineAddresses.end());
+
+            _windowLineAddresses.erase(std::unique(_windowLineAddresses.begin(), _windowLineAddresses.end()), _windowLineAddresses.end());
+        }
+
+        // Go on. Without a line table, it starts at the function's start.
+        extendWindowBackward();
+
+        return;
+    }
+
+    // gdb couldn't do it. Don't keep asking.
+    if (text.contains("^done,asm_insns=") == false) {
+
+        if (request == WindowBackward) {
+            _windowAtStart = true;
+        }else{
+            _windowAtEnd = true;
+        }
+
+        return;
+    }
+
+    bool foreign = false;
+    int  added   = mergeWindowInstructions(parseWindowInstructions(text), foreign);
+
+    if (request == WindowBackward) {
+        if (added == 0 || _windowInstructions.first().offset.toULongLong(0,0) == 0) {
+            _windowAtStart = true;
+        }
+    }else{
+        if (added == 0 || foreign == true) {
+            _windowAtEnd = true;
+        }
+    }
+
+    if (added == 0) {
+        return;
+    }
+
+    showWindow(true);
+
+    // Keep going if the view still isn't full.
+    handleWindowScroll(verticalScrollBar()->value());
+}
+
+void SeerEditorWidgetAssemblyArea::handleWindowScroll (int value) {
+
+    if (_disassemblyWindow <= 0 || _windowUpdating == true || _windowId != 0) {
+        return;
+    }
+
+    // Load more when getting close to either end.
+    const int   margin    = 4;
+    QScrollBar* scrollBar = verticalScrollBar();
+
+    if (value - scrollBar->minimum() <= margin && _windowAtStart == false) {
+        extendWindowBackward();
+    }else if (scrollBar->maximum() - value <= margin) {
+        extendWindowForward();
     }
 }
 
@@ -971,9 +1275,9 @@ bool SeerEditorWidgetAssemblyArea::setCurrentLine (const QString& address) {
         qulonglong addr = address.toULongLong(&ok, 0); // Try it as an '0x.....'.
 
         if (ok) {
-            if (_addressLineMap.contains(addr)) {
-                lineno = _addressLineMap[addr];
-            }else{
+            lineno = lineForAddress(addr);
+
+            if (lineno < 1) {
                 ok = false;
             }
         }
@@ -985,9 +1289,9 @@ bool SeerEditorWidgetAssemblyArea::setCurrentLine (const QString& address) {
         qulonglong offset = address.toULongLong(&ok, 0); // Try it as an '+.....'.
 
         if (ok) {
-            if (_offsetLineMap.contains(offset)) {
-                lineno = _offsetLineMap[offset];
-            }else{
+            lineno = lineForOffset(offset);
+
+            if (lineno < 1) {
                 ok = false;
             }
         }
@@ -1048,8 +1352,8 @@ void SeerEditorWidgetAssemblyArea::scrollToLine (const QString& address) {
     //
     // Test for which one and convert it to a linenumber using the maps:
     //
-    //      _addressLineMap
-    //      _offsetLineMap
+    //      _listing.addressLines
+    //      _listing.offsetLines
     //
     //      Or just go to the line#
     //
@@ -1064,9 +1368,9 @@ void SeerEditorWidgetAssemblyArea::scrollToLine (const QString& address) {
         qulonglong addr = address.toULongLong(&ok, 0); // Try it as an '0x.....'.
 
         if (ok) {
-            if (_addressLineMap.contains(addr)) {
-                lineno = _addressLineMap[addr];
-            }else{
+            lineno = lineForAddress(addr);
+
+            if (lineno < 1) {
                 ok = false;
             }
         }
@@ -1078,9 +1382,9 @@ void SeerEditorWidgetAssemblyArea::scrollToLine (const QString& address) {
         qulonglong offset = address.toULongLong(&ok, 0); // Try it as an '+.....'.
 
         if (ok) {
-            if (_offsetLineMap.contains(offset)) {
-                lineno = _offsetLineMap[offset];
-            }else{
+            lineno = lineForOffset(offset);
+
+            if (lineno < 1) {
                 ok = false;
             }
         }
@@ -1118,52 +1422,13 @@ void SeerEditorWidgetAssemblyArea::scrollToLine (const QString& address) {
     centerCursor();
 }
 
-int SeerEditorWidgetAssemblyArea::findText (const QString& text, QTextDocument::FindFlags flags) {
-
-    _findExtraSelections.clear();
-
-    if (document()) {
-
-        QTextCharFormat matchFormat = highlighterSettings().get("Match");
-
-        // Build a list of highlights for all matches.
-        QTextCursor cursor(document());
-        cursor = document()->find(text, cursor, flags);
-
-        while (cursor.isNull() == false) {
-
-            QTextEdit::ExtraSelection extra;
-            extra.format = matchFormat;
-            extra.cursor = cursor;
-
-            _findExtraSelections.append(extra);
-
-            cursor = document()->find(text, cursor, flags);
-        }
-
-        // Move to the next match after out current position.
-        find(text, flags);
-    }
-
-    refreshExtraSelections();
-
-    return _findExtraSelections.size();
-}
-
-void SeerEditorWidgetAssemblyArea::clearFindText () {
-
-    _findExtraSelections.clear();
-
-    refreshExtraSelections();
-}
-
 void SeerEditorWidgetAssemblyArea::clearBreakpoints () {
 
     _breakpointsNumbers.clear();
     _breakpointsAddresses.clear();
     _breakpointsEnableds.clear();
 
-    repaint();
+    update();
 }
 
 void SeerEditorWidgetAssemblyArea::addBreakpoint (int number, const QString& address, bool enabled) {
@@ -1172,7 +1437,8 @@ void SeerEditorWidgetAssemblyArea::addBreakpoint (int number, const QString& add
     _breakpointsAddresses.push_back(address);
     _breakpointsEnableds.push_back(enabled);
 
-    repaint();
+    // Schedule a repaint. Adding a list of breakpoints results in just one.
+    update();
 }
 
 bool SeerEditorWidgetAssemblyArea::hasBreakpointNumber (int number) const {
@@ -1242,7 +1508,7 @@ void SeerEditorWidgetAssemblyArea::showContextMenu (const QPoint& pos, const QPo
 
     int lineno = cursor.blockNumber()+1;
 
-    QString address = _lineAddressMap[lineno];
+    QString address = addressForLine(lineno);
 
     // Create the menu actions.
     QAction* createBreakpointAction;
@@ -1423,7 +1689,7 @@ void SeerEditorWidgetAssemblyArea::setQuickBreakpoint (QMouseEvent* event) {
 
     int lineno = cursor.blockNumber()+1;
 
-    QString address = _lineAddressMap[lineno];
+    QString address = addressForLine(lineno);
 
     // If there is a breakpoint on the line, toggle it.
     if (hasBreakpointAddress(address)) {
@@ -1451,7 +1717,7 @@ void SeerEditorWidgetAssemblyArea::setQuickRunToAddress (QMouseEvent* event) {
 
     int lineno = cursor.blockNumber()+1;
 
-    QString address = _lineAddressMap[lineno];
+    QString address = addressForLine(lineno);
 
     //qDebug() << "runToAddress" << address;
 
@@ -1487,6 +1753,50 @@ bool SeerEditorWidgetAssemblyArea::highlighterEnabled () const {
     return _sourceHighlighterEnabled;
 }
 
+int SeerEditorWidgetAssemblyArea::lineForAddress (qulonglong address) const {
+
+    // Binary search the sorted (address,lineno) pairs. Returns 0 if not found.
+    // If more than one line has the address, the last one wins.
+    QVector<QPair<qulonglong,int>>::const_iterator it = std::upper_bound(_listing.addressLines.constBegin(), _listing.addressLines.constEnd(), address, [](qulonglong a, const QPair<qulonglong,int>& pair) { return a < pair.first; });
+
+    if (it == _listing.addressLines.constBegin()) {
+        return 0;
+    }
+
+    --it;
+
+    if (it->first != address) {
+        return 0;
+    }
+
+    return it->second;
+}
+
+int SeerEditorWidgetAssemblyArea::lineForOffset (qulonglong offset) const {
+
+    // Binary search the sorted (offset,lineno) pairs. Returns 0 if not found.
+    // If more than one line has the offset, the last one wins.
+    QVector<QPair<qulonglong,int>>::const_iterator it = std::upper_bound(_listing.offsetLines.constBegin(), _listing.offsetLines.constEnd(), offset, [](qulonglong a, const QPair<qulonglong,int>& pair) { return a < pair.first; });
+
+    if (it == _listing.offsetLines.constBegin()) {
+        return 0;
+    }
+
+    --it;
+
+    if (it->first != offset) {
+        return 0;
+    }
+
+    return it->second;
+}
+
+QString SeerEditorWidgetAssemblyArea::addressForLine (int lineno) const {
+
+    // 'lineno' is 1 based. Returns "" for source lines or out of range.
+    return _listing.lineAddresses.value(lineno-1);
+}
+
 QString SeerEditorWidgetAssemblyArea::sourceForLine (const QString& fullname, const QString& file, int line) {
 
     // A new file?  Zap the previously cached file.
@@ -1623,11 +1933,24 @@ void SeerEditorWidgetAssemblyArea::handleText (const QString& text) {
             }
         }
 
+    }else if (text.startsWith("=library-loaded,") || text.startsWith("=library-unloaded,") || text.startsWith("=thread-group-started,")) {
+
+        // Code may have moved. Forget the listings of functions not being shown.
+        clearAssemblyCache();
+
     }else if (text.startsWith("^done,asm_insns=")) {
 
         _asm_insns_text = text;
 
-        updateTextArea(); // This function does all the work on _asm_insns_text.
+        if (disassemblyWindow() > 0) {
+            startWindow();      // Only part of the function. More is loaded while scrolling.
+        }else{
+            updateTextArea();   // This function does all the work on _asm_insns_text.
+        }
+
+    }else if (_windowId > 0 && text.startsWith(QString::number(_windowId) + "^")) {
+
+        handleWindowText(text);
     }
 }
 
@@ -1643,8 +1966,22 @@ void SeerEditorWidgetAssemblyArea::handleHighlighterSettingsChanged () {
     p.setColor(QPalette::Text, format.foreground().color());
     setPalette(p);
 
-    // Note. The margins are automatically updated by their own paint events.
-    //       The new highlighter settings will be used.
+    // Cache the margin formats. They're used by every margin paint event.
+    _marginFormat       = highlighterSettings().get("Margin");
+    _assemblyTextFormat = highlighterSettings().get("Assembly Text");
+
+    // Recolor the minimap.
+    setMiniMapSettings(highlighterSettings());
+
+    // Recolor the search matches.
+    setFindMatchFormat(highlighterSettings().get("Match"));
+
+    // Repaint the margins with the new settings.
+    _lineNumberArea->update();
+    _offsetArea->update();
+    _breakPointArea->update();
+    _opcodeArea->update();
+    _miniMapArea->update();
 }
 
 //
@@ -1865,37 +2202,33 @@ void SeerEditorWidgetAssemblyMiniMapArea::paintEvent (QPaintEvent* event) {
 
 void SeerEditorWidgetAssemblyMiniMapArea::mouseDoubleClickEvent (QMouseEvent* event) {
 
-    QTextCursor  cursor = _editorWidget->cursorForPosition(event->pos());
-
-    qDebug() << cursor.blockNumber()+1;
-
     QWidget::mouseDoubleClickEvent(event);
 }
 
 void SeerEditorWidgetAssemblyMiniMapArea::mouseMoveEvent (QMouseEvent* event) {
 
-    QTextCursor  cursor = _editorWidget->cursorForPosition(event->pos());
-
-    qDebug() << cursor.blockNumber()+1;
+    // Dragging in the minimap scrolls the editor.
+    if (event->buttons() & Qt::LeftButton) {
+        _editorWidget->miniMapScrollTo(event->pos().y());
+        return;
+    }
 
     QWidget::mouseMoveEvent(event);
 }
 
 void SeerEditorWidgetAssemblyMiniMapArea::mousePressEvent (QMouseEvent* event) {
 
-    QTextCursor  cursor = _editorWidget->cursorForPosition(event->pos());
-
-    qDebug() << cursor.blockNumber()+1;
+    // Clicking in the minimap scrolls the editor.
+    if (event->button() == Qt::LeftButton) {
+        _editorWidget->miniMapScrollTo(event->pos().y());
+        return;
+    }
 
     QWidget::mousePressEvent(event);
 }
 
 void SeerEditorWidgetAssemblyMiniMapArea::mouseReleaseEvent (QMouseEvent* event) {
 
-    QTextCursor  cursor = _editorWidget->cursorForPosition(event->pos());
-
-    qDebug() << cursor.blockNumber()+1;
-
     QWidget::mouseReleaseEvent(event);
 }
 
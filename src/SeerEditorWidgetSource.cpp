@@ -47,6 +47,7 @@ SeerEditorWidgetSource::SeerEditorWidgetSource(QWidget* parent) : QWidget(parent
     QObject::connect(searchLineNumberLineEdit,          &QLineEdit::returnPressed,                              this,  &SeerEditorWidgetSource::handleSearchLineNumberLineEdit);
     QObject::connect(searchReloadToolButton,            &QToolButton::clicked,                                  this,  &SeerEditorWidgetSource::handleReloadToolButton);
     QObject::connect(searchCloseToolButton,             &QToolButton::clicked,                                  this,  &SeerEditorWidgetSource::handleSearchCloseToolButton);
+    QObject::connect(sourceArea(),                      &SeerPlainTextEdit::findMatchesChanged,                 this,  &SeerEditorWidgetSource::handleFindMatchesChanged);
     QObject::connect(alternateCloseToolButton,          &QToolButton::clicked,                                  this,  &SeerEditorWidgetSource::handleAlternateCloseToolButton);
     QObject::connect(alternateFileOpenToolButton,       &QToolButton::clicked,                                  this,  &SeerEditorWidgetSource::handleAlternateFileOpenToolButton);
     QObject::connect(alternateLineEdit,                 &QLineEdit::returnPressed,                              this,  &SeerEditorWidgetSource::handleAlternateLineEdit);
@@ -181,9 +182,8 @@ void SeerEditorWidgetSource::handleSearchTextLineEdit () {
         return;
     }
 
-    int nMatches = sourceArea()->findText(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
-
-    matchesLabel->setText(QString("(%1)").arg(nMatches));
+    // The matches are found in the background. The label follows along.
+    sourceArea()->findText(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
 }
 
 void SeerEditorWidgetSource::handleSearchDownToolButton () {
@@ -194,7 +194,7 @@ void SeerEditorWidgetSource::handleSearchDownToolButton () {
         return;
     }
 
-    sourceArea()->find(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
+    sourceArea()->findNext(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
 }
 
 void SeerEditorWidgetSource::handleSearchUpToolButton () {
@@ -205,7 +205,28 @@ void SeerEditorWidgetSource::handleSearchUpToolButton () {
         return;
     }
 
-    sourceArea()->find(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()) | QTextDocument::FindBackward);
+    sourceArea()->findPrevious(str, (searchMatchCase() ? QTextDocument::FindCaseSensitively : QTextDocument::FindFlags()));
+}
+
+void SeerEditorWidgetSource::handleFindMatchesChanged () {
+
+    if (sourceArea()->findPattern() == "") {
+        matchesLabel->setText("");
+        return;
+    }
+
+    // "(3 of 120)" once a match is selected. A trailing '+' while still searching.
+    QString count = QString::number(sourceArea()->findMatchCount());
+
+    if (sourceArea()->findMatchDone() == false) {
+        count += "+";
+    }
+
+    if (sourceArea()->findMatchCurrent() >= 0) {
+        matchesLabel->setText(QString("(%1 of %2)").arg(sourceArea()->findMatchCurrent()+1).arg(count));
+    }else{
+        matchesLabel->setText(QString("(%1)").arg(count));
+    }
 }
 
 void SeerEditorWidgetSource::handleSearchCloseToolButton () {
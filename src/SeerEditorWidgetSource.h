@@ -66,8 +66,6 @@ class SeerEditorWidgetSourceArea : public SeerPlainTextEdit {
 
         void                                        clearCurrentLines                   ();
         void                                        addCurrentLine                      (int lineno);
-        int                                         findText                            (const QString& text, QTextDocument::FindFlags flags);
-        void                                        clearFindText                       ();
 
         void                                        clearBreakpoints                    ();
         void                                        addBreakpoint                       (int number, int lineno, bool enabled);
@@ -129,12 +127,13 @@ class SeerEditorWidgetSourceArea : public SeerPlainTextEdit {
         bool                                        event                               (QEvent* event);
 
     private slots:
-        void                                        refreshExtraSelections              ();
+        void                                        refreshExtraSelections              () override;
 
         void                                        updateMarginAreasWidth              (int newBlockCount);
         void                                        updateLineNumberArea                (const QRect& rect, int dy);
         void                                        updateBreakPointArea                (const QRect& rect, int dy);
         void                                        updateMiniMapArea                   (const QRect& rect, int dy);
+        void                                        updateMiniMapAreaGeometry           ();
 
     private:
         QString                                     _fullname;
@@ -149,7 +148,6 @@ class SeerEditorWidgetSourceArea : public SeerPlainTextEdit {
         QVector<int>                                _breakpointsNumbers;
         QVector<int>                                _breakpointsLineNumbers;
         QVector<bool>                               _breakpointsEnableds;
-        QList<QTextEdit::ExtraSelection>            _findExtraSelections;
         QList<QTextEdit::ExtraSelection>            _currentLinesExtraSelections;
 
         QTextCursor                                 _selectedExpressionCursor;
@@ -162,9 +160,9 @@ class SeerEditorWidgetSourceArea : public SeerPlainTextEdit {
         SeerEditorWidgetSourceBreakPointArea*       _breakPointArea;
         SeerEditorWidgetSourceMiniMapArea*          _miniMapArea;
 
-        QPixmap*                                    _miniMapPixmap;
         SeerCppSourceHighlighter*                   _sourceHighlighter;
         SeerHighlighterSettings                     _sourceHighlighterSettings;
+        QTextCharFormat                             _marginFormat;
         bool                                        _sourceHighlighterEnabled;
 
         int                                         _sourceTabSize;
@@ -260,6 +258,7 @@ class SeerEditorWidgetSource : public QWidget, protected Ui::SeerEditorWidgetSou
         void                                        handleSearchDownToolButton              ();
         void                                        handleSearchUpToolButton                ();
         void                                        handleSearchCloseToolButton             ();
+        void                                        handleFindMatchesChanged                ();
         void                                        handleAlternateCloseToolButton          ();
         void                                        handleAlternateFileOpenToolButton       ();
         void                                        handleAlternateLineEdit                 ();
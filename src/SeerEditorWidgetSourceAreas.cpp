@@ -53,17 +53,17 @@ SeerEditorWidgetSourceArea::SeerEditorWidgetSourceArea(QWidget* parent) : SeerPl
     _lineNumberArea = new SeerEditorWidgetSourceLineNumberArea(this);
     _breakPointArea = new SeerEditorWidgetSourceBreakPointArea(this);
     _miniMapArea    = new SeerEditorWidgetSourceMiniMapArea(this);
-    _miniMapPixmap  = 0;
 
     enableLineNumberArea(true);
     enableBreakPointArea(true);
-    enableMiniMapArea(false);  // Doesn't work yet. Need to work on the "mini" part.
+    enableMiniMapArea(false);
 
     QObject::connect(this, &SeerEditorWidgetSourceArea::blockCountChanged,                  this, &SeerEditorWidgetSourceArea::updateMarginAreasWidth);
     QObject::connect(this, &SeerEditorWidgetSourceArea::updateRequest,                      this, &SeerEditorWidgetSourceArea::updateLineNumberArea);
     QObject::connect(this, &SeerEditorWidgetSourceArea::updateRequest,                      this, &SeerEditorWidgetSourceArea::updateBreakPointArea);
     QObject::connect(this, &SeerEditorWidgetSourceArea::updateRequest,                      this, &SeerEditorWidgetSourceArea::updateMiniMapArea);
     QObject::connect(this, &SeerEditorWidgetSourceArea::highlighterSettingsChanged,         this, &SeerEditorWidgetSourceArea::handleHighlighterSettingsChanged);
+    QObject::connect(this, &SeerEditorWidgetSourceArea::miniMapChanged,                     _miniMapArea, QOverload<>::of(&QWidget::update));
 
     setCurrentLine(0);
 
@@ -105,7 +105,13 @@ bool SeerEditorWidgetSourceArea::breakPointAreaEnabled () const {
 void SeerEditorWidgetSourceArea::enableMiniMapArea (bool flag) {
     _enableMiniMapArea = flag;
 
+    // Start (or stop) building the minimap rendering.
+    enableMiniMap(flag);
+
+    _miniMapArea->setVisible(flag);
+
     updateMarginAreasWidth(0);
+    updateMiniMapAreaGeometry();
 }
 
 bool SeerEditorWidgetSourceArea::miniMapAreaEnabled () const {
@@ -203,14 +209,16 @@ void SeerEditorWidgetSourceArea::updateMiniMapArea (const QRect& rect, int dy) {
         return;
     }
 
+    // The minimap itself doesn't scroll. Only its view box moves.
     if (dy) {
-        _miniMapArea->scroll(0, dy);
-    }else{
-        _miniMapArea->update(0, rect.y(), _miniMapArea->width(), rect.height());
+        _miniMapArea->update();
     }
 
+    // The scrollbar may have come or gone.
     if (rect.contains(viewport()->rect())) {
         updateMarginAreasWidth(0);
+        updateMiniMapAreaGeometry();
+        _miniMapArea->update();
     }
 }
 
@@ -220,27 +228,32 @@ void SeerEditorWidgetSourceArea::lineNumberAreaPaintEvent (QPaintEvent* event) {
         return;
     }
 
-    QTextCharFormat format = highlighterSettings().get("Margin");
+    countMarginFrame();
 
     QPainter painter(_lineNumberArea);
-    painter.fillRect(event->rect(), format.background().color());
-    painter.setPen(format.foreground().color());
+    painter.fillRect(event->rect(), _marginFormat.background().color());
+    painter.setPen(_marginFormat.foreground().color());
 
     QFont font = painter.font();
-    font.setItalic(format.fontItalic());
-    font.setWeight(QFont::Weight(format.fontWeight()));
+    font.setItalic(_marginFormat.fontItalic());
+    font.setWeight(QFont::Weight(_marginFormat.fontWeight()));
     painter.setFont(font);
 
+    // Walk the visible blocks. Only the first block's geometry is computed.
+    // The rest are found by adding each block's height.
     QTextBlock block       = firstVisibleBlock();
     int        blockNumber = block.blockNumber();
     int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
     int        bottom      = top + qRound(blockBoundingRect(block).height());
+    int        lineHeight  = fontMetrics().height();
+    int        areaWidth   = _lineNumberArea->width();
+    int        rectTop     = event->rect().top();
+    int        rectBottom  = event->rect().bottom();
 
-    while (block.isValid() && top <= event->rect().bottom()) {
+    while (block.isValid() && top <= rectBottom) {
 
-        if (block.isVisible() && bottom >= event->rect().top()) {
-            QString number = QString::number(blockNumber + 1);
-            painter.drawText(0, top, _lineNumberArea->width(), fontMetrics().height(), Qt::AlignRight, number);
+        if (block.isVisible() && bottom >= rectTop) {
+            painter.drawText(0, top, areaWidth, lineHeight, Qt::AlignRight, QString::number(blockNumber + 1));
         }
 
         block  = block.next();
@@ -257,55 +270,31 @@ void SeerEditorWidgetSourceArea::breakPointAreaPaintEvent (QPaintEvent* event) {
         return;
     }
 
-    QTextCharFormat format = highlighterSettings().get("Margin");
-
     QPainter painter(_breakPointArea);
-    painter.fillRect(event->rect(), format.background().color());
-    painter.setPen(format.foreground().color());
+    painter.fillRect(event->rect(), _marginFormat.background().color());
 
-    QFont font = painter.font();
-    font.setItalic(format.fontItalic());
-    font.setWeight(QFont::Weight(format.fontWeight()));
-    painter.setFont(font);
+    // Nothing more to draw if there are no breakpoints.
+    if (_breakpointsLineNumbers.size() == 0) {
+        return;
+    }
 
     QTextBlock block       = firstVisibleBlock();
     int        blockNumber = block.blockNumber();
     int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
     int        bottom      = top + qRound(blockBoundingRect(block).height());
+    int        lineHeight  = fontMetrics().height();
+    int        markerLeft  = _breakPointArea->width() - 20;
+    int        rectTop     = event->rect().top();
+    int        rectBottom  = event->rect().bottom();
 
-    while (block.isValid() && top <= event->rect().bottom()) {
-
-        if (block.isVisible() && bottom >= event->rect().top()) {
-
-            if (hasBreakpointLine(blockNumber+1)) {
-                if (breakpointLineEnabled(blockNumber+1)) {
-                    QRect rect(_breakPointArea->width() - 20, top, fontMetrics().height(), fontMetrics().height());
-
-                    QPainterPath path;
-                    path.addEllipse(rect);
-
-                    QPointF bias = QPointF(rect.width() * .25 * 1.0, rect.height() * .25 * -1.0);
-
-                    QRadialGradient gradient(rect.center(), rect.width() / 2.0, rect.center() + bias);
-                    gradient.setColorAt(0.0, QColor(Qt::white));
-                    gradient.setColorAt(0.9, QColor(Qt::red));
-                    gradient.setColorAt(1.0, QColor(Qt::transparent));
-                    painter.fillPath(path,QBrush(gradient));
+    while (block.isValid() && top <= rectBottom) {
 
-                }else{
-                    QRect rect(_breakPointArea->width() - 20, top, fontMetrics().height(), fontMetrics().height());
-
-                    QPainterPath path;
-                    path.addEllipse(rect);
+        if (block.isVisible() && bottom >= rectTop) {
 
-                    QPointF bias = QPointF(rect.width() * .25 * 1.0, rect.height() * .25 * -1.0);
+            int i = _breakpointsLineNumbers.indexOf(blockNumber+1);
 
-                    QRadialGradient gradient(rect.center(), rect.width() / 2.0, rect.center() + bias);
-                    gradient.setColorAt(0.0, QColor(Qt::white));
-                    gradient.setColorAt(0.9, QColor(Qt::darkGray));
-                    gradient.setColorAt(1.0, Qt::transparent);
-                    painter.fillPath(path,QBrush(gradient));
-                }
+            if (i >= 0) {
+                painter.drawPixmap(markerLeft, top, breakpointMarker(_breakpointsEnableds[i], lineHeight));
             }
         }
 
@@ -319,111 +308,44 @@ void SeerEditorWidgetSourceArea::breakPointAreaPaintEvent (QPaintEvent* event) {
 
 void SeerEditorWidgetSourceArea::miniMapAreaPaintEvent (QPaintEvent* event) {
 
-    //
-    // This doesn't work yet.
-    // There is nothing 'mini' about the view. Need to shrink the text somehow.
-    // Then add a 'focus' box that can be interacted with to scroll through the text.
-    //
+    Q_UNUSED(event);
 
     if (miniMapAreaEnabled() == false) {
         return;
     }
 
-    qDebug() << "Top:" << event->rect().top() << " Right:" << event->rect().right() << " Width:" << event->rect().width() << " Height:" << event->rect().height();
-
-    if (_miniMapPixmap == 0) {
-
-        int pixmapWidth  = 0;
-        int pixmapHeight = 0;
-
-        QFont font("monospace");
-        font.setStyleHint(QFont::Monospace);
-      //font.setPointSize(2);
-
-        QFontMetrics fm(font);
-
-        {
-            QTextBlock block = document()->begin();
-
-            while (block.isValid()) {
-
-                if (fm.horizontalAdvance(block.text()) > pixmapWidth) {
-                    pixmapWidth = fm.horizontalAdvance(block.text());
-                }
+    // Gather the lines to mark on top of the minimap rendering.
+    QVector<int> enabledBreakpointLines;
+    QVector<int> disabledBreakpointLines;
+    QVector<int> currentLines;
 
-                pixmapHeight += fm.height();
-
-                block = block.next();
-            }
-        }
-
-        qDebug() << "PIXMAP = " << pixmapWidth << " x " << pixmapHeight;
-
-        QTextCharFormat format = highlighterSettings().get("Margin");
-
-        _miniMapPixmap = new QPixmap(pixmapWidth, pixmapHeight);
-        _miniMapPixmap->fill(format.background().color());
-
-        QPainter painter(_miniMapPixmap);
-        painter.setPen(format.foreground().color());
-        painter.setFont(font);
-
-        QTextBlock block       = document()->begin();
-        int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
-        int        bottom      = top + qRound(blockBoundingRect(block).height());
-
-        while (block.isValid()) {
-
-            painter.drawText(0, top, block.text());
-
-            block = block.next();
-            top    = bottom;
-            bottom = top + qRound(blockBoundingRect(block).height());
+    for (int i=0; i<_breakpointsLineNumbers.size(); i++) {
+        if (_breakpointsEnableds[i]) {
+            enabledBreakpointLines.append(_breakpointsLineNumbers[i]);
+        }else{
+            disabledBreakpointLines.append(_breakpointsLineNumbers[i]);
         }
     }
 
-
-    /*
-    QRectF target(10.0, 20.0, 80.0, 60.0);
-    QRectF source(0.0, 0.0, 70.0, 40.0);
-
-    QRect target(event->rect());
-    QRect source(event->rect());
-
-    QPainter painter(_miniMapPixmap);
-    painter.drawPixmap(0, 0, *_miniMapPixmap);
-    //painter.drawPixmap(target, *_miniMapPixmap, source);
+    for (const auto& selection : _currentLinesExtraSelections) {
+        currentLines.append(selection.cursor.blockNumber()+1);
+    }
 
     QPainter painter(_miniMapArea);
-    painter.drawPixmap(0, 0, *_miniMapPixmap);
-    */
-
-    QFont font("monospace");
-    font.setStyleHint(QFont::Monospace);
-  //font.setPointSize(2);
-
-    QTextCharFormat format = highlighterSettings().get("Margin");
 
-    QPainter painter(_miniMapArea);
-    painter.fillRect(event->rect(), format.background().color());
-    painter.setPen(format.foreground().color());
-    painter.setFont(font);
+    paintMiniMap(painter, _miniMapArea->rect(), enabledBreakpointLines, disabledBreakpointLines, currentLines);
+}
 
-    QTextBlock block       = firstVisibleBlock();
-    int        top         = qRound(blockBoundingGeometry(block).translated(contentOffset()).top());
-    int        bottom      = top + qRound(blockBoundingRect(block).height());
+void SeerEditorWidgetSourceArea::updateMiniMapAreaGeometry () {
 
-    while (block.isValid() && top <= event->rect().bottom()) {
+    if (miniMapAreaEnabled() == false) {
+        return;
+    }
 
-        if (block.isVisible() && bottom >= event->rect().top()) {
-            painter.drawText(0, top, _miniMapArea->width(), painter.fontMetrics().height(), Qt::AlignLeft, block.text());
-        }
+    QRect cr             = contentsRect();
+    int   scrollBarWidth = verticalScrollBar()->isVisible() ? verticalScrollBar()->width() : 0;
 
-        block  = block.next();
-        top    = bottom;
-        bottom = top + qRound(blockBoundingRect(block).height());
-      //bottom = top + painter.fontMetrics().height();
-    }
+    _miniMapArea->setGeometry (QRect(cr.right() - miniMapAreaWidth() - scrollBarWidth, cr.top(), miniMapAreaWidth(), cr.height()));
 }
 
 void SeerEditorWidgetSourceArea::resizeEvent (QResizeEvent* e) {
@@ -440,9 +362,7 @@ void SeerEditorWidgetSourceArea::resizeEvent (QResizeEvent* e) {
         _breakPointArea->setGeometry (QRect(cr.left() + lineNumberAreaWidth(), cr.top(), breakPointAreaWidth(), cr.height()));
     }
 
-    if (miniMapAreaEnabled()) {
-        _miniMapArea->setGeometry (QRect(cr.right() - miniMapAreaWidth() - verticalScrollBar()->width(), cr.top(), miniMapAreaWidth(), cr.height()));
-    }
+    updateMiniMapAreaGeometry();
 }
 
 void SeerEditorWidgetSourceArea::contextMenuEvent (QContextMenuEvent* event) {
@@ -568,11 +488,16 @@ void SeerEditorWidgetSourceArea::refreshExtraSelections () {
     extraSelections.append(_currentLinesExtraSelections);
 
     // Append the 'searched text' extra selections.
-    extraSelections.append(_findExtraSelections);
+    extraSelections.append(findExtraSelections());
 
     // Give the editor the list of selections.
     // This will remove the old selections and select the new ones.
     setExtraSelections(extraSelections);
+
+    // The minimap shows them too.
+    if (miniMapAreaEnabled()) {
+        _miniMapArea->update();
+    }
 }
 
 bool SeerEditorWidgetSourceArea::isOpen () const {
@@ -931,52 +856,13 @@ void SeerEditorWidgetSourceArea::addCurrentLine (int lineno) {
     refreshExtraSelections();
 }
 
-int SeerEditorWidgetSourceArea::findText (const QString& text, QTextDocument::FindFlags flags) {
-
-    _findExtraSelections.clear();
-
-    if (document()) {
-
-        QTextCharFormat matchFormat = highlighterSettings().get("Match");
-
-        // Build a list of highlights for all matches.
-        QTextCursor cursor(document());
-        cursor = document()->find(text, cursor, flags);
-
-        while (cursor.isNull() == false) {
-
-            QTextEdit::ExtraSelection extra;
-            extra.format = matchFormat;
-            extra.cursor = cursor;
-
-            _findExtraSelections.append(extra);
-
-            cursor = document()->find(text, cursor, flags);
-        }
-
-        // Move to the next match after out current position.
-        find(text, flags);
-    }
-
-    refreshExtraSelections();
-
-    return _findExtraSelections.size();
-}
-
-void SeerEditorWidgetSourceArea::clearFindText () {
-
-    _findExtraSelections.clear();
-
-    refreshExtraSelections();
-}
-
 void SeerEditorWidgetSourceArea::clearBreakpoints () {
 
     _breakpointsLineNumbers.clear();
     _breakpointsNumbers.clear();
     _breakpointsEnableds.clear();
 
-    repaint();
+    update();
 }
 
 void SeerEditorWidgetSourceArea::addBreakpoint (int number, int lineno, bool enabled) {
@@ -985,7 +871,8 @@ void SeerEditorWidgetSourceArea::addBreakpoint (int number, int lineno, bool ena
     _breakpointsLineNumbers.push_back(lineno);
     _breakpointsEnableds.push_back(enabled);
 
-    repaint();
+    // Schedule a repaint. Adding a list of breakpoints results in just one.
+    update();
 }
 
 bool SeerEditorWidgetSourceArea::hasBreakpointNumber (int number) const {
@@ -1769,6 +1656,15 @@ void SeerEditorWidgetSourceArea::handleHighlighterSettingsChanged () {
     p.setColor(QPalette::Text, format.foreground().color());
     setPalette(p);
 
+    // Cache the margin format. It's used by every margin paint event.
+    _marginFormat = highlighterSettings().get("Margin");
+
+    // Recolor the minimap.
+    setMiniMapSettings(highlighterSettings());
+
+    // Recolor the search matches.
+    setFindMatchFormat(highlighterSettings().get("Match"));
+
     // Update the syntax highlighter.
     if (_sourceHighlighter) {
 
@@ -1782,8 +1678,10 @@ void SeerEditorWidgetSourceArea::handleHighlighterSettingsChanged () {
         _sourceHighlighter->rehighlight();
     }
 
-    // Note. The margins are automatically updated by their own paint events.
-    //       The new highlighter settings will be used.
+    // Repaint the margins with the new settings.
+    _lineNumberArea->update();
+    _breakPointArea->update();
+    _miniMapArea->update();
 }
 
 void SeerEditorWidgetSourceArea::handleWatchFileModified (const QString& path) {
@@ -1913,37 +1811,33 @@ void SeerEditorWidgetSourceMiniMapArea::paintEvent (QPaintEvent* event) {
 
 void SeerEditorWidgetSourceMiniMapArea::mouseDoubleClickEvent (QMouseEvent* event) {
 
-    QTextCursor  cursor = _editorWidget->cursorForPosition(event->pos());
-
-    qDebug() << cursor.blockNumber()+1;
-
     QWidget::mouseDoubleClickEvent(event);
 }
 
 void SeerEditorWidgetSourceMiniMapArea::mouseMoveEvent (QMouseEvent* event) {
 
-    QTextCursor  cursor = _editorWidget->cursorForPosition(event->pos());
-
-    qDebug() << cursor.blockNumber()+1;
+    // Dragging in the minimap scrolls the editor.
+    if (event->buttons() & Qt::LeftButton) {
+        _editorWidget->miniMapScrollTo(event->pos().y());
+        return;
+    }
 
     QWidget::mouseMoveEvent(event);
 }
 
 void SeerEditorWidgetSourceMiniMapArea::mousePressEvent (QMouseEvent* event) {
 
-    QTextCursor  cursor = _editorWidget->cursorForPosition(event->pos());
-
-    qDebug() << cursor.blockNumber()+1;
+    // Clicking in the minimap scrolls the editor.
+    if (event->button() == Qt::LeftButton) {
+        _editorWidget->miniMapScrollTo(event->pos().y());
+        return;
+    }
 
     QWidget::mousePressEvent(event);
 }
 
 void SeerEditorWidgetSourceMiniMapArea::mouseReleaseEvent (QMouseEvent* event) {
 
-    QTextCursor  cursor = _editorWidget->cursorForPosition(event->pos());
-
-    qDebug() << cursor.blockNumber()+1;
-
     QWidget::mouseReleaseEvent(event);
 }
 
@@ -0,0 +1,83 @@
+#include "SeerFrameCache.h"
+#include "SeerUtl.h"
+#include <QtCore/QDebug>
+
+SeerFrameCache::SeerFrameCache () {
+}
+
+SeerFrameCache::~SeerFrameCache () {
+}
+
+void SeerFrameCache::reset () {
+
+    _key = "";
+
+    _texts.clear();
+    _pending.clear();
+}
+
+SeerFrameCache::Selection SeerFrameCache::select (const QString& key) {
+
+    // Just stopped. What was asked for since is for this frame.
+    if (_key == "") {
+
+        _key = key;
+
+        for (QHash<int,QString>::iterator i = _pending.begin(); i != _pending.end(); ++i) {
+            if (i.value() == "") {
+                i.value() = key;
+            }
+        }
+
+        return Unchanged;
+    }
+
+    if (_key == key) {
+        return Unchanged;
+    }
+
+    _key = key;
+
+    if (_texts.contains(key)) {
+        return Cached;
+    }
+
+    return Fetch;
+}
+
+const QString& SeerFrameCache::key () const {
+
+    return _key;
+}
+
+QString SeerFrameCache::text () const {
+
+    return _texts.value(_key);
+}
+
+int SeerFrameCache::request () {
+
+    int id = Seer::createID();
+
+    _pending.insert(id, _key);
+
+    return id;
+}
+
+bool SeerFrameCache::isPending (int id) const {
+
+    return _pending.contains(id);
+}
+
+bool SeerFrameCache::reply (int id, const QString& text) {
+
+    // Keep the reply for its frame. Say if that's the frame being shown.
+    QString key = _pending.take(id);
+
+    if (key != "") {
+        _texts.insert(key, text);
+    }
+
+    return key == _key;
+}
+
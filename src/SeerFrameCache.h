@@ -0,0 +1,43 @@
+#pragma once
+
+#include <QtCore/QHash>
+#include <QtCore/QString>
+
+//
+// The replies a browser got for each frame since the program last stopped.
+//
+// Keyed by whatever the browser's view depends on, like "thread:level". Each
+// request is given an id with request(), which remembers the frame it was for,
+// so a late reply is filed under the right frame even if another one has been
+// selected since.
+//
+// reset() when the program stops. The frame isn't known until select() is
+// called, which then adopts the requests already sent.
+//
+class SeerFrameCache {
+
+    public:
+        enum Selection {
+            Unchanged = 0,      // Same frame, or the one just stopped in. Nothing to do.
+            Cached    = 1,      // Seen before. Use text().
+            Fetch     = 2       // Not seen yet. Ask gdb.
+        };
+
+        explicit SeerFrameCache ();
+       ~SeerFrameCache ();
+
+        void                                reset                   ();
+        Selection                           select                  (const QString& key);
+        const QString&                      key                     () const;
+        QString                             text                    () const;
+
+        int                                 request                 ();
+        bool                                isPending               (int id) const;
+        bool                                reply                   (int id, const QString& text);
+
+    private:
+        QString                             _key;                   // The selected frame. Empty if not known yet.
+        QHash<QString,QString>              _texts;                 // Reply text, without the id, by frame.
+        QHash<int,QString>                  _pending;               // Request id to the frame it was for.
+};
+
@@ -1,39 +1,47 @@
 #include "SeerFunctionBrowserWidget.h"
 #include "SeerUtl.h"
-#include <QtWidgets/QTreeWidget>
-#include <QtWidgets/QTreeWidgetItemIterator>
-#include <QtWidgets/QLabel>
-#include <QtWidgets/QApplication>
-#include <QtCore/QFileInfo>
+#include <QtWidgets/QTreeView>
+#include <QtWidgets/QHeaderView>
 #include <QtCore/Qt>
-#include <QtCore/QMap>
 #include <QtCore/QDebug>
 
 SeerFunctionBrowserWidget::SeerFunctionBrowserWidget (QWidget* parent) : QWidget(parent) {
 
     // Set the state.
-    _id = Seer::createID();
+    _id              = Seer::createID();
+    _indexGeneration = 0;
+    _indexLoading    = false;
+    _indexStale      = false;   // Nothing to ask for until a program is loaded. See invalidate().
+    _librariesLoaded = false;
 
     // Construct the UI.
     setupUi(this);
 
     // Setup the widgets
-    functionSearchLineEdit->setPlaceholderText("Search regex...");
+    _indexLoader = new SeerSymbolIndexLoader(this);
+    _symbolModel = new SeerSymbolModel(this);
+    _symbolModel->setColumns({SeerSymbolModel::NameField, SeerSymbolModel::FilenameField, SeerSymbolModel::LineField, SeerSymbolModel::FullnameField, SeerSymbolModel::TypeField, SeerSymbolModel::DescriptionField},
+                             {"Function", "File", "Line", "Full Name", "Type", "Description"}, 1);
+
+    _searchTimer = new QTimer(this);
+    _searchTimer->setSingleShot(true);
+    _searchTimer->setInterval(SearchInterval);
+
+    functionSearchLineEdit->setPlaceholderText("Search functions...");
     functionSearchLineEdit->setClearButtonEnabled(true);
-    functionTreeWidget->setMouseTracking(true);
-  //functionTreeWidget->resizeColumnToContents(0);
-    functionTreeWidget->resizeColumnToContents(1);
-    functionTreeWidget->resizeColumnToContents(2);
-    functionTreeWidget->resizeColumnToContents(3);
-    functionTreeWidget->resizeColumnToContents(4);
-    functionTreeWidget->resizeColumnToContents(5);
-    functionTreeWidget->clear();
-    functionTreeWidget->setSortingEnabled(false);
+    functionTreeView->setModel(_symbolModel);
+    functionTreeView->setRootIsDecorated(false);
+    functionTreeView->setUniformRowHeights(true);
+    functionTreeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    functionTreeView->header()->setSortIndicator(-1, Qt::AscendingOrder); // Best matches first, until a column is clicked.
+    functionTreeView->setSortingEnabled(true);
 
     // Connect things.
-    QObject::connect(functionTreeWidget,      &QTreeWidget::itemDoubleClicked,    this,  &SeerFunctionBrowserWidget::handleItemDoubleClicked);
-    QObject::connect(functionTreeWidget,      &QTreeWidget::itemEntered,          this,  &SeerFunctionBrowserWidget::handleItemEntered);
-    QObject::connect(functionSearchLineEdit,  &QLineEdit::returnPressed,          this,  &SeerFunctionBrowserWidget::handleSearchLineEdit);
+    QObject::connect(functionTreeView,        &QTreeView::doubleClicked,                    this,          &SeerFunctionBrowserWidget::handleItemDoubleClicked);
+    QObject::connect(functionSearchLineEdit,  &QLineEdit::returnPressed,                    this,          &SeerFunctionBrowserWidget::handleSearchLineEdit);
+    QObject::connect(functionSearchLineEdit,  &QLineEdit::textChanged,                      this,          &SeerFunctionBrowserWidget::handleSearchChanged);
+    QObject::connect(_searchTimer,            &QTimer::timeout,                             this,          &SeerFunctionBrowserWidget::handleSearchLineEdit);
+    QObject::connect(_indexLoader,            &SeerSymbolIndexLoader::loaded,               this,          &SeerFunctionBrowserWidget::handleIndexLoaded);
 }
 
 SeerFunctionBrowserWidget::~SeerFunctionBrowserWidget () {
@@ -41,137 +49,146 @@ SeerFunctionBrowserWidget::~SeerFunctionBrowserWidget () {
 
 void SeerFunctionBrowserWidget::handleText (const QString& text) {
 
-    QApplication::setOverrideCursor(Qt::BusyCursor);
-
     if (text.startsWith(QString::number(_id) + "^done,symbols={") && text.endsWith("}")) {
 
-        functionTreeWidget->clear();
-        functionTreeWidget->setSortingEnabled(false);
-        functionTreeWidget->sortByColumn(-1, Qt::AscendingOrder);
-
-        // -symbol-info-functions
-        // ^done,symbols={
-        //          debug=[
-        //                  {
-        //                      filename="elf-init.c",
-        //                      fullname="/home/abuild/rpmbuild/BUILD/glibc-2.31/csu/elf-init.c",
-        //                      symbols=[
-        //                                  {
-        //                                      line="95",
-        //                                      name="__libc_csu_fini",
-        //                                      type="void (void)",
-        //                                      description="void __libc_csu_fini(void);"
-        //                                  },
-        //                                  {
-        //                                      line="67",
-        //                                      name="__libc_csu_init",
-        //                                      type="void (int, char **, char **)",
-        //                                      description="void __libc_csu_init(int, char **, char **);"
-        //                                  }
-        //                              ]
-        //                  },
-        //                  ...
-        //                ]
-        //              }
-
-        QString debug_text = Seer::parseFirst(text, "debug=", '[', ']', false);
-
-        QStringList filenames_list = Seer::parse(debug_text, "", '{', '}', false);
-
-        for (const auto& filename_entry : filenames_list) {
-
-            QString filename_text = Seer::parseFirst(filename_entry, "filename=", '"', '"', false);
-            QString fullname_text = Seer::parseFirst(filename_entry, "fullname=", '"', '"', false);
-
-            QString symbols_text = Seer::parseFirst(filename_entry, "symbols=", '[', ']', false);
-
-            QStringList symbols_list = Seer::parse(symbols_text, "", '{', '}', false);
-
-            for (const auto& symbol_entry : symbols_list) {
-
-                QString line_text        = Seer::parseFirst(symbol_entry, "line=", '"', '"', false);
-                QString name_text        = Seer::parseFirst(symbol_entry, "name=", '"', '"', false);
-                QString type_text        = Seer::parseFirst(symbol_entry, "type=", '"', '"', false);
-                QString description_text = Seer::parseFirst(symbol_entry, "type=", '"', '"', false);
-
-                // Skip function entries that have no line number.
-                if (line_text == "") {
-                    continue;
-                }
-
-                // Add the function to the tree.
-                QTreeWidgetItem* item = new QTreeWidgetItem;
-
-                QFont f0 = item->font(0);
-                f0.setBold(true);
-                item->setFont(0,f0);
-
-                item->setText(0, name_text);
-                item->setText(1, filename_text);
-                item->setText(2, line_text);
-                item->setText(3, fullname_text);
-                item->setText(4, type_text);
-                item->setText(5, description_text);
-
-                functionTreeWidget->addTopLevelItem(item);
-            }
-        }
+        //
+        // The program's functions. Index them off the GUI thread. See handleIndexLoaded().
+        // See SeerSymbolIndex::parse() for the format.
+        //
+        _indexGeneration++;
+
+        _indexLoader->load(_indexGeneration, text);
+
+    }else if (text.startsWith(QString::number(_id) + "^error,")) {
+
+        // Try again on the next search.
+        _indexLoading = false;
+        _indexStale   = true;
+
+        functionSearchLineEdit->setPlaceholderText("Search functions...");
+
+    }else if (text.startsWith("=library-loaded,") || text.startsWith("=library-unloaded,")) {
+
+        // The library's functions aren't in the index. A program can load many libraries
+        // before it stops, so wait for the stop and ask for them all at once.
+        _librariesLoaded = true;
 
     }else{
         // Ignore others.
     }
+}
+
+void SeerFunctionBrowserWidget::handleIndexLoaded () {
+
+    SeerSymbolIndex index;
+
+    int generation = _indexLoader->result(index);
+
+    // A newer list is on its way.
+    if (generation != _indexGeneration) {
+        return;
+    }
+
+    _indexLoading = false;
+
+    functionSearchLineEdit->setPlaceholderText("Search functions...");
+
+    _symbolModel->setIndex(index);
 
-  //functionTreeWidget->resizeColumnToContents(0);
-    functionTreeWidget->resizeColumnToContents(1);
-    functionTreeWidget->resizeColumnToContents(2);
-    functionTreeWidget->resizeColumnToContents(3);
-    functionTreeWidget->resizeColumnToContents(4);
-    functionTreeWidget->resizeColumnToContents(5);
-    functionTreeWidget->sortByColumn(0, Qt::AscendingOrder);
-    functionTreeWidget->setSortingEnabled(true);
+    handleSearchLineEdit();
+}
+
+void SeerFunctionBrowserWidget::handleItemDoubleClicked (const QModelIndex& index) {
+
+    const SeerSymbol* symbol = _symbolModel->symbol(index);
+
+    if (symbol == 0) {
+        return;
+    }
 
-    QApplication::restoreOverrideCursor();
+    emit selectedFile(symbol->filename, symbol->fullname, symbol->line);
 }
 
-void SeerFunctionBrowserWidget::handleItemDoubleClicked (QTreeWidgetItem* item, int column) {
+void SeerFunctionBrowserWidget::handleSearchLineEdit () {
+
+    _searchTimer->stop();
+
+    if (_indexStale == true) {
+        loadIndex();
+    }
+
+    // Searched here, not by gdb. The index from before a reload is used until the new one is ready.
+    _symbolModel->setRows(_symbolModel->symbolIndex().search(functionSearchLineEdit->text(), QString()));
+
+  //functionTreeView->resizeColumnToContents(0);
+    functionTreeView->resizeColumnToContents(1);
+    functionTreeView->resizeColumnToContents(2);
+    functionTreeView->resizeColumnToContents(3);
+    functionTreeView->resizeColumnToContents(4);
+    functionTreeView->resizeColumnToContents(5);
+}
 
-    Q_UNUSED(column);
+void SeerFunctionBrowserWidget::handleSearchChanged () {
 
-    emit selectedFile(item->text(1), item->text(3), item->text(2).toInt());
+    _searchTimer->start();
 }
 
-void SeerFunctionBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
+void SeerFunctionBrowserWidget::refresh () {
 
-    Q_UNUSED(column);
+    _indexStale = true;
 
-    QString tip = QString("Function: %1\nFile: %2\nLine: %3\nFullname: %4\nType: %5\nDescription: %6").arg(item->text(0)).arg(item->text(1)).arg(item->text(2)).arg(item->text(3)).arg(item->text(4)).arg(item->text(5));
+    if (isVisible()) {
+        loadIndex();
+    }
+}
 
-    item->setToolTip(0, tip);
+void SeerFunctionBrowserWidget::handleStoppingPointReached () {
 
-    for (int i=1; i<functionTreeWidget->columnCount(); i++) { // Copy tooltip to the other columns.
-        item->setToolTip(i, item->toolTip(0));
+    if (_librariesLoaded == false) {
+        return;
     }
+
+    _librariesLoaded = false;
+    _indexStale      = true;
 }
 
-void SeerFunctionBrowserWidget::handleSearchLineEdit () {
+void SeerFunctionBrowserWidget::invalidate () {
 
-    functionTreeWidget->clear();
-    functionTreeWidget->setSortingEnabled(false);
-    functionTreeWidget->sortByColumn(-1, Qt::AscendingOrder);
+    // A new program. Forget the old one's functions, and any list still on its way.
+    _indexGeneration++;
+    _indexLoading    = false;
+    _indexStale      = true;
+    _librariesLoaded = false;
 
-  //functionTreeWidget->resizeColumnToContents(0);
-    functionTreeWidget->resizeColumnToContents(1);
-    functionTreeWidget->resizeColumnToContents(2);
-    functionTreeWidget->resizeColumnToContents(3);
-    functionTreeWidget->resizeColumnToContents(4);
-    functionTreeWidget->resizeColumnToContents(5);
+    _symbolModel->clear();
 
-    if (functionSearchLineEdit->text() != "") {
-        emit refreshFunctionList(_id, functionSearchLineEdit->text());
+    if (isVisible()) {
+        loadIndex();
     }
 }
 
-void SeerFunctionBrowserWidget::refresh () {
-    handleSearchLineEdit();
+void SeerFunctionBrowserWidget::loadIndex () {
+
+    if (_indexLoading == true) {
+        return;
+    }
+
+    // An empty regex asks gdb for all of the functions, once.
+    _indexLoading    = true;
+    _indexStale      = false;
+    _librariesLoaded = false;
+
+    functionSearchLineEdit->setPlaceholderText("Loading functions...");
+
+    emit refreshFunctionList(_id, "");
+}
+
+void SeerFunctionBrowserWidget::showEvent (QShowEvent* event) {
+
+    QWidget::showEvent(event);
+
+    if (_indexStale == true) {
+        loadIndex();
+    }
 }
 
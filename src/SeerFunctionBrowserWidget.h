@@ -1,6 +1,10 @@
 #pragma once
 
+#include "SeerSymbolIndex.h"
+#include "SeerSymbolModel.h"
 #include <QtWidgets/QWidget>
+#include <QtCore/QTimer>
+#include <QtCore/QModelIndex>
 #include <QtCore/QString>
 #include "ui_SeerFunctionBrowserWidget.h"
 
@@ -15,18 +19,33 @@ class SeerFunctionBrowserWidget : public QWidget, protected Ui::SeerFunctionBrow
     public slots:
         void                handleText                  (const QString& text);
         void                refresh                     ();
+        void                invalidate                  ();
+        void                handleStoppingPointReached  ();
 
     protected slots:
         void                handleSearchLineEdit        ();
-        void                handleItemDoubleClicked     (QTreeWidgetItem* item, int column);
-        void                handleItemEntered           (QTreeWidgetItem* item, int column);
+        void                handleSearchChanged         ();
+        void                handleIndexLoaded           ();
+        void                handleItemDoubleClicked     (const QModelIndex& index);
 
     signals:
         void                refreshFunctionList         (int id, const QString& functionRegex);
         void                selectedFile                (QString file, QString fullname, int lineno);
 
     protected:
+        void                loadIndex                   ();
+        void                showEvent                   (QShowEvent* event);
+
+        static const int    SearchInterval = 150;       // Milliseconds of typing before searching.
+
     private:
-        int                 _id;
+        int                         _id;
+        SeerSymbolIndexLoader*      _indexLoader;
+        SeerSymbolModel*            _symbolModel;
+        QTimer*                     _searchTimer;               // Search once typing pauses.
+        int                         _indexGeneration;
+        bool                        _indexLoading;              // Waiting for gdb's list.
+        bool                        _indexStale;                // The list needs to be asked for again.
+        bool                        _librariesLoaded;           // Libraries came or went since the list. Ask again at the next stop.
 };
 
@@ -13,12 +13,14 @@ SeerGdbLogWidget::~SeerGdbLogWidget () {
 void SeerGdbLogWidget::processText (const QString& text) {
 
     QString str;
+    char    type = 0;
 
     // Remove leading "~"
     // ~"For help, type "help".
     // "
     if (text.front() == '~') {
-        str = text.mid(1);
+        str  = text.mid(1);
+        type = '~';
 
         // Remove leading """
         if (str.front() == '"') {
@@ -40,7 +42,8 @@ void SeerGdbLogWidget::processText (const QString& text) {
     // "
     } else if (text.front() == '&') {
 
-        str = text.mid(1);
+        str  = text.mid(1);
+        type = '&';
 
         // Remove leading """
         if (str.front() == '"') {
@@ -63,7 +66,8 @@ void SeerGdbLogWidget::processText (const QString& text) {
     // "
     } else if (text.front() == '@') {
 
-        str = text.mid(1);
+        str  = text.mid(1);
+        type = '@';
 
         // Remove leading """
         if (str.front() == '"') {
@@ -91,8 +95,8 @@ void SeerGdbLogWidget::processText (const QString& text) {
     str.replace("\\t", "");
     str.replace("\\n", "");
 
-    // Write the string to the log.
-    textEdit->append(str);
+    // Write the string to the log. Its record type was stripped off, so pass it along.
+    appendLine(str, type);
 
     // If there is breakpoint message (via a manual command), ask
     // for the breakpoint list to be refreshed.
@@ -44,6 +44,9 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     _executablePid                      = 0;
 
     _gdbMonitor                         = 0;
+    _sessionLog                         = 0;
+    _varObjRegistry                     = 0;
+    _sessionLogEnabled                  = false;
     _gdbProcess                         = 0;
     _consoleWidget                      = 0;
     _breakpointsBrowserWidget           = 0;
@@ -57,6 +60,8 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     _gdbNonStopMode                     = false;
     _assemblyShowAssemblyTabOnStartup   = false;
     _assemblyDisassemblyFlavor          = "att";
+    _assemblyDisassemblyMode            = "function";
+    _assemblyDisassemblyBytes           = 256;
     _gdbHandleTerminatingException      = true;
     _gdbRandomizeStartAddress           = false;
     _gdbEnablePrettyPrinting            = true;
@@ -64,6 +69,7 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     _gdbRecordDirection                 = "";
     _consoleScrollLines                 = 1000;
     _rememberManualCommandCount         = 10;
+    _currentThread                      = -1;
     _currentFrame                       = -1;
 
     setNewExecutableFlag(true);
@@ -131,6 +137,14 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     _gdbMonitor = new GdbMonitor(this);
     _gdbMonitor->setProcess(_gdbProcess);
 
+    // Create the session log. It writes gdb's traffic and the console's output to disk, if enabled.
+    _sessionLog = new SeerSessionLog(this);
+    _gdbMonitor->setSessionLog(_sessionLog);
+
+    // Create the varobj registry. It keeps count of the varobjs made in gdb, and deletes the ones left behind.
+    _varObjRegistry = new SeerVarObjRegistry(this);
+    variableManagerWidget->varObjBrowserWidget()->setRegistry(_varObjRegistry);
+
     // Restore tab ordering.
     readLogsSettings();
 
@@ -154,10 +168,14 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              _seerOutputLog,                                                 &SeerSeerLogWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              editorManagerWidget,                                            &SeerEditorManagerWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               editorManagerWidget,                                            &SeerEditorManagerWidget::handleText);
+    QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               editorManagerWidget,                                            &SeerEditorManagerWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               sourceLibraryManagerWidget->sourceBrowserWidget(),              &SeerSourceBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               sourceLibraryManagerWidget->functionBrowserWidget(),            &SeerFunctionBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               sourceLibraryManagerWidget->typeBrowserWidget(),                &SeerTypeBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               sourceLibraryManagerWidget->staticBrowserWidget(),              &SeerStaticBrowserWidget::handleText);
+    QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               sourceLibraryManagerWidget->functionBrowserWidget(),            &SeerFunctionBrowserWidget::handleText);
+    QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               sourceLibraryManagerWidget->typeBrowserWidget(),                &SeerTypeBrowserWidget::handleText);
+    QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               sourceLibraryManagerWidget->staticBrowserWidget(),              &SeerStaticBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               sourceLibraryManagerWidget->libraryBrowserWidget(),             &SeerLibraryBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               sourceLibraryManagerWidget->adaExceptionsBrowserWidget(),       &SeerAdaExceptionsBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               stackManagerWidget->stackFramesBrowserWidget(),                 &SeerStackFramesBrowserWidget::handleText);
@@ -170,7 +188,9 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               _printpointsBrowserWidget,                                      &SeerPrintpointsBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               variableManagerWidget->registerValuesBrowserWidget(),           &SeerRegisterValuesBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               variableManagerWidget->variableTrackerBrowserWidget(),          &SeerVariableTrackerBrowserWidget::handleText);
+    QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              variableManagerWidget->variableTrackerBrowserWidget(),          &SeerVariableTrackerBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               variableManagerWidget->variableLoggerBrowserWidget(),           &SeerVariableLoggerBrowserWidget::handleText);
+    QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               _varObjRegistry,                                                &SeerVarObjRegistry::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              _watchpointsBrowserWidget,                                      &SeerWatchpointsBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              this,                                                           &SeerGdbWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               this,                                                           &SeerGdbWidget::handleText);
@@ -179,6 +199,7 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               threadManagerWidget->threadFramesBrowserWidget(),               &SeerThreadFramesBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::astrixTextOutput,                                                              threadManagerWidget->threadFramesBrowserWidget(),               &SeerThreadFramesBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               threadManagerWidget->threadIdsBrowserWidget(),                  &SeerThreadIdsBrowserWidget::handleText);
+    QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               threadManagerWidget->threadIdsBrowserWidget(),                  &SeerThreadIdsBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               threadManagerWidget->threadGroupsBrowserWidget(),               &SeerThreadGroupsBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::equalTextOutput,                                                               threadManagerWidget->threadGroupsBrowserWidget(),               &SeerThreadGroupsBrowserWidget::handleText);
     QObject::connect(_gdbMonitor,                                               &GdbMonitor::caretTextOutput,                                                               threadManagerWidget->adaTasksBrowserWidget(),                   &SeerAdaTasksBrowserWidget::handleText);
@@ -199,9 +220,10 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::addArrayVisualize,                                                this,                                                           &SeerGdbWidget::handleGdbArrayAddExpression);
     QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::addStructVisualize,                                               this,                                                           &SeerGdbWidget::handleGdbVarAddExpression);
     QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::evaluateVariableExpression,                                       this,                                                           &SeerGdbWidget::handleGdbDataEvaluateExpression);
-    QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::evaluateVariableExpression,                                       variableManagerWidget->variableLoggerBrowserWidget(),           &SeerVariableLoggerBrowserWidget::handleEvaluateVariableExpression);
     QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::requestAssembly,                                                  this,                                                           &SeerGdbWidget::handleGdbGetAssembly);
     QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::requestSourceAndAssembly,                                         this,                                                           &SeerGdbWidget::handleGdbGetSourceAndAssembly);
+    QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::requestSourceAndAssemblyRange,                                    this,                                                           &SeerGdbWidget::handleGdbGetSourceAndAssemblyRange);
+    QObject::connect(editorManagerWidget,                                       &SeerEditorManagerWidget::requestSourceLines,                                               this,                                                           &SeerGdbWidget::handleGdbSourceLines);
 
     QObject::connect(sourceLibraryManagerWidget->sourceBrowserWidget(),         &SeerSourceBrowserWidget::refreshSourceList,                                                this,                                                           &SeerGdbWidget::handleGdbExecutableSources);
     QObject::connect(sourceLibraryManagerWidget->sourceBrowserWidget(),         &SeerSourceBrowserWidget::selectedFile,                                                     editorManagerWidget,                                            &SeerEditorManagerWidget::handleOpenFile);
@@ -216,10 +238,16 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(sourceLibraryManagerWidget->adaExceptionsBrowserWidget(),  &SeerAdaExceptionsBrowserWidget::insertCatchpoint,                                          this,                                                           &SeerGdbWidget::handleGdbCatchpointInsert);
 
     QObject::connect(stackManagerWidget->stackFramesBrowserWidget(),            &SeerStackFramesBrowserWidget::refreshStackFrames,                                          this,                                                           &SeerGdbWidget::handleGdbStackListFrames);
+    QObject::connect(stackManagerWidget->stackFramesBrowserWidget(),            &SeerStackFramesBrowserWidget::refreshStackFramesRange,                                     this,                                                           &SeerGdbWidget::handleGdbStackListFramesRange);
     QObject::connect(stackManagerWidget->stackFramesBrowserWidget(),            &SeerStackFramesBrowserWidget::selectedFrame,                                               this,                                                           &SeerGdbWidget::handleGdbStackSelectFrame);
     QObject::connect(stackManagerWidget->stackFramesBrowserWidget(),            &SeerStackFramesBrowserWidget::selectedFile,                                                editorManagerWidget,                                            &SeerEditorManagerWidget::handleOpenFile);
     QObject::connect(stackManagerWidget->stackFramesBrowserWidget(),            &SeerStackFramesBrowserWidget::selectedAddress,                                             editorManagerWidget,                                            &SeerEditorManagerWidget::handleOpenAddress);
     QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::refreshStackArguments,                                    this,                                                           &SeerGdbWidget::handleGdbStackListArguments);
+    QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::refreshStackArgumentNames,                                this,                                                           &SeerGdbWidget::handleGdbStackListArgumentNames);
+    QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::varObjCreate,                                             this,                                                           &SeerGdbWidget::handleGdbVarObjCreateInFrame);
+    QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::varObjListChildren,                                       this,                                                           &SeerGdbWidget::handleGdbVarObjListChildren);
+    QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::varObjUpdate,                                             this,                                                           &SeerGdbWidget::handleGdbVarObjUpdate);
+    QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::varObjDelete,                                             this,                                                           &SeerGdbWidget::handleGdbVarObjDelete);
     QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::addVariableLoggerExpression,                              variableManagerWidget->variableLoggerBrowserWidget(),           &SeerVariableLoggerBrowserWidget::addVariableExpression);
     QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::addVariableTrackerExpression,                             this,                                                           &SeerGdbWidget::handleGdbDataAddExpression);
     QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::addMemoryVisualize,                                       this,                                                           &SeerGdbWidget::handleGdbMemoryAddExpression);
@@ -227,16 +255,29 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::addStructVisualize,                                       this,                                                           &SeerGdbWidget::handleGdbVarAddExpression);
     QObject::connect(stackManagerWidget->stackArgumentsBrowserWidget(),         &SeerStackArgumentsBrowserWidget::refreshVariableTrackerValues,                             this,                                                           &SeerGdbWidget::handleGdbDataListExpressions);
     QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::refreshStackLocals,                                          this,                                                           &SeerGdbWidget::handleGdbStackListLocals);
+    QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::refreshStackLocalNames,                                      this,                                                           &SeerGdbWidget::handleGdbStackListLocalNames);
+    QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::varObjCreate,                                                this,                                                           &SeerGdbWidget::handleGdbVarObjCreateInFrame);
+    QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::varObjListChildren,                                          this,                                                           &SeerGdbWidget::handleGdbVarObjListChildren);
+    QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::varObjUpdate,                                                this,                                                           &SeerGdbWidget::handleGdbVarObjUpdate);
+    QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::varObjDelete,                                                this,                                                           &SeerGdbWidget::handleGdbVarObjDelete);
     QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::addVariableLoggerExpression,                                 variableManagerWidget->variableLoggerBrowserWidget(),           &SeerVariableLoggerBrowserWidget::addVariableExpression);
     QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::addVariableTrackerExpression,                                this,                                                           &SeerGdbWidget::handleGdbDataAddExpression);
     QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::addMemoryVisualize,                                          this,                                                           &SeerGdbWidget::handleGdbMemoryAddExpression);
     QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::addArrayVisualize,                                           this,                                                           &SeerGdbWidget::handleGdbArrayAddExpression);
     QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::addStructVisualize,                                          this,                                                           &SeerGdbWidget::handleGdbVarAddExpression);
     QObject::connect(stackManagerWidget->stackLocalsBrowserWidget(),            &SeerStackLocalsBrowserWidget::refreshVariableTrackerValues,                                this,                                                           &SeerGdbWidget::handleGdbDataListExpressions);
-    QObject::connect(stackManagerWidget,                                        &SeerStackManagerWidget::refreshThreadFrames,                                               this,                                                           &SeerGdbWidget::handleGdbThreadListFrames);
-
-    QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::refreshVariableTrackerValues,                            this,                                                           &SeerGdbWidget::handleGdbDataListExpressions);
-    QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::refreshVariableTrackerNames,                             this,                                                           &SeerGdbWidget::handleGdbDataListValues);
+    QObject::connect(stackManagerWidget,                                        &SeerStackManagerWidget::refreshThreadIds,                                                  this,                                                           &SeerGdbWidget::handleGdbThreadListIds);
+
+    QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::refreshVariableTrackerNames,                             this,                                                           &SeerGdbWidget::handleGdbDataListExpressions);
+    QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::varObjCreate,                                            this,                                                           &SeerGdbWidget::handleGdbDataCreateVarObj);
+    QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::varObjUpdateAll,                                         this,                                                           &SeerGdbWidget::handleGdbVarObjUpdateAll);
+    QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::varObjDelete,                                            this,                                                           &SeerGdbWidget::handleGdbVarObjDelete);
+    QObject::connect(_varObjRegistry,                                           &SeerVarObjRegistry::deleteVarObj,                                                          this,                                                           &SeerGdbWidget::handleGdbVarObjDelete);
+    QObject::connect(_varObjRegistry,                                           &SeerVarObjRegistry::freezeVarObj,                                                          this,                                                           &SeerGdbWidget::handleGdbVarObjFreeze);
+    QObject::connect(_varObjRegistry,                                           &SeerVarObjRegistry::evicted,                                                               variableManagerWidget->variableTrackerBrowserWidget(),          &SeerVariableTrackerBrowserWidget::handleVarObjEvicted);
+    QObject::connect(_varObjRegistry,                                           &SeerVarObjRegistry::evicted,                                                               stackManagerWidget->stackLocalsBrowserWidget(),                 &SeerStackLocalsBrowserWidget::handleVarObjEvicted);
+    QObject::connect(_varObjRegistry,                                           &SeerVarObjRegistry::evicted,                                                               stackManagerWidget->stackArgumentsBrowserWidget(),              &SeerStackArgumentsBrowserWidget::handleVarObjEvicted);
+    QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::varObjListChildren,                                      this,                                                           &SeerGdbWidget::handleGdbVarObjListChildren);
     QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::addVariableExpression,                                   this,                                                           &SeerGdbWidget::handleGdbDataAddExpression);
     QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::deleteVariableExpressions,                               this,                                                           &SeerGdbWidget::handleGdbDataDeleteExpressions);
     QObject::connect(variableManagerWidget->variableTrackerBrowserWidget(),     &SeerVariableTrackerBrowserWidget::addMemoryVisualize,                                      this,                                                           &SeerGdbWidget::handleGdbMemoryAddExpression);
@@ -248,10 +289,11 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(variableManagerWidget->variableLoggerBrowserWidget(),      &SeerVariableLoggerBrowserWidget::addStructVisualize,                                       this,                                                           &SeerGdbWidget::handleGdbVarAddExpression);
     QObject::connect(variableManagerWidget->registerValuesBrowserWidget(),      &SeerRegisterValuesBrowserWidget::refreshRegisterNames,                                     this,                                                           &SeerGdbWidget::handleGdbRegisterListNames);
     QObject::connect(variableManagerWidget->registerValuesBrowserWidget(),      &SeerRegisterValuesBrowserWidget::refreshRegisterValues,                                    this,                                                           &SeerGdbWidget::handleGdbRegisterListValues);
+    QObject::connect(variableManagerWidget->registerValuesBrowserWidget(),      &SeerRegisterValuesBrowserWidget::refreshChangedRegisters,                                  this,                                                           &SeerGdbWidget::handleGdbRegisterListChanged);
     QObject::connect(variableManagerWidget->registerValuesBrowserWidget(),      &SeerRegisterValuesBrowserWidget::setRegisterValue,                                         this,                                                           &SeerGdbWidget::handleGdbRegisterSetValue);
 
     QObject::connect(threadManagerWidget->threadFramesBrowserWidget(),          &SeerThreadFramesBrowserWidget::refreshThreadIds,                                           this,                                                           &SeerGdbWidget::handleGdbThreadListIds);
-    QObject::connect(threadManagerWidget->threadFramesBrowserWidget(),          &SeerThreadFramesBrowserWidget::refreshThreadFrames,                                        this,                                                           &SeerGdbWidget::handleGdbThreadListFrames);
+    QObject::connect(threadManagerWidget->threadFramesBrowserWidget(),          &SeerThreadFramesBrowserWidget::refreshThreadFrame,                                         this,                                                           &SeerGdbWidget::handleGdbThreadInfo);
     QObject::connect(threadManagerWidget->threadFramesBrowserWidget(),          &SeerThreadFramesBrowserWidget::selectedFile,                                               editorManagerWidget,                                            &SeerEditorManagerWidget::handleOpenFile);
     QObject::connect(threadManagerWidget->threadFramesBrowserWidget(),          &SeerThreadFramesBrowserWidget::selectedThread,                                             this,                                                           &SeerGdbWidget::handleGdbThreadSelectId);
     QObject::connect(threadManagerWidget->threadFramesBrowserWidget(),          &SeerThreadFramesBrowserWidget::nextThreadId,                                               this,                                                           &SeerGdbWidget::handleGdbNextThreadId);
@@ -332,6 +374,20 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
     QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       _catchpointsBrowserWidget,                                      &SeerCatchpointsBrowserWidget::handleStoppingPointReached);
     QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       _printpointsBrowserWidget,                                      &SeerPrintpointsBrowserWidget::handleStoppingPointReached);
     QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       stackManagerWidget,                                             &SeerStackManagerWidget::handleStoppingPointReached);
+    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       sourceLibraryManagerWidget->functionBrowserWidget(),            &SeerFunctionBrowserWidget::handleStoppingPointReached);
+    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       sourceLibraryManagerWidget->typeBrowserWidget(),                &SeerTypeBrowserWidget::handleStoppingPointReached);
+    QObject::connect(this,                                                      &SeerGdbWidget::stoppingPointReached,                                                       sourceLibraryManagerWidget->staticBrowserWidget(),              &SeerStaticBrowserWidget::handleStoppingPointReached);
+
+    QObject::connect(this,                                                      &SeerGdbWidget::selectedThreadChanged,                                                      stackManagerWidget->stackFramesBrowserWidget(),                 &SeerStackFramesBrowserWidget::refresh);
+    QObject::connect(this,                                                      &SeerGdbWidget::selectedThreadChanged,                                                      threadManagerWidget->threadFramesBrowserWidget(),               &SeerThreadFramesBrowserWidget::refresh);
+    QObject::connect(this,                                                      &SeerGdbWidget::selectedThreadChanged,                                                      threadManagerWidget->threadIdsBrowserWidget(),                  &SeerThreadIdsBrowserWidget::refresh);
+    QObject::connect(this,                                                      &SeerGdbWidget::selectedThreadChanged,                                                      threadManagerWidget->adaTasksBrowserWidget(),                   &SeerAdaTasksBrowserWidget::refresh);
+    QObject::connect(this,                                                      &SeerGdbWidget::selectedThreadChanged,                                                      stackManagerWidget,                                             &SeerStackManagerWidget::refresh);
+
+    QObject::connect(this,                                                      &SeerGdbWidget::selectedFrameChanged,                                                       stackManagerWidget->stackLocalsBrowserWidget(),                 &SeerStackLocalsBrowserWidget::handleSelectedFrameChanged);
+    QObject::connect(this,                                                      &SeerGdbWidget::selectedFrameChanged,                                                       stackManagerWidget->stackArgumentsBrowserWidget(),              &SeerStackArgumentsBrowserWidget::handleSelectedFrameChanged);
+    QObject::connect(this,                                                      &SeerGdbWidget::selectedFrameChanged,                                                       variableManagerWidget->registerValuesBrowserWidget(),           &SeerRegisterValuesBrowserWidget::handleSelectedFrameChanged);
+    QObject::connect(this,                                                      &SeerGdbWidget::selectedFrameChanged,                                                       variableManagerWidget->variableTrackerBrowserWidget(),          &SeerVariableTrackerBrowserWidget::handleSelectedFrameChanged);
     QObject::connect(this,                                                      &SeerGdbWidget::assemblyConfigChanged,                                                      editorManagerWidget,                                            &SeerEditorManagerWidget::handleAssemblyConfigChanged);
 
     QObject::connect(leftCenterRightSplitter,                                   &QSplitter::splitterMoved,                                                                  this,                                                           &SeerGdbWidget::handleSplitterMoved);
@@ -354,12 +410,21 @@ SeerGdbWidget::SeerGdbWidget (QWidget* parent) : QWidget(parent) {
 
 SeerGdbWidget::~SeerGdbWidget () {
 
+    // The widgets that own varobjs are deleted after this. Don't send deletes for them.
+    if (_varObjRegistry) {
+        QObject::disconnect(_varObjRegistry, 0, this, 0);
+    }
+
     deleteConsole();
 
     if (_gdbMonitor) {
         delete _gdbMonitor;
     }
 
+    if (_sessionLog) {
+        delete _sessionLog; // Writes out what's left.
+    }
+
     if (_gdbProcess) {
         _gdbProcess->kill();
         _gdbProcess->waitForFinished();
@@ -813,6 +878,20 @@ void SeerGdbWidget::handleText (const QString& text) {
 
         emit stoppingPointReached();
 
+        // *stopped,reason="breakpoint-hit",...,thread-id="1",stopped-threads="all",core="6"
+        //
+        // The program stopped in frame 0 of this thread. Tells the browsers that keep
+        // values per frame which frame they just asked about.
+        //
+        QString threadid_text = Seer::parseFirst(text, "thread-id=", '"', '"', false);
+
+        if (threadid_text != "") {
+            _currentThread = threadid_text.toInt();
+            _currentFrame  = 0;
+
+            emit selectedFrameChanged(_currentThread, _currentFrame);
+        }
+
     }else if (text.startsWith("=breakpoint-created,")) {
 
         handleGdbGenericpointList();
@@ -898,6 +977,8 @@ void SeerGdbWidget::handleGdbCommand (const QString& command) {
 
     QByteArray bytes = str.toUtf8(); // 8-bit Unicode Transformation Format
 
+    _sessionLog->write(SeerSessionLog::GdbInput, bytes);
+
     _gdbProcess->write(bytes);       // Send the data into the stdin stream of the bash child process
 }
 
@@ -1746,7 +1827,9 @@ void SeerGdbWidget::handleGdbExecutableFunctions (int id, const QString& functio
         return;
     }
 
+    // No regex is all of the functions.
     if (functionRegex == "") {
+        handleGdbCommand(QString("%1-symbol-info-functions").arg(id));
         return;
     }
 
@@ -1765,7 +1848,9 @@ void SeerGdbWidget::handleGdbExecutableTypes (int id, const QString& typeRegex)
         return;
     }
 
+    // No regex is all of the types.
     if (typeRegex == "") {
+        handleGdbCommand(QString("%1-symbol-info-types").arg(id));
         return;
     }
 
@@ -1837,6 +1922,9 @@ void SeerGdbWidget::handleGdbExecutableName () {
 
         handleGdbCommand(QString("-file-symbol-file \"") + executableSymbolName() + "\"");
     }
+
+    // The symbol browsers ask for the new program's symbols when they're next used.
+    sourceLibraryManagerWidget->invalidateSymbols();
 }
 
 void SeerGdbWidget::handleGdbExecutableArguments () {
@@ -1900,7 +1988,17 @@ void SeerGdbWidget::handleGdbStackListFrames () {
         return;
     }
 
-    handleGdbCommand("-stack-list-frames");
+    // Just the first page. The stack browser asks for more as it's scrolled.
+    handleGdbCommand(QString("-stack-list-frames 0 %1").arg(SeerStackFramesBrowserWidget::PageSize - 1));
+}
+
+void SeerGdbWidget::handleGdbStackListFramesRange (int id, int low, int high) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    handleGdbCommand(QString("%1-stack-list-frames %2 %3").arg(id).arg(low).arg(high));
 }
 
 void SeerGdbWidget::handleGdbStackSelectFrame (int frameno) {
@@ -1915,25 +2013,66 @@ void SeerGdbWidget::handleGdbStackSelectFrame (int frameno) {
     // So resort to calling the non-gdbmi version.
     handleGdbCommand(QString("frame %1").arg(frameno));
 
-    emit stoppingPointReached();
+    // Nothing ran. Only what depends on the frame needs to change.
+    _currentFrame = frameno;
+
+    emit selectedFrameChanged(_currentThread, _currentFrame);
+}
+
+void SeerGdbWidget::handleGdbStackListLocals (int id) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    handleGdbCommand(QString("%1-stack-list-variables --all-values").arg(id));
 }
 
-void SeerGdbWidget::handleGdbStackListLocals () {
+void SeerGdbWidget::handleGdbStackListArguments (int id) {
 
     if (executableLaunchMode() == "") {
         return;
     }
 
-    handleGdbCommand("-stack-list-variables --all-values");
+    handleGdbCommand(QString("%1-stack-list-arguments --all-values").arg(id));
 }
 
-void SeerGdbWidget::handleGdbStackListArguments () {
+void SeerGdbWidget::handleGdbStackListLocalNames (int id) {
 
     if (executableLaunchMode() == "") {
         return;
     }
 
-    handleGdbCommand("-stack-list-arguments --all-values");
+    handleGdbCommand(QString("%1-stack-list-variables --no-values").arg(id));
+}
+
+void SeerGdbWidget::handleGdbStackListArgumentNames (int id) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    handleGdbCommand(QString("%1-stack-list-arguments --no-values").arg(id));
+}
+
+void SeerGdbWidget::handleGdbVarObjCreateInFrame (int id, QString objname, int frame, QString expression) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    _varObjRegistry->add(sender(), id, objname, expression, true);
+
+    // A frame of -1 makes a floating varobj. It is evaluated in whatever frame is selected.
+    QString str;
+
+    if (frame < 0) {
+        str = QString("%1-var-create %2 @ \"%3\"").arg(id).arg(objname).arg(expression);
+    }else{
+        str = QString("%1-var-create --frame %4 %2 * \"%3\"").arg(id).arg(objname).arg(expression).arg(frame);
+    }
+
+    handleGdbCommand(str);
 }
 
 void SeerGdbWidget::handleGdbGenericpointList () {
@@ -2169,13 +2308,13 @@ void SeerGdbWidget::handleGdbPrintpointInsert (QString printpoint) {
 }
 
 
-void SeerGdbWidget::handleGdbThreadListFrames () {
+void SeerGdbWidget::handleGdbThreadInfo (int id, int threadid) {
 
     if (executableLaunchMode() == "") {
         return;
     }
 
-    handleGdbCommand("-thread-info");
+    handleGdbCommand(QString("%1-thread-info %2").arg(id).arg(threadid));
 }
 
 void SeerGdbWidget::handleGdbThreadListIds () {
@@ -2204,7 +2343,12 @@ void SeerGdbWidget::handleGdbThreadSelectId (int threadid) {
 
     handleGdbCommand(QString("-thread-select %1").arg(threadid));
 
-    emit stoppingPointReached();
+    // Nothing ran. The thread's frame 0 is selected.
+    _currentThread = threadid;
+    _currentFrame  = 0;
+
+    emit selectedThreadChanged(_currentThread);
+    emit selectedFrameChanged(_currentThread, _currentFrame);
 }
 
 void SeerGdbWidget::handleGdbAdaListTasks () {
@@ -2234,7 +2378,7 @@ void SeerGdbWidget::handleGdbRegisterListNames () {
     handleGdbCommand("-data-list-register-names");
 }
 
-void SeerGdbWidget::handleGdbRegisterListValues (QString fmt) {
+void SeerGdbWidget::handleGdbRegisterListValues (int id, QString fmt, QString numbers) {
 
     if (executableLaunchMode() == "") {
         return;
@@ -2248,7 +2392,27 @@ void SeerGdbWidget::handleGdbRegisterListValues (QString fmt) {
     // XXX Perhaps skips registers that can't get value for.
     // XXX handleGdbCommand("-data-list-register-values --skip-unavailable " + fmt);
 
-    handleGdbCommand("-data-list-register-values " + fmt);
+    // An id of 0 sends the command without one. No numbers asks for all registers.
+    QString str = "-data-list-register-values " + fmt;
+
+    if (id > 0) {
+        str = QString::number(id) + str;
+    }
+
+    if (numbers != "") {
+        str += " " + numbers;
+    }
+
+    handleGdbCommand(str);
+}
+
+void SeerGdbWidget::handleGdbRegisterListChanged (int id) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    handleGdbCommand(QString("%1-data-list-changed-registers").arg(id));
 }
 
 void SeerGdbWidget::handleGdbRegisterSetValue (QString fmt, QString name, QString value) {
@@ -2261,7 +2425,7 @@ void SeerGdbWidget::handleGdbRegisterSetValue (QString fmt, QString name, QStrin
     handleGdbCommand("-gdb-set $" + name + "=" + value);
 
     // Refresh whoever is listening.
-    handleGdbRegisterListValues(fmt);
+    handleGdbRegisterListValues(0, fmt, "");
 }
 
 
@@ -2282,6 +2446,8 @@ void SeerGdbWidget::handleGdbVarObjCreate (int expressionid, QString expression)
 
     QString str = QString("%1-var-create seer%1 \"*\" \"%2\"").arg(expressionid).arg(expression);
 
+    _varObjRegistry->add(sender(), expressionid, QString("seer%1").arg(expressionid), expression, true);
+
     handleGdbCommand(str);
 }
 
@@ -2291,17 +2457,50 @@ void SeerGdbWidget::handleGdbVarObjListChildren (int expressionid, QString objna
         return;
     }
 
+    _varObjRegistry->touch(objname);
+
     QString str = QString("%1-var-list-children --all-values \"%2\"").arg(expressionid).arg(objname);
 
     handleGdbCommand(str);
 }
 
+void SeerGdbWidget::handleGdbVarObjListChildrenRange (int expressionid, QString objname, int from, int to) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    _varObjRegistry->touch(objname);
+
+    // Children 'from' up to, but not including, 'to'.
+    QString str = QString("%1-var-list-children --all-values \"%2\" %3 %4").arg(expressionid).arg(objname).arg(from).arg(to);
+
+    handleGdbCommand(str);
+}
+
+void SeerGdbWidget::handleGdbVarObjSetUpdateRange (int expressionid, QString objname, int from, int to) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    _varObjRegistry->touch(objname);
+
+    // Limits the children a pretty-printed container reports in "-var-update".
+    QString str = QString("%1-var-set-update-range \"%2\" %3 %4").arg(expressionid).arg(objname).arg(from).arg(to);
+
+    handleGdbCommand(str);
+}
+
 void SeerGdbWidget::handleGdbVarObjUpdate (int expressionid, QString objname) {
 
     if (executableLaunchMode() == "") {
         return;
     }
 
+    _varObjRegistry->touch(objname);
+    _varObjRegistry->updateSent(expressionid);
+
     QString str = QString("%1-var-update --all-values \"%2\"").arg(expressionid).arg(objname);
 
     handleGdbCommand(str);
@@ -2313,6 +2512,8 @@ void SeerGdbWidget::handleGdbVarObjAssign (int expressionid, QString objname, QS
         return;
     }
 
+    _varObjRegistry->touch(objname);
+
     QString str = QString("%1-var-assign \"%2\" %3").arg(expressionid).arg(objname).arg(value);
 
     handleGdbCommand(str);
@@ -2320,6 +2521,9 @@ void SeerGdbWidget::handleGdbVarObjAssign (int expressionid, QString objname, QS
 
 void SeerGdbWidget::handleGdbVarObjDelete (int expressionid, QString objname) {
 
+    // Forget it even if gdb isn't there to delete it.
+    _varObjRegistry->release(objname);
+
     if (executableLaunchMode() == "") {
         return;
     }
@@ -2329,6 +2533,51 @@ void SeerGdbWidget::handleGdbVarObjDelete (int expressionid, QString objname) {
     handleGdbCommand(str);
 }
 
+void SeerGdbWidget::handleGdbVarObjDeleteChildren (int expressionid, QString objname) {
+
+    _varObjRegistry->releaseChildren(objname);
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    // Deletes the children, but not the varobj itself.
+    QString str = QString("%1-var-delete -c \"%2\"").arg(expressionid).arg(objname);
+
+    handleGdbCommand(str);
+}
+
+void SeerGdbWidget::handleGdbVarObjUpdateAll (int expressionid) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    _varObjRegistry->touchOwner(sender());
+    _varObjRegistry->updateSent(expressionid);
+
+    // Only the varobjs that aren't frozen. See handleGdbVarObjFreeze().
+    QString str = QString("%1-var-update --all-values *").arg(expressionid);
+
+    handleGdbCommand(str);
+}
+
+void SeerGdbWidget::handleGdbVarObjFreeze (QString objname) {
+
+    //
+    // The variable tracker updates its varobjs with "-var-update *". That would
+    // take the changes of everyone else's varobjs too. A frozen varobj is left out.
+    // It, and its children, are only updated when asked for by name.
+    //
+    // The registry asks for this once gdb has made the varobj, so it can't fail.
+    //
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    handleGdbCommand(QString("-var-set-frozen \"%1\" 1").arg(objname));
+}
+
 void SeerGdbWidget::handleGdbVarObjAttributes (int objid, QString objname) {
 
     if (executableLaunchMode() == "") {
@@ -2346,9 +2595,20 @@ void SeerGdbWidget::handleGdbDataListValues () {
         return;
     }
 
-    for (int i=0; i<_dataExpressionId.size(); i++) {
-        handleGdbCommand(QString::number(_dataExpressionId[i]) + "-data-evaluate-expression \"" + _dataExpressionName[i] + "\"");
+    // The tracker keeps a varobj for each expression. It asks for all of them in one update.
+    variableManagerWidget->variableTrackerBrowserWidget()->refreshValues();
+}
+
+void SeerGdbWidget::handleGdbDataCreateVarObj (int expressionid, QString objname, QString expression) {
+
+    if (executableLaunchMode() == "") {
+        return;
     }
+
+    _varObjRegistry->add(sender(), expressionid, objname, expression);
+
+    // Floating, and not frozen, so "-var-update *" re-evaluates it in the selected frame.
+    handleGdbCommand(QString("%1-var-create %2 @ \"%3\"").arg(expressionid).arg(objname).arg(expression));
 }
 
 void SeerGdbWidget::handleGdbDataListExpressions () {
@@ -2542,10 +2802,13 @@ void SeerGdbWidget::handleGdbVarAddExpression (QString expression) {
     QObject::connect(_gdbMonitor,  &GdbMonitor::astrixTextOutput,                            w,    &SeerVarVisualizerWidget::handleText);
     QObject::connect(_gdbMonitor,  &GdbMonitor::caretTextOutput,                             w,    &SeerVarVisualizerWidget::handleText);
     QObject::connect(w,            &SeerVarVisualizerWidget::varObjCreate,                   this, &SeerGdbWidget::handleGdbVarObjCreate);
-    QObject::connect(w,            &SeerVarVisualizerWidget::varObjListChildren,             this, &SeerGdbWidget::handleGdbVarObjListChildren);
+    QObject::connect(w,            &SeerVarVisualizerWidget::varObjListChildrenRange,        this, &SeerGdbWidget::handleGdbVarObjListChildrenRange);
+    QObject::connect(w,            &SeerVarVisualizerWidget::varObjSetUpdateRange,           this, &SeerGdbWidget::handleGdbVarObjSetUpdateRange);
     QObject::connect(w,            &SeerVarVisualizerWidget::varObjUpdate,                   this, &SeerGdbWidget::handleGdbVarObjUpdate);
     QObject::connect(w,            &SeerVarVisualizerWidget::varObjAssign,                   this, &SeerGdbWidget::handleGdbVarObjAssign);
     QObject::connect(w,            &SeerVarVisualizerWidget::varObjDelete,                   this, &SeerGdbWidget::handleGdbVarObjDelete);
+    QObject::connect(w,            &SeerVarVisualizerWidget::varObjDeleteChildren,           this, &SeerGdbWidget::handleGdbVarObjDeleteChildren);
+    QObject::connect(_varObjRegistry, &SeerVarObjRegistry::evicted,                          w,    &SeerVarVisualizerWidget::handleVarObjEvicted);
     QObject::connect(w,            &SeerVarVisualizerWidget::varObjAttributes,               this, &SeerGdbWidget::handleGdbVarObjAttributes);
     QObject::connect(w,            &SeerVarVisualizerWidget::addMemoryVisualize,             this, &SeerGdbWidget::handleGdbMemoryAddExpression);
     QObject::connect(w,            &SeerVarVisualizerWidget::addArrayVisualize,              this, &SeerGdbWidget::handleGdbArrayAddExpression);
@@ -2613,7 +2876,7 @@ void SeerGdbWidget::handleGdbGetAssembly (QString address) {
 
     QString command;
 
-    if (assemblyDisassemblyMode() == "length") {
+    if (assemblyDisassemblyMode() == "length" || assemblyDisassemblyMode() == "window") {
         command = QString("-data-disassemble -s \"%1\" -e \"%1 + %2\" -- 2").arg(address).arg(assemblyDisassemblyBytes());
     }else if (assemblyDisassemblyMode() == "function") {
         command = QString("-data-disassemble -a \"%1\" -- 2").arg(address);
@@ -2636,7 +2899,7 @@ void SeerGdbWidget::handleGdbGetSourceAndAssembly (QString address) {
 
     QString command;
 
-    if (assemblyDisassemblyMode() == "length") {
+    if (assemblyDisassemblyMode() == "length" || assemblyDisassemblyMode() == "window") {
         command = QString("-data-disassemble -s \"%1\" -e \"%1 + %2\" -- 5").arg(address).arg(assemblyDisassemblyBytes());
     }else if (assemblyDisassemblyMode() == "function") {
         command = QString("-data-disassemble -a \"%1\" -- 5").arg(address);
@@ -2649,6 +2912,26 @@ void SeerGdbWidget::handleGdbGetSourceAndAssembly (QString address) {
     handleGdbCommand(command);
 }
 
+void SeerGdbWidget::handleGdbGetSourceAndAssemblyRange (int id, QString address, int count) {
+
+    // More of a windowed assembly listing. Same as the asm visualizer, with source lines.
+    handleGdbAsmEvaluateExpression(id, address, count, 5);
+}
+
+void SeerGdbWidget::handleGdbSourceLines (int id, QString fullname) {
+
+    if (executableLaunchMode() == "") {
+        return;
+    }
+
+    if (fullname == "") {
+        return;
+    }
+
+    // The line table. Every address in it starts an instruction.
+    handleGdbCommand(QString("%1-symbol-list-lines \"%2\"").arg(id).arg(fullname));
+}
+
 void SeerGdbWidget::handleGdbMemoryVisualizer () {
 
     handleGdbMemoryAddExpression("");
@@ -2909,11 +3192,20 @@ void SeerGdbWidget::writeSettings () {
     } settings.endGroup();
 
     settings.beginGroup("gdboutputlog"); {
-        settings.setValue("enabled", isGdbOutputLogEnabled());
+        settings.setValue("enabled",     isGdbOutputLogEnabled());
+        settings.setValue("memorylimit", _gdbOutputLog->memoryLimit());
     } settings.endGroup();
 
     settings.beginGroup("seeroutputlog"); {
-        settings.setValue("enabled", isSeerOutputLogEnabled());
+        settings.setValue("enabled",     isSeerOutputLogEnabled());
+        settings.setValue("memorylimit", _seerOutputLog->memoryLimit());
+    } settings.endGroup();
+
+    settings.beginGroup("sessionlog"); {
+        settings.setValue("enabled",     _sessionLogEnabled);
+        settings.setValue("directory",   _sessionLogDirectory);
+        settings.setValue("maxfilesize", _sessionLog->maxFileSize());
+        settings.setValue("maxfiles",    _sessionLog->maxFiles());
     } settings.endGroup();
 }
 
@@ -3026,11 +3318,31 @@ void SeerGdbWidget::readSettings () {
 
     settings.beginGroup("gdboutputlog"); {
         setGdbOutputLogEnabled(settings.value("enabled", true).toBool());
+        _gdbOutputLog->setMemoryLimit(settings.value("memorylimit", 16).toInt()); // Megabytes.
     } settings.endGroup();
 
     settings.beginGroup("seeroutputlog"); {
         setSeerOutputLogEnabled(settings.value("enabled", false).toBool());
+        _seerOutputLog->setMemoryLimit(settings.value("memorylimit", 16).toInt()); // Megabytes.
     } settings.endGroup();
+
+    settings.beginGroup("sessionlog"); {
+        _sessionLogEnabled   = settings.value("enabled", false).toBool();
+        _sessionLogDirectory = settings.value("directory", SeerSessionLog::defaultDirectory()).toString();
+        _sessionLog->setMaxFileSize(settings.value("maxfilesize", 64).toInt()); // Megabytes per file.
+        _sessionLog->setMaxFiles(settings.value("maxfiles", 5).toInt());        // Files kept per log.
+    } settings.endGroup();
+
+    // SEER_SESSION_LOG=<directory> turns the session log on for this run, without changing the settings.
+    QString sessionLogDirectory = qEnvironmentVariable("SEER_SESSION_LOG");
+
+    if (sessionLogDirectory != "") {
+        _sessionLog->setDirectory(sessionLogDirectory);
+        _sessionLog->setEnabled(true);
+    }else{
+        _sessionLog->setDirectory(_sessionLogDirectory);
+        _sessionLog->setEnabled(_sessionLogEnabled);
+    }
 }
 
 void SeerGdbWidget::resetDprintf () {
@@ -3113,6 +3425,9 @@ bool SeerGdbWidget::startGdb () {
     env.insert("LANG", "C");
     _gdbProcess->setProcessEnvironment(env);
 
+    // A new gdb has no varobjs.
+    _varObjRegistry->clear();
+
     // Start the gdb process.
     _gdbProcess->start();
 
@@ -3160,6 +3475,9 @@ bool SeerGdbWidget::startGdbRR () {
     env.insert("LANG", "C");
     _gdbProcess->setProcessEnvironment(env);
 
+    // A new gdb has no varobjs.
+    _varObjRegistry->clear();
+
     // Start the gdb process.
     _gdbProcess->start();
 
@@ -3201,6 +3519,8 @@ void SeerGdbWidget::createConsole () {
         setConsoleMode(consoleMode());
         setConsoleScrollLines(consoleScrollLines());
 
+        _consoleWidget->setSessionLog(_sessionLog);
+
         // Connect window title changes.
         QObject::connect(this, &SeerGdbWidget::changeWindowTitle,    _consoleWidget, &SeerConsoleWidget::handleChangeWindowTitle);
     }
@@ -3526,8 +3846,17 @@ QString SeerGdbWidget::assemblyRegisterFormat () const {
 
 void SeerGdbWidget::setAssemblyDisassemblyMode (const QString& mode, int bytes) {
 
+    bool changed = (mode != _assemblyDisassemblyMode || bytes != _assemblyDisassemblyBytes);
+
     _assemblyDisassemblyMode  = mode;
     _assemblyDisassemblyBytes = bytes;
+
+    // The assembly tab extends a windowed listing by itself.
+    editorManager()->setAssemblyDisassemblyWindow(_assemblyDisassemblyMode == "window" ? _assemblyDisassemblyBytes : 0);
+
+    if (changed && isGdbRuning()) {
+        emit assemblyConfigChanged();
+    }
 }
 
 QString SeerGdbWidget::assemblyDisassemblyMode () const {
@@ -3561,6 +3890,11 @@ bool SeerGdbWidget::isSeerOutputLogEnabled () const {
     return _seerOutputLog->isLogEnabled();
 }
 
+SeerSessionLog* SeerGdbWidget::sessionLog () {
+
+    return _sessionLog;
+}
+
 void SeerGdbWidget::sendGdbInterrupt (int signal) {
 
     //qDebug() << "Sending an interrupt to the program. Signal =" << signal;
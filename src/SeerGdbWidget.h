@@ -10,6 +10,8 @@
 #include "SeerCatchpointsBrowserWidget.h"
 #include "SeerPrintpointsBrowserWidget.h"
 #include "GdbMonitor.h"
+#include "SeerSessionLog.h"
+#include "SeerVarObjRegistry.h"
 #include <QtCore/QProcess>
 #include <QtCore/QVector>
 #include <QtWidgets/QWidget>
@@ -184,6 +186,8 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         void                                setSeerOutputLogEnabled             (bool flag);
         bool                                isSeerOutputLogEnabled              () const;
 
+        SeerSessionLog*                     sessionLog                          ();
+
         // RR settings.
         void                                setRRProgram                        (const QString& program);
         QString                             rrProgram                           () const;
@@ -268,9 +272,13 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         void                                handleGdbExecutablePostCommands     ();
         void                                handleGdbTtyDeviceName              ();
         void                                handleGdbStackListFrames            ();
+        void                                handleGdbStackListFramesRange       (int id, int low, int high);
         void                                handleGdbStackSelectFrame           (int frameno);
-        void                                handleGdbStackListLocals            ();
-        void                                handleGdbStackListArguments         ();
+        void                                handleGdbStackListLocals            (int id);
+        void                                handleGdbStackListArguments         (int id);
+        void                                handleGdbStackListLocalNames        (int id);
+        void                                handleGdbStackListArgumentNames     (int id);
+        void                                handleGdbVarObjCreateInFrame        (int id, QString objname, int frame, QString expression);
         void                                handleGdbGenericpointList           ();
         void                                handleGdbBreakpointDelete           (QString breakpoints);
         void                                handleGdbBreakpointEnable           (QString breakpoints);
@@ -294,24 +302,31 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         void                                handleGdbPrintpointEnable           (QString breakpoints);
         void                                handleGdbPrintpointDisable          (QString breakpoints);
         void                                handleGdbPrintpointInsert           (QString printpoint);
-        void                                handleGdbThreadListFrames           ();
+        void                                handleGdbThreadInfo                 (int id, int threadid);
         void                                handleGdbThreadListIds              ();
         void                                handleGdbThreadListGroups           ();
         void                                handleGdbThreadSelectId             (int threadid);
         void                                handleGdbAdaListTasks               ();
         void                                handleGdbAdaListExceptions          ();
         void                                handleGdbRegisterListNames          ();
-        void                                handleGdbRegisterListValues         (QString fmt);
+        void                                handleGdbRegisterListValues         (int id, QString fmt, QString numbers);
+        void                                handleGdbRegisterListChanged        (int id);
         void                                handleGdbRegisterSetValue           (QString fmt, QString name, QString value);
         void                                handleGdbDataEvaluateExpression     (int expressionid, QString expression);
         void                                handleGdbVarObjCreate               (int expressionid, QString expression);
         void                                handleGdbVarObjListChildren         (int expressionid, QString objname);
+        void                                handleGdbVarObjListChildrenRange    (int expressionid, QString objname, int from, int to);
+        void                                handleGdbVarObjSetUpdateRange       (int expressionid, QString objname, int from, int to);
         void                                handleGdbVarObjUpdate               (int expressionid, QString objname);
+        void                                handleGdbVarObjUpdateAll            (int expressionid);
         void                                handleGdbVarObjAssign               (int expressionid, QString objname, QString value);
         void                                handleGdbVarObjDelete               (int expressionid, QString objname);
+        void                                handleGdbVarObjDeleteChildren       (int expressionid, QString objname);
         void                                handleGdbVarObjAttributes           (int objid,        QString objname);
+        void                                handleGdbVarObjFreeze               (QString objname);
         void                                handleGdbDataListValues             ();
         void                                handleGdbDataListExpressions        ();
+        void                                handleGdbDataCreateVarObj           (int expressionid, QString objname, QString expression);
         void                                handleGdbDataAddExpression          (QString expression);
         void                                handleGdbDataDeleteExpressions      (QString expressionids);
         void                                handleGdbMemoryAddExpression        (QString expression);
@@ -324,6 +339,8 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         void                                handleGdbArrayEvaluateExpression    (int expressionid, QString address, int count);
         void                                handleGdbGetAssembly                (QString address);
         void                                handleGdbGetSourceAndAssembly       (QString address);
+        void                                handleGdbGetSourceAndAssemblyRange  (int id, QString address, int count);
+        void                                handleGdbSourceLines                (int id, QString fullname);
         void                                handleGdbMemoryVisualizer           ();
         void                                handleGdbArrayVisualizer            ();
         void                                handleGdbStructVisualizer           ();
@@ -346,6 +363,8 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
 
     signals:
         void                                stoppingPointReached                ();
+        void                                selectedThreadChanged               (int threadid);
+        void                                selectedFrameChanged                (int threadid, int frameno);
         void                                changeWindowTitle                   (QString title);
         void                                assemblyConfigChanged               ();
         void                                recordSettingsChanged               ();
@@ -406,6 +425,7 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
         QStringList                         _executablePreGdbCommands;
         QStringList                         _executablePostGdbCommands;
         bool                                _newExecutableFlag;
+        int                                 _currentThread;
         int                                 _currentFrame;
 
         SeerConsoleWidget*                  _consoleWidget;
@@ -422,6 +442,10 @@ class SeerGdbWidget : public QWidget, protected Ui::SeerGdbWidgetForm {
 
         GdbMonitor*                         _gdbMonitor;
         QProcess*                           _gdbProcess;
+        SeerSessionLog*                     _sessionLog;
+        SeerVarObjRegistry*                 _varObjRegistry;
+        bool                                _sessionLogEnabled;
+        QString                             _sessionLogDirectory;
 
         QVector<int>                        _dataExpressionId;
         QVector<QString>                    _dataExpressionName;
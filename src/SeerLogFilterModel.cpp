@@ -0,0 +1,149 @@
+#include "SeerLogFilterModel.h"
+#include <QtCore/QDebug>
+#include <algorithm>
+
+SeerLogFilterModel::SeerLogFilterModel (QObject* parent) : QAbstractListModel(parent) {
+
+    _sourceModel = 0;
+    _token       = -1;
+    _scanned     = 0;
+}
+
+SeerLogFilterModel::~SeerLogFilterModel () {
+}
+
+int SeerLogFilterModel::rowCount (const QModelIndex& parent) const {
+
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return _matches.size();
+}
+
+QVariant SeerLogFilterModel::data (const QModelIndex& index, int role) const {
+
+    if (index.isValid() == false || index.row() >= _matches.size()) {
+        return QVariant();
+    }
+
+    int row = sourceRow(index.row());
+
+    if (row < 0) {
+        return QVariant();
+    }
+
+    return _sourceModel->data(_sourceModel->index(row), role);
+}
+
+void SeerLogFilterModel::setSourceModel (SeerLogModel* model) {
+
+    if (_sourceModel) {
+        QObject::disconnect(_sourceModel, 0, this, 0);
+    }
+
+    _sourceModel = model;
+
+    if (_sourceModel) {
+        QObject::connect(_sourceModel, &SeerLogModel::rowsInserted,  this, &SeerLogFilterModel::handleRowsInserted);
+        QObject::connect(_sourceModel, &SeerLogModel::rowsRemoved,   this, &SeerLogFilterModel::handleRowsRemoved);
+        QObject::connect(_sourceModel, &SeerLogModel::modelReset,    this, &SeerLogFilterModel::handleModelReset);
+    }
+
+    refilter();
+}
+
+SeerLogModel* SeerLogFilterModel::sourceModel () const {
+
+    return _sourceModel;
+}
+
+void SeerLogFilterModel::setFilter (const QString& pattern, const QByteArray& types, int token) {
+
+    if (pattern == _pattern && types == _types && token == _token) {
+        return;
+    }
+
+    _pattern = pattern;
+    _types   = types;
+    _token   = token;
+
+    refilter();
+}
+
+bool SeerLogFilterModel::isActive () const {
+
+    return _pattern.isEmpty() == false || _types.isEmpty() == false || _token >= 0;
+}
+
+int SeerLogFilterModel::sourceRow (int row) const {
+
+    if (_sourceModel == 0 || row < 0 || row >= _matches.size()) {
+        return -1;
+    }
+
+    return _sourceModel->sequenceRow(_matches[row]);
+}
+
+void SeerLogFilterModel::handleRowsInserted () {
+
+    if (isActive() == false) {
+        return;
+    }
+
+    // Only look at the lines that are new.
+    QVector<quint32> matches = _sourceModel->search(_pattern, _types, _token, _scanned);
+
+    _scanned = _sourceModel->endSequence();
+
+    if (matches.isEmpty()) {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), _matches.size(), _matches.size() + matches.size() - 1);
+
+    _matches += matches;
+
+    endInsertRows();
+}
+
+void SeerLogFilterModel::handleRowsRemoved () {
+
+    if (isActive() == false) {
+        return;
+    }
+
+    // The log dropped its oldest lines. Drop their matches.
+    int drop = int(std::lower_bound(_matches.begin(), _matches.end(), _sourceModel->firstSequence()) - _matches.begin());
+
+    if (drop == 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), 0, drop - 1);
+
+    _matches.remove(0, drop);
+
+    endRemoveRows();
+}
+
+void SeerLogFilterModel::handleModelReset () {
+
+    refilter();
+}
+
+void SeerLogFilterModel::refilter () {
+
+    beginResetModel();
+
+    _matches.clear();
+    _scanned = 0;
+
+    if (_sourceModel && isActive()) {
+        _matches = _sourceModel->search(_pattern, _types, _token, 0);
+        _scanned = _sourceModel->endSequence();
+    }
+
+    endResetModel();
+}
+
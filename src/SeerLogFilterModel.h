@@ -0,0 +1,50 @@
+#pragma once
+
+#include "SeerLogModel.h"
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QModelIndex>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+//
+// The lines of a SeerLogModel that match a filter.
+//
+// Holds only the sequence numbers of the matching lines. The filter is run
+// once over the log's index when it changes. After that, only lines added
+// since are looked at. Matches are removed as the log drops their lines.
+//
+class SeerLogFilterModel : public QAbstractListModel {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerLogFilterModel (QObject* parent = 0);
+       ~SeerLogFilterModel ();
+
+        int                                 rowCount                (const QModelIndex& parent = QModelIndex()) const override;
+        QVariant                            data                    (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+        void                                setSourceModel          (SeerLogModel* model);
+        SeerLogModel*                       sourceModel             () const;
+        void                                setFilter               (const QString& pattern, const QByteArray& types, int token);
+        bool                                isActive                () const;
+        int                                 sourceRow               (int row) const;
+
+    private slots:
+        void                                handleRowsInserted      ();
+        void                                handleRowsRemoved       ();
+        void                                handleModelReset        ();
+
+    private:
+        void                                refilter                ();
+
+        SeerLogModel*                       _sourceModel;
+        QString                             _pattern;
+        QByteArray                          _types;
+        int                                 _token;
+        QVector<quint32>                    _matches;               // Sequence numbers, ascending.
+        quint32                             _scanned;               // Lines before this sequence number have been looked at.
+};
+
@@ -0,0 +1,517 @@
+#include "SeerLogModel.h"
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+SeerLogModel::SeerLogModel (QObject* parent) : QAbstractListModel(parent) {
+
+    _head          = 0;
+    _count         = 0;
+    _firstSequence = 0;
+    _memoryUsed    = 0;
+    _memoryLimit   = 16 * 1024 * 1024;
+    _droppedLines  = 0;
+    _livePostings  = 0;
+    _deadPostings  = 0;
+
+    _gramPostings.resize(GramBuckets);
+}
+
+SeerLogModel::~SeerLogModel () {
+}
+
+int SeerLogModel::rowCount (const QModelIndex& parent) const {
+
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return _count;
+}
+
+QVariant SeerLogModel::data (const QModelIndex& index, int role) const {
+
+    if (index.isValid() == false || index.row() >= _count) {
+        return QVariant();
+    }
+
+    if (role == Qt::DisplayRole) {
+        return line(index.row());
+    }
+
+    if (role == Qt::ToolTipRole) {
+        return QDateTime::fromMSecsSinceEpoch(lineTime(index.row())).toString("hh:mm:ss.zzz");
+    }
+
+    return QVariant();
+}
+
+void SeerLogModel::appendLines (const QStringList& lines, const QByteArray& types, const QVector<qint64>& times) {
+
+    if (lines.size() == 0) {
+        return;
+    }
+
+    //
+    // Only the newest lines of the batch fit, if it is bigger than the limit by itself.
+    // A line's index isn't built yet, so count the most postings it could add.
+    //
+    int    first  = lines.size();
+    qint64 memory = 0;
+
+    while (first > 0) {
+
+        qint64 m = lineMemory(lines[first-1], qMax(lines[first-1].size() - 2, 0));
+
+        if (memory + m > _memoryLimit) {
+            break;
+        }
+
+        first--;
+        memory += m;
+    }
+
+    _droppedLines += first;
+
+    int count = lines.size() - first;
+
+    if (count == 0) {
+        return;
+    }
+
+    //
+    // Index the lines. Sequence numbers carry on from the newest line, whatever
+    // gets dropped to make room.
+    //
+    QVector<Record> records(count);
+
+    memory = 0;
+
+    for (int i=0; i<count; i++) {
+
+        const QString& line     = lines[first+i];
+        quint32        sequence = endSequence() + quint32(i);
+        Record&        record   = records[i];
+
+        record.time  = times[first+i];
+        record.token = -1;
+        record.type  = types[first+i];
+
+        if (record.type == 0) {
+            classify(line, record.type, record.token);
+        }
+
+        if (record.token >= 0) {
+            _tokenPostings[record.token].append(sequence);
+            _livePostings++;
+        }
+
+        record.grams = indexLine(line, sequence);
+
+        memory += lineMemory(line, record.grams);
+    }
+
+    // Make room by dropping the oldest lines.
+    dropLines(memory);
+
+    // Add the rest.
+    reserveLines(_count + count);
+
+    beginInsertRows(QModelIndex(), _count, _count + count - 1);
+
+    for (int i=0; i<count; i++) {
+        int slot = (_head + _count) % _ring.size();
+
+        _ring[slot]    = lines[first+i];
+        _records[slot] = records[i];
+        _count++;
+    }
+
+    _memoryUsed += memory;
+
+    endInsertRows();
+}
+
+void SeerLogModel::clear () {
+
+    beginResetModel();
+
+    _ring.clear();
+    _records.clear();
+    _head          = 0;
+    _count         = 0;
+    _firstSequence = 0;
+    _memoryUsed    = 0;
+    _droppedLines  = 0;
+
+    _gramPostings.clear();
+    _gramPostings.resize(GramBuckets);
+    _tokenPostings.clear();
+    _livePostings  = 0;
+    _deadPostings  = 0;
+
+    endResetModel();
+}
+
+const QString& SeerLogModel::line (int row) const {
+
+    return _ring[(_head + row) % _ring.size()];
+}
+
+char SeerLogModel::lineType (int row) const {
+
+    return _records[(_head + row) % _records.size()].type;
+}
+
+int SeerLogModel::lineToken (int row) const {
+
+    return _records[(_head + row) % _records.size()].token;
+}
+
+qint64 SeerLogModel::lineTime (int row) const {
+
+    return _records[(_head + row) % _records.size()].time;
+}
+
+QString SeerLogModel::text () const {
+
+    QString str;
+
+    for (int row=0; row<_count; row++) {
+        str += line(row);
+        str += '\n';
+    }
+
+    return str;
+}
+
+quint32 SeerLogModel::firstSequence () const {
+
+    return _firstSequence;
+}
+
+quint32 SeerLogModel::endSequence () const {
+
+    return _firstSequence + quint32(_count);
+}
+
+int SeerLogModel::sequenceRow (quint32 sequence) const {
+
+    if (sequence < _firstSequence || sequence >= endSequence()) {
+        return -1;
+    }
+
+    return int(sequence - _firstSequence);
+}
+
+QVector<quint32> SeerLogModel::search (const QString& pattern, const QByteArray& types, int token, quint32 from) const {
+
+    //
+    // Returns the sequence numbers, from 'from' on, of the lines that contain 'pattern'
+    // (ignoring case), are one of 'types' and have 'token'. An empty pattern, an empty
+    // list of types or a token of -1 matches any line.
+    //
+    from = qMax(from, _firstSequence);
+
+    quint32          end = endSequence();
+    QVector<quint32> candidates;
+    bool             scanAll = false;
+
+    if (from >= end) {
+        return QVector<quint32>();
+    }
+
+    if (token >= 0) {
+
+        // Few lines have the same token. Start from those.
+        QHash<int,QVector<quint32>>::const_iterator it = _tokenPostings.constFind(token);
+
+        if (it == _tokenPostings.constEnd()) {
+            return QVector<quint32>();
+        }
+
+        const QVector<quint32>& postings = it.value();
+
+        candidates = postings.mid(int(std::lower_bound(postings.begin(), postings.end(), from) - postings.begin()));
+
+    }else if (pattern.size() >= 3) {
+
+        // Start from the shortest posting list of the pattern's trigrams. Keep the lines that are in the others.
+        QVector<int> buckets;
+
+        for (int i=2; i<pattern.size(); i++) {
+            buckets.append(gramBucket(pattern[i-2].toCaseFolded(), pattern[i-1].toCaseFolded(), pattern[i].toCaseFolded()));
+        }
+
+        std::sort(buckets.begin(), buckets.end());
+        buckets.erase(std::unique(buckets.begin(), buckets.end()), buckets.end());
+
+        int shortest     = -1;
+        int shortestSize = 0;
+
+        for (int i=0; i<buckets.size(); i++) {
+
+            const QVector<quint32>& postings = _gramPostings[buckets[i]];
+
+            int size = int(postings.end() - std::lower_bound(postings.begin(), postings.end(), from));
+
+            if (size == 0) {
+                return QVector<quint32>();
+            }
+
+            if (shortest < 0 || size < shortestSize) {
+                shortest     = i;
+                shortestSize = size;
+            }
+        }
+
+        const QVector<quint32>& postings = _gramPostings[buckets[shortest]];
+
+        candidates = postings.mid(int(std::lower_bound(postings.begin(), postings.end(), from) - postings.begin()));
+
+        for (int i=0; i<buckets.size() && candidates.size() > 0; i++) {
+
+            if (i == shortest) {
+                continue;
+            }
+
+            const QVector<quint32>& other = _gramPostings[buckets[i]];
+
+            QVector<quint32>::const_iterator begin = std::lower_bound(other.begin(), other.end(), from);
+            QVector<quint32>                 kept;
+
+            for (int c=0; c<candidates.size(); c++) {
+                begin = std::lower_bound(begin, other.end(), candidates[c]);
+
+                if (begin == other.end()) {
+                    break;
+                }
+
+                if (*begin == candidates[c]) {
+                    kept.append(candidates[c]);
+                }
+            }
+
+            candidates.swap(kept);
+        }
+
+    }else{
+        scanAll = true;
+    }
+
+    // Check each candidate line. The trigrams can match where the text doesn't.
+    QVector<quint32> matches;
+
+    int n = (scanAll ? int(end - from) : candidates.size());
+
+    for (int i=0; i<n; i++) {
+
+        quint32       sequence = (scanAll ? from + quint32(i) : candidates[i]);
+        int           slot     = (_head + int(sequence - _firstSequence)) % _ring.size();
+        const Record& record   = _records[slot];
+
+        if (types.isEmpty() == false && types.contains(record.type) == false) {
+            continue;
+        }
+
+        if (token >= 0 && record.token != token) {
+            continue;
+        }
+
+        if (pattern.isEmpty() == false && _ring[slot].contains(pattern, Qt::CaseInsensitive) == false) {
+            continue;
+        }
+
+        matches.append(sequence);
+    }
+
+    return matches;
+}
+
+void SeerLogModel::setMemoryLimit (qint64 bytes) {
+
+    _memoryLimit = qMax(bytes, qint64(64 * 1024));
+
+    // Drop lines until it fits.
+    dropLines(0);
+}
+
+qint64 SeerLogModel::memoryLimit () const {
+
+    return _memoryLimit;
+}
+
+qint64 SeerLogModel::memoryUsed () const {
+
+    return _memoryUsed;
+}
+
+qint64 SeerLogModel::droppedLines () const {
+
+    return _droppedLines;
+}
+
+void SeerLogModel::classify (const QString& line, char& type, int& token) {
+
+    // [token]type... as in "123^done" or "*stopped".
+    int i     = 0;
+    int value = 0;
+
+    while (i < line.size() && i < 9 && line[i].isDigit()) {
+        value = value * 10 + line[i].digitValue();
+        i++;
+    }
+
+    token = (i > 0 ? value : -1);
+    type  = 0;
+
+    if (i < line.size()) {
+
+        char c = line[i].toLatin1();
+
+        if (c == '^' || c == '*' || c == '+' || c == '=' || c == '~' || c == '@' || c == '&') {
+            type = c;
+        }
+    }
+}
+
+qint64 SeerLogModel::lineMemory (const QString& line, int grams) {
+
+    // The characters, plus about what QString keeps besides them, plus the line's share of the index.
+    return qint64(line.size()) * qint64(sizeof(QChar)) + 32 + qint64(sizeof(Record)) + qint64(grams) * qint64(sizeof(quint32));
+}
+
+int SeerLogModel::gramBucket (QChar c0, QChar c1, QChar c2) {
+
+    quint32 h = quint32(c0.unicode()) * 0x9E3779B1u ^ quint32(c1.unicode()) * 0x85EBCA77u ^ quint32(c2.unicode()) * 0xC2B2AE3Du;
+
+    return int((h >> 16) & quint32(GramBuckets - 1));
+}
+
+int SeerLogModel::indexLine (const QString& line, quint32 sequence) {
+
+    // Add the line to the posting list of each of its trigrams, once.
+    if (line.size() < 3) {
+        return 0;
+    }
+
+    const QChar* data  = line.constData();
+    QChar        c0    = data[0].toCaseFolded();
+    QChar        c1    = data[1].toCaseFolded();
+    int          grams = 0;
+
+    for (int i=2; i<line.size(); i++) {
+
+        QChar c2 = data[i].toCaseFolded();
+
+        QVector<quint32>& postings = _gramPostings[gramBucket(c0, c1, c2)];
+
+        if (postings.isEmpty() || postings.last() != sequence) {
+            postings.append(sequence);
+            grams++;
+        }
+
+        c0 = c1;
+        c1 = c2;
+    }
+
+    _livePostings += grams;
+
+    return grams;
+}
+
+void SeerLogModel::compactIndex () {
+
+    // Remove the postings of dropped lines. They are at the front of each list.
+    for (int b=0; b<_gramPostings.size(); b++) {
+
+        QVector<quint32>& postings = _gramPostings[b];
+
+        if (postings.isEmpty() || postings.first() >= _firstSequence) {
+            continue;
+        }
+
+        postings.erase(postings.begin(), std::lower_bound(postings.begin(), postings.end(), _firstSequence));
+        postings.squeeze();
+    }
+
+    QHash<int,QVector<quint32>>::iterator it = _tokenPostings.begin();
+
+    while (it != _tokenPostings.end()) {
+
+        QVector<quint32>& postings = it.value();
+
+        postings.erase(postings.begin(), std::lower_bound(postings.begin(), postings.end(), _firstSequence));
+
+        if (postings.isEmpty()) {
+            it = _tokenPostings.erase(it);
+        }else{
+            ++it;
+        }
+    }
+
+    _deadPostings = 0;
+}
+
+void SeerLogModel::dropLines (qint64 memory) {
+
+    // Drop the oldest lines until 'memory' more fits under the limit.
+    int drop = 0;
+
+    for (qint64 used = _memoryUsed; drop < _count && used + memory > _memoryLimit; drop++) {
+        int slot = (_head + drop) % _ring.size();
+
+        used -= lineMemory(_ring[slot], _records[slot].grams);
+    }
+
+    if (drop == 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), 0, drop - 1);
+
+    for (int i=0; i<drop; i++) {
+
+        const Record& record   = _records[_head];
+        qint64        postings = record.grams + (record.token >= 0 ? 1 : 0);
+
+        _memoryUsed   -= lineMemory(_ring[_head], record.grams);
+        _livePostings -= postings;
+        _deadPostings += postings;
+
+        _ring[_head] = QString();
+        _head = (_head + 1) % _ring.size();
+        _count--;
+        _firstSequence++;
+    }
+
+    endRemoveRows();
+
+    _droppedLines += drop;
+
+    // Dropped lines are still in the index. Clear them out once they outnumber the rest.
+    if (_deadPostings > _livePostings) {
+        compactIndex();
+    }
+}
+
+void SeerLogModel::reserveLines (int count) {
+
+    if (count <= _ring.size()) {
+        return;
+    }
+
+    // Grow the ring. Lay the lines out from the start again.
+    QVector<QString> ring(qMax(count, qMax(1024, _ring.size() * 2)));
+    QVector<Record>  records(ring.size());
+
+    for (int row=0; row<_count; row++) {
+        ring[row]    = line(row);
+        records[row] = _records[(_head + row) % _records.size()];
+    }
+
+    _ring.swap(ring);
+    _records.swap(records);
+    _head = 0;
+}
+
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QtCore/QAbstractListModel>
+#include <QtCore/QModelIndex>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtCore/QHash>
+#include <QtCore/QStringList>
+#include <QtCore/QByteArray>
+#include <QtCore/QString>
+
+//
+// The lines of a log, kept in a ring buffer.
+//
+// The memory used by the lines is capped. When appending goes over the cap,
+// the oldest lines are dropped. Lines are appended in batches, so a view
+// only has to catch up once per batch.
+//
+// Each line is given a sequence number, which doesn't change as older lines
+// are dropped, and is indexed as it is added: its record type ('^', '*', '=',
+// '~', ...), its command token and when it arrived. Its text is indexed by
+// trigram, so a substring search only looks at lines that have all of the
+// pattern's trigrams.
+//
+class SeerLogModel : public QAbstractListModel {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerLogModel (QObject* parent = 0);
+       ~SeerLogModel ();
+
+        int                                 rowCount                (const QModelIndex& parent = QModelIndex()) const override;
+        QVariant                            data                    (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+        void                                appendLines             (const QStringList& lines, const QByteArray& types, const QVector<qint64>& times);
+        void                                clear                   ();
+        const QString&                      line                    (int row) const;
+        char                                lineType                (int row) const;
+        int                                 lineToken               (int row) const;
+        qint64                              lineTime                (int row) const;
+        QString                             text                    () const;
+
+        quint32                             firstSequence           () const;
+        quint32                             endSequence             () const;
+        int                                 sequenceRow             (quint32 sequence) const;
+        QVector<quint32>                    search                  (const QString& pattern, const QByteArray& types, int token, quint32 from) const;
+
+        void                                setMemoryLimit          (qint64 bytes);
+        qint64                              memoryLimit             () const;
+        qint64                              memoryUsed              () const;
+        qint64                              droppedLines            () const;
+
+        static void                         classify                (const QString& line, char& type, int& token);
+
+        static const int                    GramBuckets = 65536;    // Trigrams hash into this many posting lists.
+
+    private:
+        struct Record {
+            qint64                          time;
+            int                             token;
+            int                             grams;                  // Postings the line added to the trigram index.
+            char                            type;
+        };
+
+        static qint64                       lineMemory              (const QString& line, int grams);
+        static int                          gramBucket              (QChar c0, QChar c1, QChar c2);
+        int                                 indexLine               (const QString& line, quint32 sequence);
+        void                                compactIndex            ();
+        void                                dropLines               (qint64 memory);
+        void                                reserveLines            (int count);
+
+        QVector<QString>                    _ring;
+        QVector<Record>                     _records;               // Parallel to _ring.
+        int                                 _head;                  // Index of the oldest line.
+        int                                 _count;
+        quint32                             _firstSequence;         // Sequence number of the oldest line.
+        qint64                              _memoryUsed;
+        qint64                              _memoryLimit;
+        qint64                              _droppedLines;
+
+        QVector<QVector<quint32>>           _gramPostings;          // Sequence numbers, ascending, per trigram bucket.
+        QHash<int,QVector<quint32>>         _tokenPostings;         // Sequence numbers, ascending, per token.
+        qint64                              _livePostings;
+        qint64                              _deadPostings;          // Postings of dropped lines, not removed yet.
+};
+
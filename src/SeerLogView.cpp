@@ -0,0 +1,110 @@
+#include "SeerLogView.h"
+#include <QtWidgets/QScrollBar>
+#include <QtWidgets/QApplication>
+#include <QtGui/QClipboard>
+#include <QtGui/QPainter>
+#include <QtGui/QPalette>
+#include <QtGui/QKeySequence>
+#include <QtCore/QModelIndexList>
+#include <QtCore/QStringList>
+#include <algorithm>
+
+SeerLogView::SeerLogView (QWidget* parent) : QListView(parent) {
+
+    setSelectionMode(QAbstractItemView::ExtendedSelection);
+    setEditTriggers(QAbstractItemView::NoEditTriggers);
+    setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
+    setTextElideMode(Qt::ElideNone);
+
+    // All lines are the same height. The view doesn't have to measure them.
+    setUniformItemSizes(true);
+    setLayoutMode(QListView::Batched);
+    setBatchSize(1000);
+}
+
+SeerLogView::~SeerLogView () {
+}
+
+void SeerLogView::setPlaceholderText (const QString& text) {
+
+    _placeholderText = text;
+
+    viewport()->update();
+}
+
+const QString& SeerLogView::placeholderText () const {
+
+    return _placeholderText;
+}
+
+void SeerLogView::setWrapText (bool flag) {
+
+    // Wrapped lines have different heights.
+    setUniformItemSizes(flag == false);
+    setWordWrap(flag);
+}
+
+bool SeerLogView::wrapText () const {
+
+    return wordWrap();
+}
+
+bool SeerLogView::isAtEnd () const {
+
+    return verticalScrollBar()->value() == verticalScrollBar()->maximum();
+}
+
+void SeerLogView::copy () {
+
+    if (model() == 0) {
+        return;
+    }
+
+    // Copy the selected lines, in order.
+    QModelIndexList indexes = selectionModel()->selectedRows();
+
+    std::sort(indexes.begin(), indexes.end());
+
+    QStringList lines;
+
+    for (const QModelIndex& index : indexes) {
+        lines.append(index.data(Qt::DisplayRole).toString());
+    }
+
+    if (lines.size() == 0) {
+        return;
+    }
+
+    QApplication::clipboard()->setText(lines.join('\n'));
+}
+
+void SeerLogView::paintEvent (QPaintEvent* event) {
+
+    // Show the placeholder text when there are no lines, like the text editors do.
+    if ((model() == 0 || model()->rowCount() == 0) && _placeholderText != "") {
+
+        QPainter painter(viewport());
+
+        QColor color = palette().color(QPalette::Text);
+        color.setAlpha(128);
+
+        painter.setPen(color);
+        painter.drawText(viewport()->rect().adjusted(4, 4, -4, -4), Qt::AlignLeft | Qt::AlignTop, _placeholderText);
+
+        return;
+    }
+
+    QListView::paintEvent(event);
+}
+
+void SeerLogView::keyPressEvent (QKeyEvent* event) {
+
+    if (event == QKeySequence::Copy) {
+        copy();
+        event->accept();
+        return;
+    }
+
+    QListView::keyPressEvent(event);
+}
+
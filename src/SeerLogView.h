@@ -0,0 +1,37 @@
+#pragma once
+
+#include <QtWidgets/QListView>
+#include <QtWidgets/QWidget>
+#include <QtGui/QPaintEvent>
+#include <QtGui/QKeyEvent>
+#include <QtCore/QString>
+
+//
+// Shows the lines of a SeerLogModel. Only the visible lines are laid out
+// and painted, however many lines the model holds.
+//
+class SeerLogView : public QListView {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerLogView (QWidget* parent = 0);
+       ~SeerLogView ();
+
+        void                                setPlaceholderText      (const QString& text);
+        const QString&                      placeholderText         () const;
+        void                                setWrapText             (bool flag);
+        bool                                wrapText                () const;
+        bool                                isAtEnd                 () const;
+
+    public slots:
+        void                                copy                    ();
+
+    protected:
+        void                                paintEvent              (QPaintEvent* event) override;
+        void                                keyPressEvent           (QKeyEvent* event) override;
+
+    private:
+        QString                             _placeholderText;
+};
+
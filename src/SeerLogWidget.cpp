@@ -1,13 +1,17 @@
 #include "SeerLogWidget.h"
-#include <QtWidgets/QTextEdit>
 #include <QtWidgets/QCheckBox>
+#include <QtWidgets/QComboBox>
+#include <QtWidgets/QLineEdit>
 #include <QtWidgets/QFileDialog>
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QScrollBar>
 #include <QtPrintSupport/QPrinter>
 #include <QtPrintSupport/QPrintDialog>
 #include <QtGui/QFont>
+#include <QtGui/QTextDocument>
+#include <QtGui/QIntValidator>
 #include <QtCore/QTextStream>
+#include <QtCore/QDateTime>
 #include <QtCore/QDebug>
 
 SeerLogWidget::SeerLogWidget (QWidget* parent) : QWidget(parent) {
@@ -20,17 +24,48 @@ SeerLogWidget::SeerLogWidget (QWidget* parent) : QWidget(parent) {
     font.setFixedPitch(true);
     font.setStyleHint(QFont::TypeWriter);
 
-    textEdit->setReadOnly(true);
-    textEdit->setFont(font);
-    textEdit->setLineWrapMode(QTextEdit::NoWrap);   // No wrap
+    _logModel    = new SeerLogModel(this);
+    _filterModel = new SeerLogFilterModel(this);
+    _filterModel->setSourceModel(_logModel);
+
+    logView->setModel(_logModel);
+    logView->setFont(font);
+    logView->setWrapText(false);                    // No wrap
     wrapTextCheckBox->setCheckState(Qt::Unchecked); // No wrap
 
+    // Lines are added to the view at most once per frame.
+    _flushTimer = new QTimer(this);
+    _flushTimer->setSingleShot(true);
+    _flushTimer->setInterval(FlushInterval);
+
+    // Search once the typing stops.
+    _searchTimer = new QTimer(this);
+    _searchTimer->setSingleShot(true);
+    _searchTimer->setInterval(SearchInterval);
+
+    typeComboBox->addItem("All records",    "");
+    typeComboBox->addItem("Results (^)",    "^");
+    typeComboBox->addItem("Exec (*)",       "*");
+    typeComboBox->addItem("Notify (=)",     "=");
+    typeComboBox->addItem("Status (+)",     "+");
+    typeComboBox->addItem("Console (~)",    "~");
+    typeComboBox->addItem("Target (@)",     "@");
+    typeComboBox->addItem("Log (&)",        "&");
+
+    tokenLineEdit->setValidator(new QIntValidator(0, 999999999, this));
+
     // Connect things.
     QObject::connect(clearButton,       &QPushButton::clicked,      this,  &SeerLogWidget::handleClearButton);
     QObject::connect(printButton,       &QPushButton::clicked,      this,  &SeerLogWidget::handlePrintButton);
     QObject::connect(saveButton,        &QPushButton::clicked,      this,  &SeerLogWidget::handleSaveButton);
     QObject::connect(wrapTextCheckBox,  &QCheckBox::clicked,        this,  &SeerLogWidget::handleWrapTextCheckBox);
     QObject::connect(enableCheckBox,    &QCheckBox::clicked,        this,  &SeerLogWidget::handleEnableCheckBox);
+    QObject::connect(_flushTimer,       &QTimer::timeout,           this,  &SeerLogWidget::handleFlushTimer);
+    QObject::connect(searchLineEdit,    &QLineEdit::textChanged,    this,  &SeerLogWidget::handleSearchChanged);
+    QObject::connect(tokenLineEdit,     &QLineEdit::textChanged,    this,  &SeerLogWidget::handleSearchChanged);
+    QObject::connect(typeComboBox,      QOverload<int>::of(&QComboBox::currentIndexChanged), this, &SeerLogWidget::handleSearchTimer);
+    QObject::connect(_searchTimer,      &QTimer::timeout,           this,  &SeerLogWidget::handleSearchTimer);
+    QObject::connect(logView,           &SeerLogView::doubleClicked, this, &SeerLogWidget::handleLogViewDoubleClicked);
 }
 
 SeerLogWidget::~SeerLogWidget () {
@@ -38,8 +73,8 @@ SeerLogWidget::~SeerLogWidget () {
 
 void SeerLogWidget::processText (const QString& text) {
 
-    // Add text to the end of the document.
-    textEdit->append(text);
+    // Add text to the end of the log.
+    appendLine(text);
 }
 
 bool SeerLogWidget::isLogEnabled () const {
@@ -54,17 +89,35 @@ void SeerLogWidget::setLogEnabled (bool flag) {
 
 void SeerLogWidget::moveToEnd () {
 
-    // Move to the end and then to the beginning of that line.
-    QTextCursor cursor = textEdit->textCursor();
-    textEdit->moveCursor(QTextCursor::End,          QTextCursor::MoveAnchor);
-    textEdit->moveCursor(QTextCursor::StartOfBlock, QTextCursor::MoveAnchor);
-
-    textEdit->verticalScrollBar()->setValue(textEdit->verticalScrollBar()->maximum());
+    // Move to the last line.
+    logView->scrollToBottom();
 }
 
 void SeerLogWidget::setPlaceholderText (const QString& text) {
 
-    textEdit->setPlaceholderText(text);
+    logView->setPlaceholderText(text);
+}
+
+void SeerLogWidget::setMemoryLimit (int megabytes) {
+
+    _logModel->setMemoryLimit(qint64(megabytes) * 1024 * 1024);
+}
+
+int SeerLogWidget::memoryLimit () const {
+
+    return int(_logModel->memoryLimit() / (1024 * 1024));
+}
+
+void SeerLogWidget::appendLine (const QString& line, char type) {
+
+    // Hold on to it until the next frame. A type of 0 means the log works it out from the line.
+    _pendingLines.append(line);
+    _pendingTypes.append(type);
+    _pendingTimes.append(QDateTime::currentMSecsSinceEpoch());
+
+    if (_flushTimer->isActive() == false) {
+        _flushTimer->start();
+    }
 }
 
 void SeerLogWidget::handleText (const QString& text) {
@@ -74,15 +127,121 @@ void SeerLogWidget::handleText (const QString& text) {
         return;
     }
 
-    // Process the text.
+    // Process the text. The lines are shown by handleFlushTimer().
     processText(text);
+}
+
+void SeerLogWidget::handleFlushTimer () {
+
+    if (_pendingLines.size() == 0) {
+        return;
+    }
+
+    // Follow the new lines only if the view is at the end. Leave it alone if older lines are being read.
+    bool atEnd = logView->isAtEnd();
+
+    // Add the frame's lines in one go. The filter, if any, looks at the new lines only.
+    _logModel->appendLines(_pendingLines, _pendingTypes, _pendingTimes);
+
+    _pendingLines.clear();
+    _pendingTypes.clear();
+    _pendingTimes.clear();
+
+    // Move to the end of the log.
+    if (atEnd) {
+        moveToEnd();
+    }
+
+    updateMatchLabel();
+}
+
+void SeerLogWidget::handleSearchChanged () {
+
+    _searchTimer->start();
+}
+
+void SeerLogWidget::handleSearchTimer () {
 
-    // Move to the end of the document.
-    moveToEnd();
+    _searchTimer->stop();
+
+    QString pattern = searchLineEdit->text();
+    QString types   = typeComboBox->currentData().toString();
+    int     token   = -1;
+    bool    atEnd   = logView->isAtEnd();
+
+    if (tokenLineEdit->text() != "") {
+        token = tokenLineEdit->text().toInt();
+    }
+
+    _filterModel->setFilter(pattern, types.toLatin1(), token);
+
+    // Show the matches, or the whole log.
+    QAbstractItemModel* model = (_filterModel->isActive() ? (QAbstractItemModel*)_filterModel : (QAbstractItemModel*)_logModel);
+
+    if (logView->model() != model) {
+        logView->setModel(model);
+    }
+
+    if (atEnd) {
+        moveToEnd();
+    }
+
+    updateMatchLabel();
+}
+
+void SeerLogWidget::handleLogViewDoubleClicked (const QModelIndex& index) {
+
+    if (logView->model() != _filterModel) {
+        return;
+    }
+
+    // Go back to the whole log, at the line that was picked.
+    int row = _filterModel->sourceRow(index.row());
+
+    searchLineEdit->blockSignals(true);
+    tokenLineEdit->blockSignals(true);
+    typeComboBox->blockSignals(true);
+
+    searchLineEdit->clear();
+    tokenLineEdit->clear();
+    typeComboBox->setCurrentIndex(0);
+
+    searchLineEdit->blockSignals(false);
+    tokenLineEdit->blockSignals(false);
+    typeComboBox->blockSignals(false);
+
+    _filterModel->setFilter("", "", -1);
+
+    logView->setModel(_logModel);
+
+    updateMatchLabel();
+
+    if (row >= 0) {
+        QModelIndex sourceIndex = _logModel->index(row);
+
+        logView->setCurrentIndex(sourceIndex);
+        logView->scrollTo(sourceIndex, QAbstractItemView::PositionAtCenter);
+    }
+}
+
+void SeerLogWidget::updateMatchLabel () {
+
+    if (_filterModel->isActive() == false) {
+        matchLabel->setText("");
+        return;
+    }
+
+    matchLabel->setText(QString("%1 of %2").arg(_filterModel->rowCount()).arg(_logModel->rowCount()));
 }
 
 void SeerLogWidget::handleClearButton () {
-    textEdit->clear();
+
+    _pendingLines.clear();
+    _pendingTypes.clear();
+    _pendingTimes.clear();
+    _logModel->clear();
+
+    updateMatchLabel();
 }
 
 void SeerLogWidget::handlePrintButton () {
@@ -95,9 +254,11 @@ void SeerLogWidget::handlePrintButton () {
         return;
     }
 
-    QTextDocument* document = textEdit->document();
+    QTextDocument document;
+    document.setDefaultFont(logView->font());
+    document.setPlainText(_logModel->text());
 
-    document->print(&printer);
+    document.print(&printer);
 }
 
 void SeerLogWidget::handleSaveButton () {
@@ -128,7 +289,7 @@ void SeerLogWidget::handleSaveButton () {
 
     if (file.open(QIODevice::ReadWrite)) {
         QTextStream stream(&file);
-        stream << textEdit->toPlainText();
+        stream << _logModel->text();
         file.flush();
         file.close();
 
@@ -141,9 +302,9 @@ void SeerLogWidget::handleSaveButton () {
 void SeerLogWidget::handleWrapTextCheckBox () {
 
     if (wrapTextCheckBox->checkState() == Qt::Unchecked) {
-        textEdit->setLineWrapMode(QTextEdit::NoWrap);       // No wrap
+        logView->setWrapText(false);    // No wrap
     }else{
-        textEdit->setLineWrapMode(QTextEdit::WidgetWidth);  // Wrap at end of widget
+        logView->setWrapText(true);     // Wrap at end of widget
     }
 }
 
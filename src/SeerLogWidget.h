@@ -1,7 +1,14 @@
 #pragma once
 
+#include "SeerLogModel.h"
+#include "SeerLogFilterModel.h"
 #include <QtWidgets/QWidget>
 #include <QtCore/QString>
+#include <QtCore/QStringList>
+#include <QtCore/QByteArray>
+#include <QtCore/QVector>
+#include <QtCore/QModelIndex>
+#include <QtCore/QTimer>
 #include "ui_SeerLogWidget.h"
 
 class SeerLogWidget : public QWidget, protected Ui::SeerLogWidgetForm {
@@ -18,6 +25,8 @@ class SeerLogWidget : public QWidget, protected Ui::SeerLogWidgetForm {
         void                setLogEnabled               (bool flag);
         void                moveToEnd                   ();
         void                setPlaceholderText          (const QString& text);
+        void                setMemoryLimit              (int megabytes);
+        int                 memoryLimit                 () const;
 
     signals:
         void                logEnabledChanged           (bool flag);
@@ -30,6 +39,26 @@ class SeerLogWidget : public QWidget, protected Ui::SeerLogWidgetForm {
         void                handleWrapTextCheckBox      ();
         void                handleEnableCheckBox        ();
 
+    protected slots:
+        void                handleFlushTimer            ();
+        void                handleSearchChanged         ();
+        void                handleSearchTimer           ();
+        void                handleLogViewDoubleClicked  (const QModelIndex& index);
+
     protected:
+        void                appendLine                  (const QString& line, char type = 0);
+        void                updateMatchLabel            ();
+
+    private:
+        SeerLogModel*       _logModel;
+        SeerLogFilterModel* _filterModel;
+        QStringList         _pendingLines;
+        QByteArray          _pendingTypes;
+        QVector<qint64>     _pendingTimes;
+        QTimer*             _flushTimer;
+        QTimer*             _searchTimer;
+
+        static const int    FlushInterval  = 16;        // Milliseconds between frames.
+        static const int    SearchInterval = 150;       // Milliseconds of typing before searching.
 };
 
@@ -673,6 +673,7 @@ void SeerMainWindow::handleSettingsConfiguration () {
     dlg.setEditorTabSize(gdbWidget->editorManager()->editorTabSize());
     dlg.setEditorHighlighterSettings(gdbWidget->editorManager()->editorHighlighterSettings());
     dlg.setEditorHighlighterEnabled(gdbWidget->editorManager()->editorHighlighterEnabled());
+    dlg.setEditorMiniMapEnabled(gdbWidget->editorManager()->editorMiniMapEnabled());
     dlg.setSourceAlternateDirectories(gdbWidget->sourceAlternateDirectories());
     dlg.setSourceIgnoreFilePatterns(gdbWidget->sourceIgnoreFilePatterns());
     dlg.setSourceMiscFilePatterns(gdbWidget->sourceMiscFilePatterns());
@@ -713,6 +714,7 @@ void SeerMainWindow::handleSettingsConfiguration () {
     gdbWidget->editorManager()->setEditorTabSize(dlg.editorTabSize());
     gdbWidget->editorManager()->setEditorHighlighterSettings(dlg.editorHighlighterSettings());
     gdbWidget->editorManager()->setEditorHighlighterEnabled(dlg.editorHighlighterEnabled());
+    gdbWidget->editorManager()->setEditorMiniMapEnabled(dlg.editorMiniMapEnabled());
     gdbWidget->setSourceAlternateDirectories(dlg.sourceAlternateDirectories());
     gdbWidget->setSourceIgnoreFilePatterns(dlg.sourceIgnoreFilePatterns());
     gdbWidget->setSourceMiscFilePatterns(dlg.sourceMiscFilePatterns());
@@ -854,6 +856,10 @@ void SeerMainWindow::handleText (const QString& text) {
             return;
         }
 
+        if (newtext.contains("^error,msg=\"Invalid thread id: ")) {
+            return;
+        }
+
         if (newtext.contains("^error,msg=\"A syntax error in expression, near ")) {
             return;
         }
@@ -1285,6 +1291,7 @@ void SeerMainWindow::writeConfigSettings () {
 
         settings.setValue("font",    gdbWidget->editorManager()->editorFont().toString());
         settings.setValue("tabsize", gdbWidget->editorManager()->editorTabSize());
+        settings.setValue("minimap", gdbWidget->editorManager()->editorMiniMapEnabled());
 
         settings.beginGroup("highlighter"); {
 
@@ -1373,6 +1380,7 @@ void SeerMainWindow::readConfigSettings () {
         gdbWidget->editorManager()->setEditorFont(f);
 
         gdbWidget->editorManager()->setEditorTabSize(settings.value("tabsize", 4).toInt());
+        gdbWidget->editorManager()->setEditorMiniMapEnabled(settings.value("minimap", false).toBool());
 
         settings.beginGroup("highlighter"); {
 
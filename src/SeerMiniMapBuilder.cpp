@@ -0,0 +1,209 @@
+#include "SeerMiniMapBuilder.h"
+#include <QtCore/QMutexLocker>
+#include <QtCore/QStringList>
+#include <QtCore/QDebug>
+
+SeerMiniMapBuilder::SeerMiniMapBuilder (QObject* parent) : QThread(parent) {
+
+    _running           = false;
+    _pending           = false;
+    _stop              = false;
+    _requestGeneration = 0;
+    _resultGeneration  = 0;
+}
+
+SeerMiniMapBuilder::~SeerMiniMapBuilder () {
+
+    {
+        QMutexLocker locker(&_mutex);
+
+        _stop    = true;
+        _pending = false;
+    }
+
+    wait();
+}
+
+void SeerMiniMapBuilder::build (int generation, const QString& text, const QVector<SeerMiniMapLine>& lines, const QColor& textColor, const QColor& commentColor, const QColor& backgroundColor) {
+
+    QMutexLocker locker(&_mutex);
+
+    // Replace any pending request. QString and QVector are implicitly shared,
+    // so nothing is copied here.
+    _requestGeneration      = generation;
+    _requestText            = text;
+    _requestLines           = lines;
+    _requestTextColor       = textColor;
+    _requestCommentColor    = commentColor;
+    _requestBackgroundColor = backgroundColor;
+    _pending                = true;
+
+    if (_running == true) {
+        return;
+    }
+
+    _running = true;
+
+    locker.unlock();
+
+    // The thread may still be on its way out of run(). Let it finish before restarting it.
+    wait();
+    start(QThread::LowPriority);
+}
+
+int SeerMiniMapBuilder::result (QVector<SeerMiniMapLine>& lines, QImage& image) {
+
+    QMutexLocker locker(&_mutex);
+
+    lines = _resultLines;
+    image = _resultImage;
+
+    return _resultGeneration;
+}
+
+SeerMiniMapLine SeerMiniMapBuilder::summarizeLine (const QString& line) {
+
+    SeerMiniMapLine summary;
+
+    int length = line.length();
+    int indent = 0;
+
+    while (indent < length && line[indent].isSpace()) {
+        indent++;
+    }
+
+    while (length > indent && line[length-1].isSpace()) {
+        length--;
+    }
+
+    QChar c0 = (indent   < length ? line[indent]   : QChar());
+    QChar c1 = (indent+1 < length ? line[indent+1] : QChar());
+
+    summary.indent  = quint16(qMin(indent, 0xFFFF));
+    summary.length  = quint16(qMin(length, 0xFFFF));
+    summary.comment = (c0 == '/' && (c1 == '/' || c1 == '*')) || c0 == '*';
+
+    return summary;
+}
+
+void SeerMiniMapBuilder::run () {
+
+    while (1) {
+
+        // Take the pending request, if any.
+        int                      generation;
+        QString                  text;
+        QVector<SeerMiniMapLine> lines;
+        QColor                   textColor;
+        QColor                   commentColor;
+        QColor                   backgroundColor;
+
+        {
+            QMutexLocker locker(&_mutex);
+
+            if (_pending == false || _stop == true) {
+                _running = false;
+                return;
+            }
+
+            generation      = _requestGeneration;
+            text            = _requestText;
+            lines           = _requestLines;
+            textColor       = _requestTextColor;
+            commentColor    = _requestCommentColor;
+            backgroundColor = _requestBackgroundColor;
+            _pending        = false;
+
+            _requestText  = QString();
+            _requestLines = QVector<SeerMiniMapLine>();
+        }
+
+        // Summarize the text, if we were given text.
+        if (text.isNull() == false) {
+
+            lines.clear();
+
+            int start = 0;
+            int end   = text.indexOf('\n');
+
+            while (end >= 0) {
+                lines.append(summarizeLine(text.mid(start, end - start)));
+
+                start = end + 1;
+                end   = text.indexOf('\n', start);
+            }
+
+            lines.append(summarizeLine(text.mid(start)));
+        }
+
+        //
+        // Render the image. One pixel per column. One row per line, unless there are
+        // more lines than MaxRows. Then several lines share a row and the row's
+        // intensity shows how much text is there.
+        //
+        QImage image;
+
+        int nlines = lines.size();
+
+        if (nlines > 0) {
+
+            int rows        = qMin(nlines, MaxRows);
+            int linesPerRow = (nlines + rows - 1) / rows;
+
+            QVector<quint16> textCounts(rows * Columns, 0);
+            QVector<quint16> commentCounts(rows * Columns, 0);
+
+            for (int i=0; i<nlines; i++) {
+
+                const SeerMiniMapLine& line = lines[i];
+
+                int row = int(qint64(i) * rows / nlines);
+                int end = qMin(int(line.length), int(Columns));
+
+                quint16* counts = (line.comment ? commentCounts.data() : textCounts.data()) + row * Columns;
+
+                for (int c=line.indent; c<end; c++) {
+                    counts[c]++;
+                }
+            }
+
+            image = QImage(Columns, rows, QImage::Format_RGB32);
+
+            for (int r=0; r<rows; r++) {
+
+                QRgb* pixels = reinterpret_cast<QRgb*>(image.scanLine(r));
+
+                for (int c=0; c<Columns; c++) {
+
+                    int ntext    = textCounts[r * Columns + c];
+                    int ncomment = commentCounts[r * Columns + c];
+                    int ntotal   = ntext + ncomment;
+
+                    if (ntotal == 0) {
+                        pixels[c] = backgroundColor.rgb();
+                        continue;
+                    }
+
+                    const QColor& color = (ncomment > ntext ? commentColor : textColor);
+
+                    double mix = 0.35 + 0.5 * qMin(1.0, double(ntotal) / linesPerRow);
+
+                    pixels[c] = qRgb(int(backgroundColor.red()   + (color.red()   - backgroundColor.red())   * mix),
+                                     int(backgroundColor.green() + (color.green() - backgroundColor.green()) * mix),
+                                     int(backgroundColor.blue()  + (color.blue()  - backgroundColor.blue())  * mix));
+                }
+            }
+        }
+
+        {
+            QMutexLocker locker(&_mutex);
+
+            _resultGeneration = generation;
+            _resultLines      = lines;
+            _resultImage      = image;
+        }
+
+        emit built();
+    }
+}
+
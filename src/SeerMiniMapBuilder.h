@@ -0,0 +1,69 @@
+#pragma once
+
+#include <QtGui/QImage>
+#include <QtGui/QColor>
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+//
+// One line of the document, reduced to what the minimap draws.
+//
+struct SeerMiniMapLine {
+    quint16     indent;     // Leading blanks, in columns.
+    quint16     length;     // Length without trailing blanks, in columns.
+    bool        comment;    // Line starts with a comment.
+};
+
+Q_DECLARE_TYPEINFO(SeerMiniMapLine, Q_PRIMITIVE_TYPE);
+
+//
+// Renders the minimap image for the source and assembly editors.
+//
+// Runs off the GUI thread. A request either carries the document text,
+// which is summarized line by line first, or an already summarized
+// list of lines (after a small edit or a color change). Requests that
+// arrive while a build is running replace any pending one. Only the
+// latest result is kept.
+//
+class SeerMiniMapBuilder : public QThread {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerMiniMapBuilder (QObject* parent = 0);
+       ~SeerMiniMapBuilder ();
+
+        void                                build                   (int generation, const QString& text, const QVector<SeerMiniMapLine>& lines, const QColor& textColor, const QColor& commentColor, const QColor& backgroundColor);
+        int                                 result                  (QVector<SeerMiniMapLine>& lines, QImage& image);
+
+        static SeerMiniMapLine              summarizeLine           (const QString& line);
+
+        static const int                    Columns = 128;
+        static const int                    MaxRows = 8192;
+
+    signals:
+        void                                built                   ();
+
+    protected:
+        void                                run                     () override;
+
+    private:
+        QMutex                              _mutex;
+        bool                                _running;
+        bool                                _pending;
+        bool                                _stop;
+
+        int                                 _requestGeneration;
+        QString                             _requestText;
+        QVector<SeerMiniMapLine>            _requestLines;
+        QColor                              _requestTextColor;
+        QColor                              _requestCommentColor;
+        QColor                              _requestBackgroundColor;
+
+        int                                 _resultGeneration;
+        QVector<SeerMiniMapLine>            _resultLines;
+        QImage                              _resultImage;
+};
+
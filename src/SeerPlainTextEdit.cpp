@@ -1,20 +1,648 @@
 #include "SeerPlainTextEdit.h"
+#include <QtGui/QPainter>
+#include <QtGui/QPainterPath>
+#include <QtGui/QRadialGradient>
+#include <QtGui/QColor>
+#include <QtGui/QTextBlock>
+#include <QtWidgets/QScrollBar>
+#include <QtCore/QDebug>
+#include <algorithm>
 
 SeerPlainTextEdit::SeerPlainTextEdit(const QString& text, QWidget* parent) : QPlainTextEdit(text, parent) {
+
+    init();
 }
 
 SeerPlainTextEdit::SeerPlainTextEdit(QWidget* parent) : QPlainTextEdit(parent) {
+
+    init();
 }
 
 SeerPlainTextEdit::~SeerPlainTextEdit () {
 }
 
+void SeerPlainTextEdit::init () {
+
+    _marginFpsEnabled   = qEnvironmentVariableIsSet("SEER_MARGIN_FPS");
+    _marginFpsFrames    = 0;
+
+    _miniMapEnabled     = false;
+    _miniMapFullPending = false;
+    _miniMapDirty       = false;
+    _miniMapGeneration  = 0;
+    _miniMapHeight      = 0;
+    _miniMapBuilder     = new SeerMiniMapBuilder(this);
+
+    _textFinder         = new SeerTextFinder(this);
+    _findGeneration     = 0;
+    _findFlags          = QTextDocument::FindFlags();
+    _findDone           = true;
+    _findCurrent        = -1;
+    _findSelectPending  = false;
+    _findStartPosition  = 0;
+    _findSelectionFrom  = 0;
+    _findSelectionTo    = 0;
+
+    QObject::connect(document(),      &QTextDocument::contentsChange,     this, &SeerPlainTextEdit::handleMiniMapContentsChange);
+    QObject::connect(document(),      &QTextDocument::contentsChange,     this, &SeerPlainTextEdit::handleFindContentsChange);
+    QObject::connect(_miniMapBuilder, &SeerMiniMapBuilder::built,         this, &SeerPlainTextEdit::handleMiniMapBuilt);
+    QObject::connect(_textFinder,     &SeerTextFinder::found,             this, &SeerPlainTextEdit::handleFindFound);
+    QObject::connect(this,            &QPlainTextEdit::updateRequest,     this, &SeerPlainTextEdit::handleFindUpdateRequest);
+}
+
 void SeerPlainTextEdit::forwardViewportEvent(QEvent* event) {
 
     viewportEvent(event);
 }
 
+const QPixmap& SeerPlainTextEdit::breakpointMarker (bool enabled, int size) {
+
+    //
+    // The breakpoint marker is rendered once per state and font size.
+    // The margin paint events just blit it. Re-render if the font size
+    // or the screen's pixel ratio changed.
+    //
+    QPixmap& marker = enabled ? _breakpointEnabledMarker : _breakpointDisabledMarker;
+    qreal    ratio  = devicePixelRatioF();
+    int      pixels = qRound(size * ratio);
+
+    if (marker.isNull() == false && marker.width() == pixels && marker.devicePixelRatio() == ratio) {
+        return marker;
+    }
+
+    marker = QPixmap(pixels, pixels);
+    marker.setDevicePixelRatio(ratio);
+    marker.fill(Qt::transparent);
+
+    QRect rect(0, 0, size, size);
+
+    QPainterPath path;
+    path.addEllipse(rect);
+
+    QPointF bias = QPointF(rect.width() * .25 * 1.0, rect.height() * .25 * -1.0);
+
+    QRadialGradient gradient(rect.center(), rect.width() / 2.0, rect.center() + bias);
+    gradient.setColorAt(0.0, QColor(Qt::white));
+    gradient.setColorAt(0.9, enabled ? QColor(Qt::red) : QColor(Qt::darkGray));
+    gradient.setColorAt(1.0, QColor(Qt::transparent));
+
+    QPainter painter(&marker);
+    painter.fillPath(path, QBrush(gradient));
+
+    return marker;
+}
+
+void SeerPlainTextEdit::countMarginFrame () {
+
+    // Report the margin repaint rate, once a second, when SEER_MARGIN_FPS is set.
+    // Used to measure scrolling performance on large files.
+    if (_marginFpsEnabled == false) {
+        return;
+    }
+
+    if (_marginFpsTimer.isValid() == false) {
+        _marginFpsTimer.start();
+        _marginFpsFrames = 0;
+    }
+
+    _marginFpsFrames++;
+
+    qint64 elapsed = _marginFpsTimer.elapsed();
+
+    if (elapsed >= 1000) {
+        qDebug() << documentTitle() << "margin fps:" << (_marginFpsFrames * 1000.0 / elapsed) << "blocks:" << blockCount();
+
+        _marginFpsFrames = 0;
+        _marginFpsTimer.restart();
+    }
+}
+
+void SeerPlainTextEdit::enableMiniMap (bool flag) {
+
+    if (flag == _miniMapEnabled) {
+        return;
+    }
+
+    _miniMapEnabled = flag;
+
+    if (_miniMapEnabled) {
+        requestMiniMap(true);
+    }else{
+        // Free the rendering. Any build in flight is ignored when it arrives.
+        _miniMapGeneration++;
+        _miniMapFullPending = false;
+        _miniMapDirty       = false;
+        _miniMapLines.clear();
+        _miniMapImage       = QImage();
+        _miniMapScaled      = QPixmap();
+        _miniMapHeight      = 0;
+    }
+}
+
+void SeerPlainTextEdit::setMiniMapSettings (const SeerHighlighterSettings& settings) {
+
+    _miniMapTextColor        = settings.get("Text").foreground().color();
+    _miniMapBackgroundColor  = settings.get("Text").background().color();
+    _miniMapCommentColor     = settings.get("Comment").foreground().color();
+    _miniMapCurrentLineColor = settings.get("Current Line").background().color();
+    _miniMapMatchColor       = settings.get("Match").background().color();
+
+    // Re-render with the new colors. The line summaries don't change.
+    requestMiniMap(false);
+}
+
+void SeerPlainTextEdit::requestMiniMap (bool full) {
+
+    if (_miniMapEnabled == false) {
+        return;
+    }
+
+    // The summaries can only be reused if they're complete.
+    if (_miniMapFullPending == true || _miniMapLines.size() != document()->blockCount()) {
+        full = true;
+    }
+
+    _miniMapGeneration++;
+
+    if (full) {
+        _miniMapFullPending = true;
+        _miniMapDirty       = false;
+        _miniMapBuilder->build(_miniMapGeneration, document()->toPlainText(), QVector<SeerMiniMapLine>(), _miniMapTextColor, _miniMapCommentColor, _miniMapBackgroundColor);
+    }else{
+        _miniMapBuilder->build(_miniMapGeneration, QString(), _miniMapLines, _miniMapTextColor, _miniMapCommentColor, _miniMapBackgroundColor);
+    }
+}
+
+void SeerPlainTextEdit::handleMiniMapContentsChange (int position, int charsRemoved, int charsAdded) {
+
+    if (_miniMapEnabled == false) {
+        return;
+    }
+
+    // The text changed while a full build is running. Usually this is the highlighter
+    // formatting the blocks of a newly loaded file. Build again once this one is done.
+    if (_miniMapFullPending == true) {
+        _miniMapDirty = true;
+        return;
+    }
+
+    // Large changes (a new file, a new function's assembly, a rehighlight) are
+    // summarized from scratch in the builder thread.
+    if (_miniMapLines.size() == 0 || charsRemoved + charsAdded > 4096) {
+        requestMiniMap(true);
+        return;
+    }
+
+    //
+    // Small changes. Re-summarize just the blocks that changed and splice them in.
+    //
+    // The new blocks are [first,last]. They replace the old blocks [first,last-delta],
+    // where delta is how many blocks were added (or removed, if negative).
+    //
+    QTextBlock first = document()->findBlock(position);
+    QTextBlock last  = document()->findBlock(position + charsAdded);
+
+    if (first.isValid() == false) {
+        requestMiniMap(true);
+        return;
+    }
+
+    if (last.isValid() == false) {
+        last = document()->lastBlock();
+    }
+
+    int firstNumber = first.blockNumber();
+    int lastNumber  = last.blockNumber();
+    int oldLast     = lastNumber - (document()->blockCount() - _miniMapLines.size());
+
+    //
+    // The highlighter reports every block it formats as a change of the same size.
+    // Only the text matters here, so don't rebuild if the summaries are the same.
+    //
+    if (oldLast == lastNumber) {
+
+        bool same = true;
+
+        for (QTextBlock block = first; block.isValid() && block.blockNumber() <= lastNumber; block = block.next()) {
+
+            SeerMiniMapLine        summary = SeerMiniMapBuilder::summarizeLine(block.text());
+            const SeerMiniMapLine& old     = _miniMapLines[block.blockNumber()];
+
+            if (summary.indent != old.indent || summary.length != old.length || summary.comment != old.comment) {
+                same = false;
+                break;
+            }
+        }
+
+        if (same) {
+            return;
+        }
+    }
+
+    if (oldLast < firstNumber - 1 || oldLast >= _miniMapLines.size()) {
+        requestMiniMap(true);
+        return;
+    }
+
+    QVector<SeerMiniMapLine> changed;
+
+    for (QTextBlock block = first; block.isValid() && block.blockNumber() <= lastNumber; block = block.next()) {
+        changed.append(SeerMiniMapBuilder::summarizeLine(block.text()));
+    }
+
+    _miniMapLines = _miniMapLines.mid(0, firstNumber) + changed + _miniMapLines.mid(oldLast + 1);
+
+    requestMiniMap(false);
+}
+
+void SeerPlainTextEdit::handleMiniMapBuilt () {
+
+    QVector<SeerMiniMapLine> lines;
+    QImage                   image;
+
+    int generation = _miniMapBuilder->result(lines, image);
+
+    // A newer request is on its way. Wait for that one.
+    if (generation != _miniMapGeneration || _miniMapEnabled == false) {
+        return;
+    }
+
+    _miniMapFullPending = false;
+    _miniMapLines       = lines;
+    _miniMapImage       = image;
+    _miniMapScaled      = QPixmap();
+
+    emit miniMapChanged();
+
+    if (_miniMapDirty == true) {
+        requestMiniMap(true);
+    }
+}
+
+int SeerPlainTextEdit::miniMapLineY (int lineno) const {
+
+    int nlines = document()->blockCount();
+
+    if (nlines <= 0) {
+        return 0;
+    }
+
+    return int(qint64(lineno - 1) * _miniMapHeight / nlines);
+}
+
+void SeerPlainTextEdit::paintMiniMap (QPainter& painter, const QRect& rect, const QVector<int>& enabledBreakpointLines, const QVector<int>& disabledBreakpointLines, const QVector<int>& currentLines) {
+
+    painter.fillRect(rect, _miniMapBackgroundColor);
+
+    int nlines = document()->blockCount();
+
+    if (_miniMapImage.isNull() == true || nlines <= 0) {
+        _miniMapHeight = 0;
+        return;
+    }
+
+    // Two pixels per line, or less if the document doesn't fit.
+    _miniMapHeight = qMin(rect.height(), nlines * 2);
+
+    // Scale the rendering to the area. Only redone when the area or the rendering changes.
+    QSize size(rect.width(), _miniMapHeight);
+
+    if (_miniMapScaled.isNull() == true || _miniMapScaled.size() != size) {
+        _miniMapScaled = QPixmap::fromImage(_miniMapImage.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    }
+
+    painter.drawPixmap(rect.left(), rect.top(), _miniMapScaled);
+
+    int markerHeight = qMax(2, _miniMapHeight / nlines);
+
+    // Current lines. Full width.
+    for (int lineno : currentLines) {
+        painter.fillRect(QRect(rect.left(), rect.top() + miniMapLineY(lineno), rect.width(), markerHeight), _miniMapCurrentLineColor);
+    }
+
+    // Search matches. Along the right side. There can be many, so draw each row once.
+    int lastMatchY = -1;
+
+    for (int lineno : _findMatchLines) {
+
+        int y = miniMapLineY(lineno);
+
+        if (y == lastMatchY) {
+            continue;
+        }
+
+        painter.fillRect(QRect(rect.right() - 5, rect.top() + y, 6, markerHeight), _miniMapMatchColor);
+
+        lastMatchY = y;
+    }
+
+    // Breakpoints. Along the left side.
+    for (int lineno : enabledBreakpointLines) {
+        painter.fillRect(QRect(rect.left(), rect.top() + miniMapLineY(lineno), 4, markerHeight), QColor(Qt::red));
+    }
+
+    for (int lineno : disabledBreakpointLines) {
+        painter.fillRect(QRect(rect.left(), rect.top() + miniMapLineY(lineno), 4, markerHeight), QColor(Qt::darkGray));
+    }
+
+    // The part of the document that is in view.
+    int first   = firstVisibleBlock().blockNumber() + 1;
+    int visible = viewport()->height() / qMax(1, fontMetrics().height());
+    int top     = miniMapLineY(first);
+    int bottom  = qMax(top + 2, miniMapLineY(first + visible));
+
+    QColor boxColor = _miniMapTextColor;
+
+    boxColor.setAlpha(40);
+    painter.fillRect(QRect(rect.left(), rect.top() + top, rect.width(), bottom - top), boxColor);
+
+    boxColor.setAlpha(120);
+    painter.setPen(boxColor);
+    painter.drawRect(QRect(rect.left(), rect.top() + top, rect.width() - 1, bottom - top - 1));
+}
+
+void SeerPlainTextEdit::miniMapScrollTo (int y) {
+
+    if (_miniMapHeight <= 0) {
+        return;
+    }
+
+    // Center the view on the line under 'y'.
+    int lineno  = int(qint64(qBound(0, y, _miniMapHeight)) * document()->blockCount() / _miniMapHeight);
+    int visible = viewport()->height() / qMax(1, fontMetrics().height());
+
+    verticalScrollBar()->setValue(lineno - visible / 2);
+}
+
+void SeerPlainTextEdit::findText (const QString& text, QTextDocument::FindFlags flags) {
+
+    _findPattern = text;
+    _findFlags   = flags & QTextDocument::FindCaseSensitively;
+
+    // Move to the first match after our current position, once it is found.
+    startFind(true);
+}
+
+void SeerPlainTextEdit::findNext (const QString& text, QTextDocument::FindFlags flags) {
+
+    // A different search. Start it over.
+    if (text != _findPattern || (flags & QTextDocument::FindCaseSensitively) != _findFlags) {
+        findText(text, flags);
+        return;
+    }
 
+    if (_findMatchPositions.size() == 0) {
+        return;
+    }
+
+    // The first match after the current selection. Wrap around at the end, once all matches are known.
+    int index = int(std::lower_bound(_findMatchPositions.constBegin(), _findMatchPositions.constEnd(), textCursor().selectionEnd()) - _findMatchPositions.constBegin());
+
+    if (index >= _findMatchPositions.size()) {
+        if (_findDone == false) {
+            return;
+        }
+        index = 0;
+    }
+
+    selectFindMatch(index);
+}
+
+void SeerPlainTextEdit::findPrevious (const QString& text, QTextDocument::FindFlags flags) {
+
+    // A different search. Start it over.
+    if (text != _findPattern || (flags & QTextDocument::FindCaseSensitively) != _findFlags) {
+        findText(text, flags);
+        return;
+    }
+
+    if (_findMatchPositions.size() == 0) {
+        return;
+    }
+
+    // The last match before the current selection. Wrap around at the start.
+    int index = int(std::lower_bound(_findMatchPositions.constBegin(), _findMatchPositions.constEnd(), textCursor().selectionStart()) - _findMatchPositions.constBegin()) - 1;
+
+    if (index < 0) {
+        index = _findMatchPositions.size() - 1;
+    }
+
+    selectFindMatch(index);
+}
+
+void SeerPlainTextEdit::clearFindText () {
+
+    _findPattern = "";
+
+    startFind(false);
+}
+
+const QString& SeerPlainTextEdit::findPattern () const {
+
+    return _findPattern;
+}
+
+int SeerPlainTextEdit::findMatchCount () const {
+
+    return _findMatchPositions.size();
+}
+
+int SeerPlainTextEdit::findMatchCurrent () const {
+
+    return _findCurrent;
+}
+
+bool SeerPlainTextEdit::findMatchDone () const {
+
+    return _findDone;
+}
+
+void SeerPlainTextEdit::setFindMatchFormat (const QTextCharFormat& format) {
+
+    _findMatchFormat = format;
+
+    // Recolor the visible matches.
+    if (_findMatchPositions.size() > 0) {
+        updateFindExtraSelections(true);
+        refreshExtraSelections();
+    }
+}
+
+const QList<QTextEdit::ExtraSelection>& SeerPlainTextEdit::findExtraSelections () const {
+
+    return _findExtraSelections;
+}
+
+void SeerPlainTextEdit::refreshExtraSelections () {
+
+    setExtraSelections(findExtraSelections());
+}
+
+void SeerPlainTextEdit::startFind (bool select) {
+
+    // Forget the old matches. Any batches still on their way are ignored.
+    _findGeneration++;
+    _findMatchPositions.clear();
+    _findMatchLines.clear();
+    _findExtraSelections.clear();
+    _findCurrent       = -1;
+    _findSelectPending = select;
+    _findStartPosition = textCursor().position();
+    _findSelectionFrom = 0;
+    _findSelectionTo   = 0;
+
+    if (_findPattern.isEmpty()) {
+        _findDone = true;
+        _textFinder->cancel();
+    }else{
+        _findDone = false;
+        _textFinder->find(_findGeneration, document()->toPlainText(), _findPattern, _findFlags.testFlag(QTextDocument::FindCaseSensitively) ? Qt::CaseSensitive : Qt::CaseInsensitive);
+    }
+
+    refreshExtraSelections();
+
+    emit findMatchesChanged();
+    emit miniMapChanged();
+}
+
+void SeerPlainTextEdit::handleFindContentsChange (int position, int charsRemoved, int charsAdded) {
+
+    if (_findPattern.isEmpty()) {
+        return;
+    }
+
+    //
+    // The highlighter reports every block it formats as a change of the same size.
+    // Those don't move any matches. Anything else, including a whole new text,
+    // means searching again. Don't move the cursor for that.
+    //
+    if (charsRemoved == charsAdded && (position != 0 || charsAdded < document()->characterCount() - 1)) {
+        return;
+    }
+
+    startFind(false);
+}
+
+void SeerPlainTextEdit::handleFindFound () {
+
+    QVector<int> positions;
+    QVector<int> lines;
+    bool         done;
+
+    int generation = _textFinder->takeMatches(positions, lines, done);
+
+    // From an older search.
+    if (generation != _findGeneration) {
+        return;
+    }
+
+    _findMatchPositions += positions;
+    _findMatchLines     += lines;
+    _findDone            = done;
+
+    // Select the first match after where the search started. Wrap around if there isn't one.
+    if (_findSelectPending == true) {
+
+        int index = int(std::lower_bound(_findMatchPositions.constBegin(), _findMatchPositions.constEnd(), _findStartPosition) - _findMatchPositions.constBegin());
+
+        if (index < _findMatchPositions.size()) {
+            selectFindMatch(index);
+        }else if (_findDone == true && _findMatchPositions.size() > 0) {
+            selectFindMatch(0);
+        }
+    }
+
+    // Only the matches near the view become selections.
+    if (positions.size() > 0 && positions.first() < _findSelectionTo) {
+        updateFindExtraSelections(true);
+        refreshExtraSelections();
+    }else if (updateFindExtraSelections(false)) {
+        refreshExtraSelections();
+    }
+
+    emit findMatchesChanged();
+    emit miniMapChanged();
+}
+
+void SeerPlainTextEdit::handleFindUpdateRequest (const QRect& rect, int dy) {
+
+    Q_UNUSED(rect);
+    Q_UNUSED(dy);
+
+    if (_findMatchPositions.size() == 0) {
+        return;
+    }
+
+    // Scrolled out of the range the selections were made for. Make new ones.
+    if (updateFindExtraSelections(false)) {
+        refreshExtraSelections();
+    }
+}
+
+bool SeerPlainTextEdit::updateFindExtraSelections (bool force) {
+
+    //
+    // Work out the part of the document in view.
+    //
+    QTextBlock top    = firstVisibleBlock();
+    QTextBlock bottom = cursorForPosition(QPoint(0, viewport()->height())).block();
+
+    if (top.isValid() == false || bottom.isValid() == false) {
+        return false;
+    }
+
+    int from = top.position();
+    int to   = bottom.position() + bottom.length();
+
+    if (force == false && from >= _findSelectionFrom && to <= _findSelectionTo) {
+        return false;
+    }
+
+    //
+    // Make selections for a page either side of it, so small scrolls don't
+    // need new ones.
+    //
+    int span = to - from;
+
+    _findSelectionFrom = qMax(0, from - span);
+    _findSelectionTo   = to + span;
+
+    _findExtraSelections.clear();
+
+    int index = int(std::lower_bound(_findMatchPositions.constBegin(), _findMatchPositions.constEnd(), _findSelectionFrom) - _findMatchPositions.constBegin());
+
+    for (; index < _findMatchPositions.size() && _findMatchPositions[index] < _findSelectionTo; index++) {
+
+        QTextEdit::ExtraSelection extra;
+        extra.format = _findMatchFormat;
+        extra.cursor = QTextCursor(document());
+        extra.cursor.setPosition(_findMatchPositions[index]);
+        extra.cursor.setPosition(_findMatchPositions[index] + _findPattern.length(), QTextCursor::KeepAnchor);
+
+        _findExtraSelections.append(extra);
+    }
+
+    return true;
+}
+
+void SeerPlainTextEdit::selectFindMatch (int index) {
+
+    if (index < 0 || index >= _findMatchPositions.size()) {
+        return;
+    }
+
+    QTextCursor cursor(document());
+    cursor.setPosition(_findMatchPositions[index]);
+    cursor.setPosition(_findMatchPositions[index] + _findPattern.length(), QTextCursor::KeepAnchor);
+
+    setTextCursor(cursor);
+    ensureCursorVisible();
+
+    _findCurrent       = index;
+    _findSelectPending = false;
+
+    emit findMatchesChanged();
+}
 
 SeerPlainTextWheelEventForwarder::SeerPlainTextWheelEventForwarder (SeerPlainTextEdit* target ) : QObject(), _target(target) {
 }
@@ -38,4 +666,3 @@ bool SeerPlainTextWheelEventForwarder::eventFilter (QObject* obj, QEvent* event)
     // do not filter the event
     return false;
 }
-
@@ -1,7 +1,19 @@
 #pragma once
 
+#include "SeerMiniMapBuilder.h"
+#include "SeerTextFinder.h"
+#include "SeerHighlighterSettings.h"
 #include <QtWidgets/QPlainTextEdit>
+#include <QtWidgets/QTextEdit>
 #include <QtWidgets/QWidget>
+#include <QtGui/QPixmap>
+#include <QtGui/QPainter>
+#include <QtGui/QColor>
+#include <QtGui/QTextCharFormat>
+#include <QtGui/QTextDocument>
+#include <QtCore/QVector>
+#include <QtCore/QList>
+#include <QtCore/QElapsedTimer>
 #include <QtCore/QString>
 #include <QtCore/QEvent>
 #include <QtCore/QObject>
@@ -15,7 +27,85 @@ class SeerPlainTextEdit : public QPlainTextEdit {
         explicit SeerPlainTextEdit (QWidget* parent = 0);
        ~SeerPlainTextEdit ();
 
-        void                    forwardViewportEvent        (QEvent* event);
+        void                                forwardViewportEvent        (QEvent* event);
+
+        void                                miniMapScrollTo             (int y);
+
+        void                                findText                    (const QString& text, QTextDocument::FindFlags flags);
+        void                                findNext                    (const QString& text, QTextDocument::FindFlags flags);
+        void                                findPrevious                (const QString& text, QTextDocument::FindFlags flags);
+        void                                clearFindText               ();
+        const QString&                      findPattern                 () const;
+        int                                 findMatchCount              () const;
+        int                                 findMatchCurrent            () const;
+        bool                                findMatchDone               () const;
+
+    signals:
+        void                                miniMapChanged              ();
+        void                                findMatchesChanged          ();
+
+    protected:
+        const QPixmap&                      breakpointMarker            (bool enabled, int size);
+        void                                countMarginFrame            ();
+
+        void                                enableMiniMap               (bool flag);
+        void                                setMiniMapSettings          (const SeerHighlighterSettings& settings);
+        void                                paintMiniMap                (QPainter& painter, const QRect& rect, const QVector<int>& enabledBreakpointLines, const QVector<int>& disabledBreakpointLines, const QVector<int>& currentLines);
+
+        void                                setFindMatchFormat          (const QTextCharFormat& format);
+        const QList<QTextEdit::ExtraSelection>& findExtraSelections     () const;
+        virtual void                        refreshExtraSelections      ();
+
+    private slots:
+        void                                handleMiniMapContentsChange (int position, int charsRemoved, int charsAdded);
+        void                                handleMiniMapBuilt          ();
+        void                                handleFindContentsChange    (int position, int charsRemoved, int charsAdded);
+        void                                handleFindFound             ();
+        void                                handleFindUpdateRequest     (const QRect& rect, int dy);
+
+    private:
+        void                                init                        ();
+        void                                requestMiniMap              (bool full);
+        int                                 miniMapLineY                (int lineno) const;
+        void                                startFind                   (bool select);
+        void                                selectFindMatch             (int index);
+        bool                                updateFindExtraSelections   (bool force);
+
+        QPixmap                             _breakpointEnabledMarker;
+        QPixmap                             _breakpointDisabledMarker;
+        bool                                _marginFpsEnabled;
+        int                                 _marginFpsFrames;
+        QElapsedTimer                       _marginFpsTimer;
+
+        bool                                _miniMapEnabled;
+        bool                                _miniMapFullPending;
+        bool                                _miniMapDirty;
+        int                                 _miniMapGeneration;
+        int                                 _miniMapHeight;
+        SeerMiniMapBuilder*                 _miniMapBuilder;
+        QVector<SeerMiniMapLine>            _miniMapLines;
+        QImage                              _miniMapImage;
+        QPixmap                             _miniMapScaled;
+        QColor                              _miniMapTextColor;
+        QColor                              _miniMapCommentColor;
+        QColor                              _miniMapBackgroundColor;
+        QColor                              _miniMapCurrentLineColor;
+        QColor                              _miniMapMatchColor;
+
+        SeerTextFinder*                     _textFinder;
+        int                                 _findGeneration;
+        QString                             _findPattern;
+        QTextDocument::FindFlags            _findFlags;
+        QVector<int>                        _findMatchPositions;
+        QVector<int>                        _findMatchLines;
+        bool                                _findDone;
+        int                                 _findCurrent;
+        bool                                _findSelectPending;
+        int                                 _findStartPosition;
+        int                                 _findSelectionFrom;
+        int                                 _findSelectionTo;
+        QTextCharFormat                     _findMatchFormat;
+        QList<QTextEdit::ExtraSelection>    _findExtraSelections;
 };
 
 
@@ -27,9 +117,9 @@ class SeerPlainTextWheelEventForwarder : public QObject {
         explicit SeerPlainTextWheelEventForwarder (SeerPlainTextEdit* target);
        ~SeerPlainTextWheelEventForwarder();
 
-        bool                    eventFilter                 (QObject* obj, QEvent* event);
+        bool                                eventFilter                 (QObject* obj, QEvent* event);
 
     private:
-        SeerPlainTextEdit*      _target;
+        SeerPlainTextEdit*                  _target;
 };
 
@@ -13,6 +13,7 @@
 #include <QtGui/QClipboard>
 #include <QtCore/QSettings>
 #include <QtCore/QVector>
+#include <QtCore/QSet>
 #include <QtCore/QByteArray>
 #include <QtCore/QDebug>
 
@@ -47,6 +48,11 @@ SeerRegisterValuesBrowserWidget::SeerRegisterValuesBrowserWidget (QWidget* paren
     registerProfileComboBox->addItem("allregisters");
 
     _needsRegisterNames = true;
+    _allEnabled         = true;
+    _valuesId           = Seer::createID();
+    _changedId          = Seer::createID();
+    _syncId             = Seer::createID();
+    _frameId            = 0;
 
     // Create edit delegate.
     QAllowEditDelegate* editDelegate = new QAllowEditDelegate(this);
@@ -107,14 +113,21 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
         // This recreates the tree.
         registersTreeWidget->clear();
 
+        _registerItems.clear();
+        _changedNumbers.clear();
+
         QString newtext = Seer::filterEscapes(text); // Filter escaped characters.
 
         QString frame_text = Seer::parseFirst(newtext, "register-names=", '[', ']', false);
 
         QStringList name_list = Seer::parse(frame_text, "", '"', '"', false);
 
-        int i = 0;
-        for ( const auto& name_text : name_list  ) {
+        // A register's number is its position in the list, counting the unnamed ones.
+        _registerItems.fill(0, name_list.size());
+
+        for (int i=0; i<name_list.size(); i++) {
+
+            const QString& name_text = name_list[i];
 
             // XXX Commenting this out will get extra registers.
             // XXX Are they valid?
@@ -133,27 +146,25 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
 
             registersTreeWidget->addTopLevelItem(topItem);
 
-            i++;
+            _registerItems[i] = topItem;
         }
 
+        // Also asks for their values.
         handleShowHideRegisters();
 
         _needsRegisterNames = false;
 
-    }else if (text.startsWith("^done,register-values=[") && text.endsWith("]")) {
+        // The values were asked for above. Reset what gdb compares against for the next stop.
+        emit refreshChangedRegisters(_syncId);
 
-        // Mark each entry initially as "unused".
-        // Later, some will be marked as "reused" or "new". Then the "unused" ones will
-        // be deleted.
-        QTreeWidgetItemIterator it(registersTreeWidget);
-        while (*it) {
-            (*it)->setText(3, "unused");
-            ++it;
-        }
+    }else if ((text.startsWith("^done,register-values=[") || text.startsWith(QString::number(_valuesId) + "^done,register-values=[") ||
+               (_frameId > 0 && text.startsWith(QString::number(_frameId) + "^done,register-values=["))) && text.endsWith("]")) {
 
         // "^done,register-values=[{number=\"0\",value=\"0x4005e7\"},{number=\"1\",value=\"0x0\"},{number=\"2\",value=\"0x100\"},
         //                    {number=\"3\",value=\"0x7fffffffd548\"},{number=\"4\",value=\"0x7fffffffd538\"},{number=\"5\",value=\"0x1\"},...
         //                    {number=\"205\",value=\"0x0\"},{number=\"206\",value=\"0x0\"}]"
+        //
+        // May be all registers or only some of them. Registers that aren't listed keep their value.
 
         QString newtext = Seer::filterEscapes(text); // Filter escaped characters.
 
@@ -161,56 +172,84 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
 
         QStringList registers_list = Seer::parse(frame_text, "", '{', '}', false);
 
+        // Another frame's values aren't changes. Only flag what changed since the last stop.
+        bool flagChange = (_frameId <= 0 || text.startsWith(QString::number(_frameId) + "^") == false);
+
         for ( const auto& register_text : registers_list  ) {
 
             QString number_text = Seer::parseFirst(register_text, "number=",  '"', '"', false);
             QString value_text  = Seer::parseFirst(register_text, "value=",   '"', '"', false);
 
-            // Instead of creating a new tree each time, we will reuse existing items, if they are there.
-            // This allows the expanded items to remain expanded.
-            QList<QTreeWidgetItem*> matches = registersTreeWidget->findItems(number_text, Qt::MatchExactly, 0);
+            int number = number_text.toInt();
 
-            // Found a match. Reuse it. Set the value.
-            // If no matches, do not add this entry.
-            if (matches.size() > 0) {
+            // If there's no item for the number, do not add this entry.
+            if (number < 0 || number >= _registerItems.size() || _registerItems[number] == 0) {
+                continue;
+            }
 
-                QTreeWidgetItem* item = matches.takeFirst();
+            setValue(_registerItems[number], value_text, flagChange);
+        }
 
-                bool isDifferent = false;
+    }else if (text.startsWith(QString::number(_changedId) + "^done,changed-registers=[") && text.endsWith("]")) {
+
+        // "12^done,changed-registers=[\"0\",\"1\",\"2\",\"4\",\"5\",\"16\",\"17\"]"
+
+        // Last stop's changes aren't changes anymore.
+        for (int i=0; i<_changedNumbers.size(); i++) {
+
+            QTreeWidgetItem* item = _registerItems[_changedNumbers[i]];
+
+            QFont f1 = item->font(1);
+            QFont f2 = item->font(2);
+
+            f1.setBold(false);
+            f2.setBold(false);
+
+            item->setFont(1, f1);
+            item->setFont(2, f2);
+        }
 
-                // Flag it as different of the new value is different than the old version _AND_
-                // the old one isn't "" (like after a refresh).
-                if (item->text(2) != "" && item->text(2) != value_text) {
-                    isDifferent = true;
-                }
+        _changedNumbers.clear();
 
-                item->setText(2, value_text);
-                item->setText(3, "reused");
+        QString     frame_text  = Seer::parseFirst(text, "changed-registers=", '[', ']', false);
+        QStringList number_list = Seer::parse(frame_text, "", '"', '"', false);
+        QStringList numbers;
 
-                QFont f1 = item->font(1);
-                QFont f2 = item->font(2);
+        // Only ask for the ones the profile shows.
+        for (const auto& number_text : number_list) {
 
-                f1.setBold(isDifferent);
-                f2.setBold(isDifferent);
+            int number = number_text.toInt();
 
-                item->setFont(1, f1);
-                item->setFont(2, f2);
+            if (number < 0 || number >= _registerItems.size() || _registerItems[number] == 0 || _registerItems[number]->isHidden()) {
+                continue;
             }
+
+            numbers.append(number_text);
         }
 
-        // At this point, there are some new entries, some reused entries, and some unused ones.
-        // Delete the unused ones. They are obsolete.
-        QList<QTreeWidgetItem*> matches = registersTreeWidget->findItems("unused", Qt::MatchExactly, 3);
+        if (numbers.size() > 0) {
+            emit refreshRegisterValues(_valuesId, registerFormatComboBox->currentData().toString(), numbers.join(' '));
+        }
 
-        qDeleteAll(matches);
+    }else if (text.startsWith(QString::number(_syncId) + "^done,changed-registers=[")) {
+        // Only there to reset gdb's copy of the registers. Nothing to show.
 
-    }else if (text.startsWith("^error,msg=\"No registers.\"")) {
+    }else if (text.startsWith("^error,msg=\"No registers.\"") || text.startsWith(QString::number(_changedId) + "^error,msg=\"No registers.\"")) {
         registersTreeWidget->clear();
 
+        _registerItems.clear();
+        _changedNumbers.clear();
+        _frameValues.clear();
+
+        _frameKey = "";
+        _stopKey  = "";
+
         _needsRegisterNames = true;
 
     }else{
         // Ignore others.
+        QApplication::restoreOverrideCursor();
+        return;
     }
 
     registersTreeWidget->resizeColumnToContents(0);
@@ -223,37 +262,166 @@ void SeerRegisterValuesBrowserWidget::handleText (const QString& text) {
 
 void SeerRegisterValuesBrowserWidget::handleStoppingPointReached () {
 
+    // The program ran. The values kept for other frames are out of date. If another
+    // frame than the one stopped in is shown, gdb's list of changes doesn't apply to it.
+    bool otherFrame = (_frameKey != _stopKey);
+
+    _frameValues.clear();
+    _frameKey = "";
+    _frameId  = 0;
+
     // Don't do any work if the widget is hidden.
     if (isHidden()) {
         return;
     }
 
+    // The values follow the names.
     if (_needsRegisterNames) {
 
         emit refreshRegisterNames();
 
         _needsRegisterNames = false;
+
+        return;
     }
 
-    // Get the format.
-    QString fmt = registerFormatComboBox->currentData().toString();
+    // Get all of them, and reset what gdb compares against for the next stop.
+    if (otherFrame) {
+
+        requestValues(_valuesId);
+
+        emit refreshChangedRegisters(_syncId);
+
+        return;
+    }
+
+    // If a stopping point is reached, ask which registers changed.
+    // Only their values are asked for.
+    emit refreshChangedRegisters(_changedId);
+}
+
+void SeerRegisterValuesBrowserWidget::handleSelectedFrameChanged (int threadid, int frameno) {
+
+    QString key = QString::number(threadid) + ":" + QString::number(frameno);
+
+    // Just stopped. The values being fetched are of this frame.
+    if (_frameKey == "") {
+        _frameKey = key;
+        _stopKey  = key;
+        return;
+    }
+
+    if (_frameKey == key) {
+        return;
+    }
+
+    // Keep the values of the frame being left. Show the ones of the new frame, if
+    // it was looked at before. Otherwise ask for them.
+    _frameValues.insert(_frameKey, frameValues());
+
+    _frameKey = key;
+
+    if (isHidden()) {
+        return;
+    }
+
+    if (_frameValues.contains(key)) {
+
+        const QStringList& values = _frameValues[key];
+
+        for (int i=0; i<_registerItems.size() && i<values.size(); i++) {
+            if (_registerItems[i] != 0) {
+                setValue(_registerItems[i], values[i], false);
+            }
+        }
+
+        _frameId = 0;
+
+        return;
+    }
+
+    // A new id, so a late answer about another frame isn't shown.
+    _frameId = Seer::createID();
 
-    // refresh();
-    // If a stopping point is reached, just refresh the values.
-    // The register names should already be there.
-    emit refreshRegisterValues(fmt);
+    requestValues(_frameId);
+}
+
+QStringList SeerRegisterValuesBrowserWidget::frameValues () const {
+
+    QStringList values;
+
+    values.reserve(_registerItems.size());
+
+    for (int i=0; i<_registerItems.size(); i++) {
+        values.append(_registerItems[i] != 0 ? _registerItems[i]->text(2) : QString());
+    }
+
+    return values;
 }
 
 void SeerRegisterValuesBrowserWidget::refresh () {
 
-    // Force new names.
+    // Force new names. The values follow them.
     _needsRegisterNames = true;
 
+    emit refreshRegisterNames();
+}
+
+void SeerRegisterValuesBrowserWidget::requestValues (int id) {
+
     // Get the format.
     QString fmt = registerFormatComboBox->currentData().toString();
 
-    emit refreshRegisterNames();
-    emit refreshRegisterValues(fmt);
+    // All of them.
+    if (_allEnabled) {
+        emit refreshRegisterValues(id, fmt, "");
+        return;
+    }
+
+    // Only the ones the profile shows.
+    if (_enabledNumbers.size() == 0) {
+        return;
+    }
+
+    QStringList numbers;
+
+    for (int i=0; i<_enabledNumbers.size(); i++) {
+        numbers.append(QString::number(_enabledNumbers[i]));
+    }
+
+    emit refreshRegisterValues(id, fmt, numbers.join(' '));
+}
+
+void SeerRegisterValuesBrowserWidget::setValue (QTreeWidgetItem* item, const QString& value, bool flagChange) {
+
+    if (item->text(2) == value) {
+        return;
+    }
+
+    // Flag it as different if the old one isn't "" (like after a refresh). Not when
+    // showing another frame's values.
+    bool isDifferent = (flagChange == true && item->text(2) != "");
+
+    item->setText(2, value);
+
+    if (isDifferent == false) {
+        return;
+    }
+
+    QFont f1 = item->font(1);
+    QFont f2 = item->font(2);
+
+    f1.setBold(true);
+    f2.setBold(true);
+
+    item->setFont(1, f1);
+    item->setFont(2, f2);
+
+    int number = item->text(0).toInt();
+
+    if (_changedNumbers.contains(number) == false) {
+        _changedNumbers.append(number);
+    }
 }
 
 void SeerRegisterValuesBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
@@ -381,11 +549,20 @@ void SeerRegisterValuesBrowserWidget::handleIndexEditingFinished  (const QModelI
 
 void SeerRegisterValuesBrowserWidget::handleFormatChanged (int index) {
 
-    // Get the format.
-    QString fmt = registerFormatComboBox->itemData(index).toString();
+    Q_UNUSED(index);
+
+    // Every value changes with the format. Don't show them as changed.
+    for (int i=0; i<_registerItems.size(); i++) {
+        if (_registerItems[i] != 0) {
+            _registerItems[i]->setText(2, "");
+        }
+    }
+
+    // The values kept for other frames are in the old format.
+    _frameValues.clear();
 
     // Refresh the register values.
-    emit refreshRegisterValues(fmt);
+    requestValues(_valuesId);
 }
 
 void SeerRegisterValuesBrowserWidget::handleColumnSelected (int logicalIndex) {
@@ -539,39 +716,54 @@ void SeerRegisterValuesBrowserWidget::handleDeleteProfile () {
 
 void SeerRegisterValuesBrowserWidget::handleShowHideRegisters () {
 
-    // If the list is empty, show all.
-    if (_registerNames.count() == 0 || _registerEnabled.count() == 0) {
+    // If the list is empty, show all. Otherwise, show which ones are enabled.
+    _allEnabled = (_registerNames.count() == 0 || _registerEnabled.count() == 0);
 
-        for (int i=0; i<registersTreeWidget->topLevelItemCount(); i++) {
+    QSet<QString> enabledNames;
 
-            QTreeWidgetItem* topItem = registersTreeWidget->topLevelItem(i);
-            topItem->setHidden(false);
+    for (int i=0; i<_registerNames.count() && i<_registerEnabled.count(); i++) {
+        if (_registerEnabled[i]) {
+            enabledNames.insert(_registerNames[i]);
         }
-
-        return;
     }
 
-    // There is a list. Hide all, then show which ones are enabled.
-    for (int i=0; i<registersTreeWidget->topLevelItemCount(); i++) {
+    _enabledNumbers.clear();
 
-        QTreeWidgetItem* topItem = registersTreeWidget->topLevelItem(i);
-        topItem->setHidden(true);
-    }
+    QStringList missing;
+
+    for (int i=0; i<_registerItems.size(); i++) {
 
-    for (int i=0; i<_registerNames.count(); i++) {
+        QTreeWidgetItem* topItem = _registerItems[i];
 
-        if (_registerEnabled[i] == false) {
+        if (topItem == 0) {
             continue;
         }
 
-        QString registerName = _registerNames[i];
+        bool enabled = (_allEnabled || enabledNames.contains(topItem->text(1)));
+
+        topItem->setHidden(enabled == false);
+
+        if (enabled == false) {
+            continue;
+        }
 
-        QList<QTreeWidgetItem*> matches = registersTreeWidget->findItems(registerName, Qt::MatchExactly, 1);
+        _enabledNumbers.append(i);
 
-        for (int i=0; i<matches.size(); i++) {
-            matches[i]->setHidden(false);
+        // Newly shown registers may never have been read.
+        if (topItem->text(2) == "") {
+            missing.append(QString::number(i));
         }
     }
+
+    if (missing.size() == 0) {
+        return;
+    }
+
+    if (missing.size() == _enabledNumbers.size()) {
+        requestValues(_valuesId);
+    }else{
+        emit refreshRegisterValues(_valuesId, registerFormatComboBox->currentData().toString(), missing.join(' '));
+    }
 }
 
 void SeerRegisterValuesBrowserWidget::handleProfileChanged (int index) {
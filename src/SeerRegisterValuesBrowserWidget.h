@@ -6,6 +6,7 @@
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QVector>
+#include <QtCore/QHash>
 #include <QtCore/QDebug>
 
 class SeerRegisterValuesBrowserWidget : public QWidget, protected Ui::SeerRegisterValuesBrowserWidgetForm {
@@ -22,6 +23,7 @@ class SeerRegisterValuesBrowserWidget : public QWidget, protected Ui::SeerRegist
     public slots:
         void                        handleText                              (const QString& text);
         void                        handleStoppingPointReached              ();
+        void                        handleSelectedFrameChanged              (int threadid, int frameno);
         void                        refresh                                 ();
 
     protected slots:
@@ -38,7 +40,8 @@ class SeerRegisterValuesBrowserWidget : public QWidget, protected Ui::SeerRegist
 
     signals:
         void                        refreshRegisterNames                    ();
-        void                        refreshRegisterValues                   (QString fmt);
+        void                        refreshRegisterValues                   (int id, QString fmt, QString numbers);
+        void                        refreshChangedRegisters                 (int id);
         void                        setRegisterValue                        (QString fmt, QString name, QString value);
 
     protected:
@@ -48,11 +51,25 @@ class SeerRegisterValuesBrowserWidget : public QWidget, protected Ui::SeerRegist
         bool                        readProfileSettings                     (const QString& profileName, QStringList& registerNames, QVector<bool>& registerEnabled);
         void                        writeProfileSettings                    (const QString& profileName, const QStringList& registerNames, const QVector<bool>& registerEnabled);
         void                        deleteProfileSettings                   (const QString& profileName);
+        void                        requestValues                           (int id);
+        QStringList                 frameValues                             () const;
+        void                        setValue                                (QTreeWidgetItem* item, const QString& value, bool flagChange);
 
     private:
         bool                        _needsRegisterNames;
         QStringList                 _registerNames;
         QVector<bool>               _registerEnabled;
+        QVector<QTreeWidgetItem*>   _registerItems;                         // Indexed by gdb's register number. 0 for unnamed numbers.
+        QVector<int>                _enabledNumbers;                        // Registers shown by the profile.
+        bool                        _allEnabled;                            // The profile shows all registers.
+        QVector<int>                _changedNumbers;                        // Registers highlighted as changed.
+        int                         _valuesId;
+        int                         _changedId;
+        int                         _syncId;
+        int                         _frameId;                               // Asking for the values of a newly selected frame.
+        QString                     _frameKey;                              // "thread:level" the values are of. "" until told, after a stop.
+        QString                     _stopKey;                               // "thread:level" the program stopped in.
+        QHash<QString,QStringList>  _frameValues;                           // Values, by register number, of the frames looked at since the stop.
         QAction*                    _newProfileAction;
         QAction*                    _modifyProfileAction;
         QAction*                    _deleteProfileAction;
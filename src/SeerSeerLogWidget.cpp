@@ -47,6 +47,6 @@ void SeerSeerLogWidget::processText (const QString& text) {
     QString str = Seer::filterEscapes(text);
 
     // Write the string to the log.
-    textEdit->append(str);
+    appendLine(str);
 }
 
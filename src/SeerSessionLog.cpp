@@ -0,0 +1,382 @@
+#include "SeerSessionLog.h"
+#include <QtCore/QMutexLocker>
+#include <QtCore/QDateTime>
+#include <QtCore/QStandardPaths>
+#include <QtCore/QCoreApplication>
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+#include <QtCore/QDebug>
+
+SeerSessionLog::SeerSessionLog (QObject* parent) : QThread(parent) {
+
+    _enabled        = false;
+    _directory      = defaultDirectory();
+    _maxFileSize    = 64;
+    _maxFiles       = 5;
+    _queuedBytes    = 0;
+    _droppedBytes   = 0;
+    _stop           = false;
+    _runMaxFileSize = 0;
+    _runMaxFiles    = 0;
+    _timestampMSecs = -1;
+}
+
+SeerSessionLog::~SeerSessionLog () {
+
+    stop();
+}
+
+void SeerSessionLog::setEnabled (bool flag) {
+
+    if (_enabled == flag) {
+        return;
+    }
+
+    _enabled = flag;
+
+    if (_enabled) {
+        restart();
+    }else{
+        stop();
+    }
+}
+
+bool SeerSessionLog::isEnabled () const {
+
+    return _enabled;
+}
+
+void SeerSessionLog::setDirectory (const QString& directory) {
+
+    QString dir = (directory == "" ? defaultDirectory() : directory);
+
+    if (_directory == dir) {
+        return;
+    }
+
+    _directory = dir;
+
+    if (_enabled) {
+        restart();
+    }
+}
+
+const QString& SeerSessionLog::directory () const {
+
+    return _directory;
+}
+
+void SeerSessionLog::setMaxFileSize (int megabytes) {
+
+    megabytes = qMax(megabytes, 1);
+
+    if (_maxFileSize == megabytes) {
+        return;
+    }
+
+    _maxFileSize = megabytes;
+
+    if (_enabled) {
+        restart();
+    }
+}
+
+int SeerSessionLog::maxFileSize () const {
+
+    return _maxFileSize;
+}
+
+void SeerSessionLog::setMaxFiles (int count) {
+
+    count = qMax(count, 1);
+
+    if (_maxFiles == count) {
+        return;
+    }
+
+    _maxFiles = count;
+
+    if (_enabled) {
+        restart();
+    }
+}
+
+int SeerSessionLog::maxFiles () const {
+
+    return _maxFiles;
+}
+
+void SeerSessionLog::write (Stream stream, const QByteArray& data) {
+
+    // Called for every line gdb sends. Keep it to a lock and an append.
+    if (_enabled == false || data.isEmpty()) {
+        return;
+    }
+
+    QMutexLocker locker(&_mutex);
+
+    if (_queuedBytes + data.size() > QueueLimit) {
+        _droppedBytes += data.size();
+        return;
+    }
+
+    Entry entry;
+    entry.msecs  = QDateTime::currentMSecsSinceEpoch();
+    entry.stream = stream;
+    entry.data   = data;
+
+    _queue.append(entry);
+    _queuedBytes += data.size();
+}
+
+QString SeerSessionLog::defaultDirectory () {
+
+    return QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation) + "/logs";
+}
+
+void SeerSessionLog::restart () {
+
+    stop();
+
+    // The thread isn't running. Hand it the settings.
+    _runDirectory   = _directory;
+    _runMaxFileSize = qint64(_maxFileSize) * 1024 * 1024;
+    _runMaxFiles    = _maxFiles;
+
+    {
+        QMutexLocker locker(&_mutex);
+
+        _stop = false;
+    }
+
+    start(QThread::LowPriority);
+}
+
+void SeerSessionLog::stop () {
+
+    {
+        QMutexLocker locker(&_mutex);
+
+        _stop = true;
+
+        _wakeup.wakeAll();
+    }
+
+    // The thread writes what's queued before it leaves.
+    wait();
+}
+
+bool SeerSessionLog::openFile (File& file) {
+
+    if (file.file.isOpen()) {
+        return true;
+    }
+
+    if (file.failed) {
+        return false;
+    }
+
+    if (QDir().mkpath(QFileInfo(file.path).absolutePath()) == false || file.file.open(QIODevice::WriteOnly | QIODevice::Append) == false) {
+        qWarning() << "Can't open session log" << file.path;
+        file.failed = true;
+        return false;
+    }
+
+    file.size = file.file.size();
+
+    QByteArray header = timestamp(QDateTime::currentMSecsSinceEpoch()) + " --- Seer session log opened. Pid " + QByteArray::number(QCoreApplication::applicationPid()) + ". ---\n";
+
+    file.file.write(header);
+    file.size += header.size();
+
+    return true;
+}
+
+void SeerSessionLog::closeFile (File& file) {
+
+    if (file.file.isOpen() == false) {
+        return;
+    }
+
+    flushFile(file);
+
+    // Finish a partial console line, so the next session starts on its own line.
+    if (file.lineStart == false) {
+        file.file.write("\n");
+        file.lineStart = true;
+    }
+
+    file.file.close();
+}
+
+void SeerSessionLog::flushFile (File& file) {
+
+    if (file.buffer.isEmpty()) {
+        return;
+    }
+
+    file.file.write(file.buffer);
+    file.file.flush();
+    file.buffer.clear();
+}
+
+void SeerSessionLog::rotateFile (File& file) {
+
+    flushFile(file);
+
+    file.file.close();
+
+    // Shift "name.1" .. "name.N-1" up by one. The oldest falls off the end.
+    if (_runMaxFiles > 1) {
+
+        QFile::remove(file.path + "." + QString::number(_runMaxFiles-1));
+
+        for (int i=_runMaxFiles-2; i>=1; i--) {
+            QFile::rename(file.path + "." + QString::number(i), file.path + "." + QString::number(i+1));
+        }
+
+        QFile::rename(file.path, file.path + ".1");
+
+    }else{
+        QFile::remove(file.path);
+    }
+
+    openFile(file);
+}
+
+void SeerSessionLog::appendRecord (File& file, const QByteArray& record) {
+
+    if (openFile(file) == false) {
+        return;
+    }
+
+    if (file.size > 0 && file.size + record.size() > _runMaxFileSize) {
+        rotateFile(file);
+    }
+
+    file.buffer += record;
+    file.size   += record.size();
+}
+
+const QByteArray& SeerSessionLog::timestamp (qint64 msecs) {
+
+    // Lines tend to come in bursts. Format each millisecond once.
+    if (msecs != _timestampMSecs) {
+        _timestampMSecs = msecs;
+        _timestamp      = QDateTime::fromMSecsSinceEpoch(msecs).toString("yyyy-MM-dd hh:mm:ss.zzz").toLatin1();
+    }
+
+    return _timestamp;
+}
+
+void SeerSessionLog::run () {
+
+    File mi;
+    mi.path      = _runDirectory + "/seergdb-mi.log";
+    mi.size      = 0;
+    mi.lineStart = true;
+    mi.failed    = false;
+    mi.file.setFileName(mi.path);
+
+    File console;
+    console.path      = _runDirectory + "/seergdb-console.log";
+    console.size      = 0;
+    console.lineStart = true;
+    console.failed    = false;
+    console.file.setFileName(console.path);
+
+    while (1) {
+
+        QVector<Entry> entries;
+        qint64         dropped;
+        bool           stopping;
+
+        {
+            QMutexLocker locker(&_mutex);
+
+            if (_stop == false) {
+                _wakeup.wait(&_mutex, FlushInterval);
+            }
+
+            entries.swap(_queue);
+
+            dropped       = _droppedBytes;
+            stopping      = _stop;
+
+            _queuedBytes  = 0;
+            _droppedBytes = 0;
+        }
+
+        if (dropped > 0) {
+
+            QByteArray note = " --- Seer: " + QByteArray::number(dropped) + " bytes were not logged. The disk fell behind. ---\n";
+
+            appendRecord(mi, timestamp(QDateTime::currentMSecsSinceEpoch()) + note);
+        }
+
+        for (int i=0; i<entries.size(); i++) {
+
+            const Entry& entry = entries[i];
+
+            if (entry.stream == Console) {
+
+                //
+                // Console output arrives in arbitrary chunks. Stamp each line where it
+                // starts, which may be in an earlier chunk.
+                //
+                const QByteArray& data   = entry.data;
+                QByteArray        record;
+                int               start  = 0;
+
+                record.reserve(data.size() + 64);
+
+                while (start < data.size()) {
+
+                    if (console.lineStart) {
+                        record += timestamp(entry.msecs);
+                        record += ' ';
+                    }
+
+                    int end = data.indexOf('\n', start);
+
+                    if (end < 0) {
+                        record += data.mid(start);
+                        console.lineStart = false;
+                        break;
+                    }
+
+                    record += data.mid(start, end - start + 1);
+                    console.lineStart = true;
+
+                    start = end + 1;
+                }
+
+                appendRecord(console, record);
+
+            }else{
+
+                // One line of MI per entry. Mark its direction.
+                QByteArray data = entry.data;
+
+                while (data.endsWith('\n') || data.endsWith('\r')) {
+                    data.chop(1);
+                }
+
+                const char* direction = (entry.stream == GdbInput ? " > " : (entry.stream == GdbOutput ? " < " : " ! "));
+
+                appendRecord(mi, timestamp(entry.msecs) + direction + data + '\n');
+            }
+        }
+
+        flushFile(mi);
+        flushFile(console);
+
+        if (stopping) {
+            break;
+        }
+    }
+
+    closeFile(mi);
+    closeFile(console);
+}
+
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <QtCore/QWaitCondition>
+#include <QtCore/QFile>
+#include <QtCore/QByteArray>
+#include <QtCore/QVector>
+#include <QtCore/QString>
+
+//
+// Writes the raw gdb/mi traffic and the program's console output to files on disk.
+//
+// Independent of the log widgets. Callers hand over bytes with write(), which only
+// queues them. A thread wakes a few times a second, timestamps each line and appends
+// it to "seergdb-mi.log" or "seergdb-console.log" in the log directory. A file that
+// grows past the size limit is renamed to ".1" (".1" to ".2", and so on) and a new
+// one is started. If the disk can't keep up, queued data past QueueLimit is dropped
+// and the loss is noted in the files.
+//
+class SeerSessionLog : public QThread {
+
+    Q_OBJECT
+
+    public:
+        enum Stream {
+            GdbInput  = 0,      // Commands sent to gdb.
+            GdbOutput = 1,      // gdb's stdout.
+            GdbError  = 2,      // gdb's stderr.
+            Console   = 3       // The program's tty.
+        };
+
+        explicit SeerSessionLog (QObject* parent = 0);
+       ~SeerSessionLog ();
+
+        void                                setEnabled              (bool flag);
+        bool                                isEnabled               () const;
+        void                                setDirectory            (const QString& directory);
+        const QString&                      directory               () const;
+        void                                setMaxFileSize          (int megabytes);
+        int                                 maxFileSize             () const;
+        void                                setMaxFiles             (int count);
+        int                                 maxFiles                () const;
+
+        void                                write                   (Stream stream, const QByteArray& data);
+
+        static QString                      defaultDirectory        ();
+
+        static const int                    QueueLimit    = 32 * 1024 * 1024;   // Bytes waiting to be written.
+        static const int                    FlushInterval = 250;                // Milliseconds between writes.
+
+    protected:
+        void                                run                     () override;
+
+    private:
+        struct Entry {
+            qint64                          msecs;
+            Stream                          stream;
+            QByteArray                      data;
+        };
+
+        struct File {
+            QFile                           file;
+            QString                         path;
+            qint64                          size;
+            bool                            lineStart;
+            bool                            failed;
+            QByteArray                      buffer;
+        };
+
+        void                                restart                 ();
+        void                                stop                    ();
+        bool                                openFile                (File& file);
+        void                                closeFile               (File& file);
+        void                                flushFile               (File& file);
+        void                                rotateFile              (File& file);
+        void                                appendRecord            (File& file, const QByteArray& record);
+        const QByteArray&                   timestamp               (qint64 msecs);
+
+        // Used by the GUI thread only.
+        bool                                _enabled;
+        QString                             _directory;
+        int                                 _maxFileSize;
+        int                                 _maxFiles;
+
+        // Shared with the writer thread.
+        QMutex                              _mutex;
+        QWaitCondition                      _wakeup;
+        QVector<Entry>                      _queue;
+        qint64                              _queuedBytes;
+        qint64                              _droppedBytes;
+        bool                                _stop;
+
+        // Used by the writer thread only.
+        QString                             _runDirectory;
+        qint64                              _runMaxFileSize;
+        int                                 _runMaxFiles;
+        qint64                              _timestampMSecs;
+        QByteArray                          _timestamp;
+};
+
@@ -1,12 +1,10 @@
 #include "SeerSourceBrowserWidget.h"
 #include "SeerUtl.h"
-#include <QtWidgets/QTreeWidget>
-#include <QtWidgets/QTreeWidgetItemIterator>
-#include <QtWidgets/QLabel>
-#include <QtWidgets/QApplication>
-#include <QtCore/QFileInfo>
+#include <QtWidgets/QTreeView>
+#include <QtWidgets/QHeaderView>
+#include <QtWidgets/QCheckBox>
+#include <QtCore/QSettings>
 #include <QtCore/Qt>
-#include <QtCore/QMap>
 #include <QtCore/QDebug>
 
 SeerSourceBrowserWidget::SeerSourceBrowserWidget (QWidget* parent) : QWidget(parent) {
@@ -15,33 +13,32 @@ SeerSourceBrowserWidget::SeerSourceBrowserWidget (QWidget* parent) : QWidget(par
     setupUi(this);
 
     // Setup the widgets
-    sourceSearchLineEdit->setPlaceholderText("Search regex...");
+    sourceSearchLineEdit->setPlaceholderText("Search files...");
     sourceSearchLineEdit->setClearButtonEnabled(true);
 
-    _sourceFilesItems = new QTreeWidgetItem;
-    _sourceFilesItems->setText(0, "Source files");
+    _fileModel      = new SeerSourceFileModel(this);
+    _fileLoader     = new SeerSourceFileLoader(this);
+    _fileGeneration = 0;
 
-    _headerFilesItems = new QTreeWidgetItem;
-    _headerFilesItems->setText(0, "Header files");
-
-    _miscFilesItems = new QTreeWidgetItem;
-    _miscFilesItems->setText(0, "Misc files");
-
-    sourceTreeWidget->setMouseTracking(true);
-    sourceTreeWidget->addTopLevelItem(_sourceFilesItems);
-    sourceTreeWidget->addTopLevelItem(_headerFilesItems);
-    sourceTreeWidget->addTopLevelItem(_miscFilesItems);
-    sourceTreeWidget->resizeColumnToContents(0);
-    sourceTreeWidget->resizeColumnToContents(1);
+    sourceTreeView->setModel(_fileModel);
+    sourceTreeView->setUniformRowHeights(true);
+    sourceTreeView->setSortingEnabled(false); // The files are already sorted by name.
+    sourceTreeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    sourceTreeView->resizeColumnToContents(0);
 
     _sourceFilePatterns = QStringList( {"*.cpp", "*.c", "*.C", "*.f", "*.f90", ".F90", "*.rs", "*.go", "*.ada", "*.adb"} ); // Default settings.
     _headerFilePatterns = QStringList( {"*.hpp", "*.h", "*.ads"} );
     _miscFilePatterns   = QStringList( {"/usr/include/"} );
 
+    // Restore settings.
+    readSettings();
+
     // Connect things.
-    QObject::connect(sourceTreeWidget,      &QTreeWidget::itemDoubleClicked,    this,  &SeerSourceBrowserWidget::handleItemDoubleClicked);
-    QObject::connect(sourceTreeWidget,      &QTreeWidget::itemEntered,          this,  &SeerSourceBrowserWidget::handleItemEntered);
+    QObject::connect(sourceTreeView,        &QTreeView::doubleClicked,          this,  &SeerSourceBrowserWidget::handleItemDoubleClicked);
     QObject::connect(sourceSearchLineEdit,  &QLineEdit::textChanged,            this,  &SeerSourceBrowserWidget::handleSearchLineEdit);
+    QObject::connect(sourceSearchLineEdit,  &QLineEdit::returnPressed,          this,  &SeerSourceBrowserWidget::handleSearchReturnPressed);
+    QObject::connect(flatCheckBox,          &QCheckBox::toggled,                this,  &SeerSourceBrowserWidget::handleFlatCheckBox);
+    QObject::connect(_fileLoader,           &SeerSourceFileLoader::loaded,      this,  &SeerSourceBrowserWidget::handleFilesLoaded);
 }
 
 SeerSourceBrowserWidget::~SeerSourceBrowserWidget () {
@@ -89,191 +86,133 @@ const QStringList& SeerSourceBrowserWidget::ignoreFilePatterns () const {
 
 void SeerSourceBrowserWidget::handleText (const QString& text) {
 
-    QApplication::setOverrideCursor(Qt::BusyCursor);
-
     if (text.startsWith("^done,files=[") && text.endsWith("]")) {
 
-        // Delete previous files.
-        foreach (auto i, _sourceFilesItems->takeChildren()) {
-            delete i;
-        }
+        //
+        // Parsing, removing duplicates and putting each file in its folder is done
+        // off the GUI thread. A large program can have tens of thousands of files.
+        // See handleFilesLoaded().
+        //
+        _fileGeneration++;
 
-        foreach (auto i, _headerFilesItems->takeChildren()) {
-            delete i;
-        }
+        _fileLoader->load(_fileGeneration, text, sourceFilePatterns(), headerFilePatterns(), miscFilePatterns(), ignoreFilePatterns());
 
-        foreach (auto i, _miscFilesItems->takeChildren()) {
-            delete i;
-        }
-
-        // ^done,files=[
-        //     {file=\"../sysdeps/x86_64/start.S\",fullname=\"/home/abuild/rpmbuild/BUILD/glibc-2.26/csu/../sysdeps/x86_64/start.S\"},
-        //     {file=\"helloworld.cpp\",fullname=\"/home/erniep/Development/Peak/src/Seer/helloworld/helloworld.cpp\"}
-        // ]
-
-        QString files_text     = Seer::parseFirst(text, "files=", '[', ']', false);
-        QStringList files_list = Seer::parse(files_text, "", '{', '}', false);
-
-        // Set up a map to look for duplicate entries.  QMap<fullname,file>
-        QMap<QString,QString> files;
-
-        for (const auto& entry_text : files_list) {
+    }else{
+        // Ignore others.
+    }
+}
 
-            QString file_text     = Seer::parseFirst(entry_text, "file=",     '"', '"', false);
-            QString fullname_text = Seer::parseFirst(entry_text, "fullname=", '"', '"', false);
+void SeerSourceBrowserWidget::handleFilesLoaded () {
 
-            //qDebug() << file_text << fullname_text;
+    QVector<SeerSourceFile> files;
 
-            // Skip duplicates
-            if (files.contains(fullname_text)) {
-                continue;
-            }
+    int generation = _fileLoader->result(files);
 
-            files.insert(fullname_text, file_text);
+    // A newer list is on its way.
+    if (generation != _fileGeneration) {
+        return;
+    }
 
-            // Add the file to the tree.
-            QTreeWidgetItem* item = new QTreeWidgetItem;
-            item->setText(0, QFileInfo(file_text).fileName());
-            item->setText(1, fullname_text);
+    // The filter that's typed in is kept. It's applied to the new files.
+    _fileModel->setFiles(files);
 
-            // See which pattern the file matches. Put the file under that folder.
-            // If no match, put it in 'misc'.
+    showMatches();
+}
 
-            if (Seer::matchesWildcard(ignoreFilePatterns(), fullname_text)) {
-                continue;
-            }else if (Seer::matchesWildcard(miscFilePatterns(), fullname_text)) {
-                _miscFilesItems->addChild(item);
-            }else if (Seer::matchesWildcard(sourceFilePatterns(), fullname_text)) {
-                _sourceFilesItems->addChild(item);
-            }else if (Seer::matchesWildcard(headerFilePatterns(), fullname_text)) {
-                _headerFilesItems->addChild(item);
-            }else{
-                _miscFilesItems->addChild(item);
-            }
-        }
+void SeerSourceBrowserWidget::handleItemDoubleClicked (const QModelIndex& index) {
 
-        _sourceFilesItems->setExpanded(true);
-        _headerFilesItems->setExpanded(false);
-        _miscFilesItems->setExpanded(false);
+    const SeerSourceFile* file = _fileModel->file(index);
 
-    }else{
-        // Ignore others.
+    // A folder.
+    if (file == 0) {
+        return;
     }
 
-    sourceTreeWidget->resizeColumnToContents(0);
-    sourceTreeWidget->resizeColumnToContents(1);
-    sourceTreeWidget->sortByColumn(0, Qt::AscendingOrder);
-    sourceTreeWidget->setSortingEnabled(true);
-
-    sourceSearchLineEdit->clear();
-
-    QApplication::restoreOverrideCursor();
+    emit selectedFile(file->name, file->fullname, 0);
 }
 
-void SeerSourceBrowserWidget::handleItemDoubleClicked (QTreeWidgetItem* item, int column) {
+void SeerSourceBrowserWidget::handleSearchLineEdit (const QString& text) {
 
-    Q_UNUSED(column);
+    _fileModel->setFilter(text);
 
-    emit selectedFile(item->text(0), item->text(1), 0);
+    showMatches();
 }
 
-void SeerSourceBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
+void SeerSourceBrowserWidget::handleSearchReturnPressed () {
 
-    Q_UNUSED(column);
+    // Open the selected file, or the first match.
+    QModelIndex index = sourceTreeView->currentIndex();
 
-    //qDebug() << item->text(0) << column;
+    if (_fileModel->file(index) == 0) {
+        index = _fileModel->firstMatch();
+    }
 
-    if (item->text(1) == "") { // Look at the FullName.
-        for (int i=0; i<sourceTreeWidget->columnCount(); i++) { // The top-level items do not have a tooltip.
-            item->setToolTip(i, "");
-        }
+    handleItemDoubleClicked(index);
+}
 
-    }else{
-        item->setToolTip(0, item->text(0) + " : " + item->text(1));
+void SeerSourceBrowserWidget::handleFlatCheckBox (bool checked) {
 
-        for (int i=1; i<sourceTreeWidget->columnCount(); i++) { // Copy tooltip to the other columns.
-            item->setToolTip(i, item->toolTip(0));
-        }
-    }
+    _fileModel->setFlat(checked);
+
+    showMatches();
+
+    writeSettings();
 }
 
-void SeerSourceBrowserWidget::handleSearchLineEdit (const QString& text) {
+void SeerSourceBrowserWidget::showMatches () {
 
-    // Set everything to a normal font. If there is no search text, unhide everything.
-    // If there is search text, hide everything so the matching ones can be unhidden later on.
-    QTreeWidgetItemIterator it(sourceTreeWidget);
+    bool filtered = sourceSearchLineEdit->text().trimmed().isEmpty() == false;
 
-    if (*it) {
+    // Without a filter, only the source files are expanded. With one, every folder that has a match is.
+    if (_fileModel->isFlat() == false) {
 
-        QFont f0 = (*it)->font(0);
-        QFont f1 = (*it)->font(1);
+        for (int folder=0; folder<SeerSourceFileLoader::FolderCount; folder++) {
 
-        f0.setBold(false);
-        f1.setBold(false);
+            QModelIndex index = _fileModel->folderIndex(folder);
 
-        if (text == "") {
-            while (*it) {
-                (*it)->setHidden(false); // No search text, unhide everything.
-                (*it)->setFont(0,f0);
-                (*it)->setFont(1,f1);
-                ++it;
-            }
-        }else{
-            while (*it) {
-                (*it)->setHidden(true); // Has serach text, hide everything. Matching items to be unhidden below.
-                (*it)->setFont(0,f0);
-                (*it)->setFont(1,f1);
-                ++it;
+            if (filtered) {
+                sourceTreeView->setExpanded(index, _fileModel->rowCount(index) > 0);
+            }else{
+                sourceTreeView->setExpanded(index, folder == SeerSourceFileLoader::SourceFolder);
             }
         }
     }
 
-    // Set selected items to a bold font and unhidden. Move to the first match.
-    if (text != "") {
-
-        _sourceFilesItems->setHidden(false);
-        _headerFilesItems->setHidden(false);
-        _miscFilesItems->setHidden(false);
-
-        QList<QTreeWidgetItem*> matches;
+    // Move to the first match.
+    if (filtered) {
 
-        matches = sourceTreeWidget->findItems(text, Qt::MatchRegularExpression | Qt::MatchRecursive, 0);
+        QModelIndex index = _fileModel->firstMatch();
 
-        QList<QTreeWidgetItem*>::const_iterator it = matches.begin();
-        QList<QTreeWidgetItem*>::const_iterator e  = matches.end();
+        if (index.isValid()) {
+            sourceTreeView->setCurrentIndex(index);
+            sourceTreeView->scrollTo(index);
+        }
+    }
 
-        if (it != e) {
+    sourceTreeView->resizeColumnToContents(0);
+}
 
-            sourceTreeWidget->setCurrentItem(*it);
+void SeerSourceBrowserWidget::refresh () {
+    emit refreshSourceList();
+}
 
-            QFont f0 = (*it)->font(0);
-            QFont f1 = (*it)->font(1);
+void SeerSourceBrowserWidget::writeSettings () {
 
-            f0.setBold(true);
-            f1.setBold(true);
+    QSettings settings;
 
-            while (it != e) {
-                if (*it != _sourceFilesItems && *it != _headerFilesItems && *it != _miscFilesItems) {
-                    (*it)->setHidden(false);
-                    (*it)->setFont(0,f0);
-                    (*it)->setFont(1,f1);
-                }
-                it++;
-            }
-        }
+    settings.beginGroup("sourcebrowserwindow"); {
+        settings.setValue("flat", flatCheckBox->isChecked());
+    } settings.endGroup();
+}
 
-        _sourceFilesItems->setExpanded(true);
-        _headerFilesItems->setExpanded(false);
-        _miscFilesItems->setExpanded(false);
+void SeerSourceBrowserWidget::readSettings () {
 
-        //qDebug() << text << matches.size();
-    }
+    QSettings settings;
 
-    sourceTreeWidget->resizeColumnToContents(0);
-    sourceTreeWidget->resizeColumnToContents(1);
-}
+    settings.beginGroup("sourcebrowserwindow"); {
+        flatCheckBox->setChecked(settings.value("flat", false).toBool());
+    } settings.endGroup();
 
-void SeerSourceBrowserWidget::refresh () {
-    emit refreshSourceList();
+    _fileModel->setFlat(flatCheckBox->isChecked());
 }
 
@@ -1,6 +1,9 @@
 #pragma once
 
+#include "SeerSourceFileLoader.h"
+#include "SeerSourceFileModel.h"
 #include <QtWidgets/QWidget>
+#include <QtCore/QModelIndex>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include "ui_SeerSourceBrowserWidget.h"
@@ -31,18 +34,24 @@ class SeerSourceBrowserWidget : public QWidget, protected Ui::SeerSourceBrowserW
 
     protected slots:
         void                        handleSearchLineEdit        (const QString& text);
-        void                        handleItemDoubleClicked     (QTreeWidgetItem* item, int column);
-        void                        handleItemEntered           (QTreeWidgetItem* item, int column);
+        void                        handleSearchReturnPressed   ();
+        void                        handleFlatCheckBox          (bool checked);
+        void                        handleFilesLoaded           ();
+        void                        handleItemDoubleClicked     (const QModelIndex& index);
 
     signals:
         void                        refreshSourceList           ();
         void                        selectedFile                (QString file, QString fullname, int lineno);
 
     protected:
+        void                        showMatches                 ();
+        void                        writeSettings               ();
+        void                        readSettings                ();
+
     private:
-        QTreeWidgetItem*            _sourceFilesItems;
-        QTreeWidgetItem*            _headerFilesItems;
-        QTreeWidgetItem*            _miscFilesItems;
+        SeerSourceFileLoader*       _fileLoader;
+        SeerSourceFileModel*        _fileModel;
+        int                         _fileGeneration;
         QStringList                 _sourceFilePatterns;
         QStringList                 _headerFilePatterns;
         QStringList                 _miscFilePatterns;
@@ -0,0 +1,199 @@
+#include "SeerSourceFileLoader.h"
+#include "SeerUtl.h"
+#include <QtCore/QMutexLocker>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSet>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+SeerSourceFileLoader::SeerSourceFileLoader (QObject* parent) : QThread(parent) {
+
+    _running           = false;
+    _pending           = false;
+    _stop              = false;
+    _requestGeneration = 0;
+    _resultGeneration  = 0;
+}
+
+SeerSourceFileLoader::~SeerSourceFileLoader () {
+
+    {
+        QMutexLocker locker(&_mutex);
+
+        _stop    = true;
+        _pending = false;
+    }
+
+    wait();
+}
+
+void SeerSourceFileLoader::load (int generation, const QString& text, const QStringList& sourcePatterns, const QStringList& headerPatterns, const QStringList& miscPatterns, const QStringList& ignorePatterns) {
+
+    QMutexLocker locker(&_mutex);
+
+    // Replace any pending request. QString and QStringList are implicitly shared,
+    // so nothing is copied here.
+    _requestGeneration     = generation;
+    _requestText           = text;
+    _requestSourcePatterns = sourcePatterns;
+    _requestHeaderPatterns = headerPatterns;
+    _requestMiscPatterns   = miscPatterns;
+    _requestIgnorePatterns = ignorePatterns;
+    _pending               = true;
+
+    if (_running == true) {
+        return;
+    }
+
+    _running = true;
+
+    locker.unlock();
+
+    // The thread may still be on its way out of run(). Let it finish before restarting it.
+    wait();
+    start(QThread::LowPriority);
+}
+
+int SeerSourceFileLoader::result (QVector<SeerSourceFile>& files) {
+
+    QMutexLocker locker(&_mutex);
+
+    files.clear();
+    files.swap(_resultFiles);
+
+    return _resultGeneration;
+}
+
+void SeerSourceFileLoader::run () {
+
+    while (1) {
+
+        // Take the pending request, if any.
+        int         generation;
+        QString     text;
+        QStringList sourcePatterns;
+        QStringList headerPatterns;
+        QStringList miscPatterns;
+        QStringList ignorePatterns;
+
+        {
+            QMutexLocker locker(&_mutex);
+
+            if (_pending == false || _stop == true) {
+                _running = false;
+                return;
+            }
+
+            generation     = _requestGeneration;
+            text           = _requestText;
+            sourcePatterns = _requestSourcePatterns;
+            headerPatterns = _requestHeaderPatterns;
+            miscPatterns   = _requestMiscPatterns;
+            ignorePatterns = _requestIgnorePatterns;
+            _pending       = false;
+
+            _requestText = QString();
+        }
+
+        // ^done,files=[
+        //     {file=\"../sysdeps/x86_64/start.S\",fullname=\"/home/abuild/rpmbuild/BUILD/glibc-2.26/csu/../sysdeps/x86_64/start.S\"},
+        //     {file=\"helloworld.cpp\",fullname=\"/home/erniep/Development/Peak/src/Seer/helloworld/helloworld.cpp\"}
+        // ]
+
+        QString     files_text = Seer::parseFirst(text, "files=", '[', ']', false);
+        QStringList files_list = Seer::parse(files_text, "", '{', '}', false);
+
+        text       = QString();
+        files_text = QString();
+
+        // Convert the patterns once, not once per file.
+        QVector<QRegularExpression> sourceExpressions = Seer::wildcardExpressions(sourcePatterns);
+        QVector<QRegularExpression> headerExpressions = Seer::wildcardExpressions(headerPatterns);
+        QVector<QRegularExpression> miscExpressions   = Seer::wildcardExpressions(miscPatterns);
+        QVector<QRegularExpression> ignoreExpressions = Seer::wildcardExpressions(ignorePatterns);
+
+        QVector<SeerSourceFile> files;
+        QSet<QString>           fullnames;
+        bool                    aborted = false;
+
+        files.reserve(files_list.size());
+        fullnames.reserve(files_list.size());
+
+        for (int i=0; i<files_list.size(); i++) {
+
+            // Stop if a newer request came in.
+            if (i % 4096 == 4095) {
+
+                QMutexLocker locker(&_mutex);
+
+                if (_pending == true || _stop == true) {
+                    aborted = true;
+                    break;
+                }
+            }
+
+            const QString& entry_text = files_list[i];
+
+            QString file_text     = Seer::parseFirst(entry_text, "file=",     '"', '"', false);
+            QString fullname_text = Seer::parseFirst(entry_text, "fullname=", '"', '"', false);
+
+            // Skip duplicates
+            if (fullnames.contains(fullname_text)) {
+                continue;
+            }
+
+            fullnames.insert(fullname_text);
+
+            // See which pattern the file matches. Put the file under that folder.
+            // If no match, put it in 'misc'.
+            SeerSourceFile file;
+
+            if (Seer::matchesWildcard(ignoreExpressions, fullname_text)) {
+                continue;
+            }else if (Seer::matchesWildcard(miscExpressions, fullname_text)) {
+                file.folder = MiscFolder;
+            }else if (Seer::matchesWildcard(sourceExpressions, fullname_text)) {
+                file.folder = SourceFolder;
+            }else if (Seer::matchesWildcard(headerExpressions, fullname_text)) {
+                file.folder = HeaderFolder;
+            }else{
+                file.folder = MiscFolder;
+            }
+
+            file.name     = QFileInfo(file_text).fileName();
+            file.fullname = fullname_text;
+            file.nameKey  = file.name.toLower();
+            file.fullKey  = file.fullname.toLower();
+
+            files.append(file);
+        }
+
+        if (aborted == true) {
+            continue;
+        }
+
+        // By short name, ignoring case. The full name keeps the order of files with the same name.
+        std::sort(files.begin(), files.end(), [](const SeerSourceFile& a, const SeerSourceFile& b) {
+            if (a.nameKey != b.nameKey) {
+                return a.nameKey < b.nameKey;
+            }
+            return a.fullname < b.fullname;
+        });
+
+        // Hand over the table, unless a newer request came in.
+        {
+            QMutexLocker locker(&_mutex);
+
+            if (_pending == true || _stop == true) {
+                continue;
+            }
+
+            _resultGeneration = generation;
+            _resultFiles.swap(files);
+        }
+
+        emit loaded();
+    }
+}
+
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <QtCore/QStringList>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+//
+// One file from gdb's list of source files.
+//
+struct SeerSourceFile {
+    QString     name;       // The short name, "helloworld.cpp".
+    QString     fullname;   // "/home/erniep/Development/Peak/src/Seer/helloworld/helloworld.cpp".
+    QString     nameKey;    // The short name, lower case. Searched by the filter.
+    QString     fullKey;    // The full name, lower case. Searched by the filter.
+    int         folder;     // SeerSourceFileLoader::SourceFolder, HeaderFolder or MiscFolder.
+};
+
+//
+// Turns the reply to "-file-list-exec-source-files" into a table of files.
+//
+// Runs off the GUI thread. The reply is parsed, duplicate full names are
+// dropped, each file is put in a folder by the file patterns from Config->Source
+// and the table is sorted by short name. The lower case search keys are made
+// here too, so the filter doesn't make them on each keystroke.
+//
+// A reply that arrives while one is loading replaces any pending one. Only the
+// latest table is kept.
+//
+class SeerSourceFileLoader : public QThread {
+
+    Q_OBJECT
+
+    public:
+        enum Folder {
+            SourceFolder    = 0,
+            HeaderFolder    = 1,
+            MiscFolder      = 2,
+            FolderCount     = 3
+        };
+
+        explicit SeerSourceFileLoader (QObject* parent = 0);
+       ~SeerSourceFileLoader ();
+
+        void                                load                    (int generation, const QString& text, const QStringList& sourcePatterns, const QStringList& headerPatterns, const QStringList& miscPatterns, const QStringList& ignorePatterns);
+        int                                 result                  (QVector<SeerSourceFile>& files);
+
+    signals:
+        void                                loaded                  ();
+
+    protected:
+        void                                run                     () override;
+
+    private:
+        QMutex                              _mutex;
+        bool                                _running;
+        bool                                _pending;
+        bool                                _stop;
+
+        int                                 _requestGeneration;
+        QString                             _requestText;
+        QStringList                         _requestSourcePatterns;
+        QStringList                         _requestHeaderPatterns;
+        QStringList                         _requestMiscPatterns;
+        QStringList                         _requestIgnorePatterns;
+
+        int                                 _resultGeneration;
+        QVector<SeerSourceFile>             _resultFiles;
+};
+
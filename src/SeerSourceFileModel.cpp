@@ -0,0 +1,390 @@
+#include "SeerSourceFileModel.h"
+#include <QtGui/QFont>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+SeerSourceFileModel::SeerSourceFileModel (QObject* parent) : QAbstractItemModel(parent) {
+
+    _wildcard = false;
+    _flat     = false;
+}
+
+SeerSourceFileModel::~SeerSourceFileModel () {
+}
+
+QModelIndex SeerSourceFileModel::index (int row, int column, const QModelIndex& parent) const {
+
+    if (row < 0 || column < 0 || column >= ColumnCount) {
+        return QModelIndex();
+    }
+
+    //
+    // The internal id is 0 for a folder and for a file in the flat list.
+    // For a file under a folder, it's the folder plus 1.
+    //
+    if (_flat == true) {
+
+        if (parent.isValid() || row >= _flatRows.size()) {
+            return QModelIndex();
+        }
+
+        return createIndex(row, column, quintptr(0));
+    }
+
+    if (parent.isValid() == false) {
+
+        if (row >= SeerSourceFileLoader::FolderCount) {
+            return QModelIndex();
+        }
+
+        return createIndex(row, column, quintptr(0));
+    }
+
+    if (parent.internalId() != 0 || parent.row() >= SeerSourceFileLoader::FolderCount || row >= _folders[parent.row()].size()) {
+        return QModelIndex();
+    }
+
+    return createIndex(row, column, quintptr(parent.row() + 1));
+}
+
+QModelIndex SeerSourceFileModel::parent (const QModelIndex& index) const {
+
+    if (index.isValid() == false || _flat == true || index.internalId() == 0) {
+        return QModelIndex();
+    }
+
+    return createIndex(int(index.internalId() - 1), 0, quintptr(0));
+}
+
+int SeerSourceFileModel::rowCount (const QModelIndex& parent) const {
+
+    if (_flat == true) {
+        return parent.isValid() ? 0 : _flatRows.size();
+    }
+
+    if (parent.isValid() == false) {
+        return SeerSourceFileLoader::FolderCount;
+    }
+
+    // Only the first column of a folder has children.
+    if (parent.internalId() != 0 || parent.column() != 0) {
+        return 0;
+    }
+
+    return _folders[parent.row()].size();
+}
+
+int SeerSourceFileModel::columnCount (const QModelIndex& parent) const {
+
+    Q_UNUSED(parent);
+
+    return ColumnCount;
+}
+
+QVariant SeerSourceFileModel::data (const QModelIndex& index, int role) const {
+
+    if (index.isValid() == false) {
+        return QVariant();
+    }
+
+    int row = fileRow(index);
+
+    // A folder. Show how many of its files match.
+    if (row < 0) {
+
+        if (_flat == true || index.internalId() != 0 || role != Qt::DisplayRole || index.column() != FileColumn) {
+            return QVariant();
+        }
+
+        int count = _folders[index.row()].size();
+
+        switch (index.row()) {
+            case SeerSourceFileLoader::SourceFolder: return tr("Source files (%1)").arg(count);
+            case SeerSourceFileLoader::HeaderFolder: return tr("Header files (%1)").arg(count);
+            case SeerSourceFileLoader::MiscFolder:   return tr("Misc files (%1)").arg(count);
+        }
+
+        return QVariant();
+    }
+
+    const SeerSourceFile& file = _files[row];
+
+    if (role == Qt::DisplayRole) {
+        return index.column() == FileColumn ? file.name : file.fullname;
+    }
+
+    if (role == Qt::ToolTipRole) {
+        return file.name + " : " + file.fullname;
+    }
+
+    // Files whose name has the filter text in it are in bold.
+    if (role == Qt::FontRole && _filter.isEmpty() == false && _scores[row] <= NameSubstring) {
+        QFont font;
+        font.setBold(true);
+        return font;
+    }
+
+    return QVariant();
+}
+
+QVariant SeerSourceFileModel::headerData (int section, Qt::Orientation orientation, int role) const {
+
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (section) {
+        case FileColumn:     return tr("File");
+        case FullnameColumn: return tr("Full Name");
+    }
+
+    return QVariant();
+}
+
+void SeerSourceFileModel::setFiles (const QVector<SeerSourceFile>& files) {
+
+    beginResetModel();
+
+    _files = files;
+
+    refilter(false);
+
+    endResetModel();
+}
+
+void SeerSourceFileModel::setFilter (const QString& text) {
+
+    QString filter   = text.trimmed().toLower();
+    bool    wildcard = filter.contains('*') || filter.contains('?');
+
+    if (filter == _filter) {
+        return;
+    }
+
+    // A longer plain filter only matches files that matched the shorter one.
+    bool narrow = _filter.isEmpty() == false && _wildcard == false && wildcard == false && filter.startsWith(_filter);
+
+    _filter   = filter;
+    _wildcard = wildcard;
+
+    if (_wildcard == true) {
+
+        // '*' is any text, '?' any one character. The rest is literal.
+        QString pattern;
+
+        for (const QChar& c : _filter) {
+            if (c == '*') {
+                pattern += ".*";
+            }else if (c == '?') {
+                pattern += ".";
+            }else{
+                pattern += QRegularExpression::escape(QString(c));
+            }
+        }
+
+        _wildcardExpression = QRegularExpression(pattern);
+    }else{
+        _wildcardExpression = QRegularExpression();
+    }
+
+    beginResetModel();
+
+    refilter(narrow);
+
+    endResetModel();
+}
+
+void SeerSourceFileModel::setFlat (bool flat) {
+
+    if (flat == _flat) {
+        return;
+    }
+
+    beginResetModel();
+
+    _flat = flat;
+
+    endResetModel();
+}
+
+bool SeerSourceFileModel::isFlat () const {
+
+    return _flat;
+}
+
+void SeerSourceFileModel::clear () {
+
+    setFiles(QVector<SeerSourceFile>());
+}
+
+QModelIndex SeerSourceFileModel::folderIndex (int folder) const {
+
+    if (_flat == true || folder < 0 || folder >= SeerSourceFileLoader::FolderCount) {
+        return QModelIndex();
+    }
+
+    return index(folder, 0);
+}
+
+QModelIndex SeerSourceFileModel::firstMatch () const {
+
+    if (_flat == true) {
+        return index(0, 0);
+    }
+
+    for (int folder=0; folder<SeerSourceFileLoader::FolderCount; folder++) {
+        if (_folders[folder].isEmpty() == false) {
+            return index(0, 0, folderIndex(folder));
+        }
+    }
+
+    return QModelIndex();
+}
+
+const SeerSourceFile* SeerSourceFileModel::file (const QModelIndex& index) const {
+
+    int row = fileRow(index);
+
+    if (row < 0) {
+        return 0;
+    }
+
+    return &_files[row];
+}
+
+int SeerSourceFileModel::fileCount () const {
+
+    return _files.size();
+}
+
+int SeerSourceFileModel::matchCount () const {
+
+    return _matches.size();
+}
+
+int SeerSourceFileModel::fileRow (const QModelIndex& index) const {
+
+    if (index.isValid() == false) {
+        return -1;
+    }
+
+    if (_flat == true) {
+        return index.row() < _flatRows.size() ? _flatRows[index.row()] : -1;
+    }
+
+    if (index.internalId() == 0) {
+        return -1;
+    }
+
+    const QVector<int>& rows = _folders[index.internalId() - 1];
+
+    return index.row() < rows.size() ? rows[index.row()] : -1;
+}
+
+int SeerSourceFileModel::score (const SeerSourceFile& file) const {
+
+    if (_wildcard == true) {
+
+        // Like the folder patterns, a wildcard with a '/' in it is for the full name.
+        const QString& key = _filter.contains('/') ? file.fullKey : file.nameKey;
+
+        return _wildcardExpression.match(key).hasMatch() ? NameSubstring : NoMatch;
+    }
+
+    if (file.nameKey.startsWith(_filter)) {
+        return NamePrefix;
+    }
+
+    if (file.nameKey.contains(_filter)) {
+        return NameSubstring;
+    }
+
+    if (file.fullKey.contains(_filter)) {
+        return PathSubstring;
+    }
+
+    // The letters of the filter, in order, anywhere in the short name.
+    const QChar* name    = file.nameKey.constData();
+    const QChar* nameEnd = name + file.nameKey.size();
+    const QChar* c       = _filter.constData();
+    const QChar* cEnd    = c + _filter.size();
+
+    for (; name != nameEnd && c != cEnd; ++name) {
+        if (*name == *c) {
+            ++c;
+        }
+    }
+
+    return c == cEnd ? NameLetters : NoMatch;
+}
+
+void SeerSourceFileModel::refilter (bool narrow) {
+
+    //
+    // Score the files. If the filter only got longer, only the files that
+    // matched before can match now.
+    //
+    if (_filter.isEmpty()) {
+
+        _scores.fill(NamePrefix, _files.size());
+
+        _matches.resize(_files.size());
+
+        for (int i=0; i<_files.size(); i++) {
+            _matches[i] = i;
+        }
+
+    }else if (narrow == true) {
+
+        QVector<int> matches;
+
+        matches.reserve(_matches.size());
+
+        for (int i : _matches) {
+
+            _scores[i] = qint8(score(_files[i]));
+
+            if (_scores[i] != NoMatch) {
+                matches.append(i);
+            }
+        }
+
+        _matches.swap(matches);
+
+    }else{
+
+        _scores.resize(_files.size());
+        _matches.clear();
+
+        for (int i=0; i<_files.size(); i++) {
+
+            _scores[i] = qint8(score(_files[i]));
+
+            if (_scores[i] != NoMatch) {
+                _matches.append(i);
+            }
+        }
+    }
+
+    arrange();
+}
+
+void SeerSourceFileModel::arrange () {
+
+    // The matches under each folder, in table order.
+    for (int folder=0; folder<SeerSourceFileLoader::FolderCount; folder++) {
+        _folders[folder].clear();
+    }
+
+    for (int i : _matches) {
+        _folders[_files[i].folder].append(i);
+    }
+
+    // The flat list, best matches first. Table order within the same score.
+    _flatRows = _matches;
+
+    if (_filter.isEmpty() == false) {
+        std::stable_sort(_flatRows.begin(), _flatRows.end(), [this](int a, int b) { return _scores[a] < _scores[b]; });
+    }
+}
+
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "SeerSourceFileLoader.h"
+#include <QtCore/QAbstractItemModel>
+#include <QtCore/QModelIndex>
+#include <QtCore/QVariant>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QVector>
+#include <QtCore/QString>
+
+//
+// The program's source files, for the source browser.
+//
+// The files are a table sorted by short name, made by SeerSourceFileLoader.
+// They are shown either under the "Source files", "Header files" and "Misc files"
+// folders, or as one flat list.
+//
+// The filter is run over the table's lower case keys. Plain text matches the
+// short or full name, or the letters of the short name in order ("sbw" finds
+// "SeerSourceBrowserWidget.cpp"). Text with a '*' or '?' is a wildcard. When the
+// filter only gets longer, just the files that matched before are looked at
+// again. The flat list puts the best matches first.
+//
+class SeerSourceFileModel : public QAbstractItemModel {
+
+    Q_OBJECT
+
+    public:
+        enum Column {
+            FileColumn      = 0,
+            FullnameColumn  = 1,
+            ColumnCount     = 2
+        };
+
+        explicit SeerSourceFileModel (QObject* parent = 0);
+       ~SeerSourceFileModel ();
+
+        QModelIndex                         index                   (int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex                         parent                  (const QModelIndex& index) const override;
+        int                                 rowCount                (const QModelIndex& parent = QModelIndex()) const override;
+        int                                 columnCount             (const QModelIndex& parent = QModelIndex()) const override;
+        QVariant                            data                    (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant                            headerData              (int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+        void                                setFiles                (const QVector<SeerSourceFile>& files);
+        void                                setFilter               (const QString& text);
+        void                                setFlat                 (bool flat);
+        bool                                isFlat                  () const;
+        void                                clear                   ();
+
+        QModelIndex                         folderIndex             (int folder) const;
+        QModelIndex                         firstMatch              () const;
+        const SeerSourceFile*               file                    (const QModelIndex& index) const;
+        int                                 fileCount               () const;
+        int                                 matchCount              () const;
+
+    private:
+        enum Score {
+            NoMatch         = -1,
+            NamePrefix      = 0,
+            NameSubstring   = 1,
+            PathSubstring   = 2,
+            NameLetters     = 3
+        };
+
+        int                                 fileRow                 (const QModelIndex& index) const;
+        int                                 score                   (const SeerSourceFile& file) const;
+        void                                refilter                (bool narrow);
+        void                                arrange                 ();
+
+        QVector<SeerSourceFile>             _files;                 // By short name.
+        QVector<qint8>                      _scores;                // Per file. NoMatch if the filter skips it.
+        QVector<int>                        _matches;               // The files that match, in table order.
+        QVector<int>                        _folders[SeerSourceFileLoader::FolderCount];    // The matches under each folder.
+        QVector<int>                        _flatRows;              // The matches, best first.
+        QString                             _filter;                // Lower case.
+        bool                                _wildcard;
+        QRegularExpression                  _wildcardExpression;
+        bool                                _flat;
+};
+
@@ -83,6 +83,14 @@ SeerAdaExceptionsBrowserWidget* SeerSourceSymbolLibraryManagerWidget::adaExcepti
     return _adaExceptionsBrowserWidget;
 }
 
+void SeerSourceSymbolLibraryManagerWidget::invalidateSymbols () {
+
+    // A new program was loaded. Its symbols are asked for when they're next searched.
+    functionBrowserWidget()->invalidate();
+    typeBrowserWidget()->invalidate();
+    staticBrowserWidget()->invalidate();
+}
+
 void SeerSourceSymbolLibraryManagerWidget::handleRefreshToolButtonClicked () {
 
     sourceBrowserWidget()->refresh();
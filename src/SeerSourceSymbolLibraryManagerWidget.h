@@ -26,6 +26,8 @@ class SeerSourceSymbolLibraryManagerWidget : public QWidget, protected Ui::SeerS
         SeerLibraryBrowserWidget*                       libraryBrowserWidget            ();
         SeerAdaExceptionsBrowserWidget*                 adaExceptionsBrowserWidget      ();
 
+        void                                            invalidateSymbols               ();
+
     protected:
         void                                            writeSettings                   ();
         void                                            readSettings                    ();
@@ -5,6 +5,8 @@
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QMenu>
 #include <QtGui/QFontDatabase>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QRegularExpressionMatch>
 #include <QAction>
 #include <QtCore/QDebug>
 
@@ -24,18 +26,72 @@ SeerStackArgumentsBrowserWidget::SeerStackArgumentsBrowserWidget (QWidget* paren
     argumentsTreeWidget->setColumnHidden(3, true);  // Hide the 'used' column.
     argumentsTreeWidget->clear();
 
+    _treeDiff     = new SeerVariableTreeDiff(argumentsTreeWidget, 0, 1);
+    _variableMode = "list";
+    _varObjTree   = new SeerVarObjTree(argumentsTreeWidget, "seerarg", 1, 2, this);
+    _namesId      = Seer::createID();
+
     // Connect things.
     QObject::connect(argumentsTreeWidget, &QTreeWidget::customContextMenuRequested,    this,  &SeerStackArgumentsBrowserWidget::handleContextMenu);
     QObject::connect(argumentsTreeWidget, &QTreeWidget::itemCollapsed,                 this,  &SeerStackArgumentsBrowserWidget::handleItemCollapsed);
     QObject::connect(argumentsTreeWidget, &QTreeWidget::itemExpanded,                  this,  &SeerStackArgumentsBrowserWidget::handleItemExpanded);
     QObject::connect(argumentsTreeWidget, &QTreeWidget::itemEntered,                   this,  &SeerStackArgumentsBrowserWidget::handleItemEntered);
+
+    QObject::connect(_varObjTree,         &SeerVarObjTree::varObjCreate,               this,  &SeerStackArgumentsBrowserWidget::varObjCreate);
+    QObject::connect(_varObjTree,         &SeerVarObjTree::varObjListChildren,         this,  &SeerStackArgumentsBrowserWidget::varObjListChildren);
+    QObject::connect(_varObjTree,         &SeerVarObjTree::varObjUpdate,               this,  &SeerStackArgumentsBrowserWidget::varObjUpdate);
+    QObject::connect(_varObjTree,         &SeerVarObjTree::varObjDelete,               this,  &SeerStackArgumentsBrowserWidget::varObjDelete);
+    QObject::connect(_varObjTree,         &SeerVarObjTree::invalidated,                this,  &SeerStackArgumentsBrowserWidget::refresh);
 }
 
 SeerStackArgumentsBrowserWidget::~SeerStackArgumentsBrowserWidget () {
+
+    delete _treeDiff;
+}
+
+void SeerStackArgumentsBrowserWidget::setVariableMode (const QString& mode) {
+
+    if (_variableMode == mode) {
+        return;
+    }
+
+    // Start over in the new mode.
+    _varObjTree->clear();
+    _treeDiff->clear();
+    _varObjKey    = "";
+    _variableMode = mode;
+}
+
+const QString& SeerStackArgumentsBrowserWidget::variableMode () const {
+
+    return _variableMode;
 }
 
 void SeerStackArgumentsBrowserWidget::handleText (const QString& text) {
 
+    // Replies about the varobjs. Take them even when hidden, so the values aren't left half done.
+    if (_varObjTree->handleText(text)) {
+        argumentsTreeWidget->resizeColumnToContents(2);
+        return;
+    }
+
+    // Replies to asking for the arguments. Kept for the frame they were asked for, and
+    // shown if it's still the one selected.
+    static const QRegularExpression id_re("^([0-9]+)\\^");
+
+    QRegularExpressionMatch id_match = id_re.match(text);
+
+    if (id_match.hasMatch() && _frameCache.isPending(id_match.captured(1).toInt())) {
+
+        QString reply_text = text.mid(id_match.capturedLength(1));
+
+        if (_frameCache.reply(id_match.captured(1).toInt(), reply_text)) {
+            handleText(reply_text);
+        }
+
+        return;
+    }
+
     // Don't do any work if the widget is hidden.
     if (isHidden()) {
         return;
@@ -43,7 +99,68 @@ void SeerStackArgumentsBrowserWidget::handleText (const QString& text) {
 
     QApplication::setOverrideCursor(Qt::BusyCursor);
 
-    if (text.startsWith("^done,stack-args=[") && text.endsWith("]")) {
+    if (text.startsWith(QString::number(_namesId) + "^done,stack-args=[") && text.endsWith("]")) {
+
+        // 12^done,stack-args=[frame={level=\"0\",args=[name=\"message\"]},frame={level=\"1\",args=[name=\"argc\",name=\"argv\"]}]
+        QStringList frame_list = Seer::parse(text, "frame=", '{', '}', false);
+        QStringList keys;
+
+        for (const auto& frame_text : frame_list) {
+
+            QString     level_text = Seer::parseFirst(frame_text, "level=", '"', '"', false);
+            QString     args_text  = Seer::parseFirst(frame_text, "args=",  '[', ']', false);
+            QStringList name_list  = Seer::parse(args_text, "name=", '"', '"', false);
+
+            keys.append(level_text + ":" + name_list.join(':'));
+        }
+
+        QString key = keys.join(',');
+
+        // Same arguments as before. Ask only for what changed.
+        if (key == _varObjKey && _varObjTree->rootCount() > 0 && _varObjTree->isValid()) {
+
+            _varObjTree->update();
+
+        // The stack changed. Make varobjs for the arguments of each frame, bound to that frame.
+        }else{
+
+            _varObjTree->clear();
+            argumentsTreeWidget->clear();
+
+            _varObjKey = key;
+
+            for (const auto& frame_text : frame_list) {
+
+                QString     level_text = Seer::parseFirst(frame_text, "level=", '"', '"', false);
+                QString     args_text  = Seer::parseFirst(frame_text, "args=",  '[', ']', false);
+                QStringList name_list  = Seer::parse(args_text, "name=", '"', '"', false);
+
+                QTreeWidgetItem* topItem = new QTreeWidgetItem;
+                topItem->setText(0, level_text);
+
+                argumentsTreeWidget->addTopLevelItem(topItem);
+
+                for (const auto& name_text : name_list) {
+
+                    QTreeWidgetItem* item = new QTreeWidgetItem;
+                    item->setText(0, level_text);
+                    item->setText(1, name_text);
+
+                    topItem->addChild(item);
+
+                    _varObjTree->addRoot(item, level_text.toInt(), name_text);
+                }
+
+                argumentsTreeWidget->expandItem(topItem);
+            }
+        }
+
+    }else if (text.startsWith(QString::number(_namesId) + "^error,msg=\"No registers.\"")) {
+        _varObjTree->clear();
+        _treeDiff->clear();
+        _varObjKey = "";
+
+    }else if (text.startsWith("^done,stack-args=[") && text.endsWith("]")) {
 
         //argumentsTreeWidget->clear();
 
@@ -62,14 +179,9 @@ void SeerStackArgumentsBrowserWidget::handleText (const QString& text) {
 
         QStringList frame_list = Seer::parse(text, "frame=", '{', '}', false);
 
-        // Mark each entry initially as "unused".
-        // Later, some will be marked as "reused" or "new". Then the "unused" ones will
-        // be deleted.
-        QTreeWidgetItemIterator it(argumentsTreeWidget);
-        while (*it) {
-            (*it)->setText(3, "unused");
-            ++it;
-        }
+        // Update the tree in place. Existing items are reused, by level and name, so
+        // expanded items stay expanded. Items of arguments that are gone are deleted at the end.
+        _treeDiff->begin();
 
         for ( const auto& frame_text : frame_list  ) {
 
@@ -78,23 +190,8 @@ void SeerStackArgumentsBrowserWidget::handleText (const QString& text) {
 
             QStringList namevalue_list  = Seer::parse(args_text, "",  '{', '}', false);
 
-            QList<QTreeWidgetItem*> matches = argumentsTreeWidget->findItems(level_text, Qt::MatchExactly, 0);
-
-            QTreeWidgetItem* topItem = 0;
-
-            // Use an existing level.
-            if (matches.count() > 0) {
-                topItem = matches[0];
-                topItem->setText(3, "reused");
-
-            // Add the new level to the tree.
-            }else{
-                topItem = new QTreeWidgetItem;
-                topItem->setText(0, level_text);
-                topItem->setText(3, "new");
-
-                argumentsTreeWidget->addTopLevelItem(topItem);
-            }
+            // Use an existing level. Or add the new level to the tree.
+            QTreeWidgetItem* topItem = _treeDiff->item(0, level_text);
 
             // Get the argument names and values for the level.
             for ( const auto& namevalue_text : namevalue_list  ) {
@@ -110,32 +207,10 @@ void SeerStackArgumentsBrowserWidget::handleText (const QString& text) {
             argumentsTreeWidget->expandItem(topItem);
         }
 
-        // At this point, there are some new entries, some reused entries, and some unused ones.
-        // Delete the unused ones. They are obsolete.
-        // Don't use qDeleteAll() here. It doesn't work as expected for items that are "found".
-        // Instead, get a list of matches and delete them from the bottom up.
-        QList<QTreeWidgetItem*> matches = argumentsTreeWidget->findItems("unused", Qt::MatchExactly|Qt::MatchRecursive, 3);
-
-        while (matches.isEmpty() == false) {
-            foreach (QTreeWidgetItem* item, matches) {
-                if (item->childCount() == 0) {
-                    QTreeWidgetItem* parent = item->parent();
-                    if (parent) {
-                        parent->removeChild(item);
-                    }
-
-                    bool f = matches.removeOne(item);
-                    Q_ASSERT(f != false);
-
-                    delete item;
-
-                    break;
-                }
-            }
-        }
+        _treeDiff->end();
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
-        argumentsTreeWidget->clear();
+        _treeDiff->clear();
 
     }else{
         // Ignore others.
@@ -144,13 +219,39 @@ void SeerStackArgumentsBrowserWidget::handleText (const QString& text) {
     argumentsTreeWidget->resizeColumnToContents(0);
     argumentsTreeWidget->resizeColumnToContents(1);
     argumentsTreeWidget->resizeColumnToContents(2);
-    argumentsTreeWidget->resizeColumnToContents(3);
 
     QApplication::restoreOverrideCursor();
 }
 
 void SeerStackArgumentsBrowserWidget::handleStoppingPointReached () {
 
+    // The program ran. What was kept for each frame is out of date.
+    _frameCache.reset();
+
+    refresh();
+}
+
+void SeerStackArgumentsBrowserWidget::handleVarObjEvicted (QString objname) {
+
+    _varObjTree->handleVarObjEvicted(objname);
+}
+
+void SeerStackArgumentsBrowserWidget::handleSelectedFrameChanged (int threadid, int frameno) {
+
+    Q_UNUSED(frameno);
+
+    // The arguments of every frame of the thread are shown, so only a new thread matters. Show what was kept for it, or ask for it.
+    SeerFrameCache::Selection selection = _frameCache.select(QString::number(threadid));
+
+    if (selection == SeerFrameCache::Unchanged) {
+        return;
+    }
+
+    if (selection == SeerFrameCache::Cached && _variableMode != "varobj") {
+        handleText(_frameCache.text());
+        return;
+    }
+
     refresh();
 }
 
@@ -161,7 +262,11 @@ void SeerStackArgumentsBrowserWidget::refresh () {
         return;
     }
 
-    emit refreshStackArguments();
+    if (_variableMode == "varobj") {
+        emit refreshStackArgumentNames(_namesId);
+    }else{
+        emit refreshStackArguments(_frameCache.request());
+    }
 }
 
 void SeerStackArgumentsBrowserWidget::handleContextMenu (const QPoint& pos) {
@@ -489,79 +594,47 @@ void SeerStackArgumentsBrowserWidget::handleItemEntered (QTreeWidgetItem* item,
 
 void SeerStackArgumentsBrowserWidget::handleItemCreate (QTreeWidgetItem* parentItem, const QString& level_text, const QString& name_text, const QString& value_text) {
 
-    // Instead of creating a new tree each time, we will reuse existing items, if they are there.
-    // This allows the expanded items to remain expanded. We start by looking for matches that
-    // may already be there. If there are matches, the code will reuse it.  If not, a new item
-    // is created by the code. Note, when searching, we only look at the current level. Not any
-    // children.
-    QList<QTreeWidgetItem*> matches;
-
     if (parentItem == 0) {
         Q_ASSERT(parentItem != NULL);
         return;
-    }else{
-        for (int i=0; i<parentItem->childCount(); i++) {
-            if (parentItem->child(i)->text(1) == name_text) {
-                matches.append(parentItem->child(i));
-            }
-        }
     }
 
+    // Reuse the item of the same name under the same parent, if there is one.
+    bool             created = false;
+    QTreeWidgetItem* item    = _treeDiff->item(parentItem, name_text, &created);
+
+    if (created) {
+        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    }
+
+    SeerVariableTreeDiff::setText(item, 0, level_text);
+
     // Parse bookmarks.
-    QString capture0; // With const address.
-    QString capture1; // Without.
+    static const QRegularExpression withaddress_re("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
+    static const QRegularExpression noaddress_re("^\\{(.*?)\\}$");
+
+    QString capture1; // Without const address.
 
-    QRegularExpression withaddress_re("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
     QRegularExpressionMatch withaddress_match = withaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
 
     if (withaddress_match.hasMatch()) {
-        capture0 = withaddress_match.captured(0);
         capture1 = withaddress_match.captured(1);
 
     }else{
-        QRegularExpression noaddress_re("^\\{(.*?)\\}$");
-        QRegularExpressionMatch noaddress_match   = noaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
+        QRegularExpressionMatch noaddress_match = noaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
 
         if (noaddress_match.hasMatch()) {
-            capture0 = noaddress_match.captured(0);
             capture1 = noaddress_match.captured(1);
         }
     }
 
-    // Add the complex entry to the tree. Reuse, if possible.
-    if (capture0 != "" && capture1 != "") {
-
-        // Remove bookends
-        QString text = capture1;
-
-        QTreeWidgetItem* item = 0;
-
-        // Use the privously created item. Or create a new one.
-        if (matches.size() > 0) {
-            item = matches[0];
-            item->setText(3, "reused");
+    // A complex entry. Set the flat value and add its members as children.
+    if (capture1 != "") {
 
-        }else{
-            item = new QTreeWidgetItem;
-            item->setText(3, "new");
-
-            // If we're dealing with a top-level item, attach it to the tree.
-            // Otherwise, attach it to the parent.
-            if (parentItem) {
-                parentItem->addChild(item);
-            }else{
-                argumentsTreeWidget->addTopLevelItem(item);
-            }
-        }
-
-        // Set the flatvalue text.
-        item->setText(0, level_text);
-        item->setText(1, name_text);
-        item->setText(2, Seer::filterEscapes(text));
-        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        SeerVariableTreeDiff::setText(item, 2, Seer::filterEscapes(capture1));
 
         // Convert to a list of name/value pairs.
-        QStringList nv_pairs = Seer::parseCommaList(text, '{', '}');
+        QStringList nv_pairs = Seer::parseCommaList(capture1, '{', '}');
 
         // Go through each pair and add the name and its value to the tree.
         for (const auto& nv : nv_pairs) {
@@ -571,39 +644,9 @@ void SeerStackArgumentsBrowserWidget::handleItemCreate (QTreeWidgetItem* parentI
             handleItemCreate(item, level_text, pair.first, pair.second);
         }
 
-    // Add the simple entry to the tree. Reuse, if possible.
+    // A simple entry. It has no children. Any it had are deleted by the diff.
     }else{
-        QTreeWidgetItem* item = 0;
-
-        // Use the privously created item. Or create a new one.
-        if (matches.size() > 0) {
-            item = matches[0];
-            item->setText(3, "reused");
-
-        }else{
-            item = new QTreeWidgetItem;
-            item->setText(3, "new");
-
-            // If we're dealing with a top-level item, attach it to the tree.
-            // Otherwise, attach it to the parent.
-            if (parentItem) {
-                parentItem->addChild(item);
-            }else{
-                argumentsTreeWidget->addTopLevelItem(item);
-            }
-        }
-
-        // Simple entries don't have children. Delete them.
-        QList<QTreeWidgetItem*> children = item->takeChildren();
-        if (matches.size() > 0) {
-            qDeleteAll(children);
-        }
-
-        // Populate the item.
-        item->setText(0, level_text);
-        item->setText(1, name_text);
-        item->setText(2, Seer::filterEscapes(value_text));
-        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        SeerVariableTreeDiff::setText(item, 2, Seer::filterEscapes(value_text));
     }
 }
 
@@ -2,6 +2,7 @@
 #include "SeerUtl.h"
 #include <QtWidgets/QTreeWidget>
 #include <QtWidgets/QTreeWidgetItemIterator>
+#include <QtWidgets/QScrollBar>
 #include <QtWidgets/QApplication>
 #include <QtCore/QFileInfo>
 #include <QtCore/QDebug>
@@ -12,10 +13,13 @@ SeerStackFramesBrowserWidget::SeerStackFramesBrowserWidget (QWidget* parent) : Q
     setupUi(this);
 
     _previousStackFrameText = "";
+    _depth                  = -1;
+    _pageId                 = 0;
 
     // Setup the widgets
     stackTreeWidget->setMouseTracking(true);
     stackTreeWidget->setSortingEnabled(false);
+    stackTreeWidget->setUniformRowHeights(true);
     stackTreeWidget->resizeColumnToContents(0); // level
     stackTreeWidget->resizeColumnToContents(1); // func
     stackTreeWidget->resizeColumnToContents(2); // file
@@ -29,6 +33,7 @@ SeerStackFramesBrowserWidget::SeerStackFramesBrowserWidget (QWidget* parent) : Q
     // Connect things.
     QObject::connect(stackTreeWidget, &QTreeWidget::itemClicked,          this,  &SeerStackFramesBrowserWidget::handleItemClicked);
     QObject::connect(stackTreeWidget, &QTreeWidget::itemEntered,          this,  &SeerStackFramesBrowserWidget::handleItemEntered);
+    QObject::connect(stackTreeWidget->verticalScrollBar(), &QScrollBar::valueChanged, this,  &SeerStackFramesBrowserWidget::handleScrollValueChanged);
 }
 
 SeerStackFramesBrowserWidget::~SeerStackFramesBrowserWidget () {
@@ -51,73 +56,39 @@ void SeerStackFramesBrowserWidget::handleText (const QString& text) {
         //     frame={level=\"0\",addr=\"0x0000000000400d72\",func=\"function1\",file=\"function1.cpp\",fullname=\"/home/erniep/Development/Peak/src/Seer/helloworld/function1.cpp\",line=\"7\",arch=\"i386:x86-64\"},
         //     frame={level=\"1\",addr=\"0x0000000000400cc3\",func=\"main\",file=\"helloworld.cpp\",fullname=\"/home/erniep/Development/Peak/src/Seer/helloworld/helloworld.cpp\",line=\"14\",arch=\"i386:x86-64\"}
         // ]
+        //
+        // The first page of the stack. The rest is asked for as it's scrolled to.
+        //
 
         // If we are simply moving up and down the stack (via frame-select) then the text won't change.
         // If it is different, reconstruct the tree. Select the first frame.
         if (text != _previousStackFrameText) {
 
             _previousStackFrameText = text;
+            _depth                  = -1;
+            _pageId                 = 0;
 
             stackTreeWidget->clear();
 
-            QString stack_text = Seer::parseFirst(text, "stack=", '[', ']', false);
-
-            if (stack_text != "") {
-
-                // Parse through the frame list and set the current lines that are in the frame list.
-                QStringList frame_list = Seer::parse(text, "frame=", '{', '}', false);
-
-                QString firstLiveFrameLevel     = "";
-                QString firstLiveFrameFile      = "";
-                QString firstLiveFrameFullname  = "";
-                QString firstLiveFrameLine      = "";
-
-                for ( const auto& frame_text : frame_list  ) {
-
-                    QString level_text    = Seer::parseFirst(frame_text, "level=",    '"', '"', false);
-                    QString addr_text     = Seer::parseFirst(frame_text, "addr=",     '"', '"', false);
-                    QString func_text     = Seer::parseFirst(frame_text, "func=",     '"', '"', false);
-                    QString file_text     = Seer::parseFirst(frame_text, "file=",     '"', '"', false);
-                    QString fullname_text = Seer::parseFirst(frame_text, "fullname=", '"', '"', false);
-                    QString line_text     = Seer::parseFirst(frame_text, "line=",     '"', '"', false);
-                    QString arch_text     = Seer::parseFirst(frame_text, "arch=",     '"', '"', false);
-
-                    // Create the item.
-                    QTreeWidgetItem* item = new QTreeWidgetItem;
-                    item->setText(0, level_text);
-                    item->setText(1, func_text);
-                    item->setText(2, QFileInfo(file_text).fileName());
-                    item->setText(3, line_text);
-                    item->setText(4, fullname_text);
-                    item->setText(5, addr_text);
-                    item->setText(6, arch_text);
-
-                    // Enable/disable interaction with this row depending if there is a valid file and line number.
-                    if (file_text != "" && fullname_text != "" && line_text != "") {
-
-                        item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled | Qt::ItemIsDropEnabled);
-
-                        // Save the first live frame (that has a valid file and lineno) so we can select it automatically.
-                        // This only happens if the stack text is different (a stop point is reached).
-                        if (firstLiveFrameLevel == "") {
-                            firstLiveFrameLevel    = level_text;
-                            firstLiveFrameFile     = QFileInfo(file_text).fileName();
-                            firstLiveFrameFullname = fullname_text;
-                            firstLiveFrameLine     = line_text;
-                        }
-
-                    }else{
-                        item->setFlags(Qt::NoItemFlags);
-                    }
-
-                    // Add the frame to the tree.
-                    stackTreeWidget->addTopLevelItem(item);
-                }
+            addFrames(text);
+
+            // Automatically bring up the file for the first live frame.
+            QTreeWidgetItemIterator it(stackTreeWidget);
+
+            while (*it) {
 
-                // Automatically bring up the file for the first live frame.
-                if (firstLiveFrameLevel != "") {
-                    emit selectedFile(firstLiveFrameFile, firstLiveFrameFullname, firstLiveFrameLine.toInt());
+                if ((*it)->flags() != Qt::NoItemFlags) {
+                    emit selectedFile((*it)->text(2), (*it)->text(4), (*it)->text(3).toInt());
+                    break;
                 }
+
+                ++it;
+            }
+
+            // A short page is the whole stack. After a full page, there may be more.
+            // Asking gdb for the depth would have it unwind all of a runaway stack.
+            if (stackTreeWidget->topLevelItemCount() < PageSize) {
+                _depth = stackTreeWidget->topLevelItemCount();
             }
 
             // Select the first frame level.
@@ -128,10 +99,37 @@ void SeerStackFramesBrowserWidget::handleText (const QString& text) {
             if (matches.size() > 0) {
                 stackTreeWidget->setCurrentItem(matches.first());
             }
+
+            // The whole first page may fit, with nothing to scroll.
+            handleScrollValueChanged(stackTreeWidget->verticalScrollBar()->value());
         }
 
+    }else if (_pageId > 0 && text.startsWith(QString::number(_pageId) + "^done,stack=[") && text.endsWith("]")) {
+
+        _pageId = 0;
+
+        int loaded = stackTreeWidget->topLevelItemCount();
+
+        addFrames(text);
+
+        // A short page is the end of the stack.
+        if (stackTreeWidget->topLevelItemCount() - loaded < PageSize) {
+            _depth = stackTreeWidget->topLevelItemCount();
+        }
+
+        handleScrollValueChanged(stackTreeWidget->verticalScrollBar()->value());
+
+    }else if (_pageId > 0 && text.startsWith(QString::number(_pageId) + "^error,")) {
+
+        // Can't unwind further. Stop here.
+        _pageId = 0;
+        _depth  = stackTreeWidget->topLevelItemCount();
+
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
         stackTreeWidget->clear();
+        _previousStackFrameText = "";
+        _depth                  = -1;
+        _pageId                 = 0;
 
     }else{
         // Ignore others.
@@ -192,6 +190,80 @@ void SeerStackFramesBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int
     }
 }
 
+void SeerStackFramesBrowserWidget::handleScrollValueChanged (int value) {
+
+    // Near the bottom? Get the next page.
+    QScrollBar* scrollBar = stackTreeWidget->verticalScrollBar();
+
+    if (value >= scrollBar->maximum() - scrollBar->pageStep()) {
+        fetchMoreFrames();
+    }
+}
+
+void SeerStackFramesBrowserWidget::addFrames (const QString& text) {
+
+    QString stack_text = Seer::parseFirst(text, "stack=", '[', ']', false);
+
+    if (stack_text == "") {
+        return;
+    }
+
+    // Parse through the frame list and add the frames, in one go.
+    QStringList             frame_list = Seer::parse(text, "frame=", '{', '}', false);
+    QList<QTreeWidgetItem*> items;
+
+    items.reserve(frame_list.size());
+
+    for ( const auto& frame_text : frame_list  ) {
+
+        QString level_text    = Seer::parseFirst(frame_text, "level=",    '"', '"', false);
+        QString addr_text     = Seer::parseFirst(frame_text, "addr=",     '"', '"', false);
+        QString func_text     = Seer::parseFirst(frame_text, "func=",     '"', '"', false);
+        QString file_text     = Seer::parseFirst(frame_text, "file=",     '"', '"', false);
+        QString fullname_text = Seer::parseFirst(frame_text, "fullname=", '"', '"', false);
+        QString line_text     = Seer::parseFirst(frame_text, "line=",     '"', '"', false);
+        QString arch_text     = Seer::parseFirst(frame_text, "arch=",     '"', '"', false);
+
+        // Create the item.
+        QTreeWidgetItem* item = new QTreeWidgetItem;
+        item->setText(0, level_text);
+        item->setText(1, func_text);
+        item->setText(2, QFileInfo(file_text).fileName());
+        item->setText(3, line_text);
+        item->setText(4, fullname_text);
+        item->setText(5, addr_text);
+        item->setText(6, arch_text);
+
+        // Enable/disable interaction with this row depending if there is a valid file and line number.
+        if (file_text != "" && fullname_text != "" && line_text != "") {
+            item->setFlags(Qt::ItemIsSelectable | Qt::ItemIsUserCheckable | Qt::ItemIsEnabled | Qt::ItemIsDragEnabled | Qt::ItemIsDropEnabled);
+        }else{
+            item->setFlags(Qt::NoItemFlags);
+        }
+
+        items.append(item);
+    }
+
+    // Add the frames to the tree.
+    stackTreeWidget->addTopLevelItems(items);
+}
+
+void SeerStackFramesBrowserWidget::fetchMoreFrames () {
+
+    // One page at a time, until a short one says that's all of it.
+    int loaded = stackTreeWidget->topLevelItemCount();
+
+    if (_pageId > 0 || _depth >= 0) {
+        return;
+    }
+
+    int high = loaded + int(PageSize) - 1;
+
+    _pageId = Seer::createID();
+
+    emit refreshStackFramesRange(_pageId, loaded, high);
+}
+
 void SeerStackFramesBrowserWidget::showEvent (QShowEvent* event) {
 
     QWidget::showEvent(event);
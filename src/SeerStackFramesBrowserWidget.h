@@ -12,6 +12,8 @@ class SeerStackFramesBrowserWidget : public QWidget, protected Ui::SeerStackFram
         explicit SeerStackFramesBrowserWidget (QWidget* parent = 0);
        ~SeerStackFramesBrowserWidget ();
 
+        static const int    PageSize = 200;                 // Frames asked for at a time.
+
     public slots:
         void                handleText                  (const QString& text);
         void                handleStoppingPointReached  ();
@@ -20,9 +22,11 @@ class SeerStackFramesBrowserWidget : public QWidget, protected Ui::SeerStackFram
     protected slots:
         void                handleItemClicked           (QTreeWidgetItem* item, int column);
         void                handleItemEntered           (QTreeWidgetItem* item, int column);
+        void                handleScrollValueChanged    (int value);
 
     signals:
         void                refreshStackFrames          ();
+        void                refreshStackFramesRange     (int id, int low, int high);
         void                selectedFile                (QString file, QString fullname, int lineno);
         void                selectedAddress             (QString address);
         void                selectedFrame               (int frameno);
@@ -31,6 +35,11 @@ class SeerStackFramesBrowserWidget : public QWidget, protected Ui::SeerStackFram
         void                showEvent                   (QShowEvent* event);
 
     private:
+        void                addFrames                   (const QString& text);
+        void                fetchMoreFrames             ();
+
         QString             _previousStackFrameText;
+        int                 _depth;                         // Of the whole stack. -1 until a short page is seen.
+        int                 _pageId;                        // Of the page being fetched. 0 if none.
 };
 
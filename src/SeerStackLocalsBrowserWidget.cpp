@@ -5,6 +5,7 @@
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QMenu>
 #include <QtGui/QFontDatabase>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QRegularExpressionMatch>
 #include <QAction>
 #include <QtCore/QDebug>
@@ -26,20 +27,73 @@ SeerStackLocalsBrowserWidget::SeerStackLocalsBrowserWidget (QWidget* parent) : Q
     localsTreeWidget->setColumnHidden(3, true);  // Hide the 'used' column.
     localsTreeWidget->clear();
 
-    _frameNumber = 0;
+    _frameNumber  = 0;
+    _treeDiff     = new SeerVariableTreeDiff(localsTreeWidget, 0, 0);
+    _variableMode = "list";
+    _varObjTree   = new SeerVarObjTree(localsTreeWidget, "seerlocal", 0, 2, this);
+    _namesId      = Seer::createID();
 
     // Connect things.
     QObject::connect(localsTreeWidget, &QTreeWidget::customContextMenuRequested,    this,  &SeerStackLocalsBrowserWidget::handleContextMenu);
     QObject::connect(localsTreeWidget, &QTreeWidget::itemCollapsed,                 this,  &SeerStackLocalsBrowserWidget::handleItemCollapsed);
     QObject::connect(localsTreeWidget, &QTreeWidget::itemExpanded,                  this,  &SeerStackLocalsBrowserWidget::handleItemExpanded);
     QObject::connect(localsTreeWidget, &QTreeWidget::itemEntered,                   this,  &SeerStackLocalsBrowserWidget::handleItemEntered);
+
+    QObject::connect(_varObjTree,      &SeerVarObjTree::varObjCreate,               this,  &SeerStackLocalsBrowserWidget::varObjCreate);
+    QObject::connect(_varObjTree,      &SeerVarObjTree::varObjListChildren,         this,  &SeerStackLocalsBrowserWidget::varObjListChildren);
+    QObject::connect(_varObjTree,      &SeerVarObjTree::varObjUpdate,               this,  &SeerStackLocalsBrowserWidget::varObjUpdate);
+    QObject::connect(_varObjTree,      &SeerVarObjTree::varObjDelete,               this,  &SeerStackLocalsBrowserWidget::varObjDelete);
+    QObject::connect(_varObjTree,      &SeerVarObjTree::invalidated,                this,  &SeerStackLocalsBrowserWidget::refresh);
 }
 
 SeerStackLocalsBrowserWidget::~SeerStackLocalsBrowserWidget () {
+
+    delete _treeDiff;
+}
+
+void SeerStackLocalsBrowserWidget::setVariableMode (const QString& mode) {
+
+    if (_variableMode == mode) {
+        return;
+    }
+
+    // Start over in the new mode.
+    _varObjTree->clear();
+    _treeDiff->clear();
+    _varObjKey    = "";
+    _variableMode = mode;
+}
+
+const QString& SeerStackLocalsBrowserWidget::variableMode () const {
+
+    return _variableMode;
 }
 
 void SeerStackLocalsBrowserWidget::handleText (const QString& text) {
 
+    // Replies about the varobjs. Take them even when hidden, so the values aren't left half done.
+    if (_varObjTree->handleText(text)) {
+        localsTreeWidget->resizeColumnToContents(2);
+        return;
+    }
+
+    // Replies to asking for the locals. Kept for the frame they were asked for, and
+    // shown if it's still the one selected.
+    static const QRegularExpression id_re("^([0-9]+)\\^");
+
+    QRegularExpressionMatch id_match = id_re.match(text);
+
+    if (id_match.hasMatch() && _frameCache.isPending(id_match.captured(1).toInt())) {
+
+        QString reply_text = text.mid(id_match.capturedLength(1));
+
+        if (_frameCache.reply(id_match.captured(1).toInt(), reply_text)) {
+            handleText(reply_text);
+        }
+
+        return;
+    }
+
     // Don't do any work if the widget is hidden.
     if (isHidden()) {
         return;
@@ -47,7 +101,54 @@ void SeerStackLocalsBrowserWidget::handleText (const QString& text) {
 
     QApplication::setOverrideCursor(Qt::BusyCursor);
 
-    if (text.startsWith("^done,variables=[") && text.endsWith("]")) {
+    if (text.startsWith(QString::number(_namesId) + "^done,variables=[") && text.endsWith("]")) {
+
+        // 12^done,variables=[{name=\"message\",arg=\"1\"},{name=\"something\"}]
+        QString     frame_text    = Seer::parseFirst(text, "variables=", '[', ']', false);
+        QStringList variable_list = Seer::parse(frame_text, "", '{', '}', false);
+        QStringList keys;
+
+        for (const auto& variable_text : variable_list) {
+            keys.append(Seer::parseFirst(variable_text, "name=", '"', '"', false) + ":" + Seer::parseFirst(variable_text, "arg=", '"', '"', false));
+        }
+
+        QString key = keys.join(',');
+
+        // Same locals as before. Ask only for what changed.
+        if (key == _varObjKey && _varObjTree->rootCount() > 0 && _varObjTree->isValid()) {
+
+            _varObjTree->update();
+
+        // A different frame. Make varobjs for its locals. They are floating, so they
+        // follow the selected frame.
+        }else{
+
+            _varObjTree->clear();
+            localsTreeWidget->clear();
+
+            _varObjKey = key;
+
+            for (const auto& variable_text : variable_list) {
+
+                QString name_text = Seer::parseFirst(variable_text, "name=", '"', '"', false);
+                QString arg_text  = Seer::parseFirst(variable_text, "arg=",  '"', '"', false);
+
+                QTreeWidgetItem* item = new QTreeWidgetItem;
+                item->setText(0, name_text);
+                item->setText(1, arg_text == "1" ? "yes" : "");
+
+                localsTreeWidget->addTopLevelItem(item);
+
+                _varObjTree->addRoot(item, -1, name_text);
+            }
+        }
+
+    }else if (text.startsWith(QString::number(_namesId) + "^error,msg=\"No registers.\"")) {
+        _varObjTree->clear();
+        _treeDiff->clear();
+        _varObjKey = "";
+
+    }else if (text.startsWith("^done,variables=[") && text.endsWith("]")) {
 
         // ^done,variables=[
         //     {name=\"message\",arg=\"1\",value=\"\\\"Hello, World!\\\"\"},
@@ -59,14 +160,9 @@ void SeerStackLocalsBrowserWidget::handleText (const QString& text) {
 
         QStringList variable_list = Seer::parse(frame_text, "", '{', '}', false);
 
-        // Mark each entry initially as "unused".
-        // Later, some will be marked as "reused" or "new". Then the "unused" ones will
-        // be deleted.
-        QTreeWidgetItemIterator it(localsTreeWidget);
-        while (*it) {
-            (*it)->setText(3, "unused");
-            ++it;
-        }
+        // Update the tree in place. Existing items are reused, by name, so expanded
+        // items stay expanded. Items of variables that are gone are deleted at the end.
+        _treeDiff->begin();
 
         // Loop through each variable.
         for (const auto& variable_text : variable_list) {
@@ -82,32 +178,10 @@ void SeerStackLocalsBrowserWidget::handleText (const QString& text) {
             handleItemCreate(0, name_text, arg_text, value_text);
         }
 
-        // At this point, there are some new entries, some reused entries, and some unused ones.
-        // Delete the unused ones. They are obsolete.
-        // Don't use qDeleteAll() here. It doesn't work as expected for items that are "found".
-        // Instead, get a list of matches and delete them from the bottom up.
-        QList<QTreeWidgetItem*> matches = localsTreeWidget->findItems("unused", Qt::MatchExactly|Qt::MatchRecursive, 3);
-
-        while (matches.isEmpty() == false) {
-            foreach (QTreeWidgetItem* item, matches) {
-                if (item->childCount() == 0) {
-                    QTreeWidgetItem* parent = item->parent();
-                    if (parent) {
-                        parent->removeChild(item);
-                    }
-
-                    bool f = matches.removeOne(item);
-                    Q_ASSERT(f != false);
-
-                    delete item;
-
-                    break;
-                }
-            }
-        }
+        _treeDiff->end();
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
-        localsTreeWidget->clear();
+        _treeDiff->clear();
 
     }else{
         // Ignore others.
@@ -116,13 +190,37 @@ void SeerStackLocalsBrowserWidget::handleText (const QString& text) {
     localsTreeWidget->resizeColumnToContents(0);
     localsTreeWidget->resizeColumnToContents(1);
     localsTreeWidget->resizeColumnToContents(2);
-    localsTreeWidget->resizeColumnToContents(3);
 
     QApplication::restoreOverrideCursor();
 }
 
 void SeerStackLocalsBrowserWidget::handleStoppingPointReached () {
 
+    // The program ran. What was kept for each frame is out of date.
+    _frameCache.reset();
+
+    refresh();
+}
+
+void SeerStackLocalsBrowserWidget::handleVarObjEvicted (QString objname) {
+
+    _varObjTree->handleVarObjEvicted(objname);
+}
+
+void SeerStackLocalsBrowserWidget::handleSelectedFrameChanged (int threadid, int frameno) {
+
+    // The locals are of the selected frame. Show what was kept for it, or ask for it.
+    SeerFrameCache::Selection selection = _frameCache.select(QString::number(threadid) + ":" + QString::number(frameno));
+
+    if (selection == SeerFrameCache::Unchanged) {
+        return;
+    }
+
+    if (selection == SeerFrameCache::Cached && _variableMode != "varobj") {
+        handleText(_frameCache.text());
+        return;
+    }
+
     refresh();
 }
 
@@ -133,7 +231,11 @@ void SeerStackLocalsBrowserWidget::refresh () {
         return;
     }
 
-    emit refreshStackLocals();
+    if (_variableMode == "varobj") {
+        emit refreshStackLocalNames(_namesId);
+    }else{
+        emit refreshStackLocals(_frameCache.request());
+    }
 }
 
 void SeerStackLocalsBrowserWidget::handleContextMenu (const QPoint& pos) {
@@ -456,78 +558,42 @@ void SeerStackLocalsBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int
 
 void SeerStackLocalsBrowserWidget::handleItemCreate (QTreeWidgetItem* parentItem, const QString& name_text, const QString& arg_text, const QString& value_text) {
 
-    // Instead of creating a new tree each time, we will reuse existing items, if they are there.
-    // This allows the expanded items to remain expanded. We start by looking for matches that
-    // may already be there. If there are matches, the code will reuse it.  If not, a new item
-    // is created by the code. Note, when searching, we only look at the current level. Not any
-    // children.
-    QList<QTreeWidgetItem*> matches;
+    // Reuse the item of the same name under the same parent, if there is one.
+    bool             created = false;
+    QTreeWidgetItem* item    = _treeDiff->item(parentItem, name_text, &created);
 
-    if (parentItem == 0) {
-        matches = localsTreeWidget->findItems(name_text, Qt::MatchExactly, 0);
-    }else{
-        for (int i=0; i<parentItem->childCount(); i++) {
-            if (parentItem->child(i)->text(0) == name_text) {
-                matches.append(parentItem->child(i));
-            }
-        }
+    if (created) {
+        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
     }
 
+    SeerVariableTreeDiff::setText(item, 1, arg_text);
+
     // Parse bookmarks.
-    QString capture0; // With bookends.
-    QString capture1; // Without.
+    static const QRegularExpression withaddress_re("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
+    static const QRegularExpression noaddress_re("^\\{(.*?)\\}$");
+
+    QString capture1; // Without bookends.
 
-    QRegularExpression withaddress_re("^@0[xX][0-9a-fA-F]+: \\{(.*?)\\}$");
     QRegularExpressionMatch withaddress_match = withaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
 
     if (withaddress_match.hasMatch()) {
-        capture0 = withaddress_match.captured(0);
         capture1 = withaddress_match.captured(1);
 
     }else{
-        QRegularExpression noaddress_re("^\\{(.*?)\\}$");
-        QRegularExpressionMatch noaddress_match   = noaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
+        QRegularExpressionMatch noaddress_match = noaddress_re.match(value_text, 0, QRegularExpression::PartialPreferCompleteMatch);
 
         if (noaddress_match.hasMatch()) {
-            capture0 = noaddress_match.captured(0);
             capture1 = noaddress_match.captured(1);
         }
     }
 
-    // Add the complex entry to the tree. Reuse, if possible.
-    if (capture0 != "" && capture1 != "") {
-
-        // Remove bookends
-        QString text = capture1;
-
-        QTreeWidgetItem* item = 0;
+    // A complex entry. Set the flat value and add its members as children.
+    if (capture1 != "") {
 
-        // Use the privously created item. Or create a new one.
-        if (matches.size() > 0) {
-            item = matches[0];
-            item->setText(3, "reused");
-
-        }else{
-            item = new QTreeWidgetItem;
-            item->setText(3, "new");
-
-            // If we're dealing with a top-level item, attach it to the tree.
-            // Otherwise, attach it to the parent.
-            if (parentItem) {
-                parentItem->addChild(item);
-            }else{
-                localsTreeWidget->addTopLevelItem(item);
-            }
-        }
-
-        // Set the flatvalue text.
-        item->setText(0, name_text);
-        item->setText(1, arg_text);
-        item->setText(2, Seer::filterEscapes(text));
-        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        SeerVariableTreeDiff::setText(item, 2, Seer::filterEscapes(capture1));
 
         // Convert to a list of name/value pairs.
-        QStringList nv_pairs = Seer::parseCommaList(text, '{', '}');
+        QStringList nv_pairs = Seer::parseCommaList(capture1, '{', '}');
 
         // Go through each pair and add the name and its value to the tree.
         for (const auto& nv : nv_pairs) {
@@ -537,39 +603,9 @@ void SeerStackLocalsBrowserWidget::handleItemCreate (QTreeWidgetItem* parentItem
             handleItemCreate(item, pair.first, arg_text, pair.second);
         }
 
-    // Add the simple entry to the tree. Reuse, if possible.
+    // A simple entry. It has no children. Any it had are deleted by the diff.
     }else{
-        QTreeWidgetItem* item = 0;
-
-        // Use the privously created item. Or create a new one.
-        if (matches.size() > 0) {
-            item = matches[0];
-            item->setText(3, "reused");
-
-        }else{
-            item = new QTreeWidgetItem;
-            item->setText(3, "new");
-
-            // If we're dealing with a top-level item, attach it to the tree.
-            // Otherwise, attach it to the parent.
-            if (parentItem) {
-                parentItem->addChild(item);
-            }else{
-                localsTreeWidget->addTopLevelItem(item);
-            }
-        }
-
-        // Simple entries don't have children. Delete them.
-        QList<QTreeWidgetItem*> children = item->takeChildren();
-        if (matches.size() > 0) {
-            qDeleteAll(children);
-        }
-
-        // Populate the item.
-        item->setText(0, name_text);
-        item->setText(1, arg_text);
-        item->setText(2, Seer::filterEscapes(value_text));
-        item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        SeerVariableTreeDiff::setText(item, 2, Seer::filterEscapes(value_text));
     }
 }
 
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "SeerVariableTreeDiff.h"
+#include "SeerVarObjTree.h"
+#include "SeerFrameCache.h"
 #include <QtWidgets/QWidget>
 #include <QtCore/QString>
 #include "ui_SeerStackLocalsBrowserWidget.h"
@@ -12,9 +15,14 @@ class SeerStackLocalsBrowserWidget : public QWidget, protected Ui::SeerStackLoca
         explicit SeerStackLocalsBrowserWidget (QWidget* parent = 0);
        ~SeerStackLocalsBrowserWidget ();
 
+        void                setVariableMode                     (const QString& mode);
+        const QString&      variableMode                        () const;
+
     public slots:
         void                handleText                          (const QString& text);
         void                handleStoppingPointReached          ();
+        void                handleSelectedFrameChanged          (int threadid, int frameno);
+        void                handleVarObjEvicted                 (QString objname);
         void                refresh                             ();
 
     protected slots:
@@ -24,7 +32,12 @@ class SeerStackLocalsBrowserWidget : public QWidget, protected Ui::SeerStackLoca
         void                handleItemEntered                   (QTreeWidgetItem* item, int column);
 
     signals:
-        void                refreshStackLocals                  ();
+        void                refreshStackLocals                  (int id);
+        void                refreshStackLocalNames              (int id);
+        void                varObjCreate                        (int id, QString objname, int frame, QString expression);
+        void                varObjListChildren                  (int id, QString objname);
+        void                varObjUpdate                        (int id, QString objname);
+        void                varObjDelete                        (int id, QString objname);
         void                addVariableLoggerExpression         (QString expression);
         void                addVariableTrackerExpression        (QString expression);
         void                refreshVariableTrackerValues        ();
@@ -37,6 +50,12 @@ class SeerStackLocalsBrowserWidget : public QWidget, protected Ui::SeerStackLoca
         void                showEvent                           (QShowEvent* event);
 
     private:
-        int                 _frameNumber;
+        int                     _frameNumber;
+        SeerVariableTreeDiff*   _treeDiff;
+        QString                 _variableMode;
+        SeerVarObjTree*         _varObjTree;
+        int                     _namesId;
+        SeerFrameCache          _frameCache;
+        QString                 _varObjKey;             // The frame's locals, as of when the varobjs were made.
 };
 
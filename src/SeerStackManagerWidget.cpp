@@ -3,6 +3,8 @@
 #include "SeerUtl.h"
 #include "QHContainerWidget.h"
 #include <QtWidgets/QToolButton>
+#include <QtWidgets/QMenu>
+#include <QAction>
 #include <QtGui/QIcon>
 #include <QtCore/QSettings>
 #include <QtCore/QDebug>
@@ -30,6 +32,18 @@ SeerStackManagerWidget::SeerStackManagerWidget (QWidget* parent) : QWidget(paren
     refreshToolButton->setIcon(QIcon(":/seer/resources/RelaxLightIcons/view-refresh.svg"));
     refreshToolButton->setToolTip("Refresh the stack information.");
 
+    // Preference menu.
+    QMenu* menu = new QMenu(this);
+
+    _variableObjectsAction = menu->addAction("Use variable objects for Arguments and Locals");
+    _variableObjectsAction->setCheckable(true);
+
+    QToolButton* preferencesToolButton = new QToolButton(tabWidget);
+    preferencesToolButton->setIcon(QIcon(":/seer/resources/RelaxLightIcons/application-menu.svg"));
+    preferencesToolButton->setToolTip("Stack information preferences.");
+    preferencesToolButton->setMenu(menu);
+    preferencesToolButton->setPopupMode(QToolButton::InstantPopup);
+
     QToolButton* helpToolButton = new QToolButton(tabWidget);
     helpToolButton->setIcon(QIcon(":/seer/resources/RelaxLightIcons/help-about.svg"));
     helpToolButton->setToolTip("Help on stack information.");
@@ -37,11 +51,12 @@ SeerStackManagerWidget::SeerStackManagerWidget (QWidget* parent) : QWidget(paren
     QHContainerWidget* hcontainer = new QHContainerWidget(this);
     hcontainer->setSpacing(3);
     hcontainer->addWidget(refreshToolButton);
+    hcontainer->addWidget(preferencesToolButton);
     hcontainer->addWidget(helpToolButton);
 
     tabWidget->setCornerWidget(hcontainer, Qt::TopRightCorner);
 
-    // Restore tab ordering.
+    // Restore tab ordering and the variable mode.
     readSettings();
 
     // Connect things.
@@ -49,6 +64,7 @@ SeerStackManagerWidget::SeerStackManagerWidget (QWidget* parent) : QWidget(paren
     QObject::connect(helpToolButton,       &QToolButton::clicked,         this,  &SeerStackManagerWidget::handleHelpToolButtonClicked);
     QObject::connect(tabWidget->tabBar(),  &QTabBar::tabMoved,            this,  &SeerStackManagerWidget::handleTabMoved);
     QObject::connect(tabWidget->tabBar(),  &QTabBar::currentChanged,      this,  &SeerStackManagerWidget::handleTabChanged);
+    QObject::connect(_variableObjectsAction, &QAction::triggered,         this,  &SeerStackManagerWidget::handleVariableObjectsTriggered);
 }
 
 SeerStackManagerWidget::~SeerStackManagerWidget () {
@@ -83,6 +99,20 @@ void SeerStackManagerWidget::handleHelpToolButtonClicked () {
     help->raise();
 }
 
+void SeerStackManagerWidget::handleVariableObjectsTriggered (bool checked) {
+
+    // Switch how the Arguments and Locals tabs fetch their values, then fetch them again.
+    QString mode = (checked ? "varobj" : "list");
+
+    stackArgumentsBrowserWidget()->setVariableMode(mode);
+    stackLocalsBrowserWidget()->setVariableMode(mode);
+
+    writeSettings();
+
+    stackArgumentsBrowserWidget()->refresh();
+    stackLocalsBrowserWidget()->refresh();
+}
+
 void SeerStackManagerWidget::handleTabMoved (int from, int to) {
 
     Q_UNUSED(from);
@@ -117,18 +147,30 @@ void SeerStackManagerWidget::writeSettings () {
     settings.beginGroup("stackmanagerwindow"); {
         settings.setValue("taborder",   tabs.join(','));
         settings.setValue("tabcurrent", current);
+        settings.setValue("variablemode", stackLocalsBrowserWidget()->variableMode());
     } settings.endGroup();
 }
 
 void SeerStackManagerWidget::readSettings () {
 
+    // How the Arguments and Locals tabs fetch their values. "list" or "varobj".
+    QSettings settings;
+
+    settings.beginGroup("stackmanagerwindow"); {
+        QString mode = settings.value("variablemode", "list").toString();
+
+        stackArgumentsBrowserWidget()->setVariableMode(mode);
+        stackLocalsBrowserWidget()->setVariableMode(mode);
+
+        _variableObjectsAction->setChecked(mode == "varobj");
+    } settings.endGroup();
+
     // Can't move things?
     if (tabWidget->tabBar()->isMovable() == false) {
         return;
     }
 
     // Read tab order from settings.
-    QSettings   settings;
     QStringList tabs;
     QString     current;
 
@@ -222,7 +264,7 @@ void SeerStackManagerWidget::handleStoppingPointReached () {
 
 void SeerStackManagerWidget::refresh () {
 
-    emit refreshThreadFrames();
+    emit refreshThreadIds();
 }
 
 
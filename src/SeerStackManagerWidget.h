@@ -5,6 +5,7 @@
 #include "SeerStackLocalsBrowserWidget.h"
 
 #include <QtWidgets/QWidget>
+#include <QAction>
 
 #include "ui_SeerStackManagerWidget.h"
 
@@ -21,7 +22,7 @@ class SeerStackManagerWidget : public QWidget, protected Ui::SeerStackManagerWid
         SeerStackLocalsBrowserWidget*                   stackLocalsBrowserWidget            ();
 
     signals:
-        void                                            refreshThreadFrames                 ();
+        void                                            refreshThreadIds                    ();
 
     protected:
         void                                            writeSettings                       ();
@@ -35,6 +36,7 @@ class SeerStackManagerWidget : public QWidget, protected Ui::SeerStackManagerWid
     private slots:
         void                                            handleRefreshToolButtonClicked      ();
         void                                            handleHelpToolButtonClicked         ();
+        void                                            handleVariableObjectsTriggered      (bool checked);
         void                                            handleTabMoved                      (int from, int to);
         void                                            handleTabChanged                    (int index);
 
@@ -42,5 +44,6 @@ class SeerStackManagerWidget : public QWidget, protected Ui::SeerStackManagerWid
         SeerStackFramesBrowserWidget*                   _stackFramesBrowserWidget;
         SeerStackArgumentsBrowserWidget*                _stackArgumentsBrowserWidget;
         SeerStackLocalsBrowserWidget*                   _stackLocalsBrowserWidget;
+        QAction*                                        _variableObjectsAction;
 };
 
@@ -1,42 +1,51 @@
 #include "SeerStaticBrowserWidget.h"
 #include "SeerUtl.h"
-#include <QtWidgets/QTreeWidget>
-#include <QtWidgets/QTreeWidgetItemIterator>
-#include <QtWidgets/QLabel>
-#include <QtWidgets/QApplication>
-#include <QtCore/QFileInfo>
+#include <QtWidgets/QTreeView>
+#include <QtWidgets/QHeaderView>
 #include <QtCore/Qt>
-#include <QtCore/QMap>
 #include <QtCore/QDebug>
 
 SeerStaticBrowserWidget::SeerStaticBrowserWidget (QWidget* parent) : QWidget(parent) {
 
     // Set the state.
-    _id = Seer::createID();
+    _id              = Seer::createID();
+    _indexGeneration = 0;
+    _indexLoading    = false;
+    _indexStale      = false;   // Nothing to ask for until a program is loaded. See invalidate().
+    _librariesLoaded = false;
 
     // Construct the UI.
     setupUi(this);
 
     // Setup the widgets
-    staticNameSearchLineEdit->setPlaceholderText("Static name regex...");
+    _indexLoader = new SeerSymbolIndexLoader(this);
+    _symbolModel = new SeerSymbolModel(this);
+    _symbolModel->setColumns({SeerSymbolModel::NameField, SeerSymbolModel::TypeField, SeerSymbolModel::FilenameField, SeerSymbolModel::LineField, SeerSymbolModel::FullnameField, SeerSymbolModel::DescriptionField},
+                             {"Variable", "Type", "File", "Line", "Full Name", "Description"}, 2);
+
+    _searchTimer = new QTimer(this);
+    _searchTimer->setSingleShot(true);
+    _searchTimer->setInterval(SearchInterval);
+
+    staticNameSearchLineEdit->setPlaceholderText("Static names...");
     staticNameSearchLineEdit->setClearButtonEnabled(true);
-    staticTypeSearchLineEdit->setPlaceholderText("Static type regex...");
+    staticTypeSearchLineEdit->setPlaceholderText("Static types...");
     staticTypeSearchLineEdit->setClearButtonEnabled(true);
-    staticTreeWidget->setMouseTracking(true);
-  //staticTreeWidget->resizeColumnToContents(0);
-  //staticTreeWidget->resizeColumnToContents(1);
-    staticTreeWidget->resizeColumnToContents(2);
-    staticTreeWidget->resizeColumnToContents(3);
-    staticTreeWidget->resizeColumnToContents(4);
-    staticTreeWidget->resizeColumnToContents(5);
-    staticTreeWidget->clear();
-    staticTreeWidget->setSortingEnabled(false);
+    staticTreeView->setModel(_symbolModel);
+    staticTreeView->setRootIsDecorated(false);
+    staticTreeView->setUniformRowHeights(true);
+    staticTreeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    staticTreeView->header()->setSortIndicator(-1, Qt::AscendingOrder); // Best matches first, until a column is clicked.
+    staticTreeView->setSortingEnabled(true);
 
     // Connect things.
-    QObject::connect(staticTreeWidget,          &QTreeWidget::itemDoubleClicked,    this,  &SeerStaticBrowserWidget::handleItemDoubleClicked);
-    QObject::connect(staticTreeWidget,          &QTreeWidget::itemEntered,          this,  &SeerStaticBrowserWidget::handleItemEntered);
-    QObject::connect(staticNameSearchLineEdit,  &QLineEdit::returnPressed,          this,  &SeerStaticBrowserWidget::handleSearchLineEdit);
-    QObject::connect(staticTypeSearchLineEdit,  &QLineEdit::returnPressed,          this,  &SeerStaticBrowserWidget::handleSearchLineEdit);
+    QObject::connect(staticTreeView,            &QTreeView::doubleClicked,                    this,          &SeerStaticBrowserWidget::handleItemDoubleClicked);
+    QObject::connect(staticNameSearchLineEdit,  &QLineEdit::returnPressed,                    this,          &SeerStaticBrowserWidget::handleSearchLineEdit);
+    QObject::connect(staticTypeSearchLineEdit,  &QLineEdit::returnPressed,                    this,          &SeerStaticBrowserWidget::handleSearchLineEdit);
+    QObject::connect(staticNameSearchLineEdit,  &QLineEdit::textChanged,                      this,          &SeerStaticBrowserWidget::handleSearchChanged);
+    QObject::connect(staticTypeSearchLineEdit,  &QLineEdit::textChanged,                      this,          &SeerStaticBrowserWidget::handleSearchChanged);
+    QObject::connect(_searchTimer,              &QTimer::timeout,                             this,          &SeerStaticBrowserWidget::handleSearchLineEdit);
+    QObject::connect(_indexLoader,              &SeerSymbolIndexLoader::loaded,               this,          &SeerStaticBrowserWidget::handleIndexLoaded);
 }
 
 SeerStaticBrowserWidget::~SeerStaticBrowserWidget () {
@@ -44,138 +53,146 @@ SeerStaticBrowserWidget::~SeerStaticBrowserWidget () {
 
 void SeerStaticBrowserWidget::handleText (const QString& text) {
 
-    QApplication::setOverrideCursor(Qt::BusyCursor);
-
     if (text.startsWith(QString::number(_id) + "^done,symbols={") && text.endsWith("}")) {
 
-        staticTreeWidget->clear();
-        staticTreeWidget->setSortingEnabled(false);
-        staticTreeWidget->sortByColumn(-1, Qt::AscendingOrder);
-
-        // -symbol-info-variables
-        // ^done,symbols={
-        //          debug=[
-        //                  {
-        //                      filename="elf-init.c",
-        //                      fullname="/home/abuild/rpmbuild/BUILD/glibc-2.31/csu/elf-init.c",
-        //                      symbols=[
-        //                                  {
-        //                                      line="95",
-        //                                      name="__libc_csu_fini",
-        //                                      type="void (void)",
-        //                                      description="void __libc_csu_fini(void);"
-        //                                  },
-        //                                  {
-        //                                      line="67",
-        //                                      name="__libc_csu_init",
-        //                                      type="void (int, char **, char **)",
-        //                                      description="void __libc_csu_init(int, char **, char **);"
-        //                                  }
-        //                              ]
-        //                  },
-        //                  ...
-        //                ]
-        //              }
-
-        QString debug_text = Seer::parseFirst(text, "debug=", '[', ']', false);
-
-        QStringList filenames_list = Seer::parse(debug_text, "", '{', '}', false);
-
-        for (const auto& filename_entry : filenames_list) {
-
-            QString filename_text = Seer::parseFirst(filename_entry, "filename=", '"', '"', false);
-            QString fullname_text = Seer::parseFirst(filename_entry, "fullname=", '"', '"', false);
-
-            QString symbols_text = Seer::parseFirst(filename_entry, "symbols=", '[', ']', false);
-
-            QStringList symbols_list = Seer::parse(symbols_text, "", '{', '}', false);
-
-            for (const auto& symbol_entry : symbols_list) {
-
-                QString line_text        = Seer::parseFirst(symbol_entry, "line=", '"', '"', false);
-                QString name_text        = Seer::parseFirst(symbol_entry, "name=", '"', '"', false);
-                QString type_text        = Seer::parseFirst(symbol_entry, "type=", '"', '"', false);
-                QString description_text = Seer::parseFirst(symbol_entry, "type=", '"', '"', false);
-
-                // Skip variable entries that have no line number.
-                if (line_text == "") {
-                    continue;
-                }
-
-                // Add the variable to the tree.
-                QTreeWidgetItem* item = new QTreeWidgetItem;
-
-                QFont f0 = item->font(0);
-                f0.setBold(true);
-                item->setFont(0,f0);
-                item->setFont(1,f0);
-
-                item->setText(0, name_text);
-                item->setText(1, type_text);
-                item->setText(2, filename_text);
-                item->setText(3, line_text);
-                item->setText(4, fullname_text);
-                item->setText(5, description_text);
-
-                staticTreeWidget->addTopLevelItem(item);
-            }
-        }
+        //
+        // The program's static variables. Index them off the GUI thread. See handleIndexLoaded().
+        // See SeerSymbolIndex::parse() for the format.
+        //
+        _indexGeneration++;
+
+        _indexLoader->load(_indexGeneration, text);
+
+    }else if (text.startsWith(QString::number(_id) + "^error,")) {
+
+        // Try again on the next search.
+        _indexLoading = false;
+        _indexStale   = true;
+
+        staticNameSearchLineEdit->setPlaceholderText("Static names...");
+
+    }else if (text.startsWith("=library-loaded,") || text.startsWith("=library-unloaded,")) {
+
+        // The library's variables aren't in the index. A program can load many libraries
+        // before it stops, so wait for the stop and ask for them all at once.
+        _librariesLoaded = true;
 
     }else{
         // Ignore others.
     }
+}
+
+void SeerStaticBrowserWidget::handleIndexLoaded () {
+
+    SeerSymbolIndex index;
+
+    int generation = _indexLoader->result(index);
+
+    // A newer list is on its way.
+    if (generation != _indexGeneration) {
+        return;
+    }
+
+    _indexLoading = false;
+
+    staticNameSearchLineEdit->setPlaceholderText("Static names...");
+
+    _symbolModel->setIndex(index);
 
-  //staticTreeWidget->resizeColumnToContents(0);  // Name
-  //staticTreeWidget->resizeColumnToContents(1);  // Type
-    staticTreeWidget->resizeColumnToContents(2);  // Filename
-    staticTreeWidget->resizeColumnToContents(3);  // Line
-    staticTreeWidget->resizeColumnToContents(4);  // Fullname
-    staticTreeWidget->resizeColumnToContents(5);  // Description
-    staticTreeWidget->sortByColumn(0, Qt::AscendingOrder);
-    staticTreeWidget->setSortingEnabled(true);
+    handleSearchLineEdit();
+}
+
+void SeerStaticBrowserWidget::handleItemDoubleClicked (const QModelIndex& index) {
+
+    const SeerSymbol* symbol = _symbolModel->symbol(index);
+
+    if (symbol == 0) {
+        return;
+    }
 
-    QApplication::restoreOverrideCursor();
+    emit selectedFile(symbol->filename, symbol->fullname, symbol->line);
 }
 
-void SeerStaticBrowserWidget::handleItemDoubleClicked (QTreeWidgetItem* item, int column) {
+void SeerStaticBrowserWidget::handleSearchLineEdit () {
+
+    _searchTimer->stop();
+
+    if (_indexStale == true) {
+        loadIndex();
+    }
+
+    // Searched here, not by gdb. The index from before a reload is used until the new one is ready.
+    _symbolModel->setRows(_symbolModel->symbolIndex().search(staticNameSearchLineEdit->text(), staticTypeSearchLineEdit->text()));
+
+  //staticTreeView->resizeColumnToContents(0);  // Name
+  //staticTreeView->resizeColumnToContents(1);  // Type
+    staticTreeView->resizeColumnToContents(2);  // Filename
+    staticTreeView->resizeColumnToContents(3);  // Line
+    staticTreeView->resizeColumnToContents(4);  // Fullname
+    staticTreeView->resizeColumnToContents(5);  // Description
+}
 
-    Q_UNUSED(column);
+void SeerStaticBrowserWidget::handleSearchChanged () {
 
-    emit selectedFile(item->text(2), item->text(4), item->text(3).toInt());
+    _searchTimer->start();
 }
 
-void SeerStaticBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
+void SeerStaticBrowserWidget::refresh () {
 
-    Q_UNUSED(column);
+    _indexStale = true;
 
-    QString tip = QString("Variable: %1\nType: %2\nFile: %3\nLine: %4\nFullname: %5\nDescription: %6").arg(item->text(0)).arg(item->text(1)).arg(item->text(2)).arg(item->text(3)).arg(item->text(4)).arg(item->text(5));
+    if (isVisible()) {
+        loadIndex();
+    }
+}
 
-    item->setToolTip(0, tip);
+void SeerStaticBrowserWidget::handleStoppingPointReached () {
 
-    for (int i=1; i<staticTreeWidget->columnCount(); i++) { // Copy tooltip to the other columns.
-        item->setToolTip(i, item->toolTip(0));
+    if (_librariesLoaded == false) {
+        return;
     }
+
+    _librariesLoaded = false;
+    _indexStale      = true;
 }
 
-void SeerStaticBrowserWidget::handleSearchLineEdit () {
+void SeerStaticBrowserWidget::invalidate () {
 
-    staticTreeWidget->clear();
-    staticTreeWidget->setSortingEnabled(false);
-    staticTreeWidget->sortByColumn(-1, Qt::AscendingOrder);
+    // A new program. Forget the old one's variables, and any list still on its way.
+    _indexGeneration++;
+    _indexLoading    = false;
+    _indexStale      = true;
+    _librariesLoaded = false;
 
-  //staticTreeWidget->resizeColumnToContents(0);
-  //staticTreeWidget->resizeColumnToContents(1);
-    staticTreeWidget->resizeColumnToContents(2);
-    staticTreeWidget->resizeColumnToContents(3);
-    staticTreeWidget->resizeColumnToContents(4);
-    staticTreeWidget->resizeColumnToContents(5);
+    _symbolModel->clear();
 
-    if (staticNameSearchLineEdit->text() != "" || staticTypeSearchLineEdit->text() != "") {
-        emit refreshVariableList(_id, staticNameSearchLineEdit->text(), staticTypeSearchLineEdit->text());
+    if (isVisible()) {
+        loadIndex();
     }
 }
 
-void SeerStaticBrowserWidget::refresh () {
-    handleSearchLineEdit();
+void SeerStaticBrowserWidget::loadIndex () {
+
+    if (_indexLoading == true) {
+        return;
+    }
+
+    // A name regex that matches any name asks gdb for all of the variables, once.
+    _indexLoading    = true;
+    _indexStale      = false;
+    _librariesLoaded = false;
+
+    staticNameSearchLineEdit->setPlaceholderText("Loading statics...");
+
+    emit refreshVariableList(_id, ".", "");
+}
+
+void SeerStaticBrowserWidget::showEvent (QShowEvent* event) {
+
+    QWidget::showEvent(event);
+
+    if (_indexStale == true) {
+        loadIndex();
+    }
 }
 
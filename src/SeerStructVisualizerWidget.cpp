@@ -11,6 +11,14 @@
 #include <QtCore/QSettings>
 #include <QtCore/QDebug>
 
+// Where the members of an item are in _valueText, until they are parsed. A start of -1 is nothing to parse.
+static const int ValueStartRole  = Qt::UserRole;
+static const int ValueEndRole    = Qt::UserRole + 1;
+static const int LoadMoreRole    = Qt::UserRole + 2;
+
+// The flat value shown beside a struct is cut to this length.
+static const int FlatValueLength = 1000;
+
 SeerStructVisualizerWidget::SeerStructVisualizerWidget (QWidget* parent) : QWidget(parent) {
 
     // Init variables.
@@ -42,6 +50,8 @@ SeerStructVisualizerWidget::SeerStructVisualizerWidget (QWidget* parent) : QWidg
     QObject::connect(variableTreeWidget,     &QTreeWidget::itemEntered,                   this,  &SeerStructVisualizerWidget::handleItemEntered);
     QObject::connect(variableTreeWidget,     &QTreeWidget::itemExpanded,                  this,  &SeerStructVisualizerWidget::handleItemExpanded);
     QObject::connect(variableTreeWidget,     &QTreeWidget::itemCollapsed,                 this,  &SeerStructVisualizerWidget::handleItemExpanded);
+    QObject::connect(variableTreeWidget,     &QTreeWidget::itemClicked,                   this,  &SeerStructVisualizerWidget::handleItemClicked);
+    QObject::connect(elementLimitSpinBox,    QOverload<int>::of(&QSpinBox::valueChanged), this,  &SeerStructVisualizerWidget::handleElementLimitSpinBox);
 
     // Restore window settings.
     readSettings();
@@ -58,11 +68,13 @@ void SeerStructVisualizerWidget::setVariableName (const QString& name) {
 
     // Create the initial variable in the tree.
     variableTreeWidget->clear();
+    _valueText.clear();
 
     if (variableNameLineEdit->text() != "") {
         QTreeWidgetItem* item = new QTreeWidgetItem;
         item->setText(0, name);
         item->setText(1, "");
+        item->setData(0, ValueStartRole, -1);
 
         variableTreeWidget->addTopLevelItem(item);
     }
@@ -97,14 +109,25 @@ void SeerStructVisualizerWidget::handleText (const QString& text) {
                 return;
             }
 
+            // Remember what was expanded, so a refresh shows the same levels.
+            QSet<QString> expanded;
+
+            for (QTreeWidgetItemIterator it(topItem); *it; ++it) {
+                if ((*it)->isExpanded() && (*it)->childCount() > 0) {
+                    expanded.insert(itemPath(*it));
+                }
+            }
+
             // Delete all subitems of the toplevel item.
             foreach (auto item, topItem->takeChildren()) delete item;
 
-            // Populate the tree.
-            handleItemCreate(topItem, value_text);
+            // Keep the value. Only the levels that are expanded are parsed.
+            _valueText = value_text;
+
+            handleItemValue(topItem, 0, _valueText.size());
 
-            // For now, always expand everything.
-            variableTreeWidget->expandAll();
+            // The toplevel item is always expanded. The others only if they were before.
+            restoreExpanded(topItem, itemPath(topItem), expanded);
         }
 
 
@@ -130,6 +153,7 @@ void SeerStructVisualizerWidget::handleText (const QString& text) {
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
         variableTreeWidget->clear();
+        _valueText.clear();
 
     // At a stopping point, refresh.
     }else if (text.startsWith("*stopped,reason=\"")) {
@@ -150,84 +174,241 @@ void SeerStructVisualizerWidget::handleText (const QString& text) {
     QApplication::restoreOverrideCursor();
 }
 
-void SeerStructVisualizerWidget::handleItemCreate (QTreeWidgetItem* parentItem, const QString& value_text) {
+void SeerStructVisualizerWidget::handleItemCreate (QTreeWidgetItem* parentItem, int start, int end) {
+
+    //
+    // Add the members in _valueText[start,end) to the item, up to the element limit.
+    //
+    // name = "Pasveer, Ernie", age = 60, salary = 0.25, location = {city = "Houston", state = "Texas", zip = 77063}
+    //
+    // The members that are structs aren't parsed. Their place in the text is kept
+    // for when they are expanded.
+    //
+    QList<QTreeWidgetItem*> items;
+    QTreeWidgetItem*        prevItem = (parentItem->childCount() > 0 ? parentItem->child(parentItem->childCount()-1) : 0);
+    int                     limit    = elementLimitSpinBox->value();
+    int                     count    = 0;
+    int                     index    = start;
+
+    while (index < end) {
+
+        // Leave the rest for later.
+        if (count >= limit) {
+
+            QTreeWidgetItem* item = new QTreeWidgetItem;
+            item->setText(0, "...");
+            item->setText(1, "Click to load more");
+            item->setData(0, ValueStartRole, index);
+            item->setData(0, ValueEndRole,   end);
+            item->setData(0, LoadMoreRole,   true);
+
+            items.append(item);
+
+            break;
+        }
 
-    if (Seer::hasBookends(value_text, '{', '}')) {
+        int fieldStart = 0;
+        int fieldEnd   = 0;
 
-        // Remove bookends
-        QString text = Seer::filterBookends(value_text, '{', '}');
+        index = nextField(index, end, fieldStart, fieldEnd);
 
-        // Set the flatvalue text.
-        parentItem->setText(1, Seer::filterEscapes(text));
+        count++;
 
-        // Convert to a list of name/value pairs.
-        QStringList nv_pairs = Seer::parseCommaList(text, '{', '}');
+        if (fieldStart == fieldEnd) {
+            continue;
+        }
 
-        // Go through each pair and add the name and its value to the tree.
-        QTreeWidgetItem* prevItem = 0;
+        int separator = findSeparator(fieldStart, fieldEnd);
 
-        for (const auto& nv : nv_pairs) {
+        // Handle "name = "xxxx", '\\000' <repeats 14 times>, "yyyy" ..., age = 0, salary = 0"
+        // There is a 'first' value but no 'second'. So just concatenate unto the previous item.
+        if (separator < 0) {
 
-            QStringPair pair = Seer::parseNameValue(nv, '=');
+            if (prevItem) {
+                prevItem->setText(0, prevItem->text(0) + _valueText.mid(fieldStart, fieldEnd-fieldStart));
+                prevItem->setText(1, "");
+            }
 
-            // Handle "name = "xxxx", '\\000' <repeats 14 times>, "yyyy" ..., age = 0, salary = 0"
-            // There is a 'first' value but no 'second'. So just concatenate unto the previous item.
-            if (pair.second == "") {
+            continue;
+        }
 
-                if (prevItem) {
-                    prevItem->setText(0, prevItem->text(0) + pair.first);
-                    prevItem->setText(1, "");
-                }
+        // Normal case of "name = value".
+        QTreeWidgetItem* item = new QTreeWidgetItem;
+        item->setText(0, _valueText.mid(fieldStart, separator-fieldStart).trimmed());
+
+        handleItemValue(item, separator+1, fieldEnd);
 
-            // Normal case of "name = value".
-            }else{
+        items.append(item);
 
-                QTreeWidgetItem* item = new QTreeWidgetItem;
-                item->setText(0, pair.first);
-                item->setText(1, "");
+        prevItem = item;
+    }
 
-                parentItem->addChild(item);
+    // Add them in one go.
+    parentItem->addChildren(items);
+}
 
-                // Handle recursion if value has bookends.
-                if (Seer::hasBookends(pair.second, '{', '}')) {
-                    handleItemCreate(item, pair.second);
-                }else{
-                    item->setText(1, Seer::filterEscapes(pair.second));
-                }
+void SeerStructVisualizerWidget::handleItemValue (QTreeWidgetItem* item, int start, int end) {
 
-                prevItem = item;
-            }
-        }
+    // Trim the value.
+    while (start < end && _valueText[start].isSpace()) {
+        start++;
+    }
+
+    while (end > start && _valueText[end-1].isSpace()) {
+        end--;
+    }
+
+    // A struct. Show it flat and keep where its members are for when it's expanded.
+    if (end - start >= 2 && _valueText[start] == '{' && _valueText[end-1] == '}') {
 
-        parentItem->setExpanded(true);
+        int length = end - start - 2;
 
+        item->setText(1, Seer::filterEscapes(Seer::elideText(_valueText.mid(start+1, qMin(length, FlatValueLength+1)), Qt::ElideRight, FlatValueLength)));
+
+        if (length > 0) {
+            item->setData(0, ValueStartRole, start+1);
+            item->setData(0, ValueEndRole,   end-1);
+            item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+        }else{
+            item->setData(0, ValueStartRole, -1);
+        }
+
+    // A plain value.
     }else{
-        parentItem->setText(1, Seer::filterEscapes(value_text));
+        item->setText(1, Seer::filterEscapes(_valueText.mid(start, end-start)));
+        item->setData(0, ValueStartRole, -1);
     }
 }
 
-void SeerStructVisualizerWidget::handleContextMenu (const QPoint& pos) {
+void SeerStructVisualizerWidget::restoreExpanded (QTreeWidgetItem* item, const QString& path, const QSet<QString>& expanded) {
 
-    QTreeWidgetItem* item = variableTreeWidget->itemAt(pos);
+    if (item->parent() != 0 && expanded.contains(path) == false) {
+        return;
+    }
 
-    if (item == 0) {
+    if (item->data(0, ValueStartRole).toInt() < 0 && item->childCount() == 0) {
         return;
     }
 
-    // Create the variable name.
+    // Parses the item, if need be.
+    item->setExpanded(true);
+    handleItemExpanded(item);
+
+    for (int i=0; i<item->childCount(); i++) {
+
+        QTreeWidgetItem* child = item->child(i);
+
+        if (child->data(0, LoadMoreRole).toBool() == false) {
+            restoreExpanded(child, path + "." + child->text(0), expanded);
+        }
+    }
+}
+
+QString SeerStructVisualizerWidget::itemPath (QTreeWidgetItem* item) const {
+
     // It's a struct so include its parent names.
-    QString variable;
+    QString path;
 
     while (item) {
-        if (variable == "") {
-            variable = item->text(0);
+        if (path == "") {
+            path = item->text(0);
         }else{
-            variable = item->text(0) + "." + variable;
+            path = item->text(0) + "." + path;
         }
 
         item = item->parent();
     }
 
+    return path;
+}
+
+int SeerStructVisualizerWidget::nextField (int start, int end, int& fieldStart, int& fieldEnd) const {
+
+    //
+    // Find the end of the field that starts at 'start'. The same rules as Seer::parseCommaList():
+    // a comma ends the field if it isn't in quotes or braces. The field is trimmed. Returns
+    // where the next field starts.
+    //
+    bool inquotes     = false;
+    int  bracketlevel = 0;
+    int  index        = start;
+
+    while (index < end) {
+
+        QChar c = _valueText[index];
+
+        if (c == '"') {
+            inquotes = !inquotes;
+
+        }else if (inquotes == false) {
+
+            if (c == '{') {
+                bracketlevel++;
+            }else if (c == '}') {
+                bracketlevel--;
+            }else if (c == ',' && bracketlevel == 0) {
+                break;
+            }
+        }
+
+        index++;
+    }
+
+    fieldStart = start;
+    fieldEnd   = index;
+
+    while (fieldStart < fieldEnd && _valueText[fieldStart].isSpace()) {
+        fieldStart++;
+    }
+
+    while (fieldEnd > fieldStart && _valueText[fieldEnd-1].isSpace()) {
+        fieldEnd--;
+    }
+
+    return index + 1;
+}
+
+int SeerStructVisualizerWidget::findSeparator (int start, int end) const {
+
+    // The first '=' that isn't in quotes, like Seer::parseNameValue(). -1 if there isn't one, or
+    // nothing follows it.
+    bool inquotes = false;
+
+    for (int index=start; index<end; index++) {
+
+        QChar c = _valueText[index];
+
+        if (c == '"') {
+            inquotes = !inquotes;
+            continue;
+        }
+
+        if (c == '=' && inquotes == false) {
+
+            for (int i=index+1; i<end; i++) {
+                if (_valueText[i].isSpace() == false) {
+                    return index;
+                }
+            }
+
+            return -1;
+        }
+    }
+
+    return -1;
+}
+
+void SeerStructVisualizerWidget::handleContextMenu (const QPoint& pos) {
+
+    QTreeWidgetItem* item = variableTreeWidget->itemAt(pos);
+
+    if (item == 0 || item->data(0, LoadMoreRole).toBool()) {
+        return;
+    }
+
+    // Create the variable name.
+    QString variable = itemPath(item);
+
     // Create the menus.
     QAction* addMemoryVisualizerAction;
     QAction* addMemoryAsteriskVisualizerAction;
@@ -409,13 +590,57 @@ void SeerStructVisualizerWidget::handleItemEntered (QTreeWidgetItem* item, int c
 
 void SeerStructVisualizerWidget::handleItemExpanded (QTreeWidgetItem* item) {
 
-    Q_UNUSED(item);
+    // Parse the members the first time the item is expanded.
+    if (item->isExpanded() && item->data(0, LoadMoreRole).toBool() == false) {
+
+        int start = item->data(0, ValueStartRole).toInt();
+        int end   = item->data(0, ValueEndRole).toInt();
+
+        if (start >= 0 && item->childCount() == 0) {
+            item->setData(0, ValueStartRole, -1);
+            handleItemCreate(item, start, end);
+        }
+    }
 
     // Resize columns.
     variableTreeWidget->resizeColumnToContents(0);
     variableTreeWidget->resizeColumnToContents(1);
 }
 
+void SeerStructVisualizerWidget::handleItemClicked (QTreeWidgetItem* item, int column) {
+
+    Q_UNUSED(column);
+
+    if (item->data(0, LoadMoreRole).toBool() == false) {
+        return;
+    }
+
+    // Replace the "load more" item with the next members.
+    QTreeWidgetItem* parentItem = item->parent();
+    int              start      = item->data(0, ValueStartRole).toInt();
+    int              end        = item->data(0, ValueEndRole).toInt();
+
+    if (parentItem == 0) {
+        return;
+    }
+
+    delete parentItem->takeChild(parentItem->indexOfChild(item));
+
+    handleItemCreate(parentItem, start, end);
+
+    // Resize columns.
+    variableTreeWidget->resizeColumnToContents(0);
+    variableTreeWidget->resizeColumnToContents(1);
+}
+
+void SeerStructVisualizerWidget::handleElementLimitSpinBox (int limit) {
+
+    Q_UNUSED(limit);
+
+    // Used the next time a level is parsed.
+    writeSettings();
+}
+
 void SeerStructVisualizerWidget::handleRefreshButton () {
 
     if (variableNameLineEdit->text() == "") {
@@ -448,7 +673,8 @@ void SeerStructVisualizerWidget::writeSettings () {
     QSettings settings;
 
     settings.beginGroup("structvisualizerwindow");
-    settings.setValue("size", size());
+    settings.setValue("size",         size());
+    settings.setValue("elementlimit", elementLimitSpinBox->value());
     settings.endGroup();
 }
 
@@ -458,6 +684,7 @@ void SeerStructVisualizerWidget::readSettings () {
 
     settings.beginGroup("structvisualizerwindow");
     resize(settings.value("size", QSize(800, 400)).toSize());
+    elementLimitSpinBox->setValue(settings.value("elementlimit", 200).toInt());
     settings.endGroup();
 }
 
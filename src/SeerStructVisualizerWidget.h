@@ -1,8 +1,17 @@
 #pragma once
 
 #include <QtWidgets/QWidget>
+#include <QtCore/QSet>
+#include <QtCore/QString>
 #include "ui_SeerStructVisualizerWidget.h"
 
+//
+// Shows the value of a struct as a tree.
+//
+// The value is kept as gdb sent it. Each item remembers where its value is in that
+// text and its members are only parsed when the item is expanded. A level with more
+// members than the element limit ends with a "load more" item for the rest.
+//
 class SeerStructVisualizerWidget : public QWidget, protected Ui::SeerStructVisualizerWidgetForm {
 
     Q_OBJECT
@@ -30,14 +39,22 @@ class SeerStructVisualizerWidget : public QWidget, protected Ui::SeerStructVisua
         void                handleContextMenu                   (const QPoint&    pos);
         void                handleItemEntered                   (QTreeWidgetItem* item, int column);
         void                handleItemExpanded                  (QTreeWidgetItem* item);
+        void                handleItemClicked                   (QTreeWidgetItem* item, int column);
+        void                handleElementLimitSpinBox           (int limit);
 
     protected:
-        void                handleItemCreate                    (QTreeWidgetItem* parentItem, const QString& value_text);
+        void                handleItemCreate                    (QTreeWidgetItem* parentItem, int start, int end);
+        void                handleItemValue                     (QTreeWidgetItem* item, int start, int end);
+        void                restoreExpanded                     (QTreeWidgetItem* item, const QString& path, const QSet<QString>& expanded);
+        QString             itemPath                            (QTreeWidgetItem* item) const;
+        int                 nextField                           (int start, int end, int& fieldStart, int& fieldEnd) const;
+        int                 findSeparator                       (int start, int end) const;
         void                writeSettings                       ();
         void                readSettings                        ();
         void                resizeEvent                         (QResizeEvent* event);
 
     private:
         int                 _variableId;
+        QString             _valueText;                         // The value as gdb sent it. Items refer to it by offset.
 };
 
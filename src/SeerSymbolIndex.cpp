@@ -0,0 +1,326 @@
+#include "SeerSymbolIndex.h"
+#include "SeerUtl.h"
+#include <QtCore/QMutexLocker>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringList>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+//
+// Text with any of these in it is a regex.
+//
+static bool isRegex (const QString& text) {
+
+    static const QString specials("^$.*+?[](){}|\\");
+
+    for (const QChar& c : text) {
+        if (specials.contains(c)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+SeerSymbolIndex::SeerSymbolIndex () {
+}
+
+SeerSymbolIndex::~SeerSymbolIndex () {
+}
+
+void SeerSymbolIndex::parse (const QString& text) {
+
+    // -symbol-info-functions
+    // ^done,symbols={
+    //          debug=[
+    //                  {
+    //                      filename="elf-init.c",
+    //                      fullname="/home/abuild/rpmbuild/BUILD/glibc-2.31/csu/elf-init.c",
+    //                      symbols=[
+    //                                  {
+    //                                      line="95",
+    //                                      name="__libc_csu_fini",
+    //                                      type="void (void)",
+    //                                      description="void __libc_csu_fini(void);"
+    //                                  },
+    //                                  ...
+    //                              ]
+    //                  },
+    //                  ...
+    //                ]
+    //              }
+    //
+    // Types have no type or description.
+
+    _symbols.clear();
+
+    QString     debug_text     = Seer::parseFirst(text, "debug=", '[', ']', false);
+    QStringList filenames_list = Seer::parse(debug_text, "", '{', '}', false);
+
+    debug_text = QString();
+
+    for (const auto& filename_entry : filenames_list) {
+
+        QString filename_text = Seer::parseFirst(filename_entry, "filename=", '"', '"', false);
+        QString fullname_text = Seer::parseFirst(filename_entry, "fullname=", '"', '"', false);
+
+        QString     symbols_text = Seer::parseFirst(filename_entry, "symbols=", '[', ']', false);
+        QStringList symbols_list = Seer::parse(symbols_text, "", '{', '}', false);
+
+        for (const auto& symbol_entry : symbols_list) {
+
+            QString line_text = Seer::parseFirst(symbol_entry, "line=", '"', '"', false);
+
+            // Skip entries that have no line number.
+            if (line_text == "") {
+                continue;
+            }
+
+            SeerSymbol symbol;
+            symbol.name        = Seer::parseFirst(symbol_entry, "name=",        '"', '"', false);
+            symbol.type        = Seer::parseFirst(symbol_entry, "type=",        '"', '"', false);
+            symbol.description = Seer::parseFirst(symbol_entry, "description=", '"', '"', false);
+            symbol.filename    = filename_text;
+            symbol.fullname    = fullname_text;
+            symbol.line        = line_text.toInt();
+            symbol.nameKey     = symbol.name.toLower();
+            symbol.typeKey     = symbol.type.toLower();
+
+            _symbols.append(symbol);
+        }
+    }
+
+    // By name, ignoring case. Then by where it is.
+    std::sort(_symbols.begin(), _symbols.end(), [](const SeerSymbol& a, const SeerSymbol& b) {
+        if (a.nameKey != b.nameKey) {
+            return a.nameKey < b.nameKey;
+        }
+        if (a.fullname != b.fullname) {
+            return a.fullname < b.fullname;
+        }
+        return a.line < b.line;
+    });
+}
+
+void SeerSymbolIndex::clear () {
+
+    _symbols.clear();
+}
+
+int SeerSymbolIndex::size () const {
+
+    return _symbols.size();
+}
+
+bool SeerSymbolIndex::isEmpty () const {
+
+    return _symbols.isEmpty();
+}
+
+const SeerSymbol& SeerSymbolIndex::symbol (int row) const {
+
+    return _symbols[row];
+}
+
+QVector<int> SeerSymbolIndex::search (const QString& nameText, const QString& typeText) const {
+
+    QVector<int> rows;
+
+    QString name = nameText.trimmed();
+    QString type = typeText.trimmed();
+
+    QRegularExpression nameRegex;
+
+    if (isRegex(name)) {
+
+        nameRegex = QRegularExpression(name, QRegularExpression::CaseInsensitiveOption);
+
+        // A regex that's only "^text" is a prefix. An invalid one is plain text.
+        if (nameRegex.isValid() == false) {
+            nameRegex = QRegularExpression();
+        }else if (name.startsWith('^') && isRegex(name.mid(1)) == false) {
+            nameRegex = QRegularExpression();
+            name      = name.mid(1);
+        }
+    }
+
+    if (name.isEmpty()) {
+
+        // Everything.
+        rows.resize(_symbols.size());
+
+        for (int i=0; i<_symbols.size(); i++) {
+            rows[i] = i;
+        }
+
+    }else if (nameRegex.pattern().isEmpty() == false) {
+
+        for (int i=0; i<_symbols.size(); i++) {
+            if (nameRegex.match(_symbols[i].name).hasMatch()) {
+                rows.append(i);
+            }
+        }
+
+    }else{
+
+        QString key = name.toLower();
+
+        // The names that start with the text are together. Find them first.
+        QVector<SeerSymbol>::const_iterator it = std::lower_bound(_symbols.constBegin(), _symbols.constEnd(), key, [](const SeerSymbol& symbol, const QString& k) { return symbol.nameKey < k; });
+
+        int first = int(it - _symbols.constBegin());
+        int last  = first;
+
+        while (last < _symbols.size() && _symbols[last].nameKey.startsWith(key)) {
+            rows.append(last);
+            last++;
+        }
+
+        // Then the names that have it further in, like "ns::text" or "get_text".
+        for (int i=0; i<_symbols.size(); i++) {
+
+            if (i == first && last > first) {
+                i = last - 1;
+                continue;
+            }
+
+            if (_symbols[i].nameKey.indexOf(key, 1) > 0) {
+                rows.append(i);
+            }
+        }
+    }
+
+    // The type, for variables.
+    if (type.isEmpty() == false) {
+
+        QRegularExpression typeRegex;
+
+        if (isRegex(type)) {
+            typeRegex = QRegularExpression(type, QRegularExpression::CaseInsensitiveOption);
+        }
+
+        QString      key = type.toLower();
+        QVector<int> matches;
+
+        matches.reserve(rows.size());
+
+        for (int i : rows) {
+
+            bool match = false;
+
+            if (typeRegex.isValid() && typeRegex.pattern().isEmpty() == false) {
+                match = typeRegex.match(_symbols[i].type).hasMatch();
+            }else{
+                match = _symbols[i].typeKey.contains(key);
+            }
+
+            if (match) {
+                matches.append(i);
+            }
+        }
+
+        rows.swap(matches);
+    }
+
+    return rows;
+}
+
+SeerSymbolIndexLoader::SeerSymbolIndexLoader (QObject* parent) : QThread(parent) {
+
+    _running           = false;
+    _pending           = false;
+    _stop              = false;
+    _requestGeneration = 0;
+    _resultGeneration  = 0;
+}
+
+SeerSymbolIndexLoader::~SeerSymbolIndexLoader () {
+
+    {
+        QMutexLocker locker(&_mutex);
+
+        _stop    = true;
+        _pending = false;
+    }
+
+    wait();
+}
+
+void SeerSymbolIndexLoader::load (int generation, const QString& text) {
+
+    QMutexLocker locker(&_mutex);
+
+    // Replace any pending request. QString is implicitly shared, so nothing is copied here.
+    _requestGeneration = generation;
+    _requestText       = text;
+    _pending           = true;
+
+    if (_running == true) {
+        return;
+    }
+
+    _running = true;
+
+    locker.unlock();
+
+    // The thread may still be on its way out of run(). Let it finish before restarting it.
+    wait();
+    start(QThread::LowPriority);
+}
+
+int SeerSymbolIndexLoader::result (SeerSymbolIndex& index) {
+
+    QMutexLocker locker(&_mutex);
+
+    index = _resultIndex;
+
+    _resultIndex.clear();
+
+    return _resultGeneration;
+}
+
+void SeerSymbolIndexLoader::run () {
+
+    while (1) {
+
+        // Take the pending request, if any.
+        int     generation;
+        QString text;
+
+        {
+            QMutexLocker locker(&_mutex);
+
+            if (_pending == false || _stop == true) {
+                _running = false;
+                return;
+            }
+
+            generation = _requestGeneration;
+            text       = _requestText;
+            _pending   = false;
+
+            _requestText = QString();
+        }
+
+        SeerSymbolIndex index;
+
+        index.parse(text);
+
+        text = QString();
+
+        // Hand over the index, unless a newer request came in.
+        {
+            QMutexLocker locker(&_mutex);
+
+            if (_pending == true || _stop == true) {
+                continue;
+            }
+
+            _resultGeneration = generation;
+            _resultIndex      = index;
+        }
+
+        emit loaded();
+    }
+}
+
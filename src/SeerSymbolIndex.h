@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+//
+// One function, type or variable from gdb's "-symbol-info-*" replies.
+//
+struct SeerSymbol {
+    QString     name;
+    QString     type;           // Functions and variables only.
+    QString     description;    // Functions and variables only.
+    QString     filename;
+    QString     fullname;
+    int         line;
+    QString     nameKey;        // The name, lower case. Searched by the index.
+    QString     typeKey;        // The type, lower case.
+};
+
+//
+// The functions, types or variables of the program, sorted by name.
+//
+// Made once from the reply to "-symbol-info-functions", "-symbol-info-types" or
+// "-symbol-info-variables" for all of the names, then searched here instead of
+// asking gdb for each search.
+//
+// Plain text finds the names that start with it first, by a binary search of the
+// sorted names, then the names that have it elsewhere. Text with regex characters
+// in it is a regex. Case is ignored.
+//
+class SeerSymbolIndex {
+
+    public:
+        SeerSymbolIndex ();
+       ~SeerSymbolIndex ();
+
+        void                                parse                   (const QString& text);
+        void                                clear                   ();
+
+        int                                 size                    () const;
+        bool                                isEmpty                 () const;
+        const SeerSymbol&                   symbol                  (int row) const;
+
+        QVector<int>                        search                  (const QString& nameText, const QString& typeText) const;
+
+    private:
+        QVector<SeerSymbol>                 _symbols;               // By name.
+};
+
+//
+// Makes a SeerSymbolIndex from a reply, off the GUI thread.
+//
+// The replies for a large program are many megabytes. A reply that arrives while
+// one is being indexed replaces any pending one. Only the latest index is kept.
+//
+class SeerSymbolIndexLoader : public QThread {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerSymbolIndexLoader (QObject* parent = 0);
+       ~SeerSymbolIndexLoader ();
+
+        void                                load                    (int generation, const QString& text);
+        int                                 result                  (SeerSymbolIndex& index);
+
+    signals:
+        void                                loaded                  ();
+
+    protected:
+        void                                run                     () override;
+
+    private:
+        QMutex                              _mutex;
+        bool                                _running;
+        bool                                _pending;
+        bool                                _stop;
+
+        int                                 _requestGeneration;
+        QString                             _requestText;
+
+        int                                 _resultGeneration;
+        SeerSymbolIndex                     _resultIndex;
+};
+
@@ -0,0 +1,175 @@
+#include "SeerSymbolModel.h"
+#include <QtGui/QFont>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+SeerSymbolModel::SeerSymbolModel (QObject* parent) : QAbstractTableModel(parent) {
+
+    _boldColumns = 0;
+    _sortColumn  = -1;
+    _sortOrder   = Qt::AscendingOrder;
+}
+
+SeerSymbolModel::~SeerSymbolModel () {
+}
+
+int SeerSymbolModel::rowCount (const QModelIndex& parent) const {
+
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return _rows.size();
+}
+
+int SeerSymbolModel::columnCount (const QModelIndex& parent) const {
+
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return _fields.size();
+}
+
+QVariant SeerSymbolModel::data (const QModelIndex& index, int role) const {
+
+    const SeerSymbol* s = symbol(index);
+
+    if (s == 0 || index.column() >= _fields.size()) {
+        return QVariant();
+    }
+
+    if (role == Qt::DisplayRole) {
+        return text(*s, _fields[index.column()]);
+    }
+
+    // "Function: main\nFile: helloworld.cpp\n..."
+    if (role == Qt::ToolTipRole) {
+
+        QStringList lines;
+
+        for (int c=0; c<_fields.size(); c++) {
+            lines.append(QString("%1: %2").arg(_headers.value(c)).arg(text(*s, _fields[c])));
+        }
+
+        return lines.join('\n');
+    }
+
+    if (role == Qt::FontRole && index.column() < _boldColumns) {
+        QFont font;
+        font.setBold(true);
+        return font;
+    }
+
+    return QVariant();
+}
+
+QVariant SeerSymbolModel::headerData (int section, Qt::Orientation orientation, int role) const {
+
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    return _headers.value(section);
+}
+
+void SeerSymbolModel::sort (int column, Qt::SortOrder order) {
+
+    _sortColumn = column;
+    _sortOrder  = order;
+
+    beginResetModel();
+
+    sortRows();
+
+    endResetModel();
+}
+
+void SeerSymbolModel::setColumns (const QVector<Field>& fields, const QStringList& headers, int boldColumns) {
+
+    beginResetModel();
+
+    _fields      = fields;
+    _headers     = headers;
+    _boldColumns = boldColumns;
+
+    endResetModel();
+}
+
+void SeerSymbolModel::setIndex (const SeerSymbolIndex& index) {
+
+    beginResetModel();
+
+    _index = index;
+    _rows.clear();
+
+    endResetModel();
+}
+
+const SeerSymbolIndex& SeerSymbolModel::symbolIndex () const {
+
+    return _index;
+}
+
+void SeerSymbolModel::setRows (const QVector<int>& rows) {
+
+    beginResetModel();
+
+    _rows = rows;
+
+    sortRows();
+
+    endResetModel();
+}
+
+void SeerSymbolModel::clear () {
+
+    setIndex(SeerSymbolIndex());
+}
+
+const SeerSymbol* SeerSymbolModel::symbol (const QModelIndex& index) const {
+
+    if (index.isValid() == false || index.row() >= _rows.size()) {
+        return 0;
+    }
+
+    return &_index.symbol(_rows[index.row()]);
+}
+
+QString SeerSymbolModel::text (const SeerSymbol& symbol, Field field) const {
+
+    switch (field) {
+        case NameField:        return symbol.name;
+        case TypeField:        return symbol.type;
+        case FilenameField:    return symbol.filename;
+        case LineField:        return QString::number(symbol.line);
+        case FullnameField:    return symbol.fullname;
+        case DescriptionField: return symbol.description;
+    }
+
+    return QString();
+}
+
+void SeerSymbolModel::sortRows () {
+
+    // No column is the search's order, best matches first.
+    if (_sortColumn < 0 || _sortColumn >= _fields.size()) {
+        return;
+    }
+
+    Field field = _fields[_sortColumn];
+    bool  up    = (_sortOrder == Qt::AscendingOrder);
+
+    std::stable_sort(_rows.begin(), _rows.end(), [this, field, up](int a, int b) {
+
+        const SeerSymbol& sa = _index.symbol(up ? a : b);
+        const SeerSymbol& sb = _index.symbol(up ? b : a);
+
+        if (field == LineField) {
+            return sa.line < sb.line;
+        }
+
+        return text(sa, field) < text(sb, field);
+    });
+}
+
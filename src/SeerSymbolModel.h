@@ -0,0 +1,61 @@
+#pragma once
+
+#include "SeerSymbolIndex.h"
+#include <QtCore/QAbstractTableModel>
+#include <QtCore/QModelIndex>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtCore/QStringList>
+#include <QtCore/QString>
+
+//
+// The symbols of a SeerSymbolIndex that matched a search, one row per symbol.
+//
+// Holds only the index's row numbers, so a search with many matches is shown
+// without copying or making an item per symbol. Each browser picks which fields
+// are shown, in which columns, and what the headers say.
+//
+class SeerSymbolModel : public QAbstractTableModel {
+
+    Q_OBJECT
+
+    public:
+        enum Field {
+            NameField           = 0,
+            TypeField           = 1,
+            FilenameField       = 2,
+            LineField           = 3,
+            FullnameField       = 4,
+            DescriptionField    = 5
+        };
+
+        explicit SeerSymbolModel (QObject* parent = 0);
+       ~SeerSymbolModel ();
+
+        int                                 rowCount                (const QModelIndex& parent = QModelIndex()) const override;
+        int                                 columnCount             (const QModelIndex& parent = QModelIndex()) const override;
+        QVariant                            data                    (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant                            headerData              (int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+        void                                sort                    (int column, Qt::SortOrder order = Qt::AscendingOrder) override;
+
+        void                                setColumns              (const QVector<Field>& fields, const QStringList& headers, int boldColumns);
+        void                                setIndex                (const SeerSymbolIndex& index);
+        const SeerSymbolIndex&              symbolIndex             () const;
+        void                                setRows                 (const QVector<int>& rows);
+        void                                clear                   ();
+
+        const SeerSymbol*                   symbol                  (const QModelIndex& index) const;
+
+    private:
+        QString                             text                    (const SeerSymbol& symbol, Field field) const;
+        void                                sortRows                ();
+
+        SeerSymbolIndex                     _index;
+        QVector<int>                        _rows;                  // Rows of the index.
+        QVector<Field>                      _fields;
+        QStringList                         _headers;
+        int                                 _boldColumns;           // The first columns are in bold.
+        int                                 _sortColumn;            // -1 is the search's order.
+        Qt::SortOrder                       _sortOrder;
+};
+
@@ -0,0 +1,176 @@
+#include "SeerTextFinder.h"
+#include <QtCore/QMutexLocker>
+#include <QtCore/QDebug>
+
+SeerTextFinder::SeerTextFinder (QObject* parent) : QThread(parent) {
+
+    _running                = false;
+    _pending                = false;
+    _stop                   = false;
+    _requestGeneration      = 0;
+    _requestCaseSensitivity = Qt::CaseInsensitive;
+    _resultGeneration       = 0;
+    _resultDone             = true;
+}
+
+SeerTextFinder::~SeerTextFinder () {
+
+    {
+        QMutexLocker locker(&_mutex);
+
+        _stop    = true;
+        _pending = false;
+    }
+
+    wait();
+}
+
+void SeerTextFinder::find (int generation, const QString& text, const QString& pattern, Qt::CaseSensitivity cs) {
+
+    QMutexLocker locker(&_mutex);
+
+    // Replace any pending request. The running one notices and stops.
+    _requestGeneration      = generation;
+    _requestText            = text;
+    _requestPattern         = pattern;
+    _requestCaseSensitivity = cs;
+    _pending                = true;
+
+    if (_running == true) {
+        return;
+    }
+
+    _running = true;
+
+    locker.unlock();
+
+    // The thread may still be on its way out of run(). Let it finish before restarting it.
+    wait();
+    start(QThread::LowPriority);
+}
+
+void SeerTextFinder::cancel () {
+
+    QMutexLocker locker(&_mutex);
+
+    // Stop at the next batch. Don't hold on to the text.
+    _requestGeneration = -1;
+    _requestText       = QString();
+    _requestPattern    = QString();
+    _pending           = _running;
+}
+
+int SeerTextFinder::takeMatches (QVector<int>& positions, QVector<int>& lines, bool& done) {
+
+    QMutexLocker locker(&_mutex);
+
+    positions.clear();
+    lines.clear();
+
+    positions.swap(_resultPositions);
+    lines.swap(_resultLines);
+
+    done = _resultDone;
+
+    return _resultGeneration;
+}
+
+void SeerTextFinder::run () {
+
+    while (1) {
+
+        // Take the pending request, if any.
+        int                 generation;
+        QString             text;
+        QString             pattern;
+        Qt::CaseSensitivity cs;
+
+        {
+            QMutexLocker locker(&_mutex);
+
+            if (_pending == false || _stop == true) {
+                _running = false;
+                return;
+            }
+
+            generation = _requestGeneration;
+            text       = _requestText;
+            pattern    = _requestPattern;
+            cs         = _requestCaseSensitivity;
+            _pending   = false;
+
+            _requestText    = QString();
+            _requestPattern = QString();
+
+            _resultGeneration = generation;
+            _resultDone       = false;
+            _resultPositions.clear();
+            _resultLines.clear();
+        }
+
+        if (generation < 0 || pattern.isEmpty()) {
+            continue;
+        }
+
+        //
+        // Walk the text. Keep track of the line number while going, so the
+        // editor doesn't have to look up each match's block.
+        //
+        const QChar* data     = text.constData();
+        int          lineno   = 1;
+        int          scanned  = 0;
+        int          position = text.indexOf(pattern, 0, cs);
+        bool         aborted  = false;
+
+        QVector<int> positions;
+        QVector<int> lines;
+
+        while (1) {
+
+            if (position >= 0) {
+
+                for (; scanned < position; scanned++) {
+                    if (data[scanned] == QLatin1Char('\n')) {
+                        lineno++;
+                    }
+                }
+
+                positions.append(position);
+                lines.append(lineno);
+
+                position = text.indexOf(pattern, position + pattern.length(), cs);
+            }
+
+            if (positions.size() < BatchSize && position >= 0) {
+                continue;
+            }
+
+            // Hand over the batch. Stop if a newer request came in.
+            {
+                QMutexLocker locker(&_mutex);
+
+                if (_pending == true || _stop == true) {
+                    aborted = true;
+                }else{
+                    _resultPositions += positions;
+                    _resultLines     += lines;
+                    _resultDone       = (position < 0);
+                }
+            }
+
+            if (aborted == true) {
+                break;
+            }
+
+            emit found();
+
+            positions.clear();
+            lines.clear();
+
+            if (position < 0) {
+                break;
+            }
+        }
+    }
+}
+
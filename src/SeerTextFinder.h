@@ -0,0 +1,52 @@
+#pragma once
+
+#include <QtCore/QThread>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+#include <QtCore/QVector>
+
+//
+// Finds all matches of a string in a snapshot of the editor's text.
+//
+// Runs off the GUI thread. Matches are handed over in batches as they are
+// found, so the editor can count and show them while the search goes on.
+// A new request stops the one that is running. Batches from an older
+// request carry the older generation and are ignored by the editor.
+//
+class SeerTextFinder : public QThread {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerTextFinder (QObject* parent = 0);
+       ~SeerTextFinder ();
+
+        void                                find                    (int generation, const QString& text, const QString& pattern, Qt::CaseSensitivity cs);
+        void                                cancel                  ();
+        int                                 takeMatches             (QVector<int>& positions, QVector<int>& lines, bool& done);
+
+        static const int                    BatchSize = 4096;
+
+    signals:
+        void                                found                   ();
+
+    protected:
+        void                                run                     () override;
+
+    private:
+        QMutex                              _mutex;
+        bool                                _running;
+        bool                                _pending;
+        bool                                _stop;
+
+        int                                 _requestGeneration;
+        QString                             _requestText;
+        QString                             _requestPattern;
+        Qt::CaseSensitivity                 _requestCaseSensitivity;
+
+        int                                 _resultGeneration;
+        QVector<int>                        _resultPositions;
+        QVector<int>                        _resultLines;
+        bool                                _resultDone;
+};
+
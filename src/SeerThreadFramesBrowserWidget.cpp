@@ -1,9 +1,10 @@
 #include "SeerThreadFramesBrowserWidget.h"
 #include "SeerUtl.h"
-#include <QtWidgets/QTreeWidget>
-#include <QtWidgets/QTreeWidgetItemIterator>
+#include <QtWidgets/QTreeView>
+#include <QtWidgets/QScrollBar>
 #include <QtWidgets/QApplication>
-#include <QtCore/QFileInfo>
+#include <QtCore/QItemSelectionModel>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QDebug>
 
 SeerThreadFramesBrowserWidget::SeerThreadFramesBrowserWidget (QWidget* parent) : QWidget(parent) {
@@ -12,27 +13,28 @@ SeerThreadFramesBrowserWidget::SeerThreadFramesBrowserWidget (QWidget* parent) :
     setupUi(this);
 
     // Setup the widgets
-    threadTreeWidget->setMouseTracking(true);
-    threadTreeWidget->setSortingEnabled(false);
-    threadTreeWidget->resizeColumnToContents(0); // id
-    threadTreeWidget->resizeColumnToContents(1); // state
-    threadTreeWidget->resizeColumnToContents(2); // target-id
-    threadTreeWidget->resizeColumnToContents(3); // func
-    threadTreeWidget->resizeColumnToContents(4); // file
-    threadTreeWidget->resizeColumnToContents(5); // line
-    threadTreeWidget->resizeColumnToContents(6); // fullname
-    threadTreeWidget->resizeColumnToContents(7); // args
-    threadTreeWidget->resizeColumnToContents(8); // name
-    threadTreeWidget->resizeColumnToContents(9); // level
-    threadTreeWidget->resizeColumnToContents(10); // addr
-    threadTreeWidget->resizeColumnToContents(11); // arch
-    threadTreeWidget->resizeColumnToContents(12); // core
-
-    threadTreeWidget->clear();
+    _threadModel = new SeerThreadModel(this);
+
+    threadTreeView->setModel(_threadModel);
+    threadTreeView->setMouseTracking(true);
+    threadTreeView->setSortingEnabled(false);
+    threadTreeView->setUniformRowHeights(true);
+    threadTreeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    resizeColumns();
+
+    // Frame details are asked for shortly after the view settles.
+    _fetchTimer = new QTimer(this);
+    _fetchTimer->setSingleShot(true);
+    _fetchTimer->setInterval(50);
 
     // Connect things.
-    QObject::connect(threadTreeWidget,          &QTreeWidget::itemClicked,          this, &SeerThreadFramesBrowserWidget::handleItemClicked);
-    QObject::connect(threadTreeWidget,          &QTreeWidget::itemEntered,          this, &SeerThreadFramesBrowserWidget::handleItemEntered);
+    QObject::connect(threadTreeView,            &QTreeView::clicked,                this, &SeerThreadFramesBrowserWidget::handleItemClicked);
+    QObject::connect(threadTreeView->verticalScrollBar(),   &QScrollBar::valueChanged,                  this, &SeerThreadFramesBrowserWidget::scheduleFetch);
+    QObject::connect(threadTreeView->selectionModel(),      &QItemSelectionModel::selectionChanged,     this, &SeerThreadFramesBrowserWidget::scheduleFetch);
+    QObject::connect(_threadModel,                          &SeerThreadModel::rowsInserted,             this, &SeerThreadFramesBrowserWidget::scheduleFetch);
+    QObject::connect(_threadModel,                          &SeerThreadModel::rowsRemoved,              this, &SeerThreadFramesBrowserWidget::scheduleFetch);
+    QObject::connect(_fetchTimer,                           &QTimer::timeout,                           this, &SeerThreadFramesBrowserWidget::fetchVisibleThreads);
     QObject::connect(gdbNextToolButton,         &QToolButton::clicked,              this, &SeerThreadFramesBrowserWidget::handleGdbNextToolButton);
     QObject::connect(gdbStepToolButton,         &QToolButton::clicked,              this, &SeerThreadFramesBrowserWidget::handleGdbStepToolButton);
     QObject::connect(gdbFinishToolButton,       &QToolButton::clicked,              this, &SeerThreadFramesBrowserWidget::handleGdbFinishToolButton);
@@ -45,6 +47,46 @@ SeerThreadFramesBrowserWidget::~SeerThreadFramesBrowserWidget () {
 
 void SeerThreadFramesBrowserWidget::handleText (const QString& text) {
 
+    static const QRegularExpression id_re("^([0-9]+)\\^");
+
+    //
+    // Replies to asking about one thread. Take them even when hidden, so the
+    // thread isn't left waiting.
+    //
+    QRegularExpressionMatch id_match = id_re.match(text);
+
+    if (id_match.hasMatch() && _pendingIds.contains(id_match.captured(1).toInt())) {
+
+        int id       = id_match.captured(1).toInt();
+        int threadid = _pendingIds.take(id);
+
+        _pendingThreads.remove(threadid);
+
+        if (text.startsWith(QString::number(id) + "^done,threads=[")) {
+
+            // 7^done,threads=[{id="2",target-id="...",frame={...},state="stopped",core="6"}]
+            QString threads_text = Seer::parseFirst(text, "threads=", '[', ']', false);
+
+            // No thread. It exited before its event got here.
+            if (threads_text == "") {
+                _threadModel->removeThread(threadid);
+            }else{
+                _threadModel->updateThreads(threads_text);
+            }
+
+        }else if (text.startsWith(QString::number(id) + "^error,msg=\"Invalid thread id: ")) {
+
+            _threadModel->removeThread(threadid);
+        }
+
+        // Size the columns once the last answer is in.
+        if (_pendingIds.isEmpty()) {
+            resizeColumns();
+        }
+
+        return;
+    }
+
     // Don't do any work if the widget is hidden.
     if (isHidden()) {
         return;
@@ -96,102 +138,117 @@ void SeerThreadFramesBrowserWidget::handleText (const QString& text) {
 
         //qDebug() << text;
 
-        threadTreeWidget->clear();
-
+        //
+        // Not asked for by this browser, which only asks about the threads it shows.
+        // Take it anyway, as someone typed it. The rows are kept by thread id and only
+        // what changed is updated, so the selection and scroll position stay put.
+        //
         QString threads_text         = Seer::parseFirst(text, "threads=", '[', ']', false);
         QString currentthreadid_text = Seer::parseFirst(text, "current-thread-id=", '"', '"', false);
 
         //qDebug() << threads_text;
 
-        if (threads_text != "") {
-
-            QStringList threads_list = Seer::parse(threads_text, "", '{', '}', false);
-
-            for ( const auto& thread_text : threads_list ) {
-
-                QString id_text       = Seer::parseFirst(thread_text, "id=",        '"', '"', false);
-                QString targetid_text = Seer::parseFirst(thread_text, "target-id=", '"', '"', false);
-                QString name_text     = Seer::parseFirst(thread_text, "name=",      '"', '"', false);
-
-                QString frame_text    = Seer::parseFirst(thread_text, "frame=",     '{', '}', false);
-                QString level_text    = Seer::parseFirst(frame_text,  "level=",     '"', '"', false);
-                QString addr_text     = Seer::parseFirst(frame_text,  "addr=",      '"', '"', false);
-                QString func_text     = Seer::parseFirst(frame_text,  "func=",      '"', '"', false);
-                QString args_text     = Seer::parseFirst(frame_text,  "args=",      '[', ']', false);
-                QString file_text     = Seer::parseFirst(frame_text,  "file=",      '"', '"', false);
-                QString fullname_text = Seer::parseFirst(frame_text,  "fullname=",  '"', '"', false);
-                QString line_text     = Seer::parseFirst(frame_text,  "line=",      '"', '"', false);
-                QString arch_text     = Seer::parseFirst(frame_text,  "arch=",      '"', '"', false);
-
-                QString state_text    = Seer::parseFirst(thread_text, "state=",     '"', '"', false);
-                QString core_text     = Seer::parseFirst(thread_text, "core=",      '"', '"', false);
-
-                //qDebug() << file_text << fullname_text;
-
-                // Create the item.
-                QTreeWidgetItem* item = new QTreeWidgetItem;
-                item->setText(0, id_text);
-                item->setText(1, state_text);
-                item->setText(2, targetid_text);
-                item->setText(3, func_text);
-                item->setText(4, QFileInfo(file_text).fileName());
-                item->setText(5, line_text);
-                item->setText(6, fullname_text);
-                item->setText(7, args_text);
-                item->setText(8, name_text);
-                item->setText(9, level_text);
-                item->setText(10, addr_text);
-                item->setText(11, arch_text);
-                item->setText(12, core_text);
-
-                // Add the frame to the tree.
-                threadTreeWidget->addTopLevelItem(item);
-            }
+        _threadModel->setThreads(threads_text);
+        _threadModel->setCurrentThread(currentthreadid_text != "" ? currentthreadid_text.toInt() : -1);
 
-            // Select the current thread id.
-            threadTreeWidget->clearSelection();
+        // Make the current thread the current row. Leave the others selected.
+        int row = _threadModel->threadRow(_threadModel->currentThread());
 
-            QList<QTreeWidgetItem*> matches = threadTreeWidget->findItems(currentthreadid_text, Qt::MatchExactly, 0);
-            if (matches.size() > 0) {
-                threadTreeWidget->setCurrentItem(matches.first());
-            }
+        if (row >= 0 && threadTreeView->currentIndex().row() != row) {
+            threadTreeView->selectionModel()->setCurrentIndex(_threadModel->index(row, 0), QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+        }
+
+        resizeColumns();
+
+    }else if (text.startsWith("^done,thread-ids={")) {
+
+        // ^done,thread-ids={
+        //        thread-id=\"1\",
+        //        thread-id=\"2\"
+        //    },
+        //    current-thread-id=\"1\",
+        //    number-of-threads=\"2\"
+        //
+        // Just the ids. Cheap, however many threads there are. The details of the
+        // threads on screen are asked for next.
+        //
+        QString     threadids_text       = Seer::parseFirst(text,           "thread-ids=",        '{', '}', false);
+        QStringList threadids_list       = Seer::parse(threadids_text,      "thread-id=",         '"', '"', false);
+        QString     currentthreadid_text = Seer::parseFirst(text,           "current-thread-id=", '"', '"', false);
+
+        _threadModel->setThreadIds(threadids_list);
+        _threadModel->setCurrentThread(currentthreadid_text != "" ? currentthreadid_text.toInt() : -1);
+
+        // Make the current thread the current row. Leave the others selected.
+        int row = _threadModel->threadRow(_threadModel->currentThread());
+
+        if (row >= 0 && threadTreeView->currentIndex().row() != row) {
+            threadTreeView->selectionModel()->setCurrentIndex(_threadModel->index(row, 0), QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
         }
 
+        scheduleFetch();
+
     }else if (text.startsWith("*running,thread-id=")) {
 
-        refresh();
+        // *running,thread-id="all"
+        // *running,thread-id="2"
+        //
+        // What's known about the thread is kept on screen, but is asked for again
+        // once it stops. Answers still on their way are out of date.
+        //
+        QString threadid_text = Seer::parseFirst(text, "thread-id=", '"', '"', false);
+        int     threadid      = (threadid_text == "all" ? -1 : threadid_text.toInt());
+
+        _threadModel->setThreadState(threadid, "running");
+        _threadModel->invalidateThread(threadid);
+
+        if (threadid < 0) {
+            _pendingIds.clear();
+            _pendingThreads.clear();
+        }else if (_pendingThreads.remove(threadid)) {
+            QList<int> ids = _pendingIds.keys(threadid);
+            for (int id : ids) {
+                _pendingIds.remove(id);
+            }
+        }
+
+    }else if (text.startsWith("*stopped")) {
+
+        // *stopped,...,stopped-threads="all",core="6"
+        // *stopped,...,stopped-threads=["2","3"],core="6"
+        if (text.contains("stopped-threads=\"all\"")) {
+
+            _threadModel->setThreadState(-1, "stopped");
+
+        }else{
+
+            QString     stopped_text = Seer::parseFirst(text, "stopped-threads=", '[', ']', false);
+            QStringList stopped_list = Seer::parse(stopped_text, "", '"', '"', false);
+
+            for (const auto& threadid_text : stopped_list) {
+                _threadModel->setThreadState(threadid_text.toInt(), "stopped");
+            }
+        }
 
     }else if (text.startsWith("=thread-created,id=")) {
 
         // =thread-created,id="2",group-id="i2"
-        refresh();
+        _threadModel->addThread(Seer::parseFirst(text, "id=", '"', '"', false).toInt());
 
     }else if (text.startsWith("=thread-exited,id=")) {
 
         // =thread-exited,id="2",group-id="i2"
-        refresh();
+        _threadModel->removeThread(Seer::parseFirst(text, "id=", '"', '"', false).toInt());
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
-        threadTreeWidget->clear();
+        _threadModel->clear();
+        _pendingIds.clear();
+        _pendingThreads.clear();
 
     }else{
         // Ignore others.
     }
 
-    threadTreeWidget->resizeColumnToContents(0);
-    threadTreeWidget->resizeColumnToContents(1);
-    threadTreeWidget->resizeColumnToContents(2);
-  //threadTreeWidget->resizeColumnToContents(3); // Don't resize.
-  //threadTreeWidget->resizeColumnToContents(4); // Don't resize.
-    threadTreeWidget->resizeColumnToContents(5);
-  //threadTreeWidget->resizeColumnToContents(6); // Don't resize.
-  //threadTreeWidget->resizeColumnToContents(7); // Don't resize.
-    threadTreeWidget->resizeColumnToContents(8);
-    threadTreeWidget->resizeColumnToContents(9);
-    threadTreeWidget->resizeColumnToContents(10);
-    threadTreeWidget->resizeColumnToContents(11);
-    threadTreeWidget->resizeColumnToContents(12);
-
     QApplication::restoreOverrideCursor();
 }
 
@@ -207,107 +264,121 @@ void SeerThreadFramesBrowserWidget::refresh () {
         return;
     }
 
+    // The ids only. The details of the threads on screen follow.
     emit refreshThreadIds();
-    emit refreshThreadFrames();
 }
 
-void SeerThreadFramesBrowserWidget::handleItemClicked (QTreeWidgetItem* item, int column) {
-
-    Q_UNUSED(column);
+void SeerThreadFramesBrowserWidget::handleItemClicked (const QModelIndex& index) {
 
-    QList<QTreeWidgetItem*> items = threadTreeWidget->selectedItems();
+    QModelIndexList indexes = threadTreeView->selectionModel()->selectedRows();
 
-    if (items.count() == 1) {
+    if (indexes.count() == 1) {
 
-        int lineno = item->text(5).toInt();
+        int row    = index.row();
+        int lineno = _threadModel->text(row, SeerThreadModel::LineColumn).toInt();
 
         //qDebug() << "Emit selectedFile and selectedFrame";
 
-        emit selectedFile(item->text(4), item->text(6), lineno);
-        emit selectedThread(item->text(0).toInt());
+        emit selectedFile(_threadModel->text(row, SeerThreadModel::FileColumn), _threadModel->text(row, SeerThreadModel::FullnameColumn), lineno);
+        emit selectedThread(_threadModel->threadId(row));
     }
 }
 
-void SeerThreadFramesBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
-
-    Q_UNUSED(column);
-
-    //qDebug() << item->text(0) << column;
+void SeerThreadFramesBrowserWidget::handleGdbNextToolButton () {
 
-    item->setToolTip(0, item->text(0) + " : " + item->text(1) + " : " + item->text(3) + " : " + item->text(4) + " : " + item->text(5));
+    QList<int> threadids = selectedThreadIds();
 
-    for (int i=1; i<threadTreeWidget->columnCount(); i++) { // Copy tooltip to other columns.
-        item->setToolTip(i, item->toolTip(0));
+    for (int threadid : threadids) {
+        emit nextThreadId(threadid);
     }
 }
 
-void SeerThreadFramesBrowserWidget::handleGdbNextToolButton () {
+void SeerThreadFramesBrowserWidget::handleGdbStepToolButton () {
 
-    QList<QTreeWidgetItem*> items = threadTreeWidget->selectedItems();
+    QList<int> threadids = selectedThreadIds();
 
-    QList<QTreeWidgetItem*>::iterator i;
+    for (int threadid : threadids) {
+        emit stepThreadId(threadid);
+    }
+}
 
-    for (i = items.begin(); i != items.end(); ++i) {
+void SeerThreadFramesBrowserWidget::handleGdbFinishToolButton () {
 
-        int threadid = (*i)->text(0).toInt();
+    QList<int> threadids = selectedThreadIds();
 
-        emit nextThreadId(threadid);
+    for (int threadid : threadids) {
+        emit finishThreadId(threadid);
     }
 }
 
-void SeerThreadFramesBrowserWidget::handleGdbStepToolButton () {
+void SeerThreadFramesBrowserWidget::handleGdbContinueToolButton () {
 
-    QList<QTreeWidgetItem*> items = threadTreeWidget->selectedItems();
+    QList<int> threadids = selectedThreadIds();
 
-    QList<QTreeWidgetItem*>::iterator i;
+    for (int threadid : threadids) {
+        emit continueThreadId(threadid);
+    }
+}
 
-    for (i = items.begin(); i != items.end(); ++i) {
+void SeerThreadFramesBrowserWidget::handleGdbInterruptToolButton () {
 
-        int threadid = (*i)->text(0).toInt();
+    QList<int> threadids = selectedThreadIds();
 
-        emit stepThreadId(threadid);
+    for (int threadid : threadids) {
+        emit interruptThreadId(threadid);
     }
 }
 
-void SeerThreadFramesBrowserWidget::handleGdbFinishToolButton () {
-
-    QList<QTreeWidgetItem*> items = threadTreeWidget->selectedItems();
-
-    QList<QTreeWidgetItem*>::iterator i;
+void SeerThreadFramesBrowserWidget::scheduleFetch () {
 
-    for (i = items.begin(); i != items.end(); ++i) {
+    _fetchTimer->start();
+}
 
-        int threadid = (*i)->text(0).toInt();
+void SeerThreadFramesBrowserWidget::fetchVisibleThreads () {
 
-        emit finishThreadId(threadid);
+    // Don't do any work if the widget is hidden.
+    if (isHidden() || _threadModel->rowCount() == 0) {
+        return;
     }
-}
 
-void SeerThreadFramesBrowserWidget::handleGdbContinueToolButton () {
+    //
+    // Ask about the threads on screen and the selected ones, if what's known about
+    // them is out of date. One -thread-info per thread; gdb takes just one id.
+    //
+    QModelIndex top    = threadTreeView->indexAt(QPoint(0, 0));
+    QModelIndex bottom = threadTreeView->indexAt(QPoint(0, threadTreeView->viewport()->height() - 1));
 
-    QList<QTreeWidgetItem*> items = threadTreeWidget->selectedItems();
+    int first = (top.isValid()    ? top.row()    : 0);
+    int last  = (bottom.isValid() ? bottom.row() : _threadModel->rowCount() - 1);
 
-    QList<QTreeWidgetItem*>::iterator i;
+    last = qMin(last, first + 200); // A very tall window shouldn't ask about thousands.
 
-    for (i = items.begin(); i != items.end(); ++i) {
+    QList<int> rows;
 
-        int threadid = (*i)->text(0).toInt();
+    for (int row=first; row<=last; row++) {
+        rows.append(row);
+    }
 
-        emit continueThreadId(threadid);
+    QModelIndexList indexes = threadTreeView->selectionModel()->selectedRows();
+
+    for (const QModelIndex& index : indexes) {
+        rows.append(index.row());
     }
-}
 
-void SeerThreadFramesBrowserWidget::handleGdbInterruptToolButton () {
+    for (int row : rows) {
 
-    QList<QTreeWidgetItem*> items = threadTreeWidget->selectedItems();
+        int threadid = _threadModel->threadId(row);
 
-    QList<QTreeWidgetItem*>::iterator i;
+        if (threadid < 0 || _threadModel->isLoaded(row) || _pendingThreads.contains(threadid)) {
+            continue;
+        }
 
-    for (i = items.begin(); i != items.end(); ++i) {
+        int id = Seer::createID();
 
-        int threadid = (*i)->text(0).toInt();
+        _pendingIds.insert(id, threadid);
+        _pendingThreads.insert(threadid);
 
-        emit interruptThreadId(threadid);
+        emit refreshThreadFrame(id, threadid);
     }
 }
 
@@ -318,3 +389,32 @@ void SeerThreadFramesBrowserWidget::showEvent (QShowEvent* event) {
     refresh();
 }
 
+void SeerThreadFramesBrowserWidget::resizeColumns () {
+
+    // The header measures a sample of the rows, not all of them. See QHeaderView::resizeContentsPrecision.
+    threadTreeView->resizeColumnToContents(SeerThreadModel::IdColumn);
+    threadTreeView->resizeColumnToContents(SeerThreadModel::StateColumn);
+    threadTreeView->resizeColumnToContents(SeerThreadModel::TargetIdColumn);
+  //threadTreeView->resizeColumnToContents(SeerThreadModel::FuncColumn);      // Don't resize.
+  //threadTreeView->resizeColumnToContents(SeerThreadModel::FileColumn);      // Don't resize.
+    threadTreeView->resizeColumnToContents(SeerThreadModel::LineColumn);
+  //threadTreeView->resizeColumnToContents(SeerThreadModel::FullnameColumn);  // Don't resize.
+  //threadTreeView->resizeColumnToContents(SeerThreadModel::ArgsColumn);      // Don't resize.
+    threadTreeView->resizeColumnToContents(SeerThreadModel::NameColumn);
+    threadTreeView->resizeColumnToContents(SeerThreadModel::LevelColumn);
+    threadTreeView->resizeColumnToContents(SeerThreadModel::AddrColumn);
+    threadTreeView->resizeColumnToContents(SeerThreadModel::ArchColumn);
+    threadTreeView->resizeColumnToContents(SeerThreadModel::CoreColumn);
+}
+
+QList<int> SeerThreadFramesBrowserWidget::selectedThreadIds () const {
+
+    QModelIndexList indexes = threadTreeView->selectionModel()->selectedRows();
+    QList<int>      threadids;
+
+    for (const QModelIndex& index : indexes) {
+        threadids.append(_threadModel->threadId(index.row()));
+    }
+
+    return threadids;
+}
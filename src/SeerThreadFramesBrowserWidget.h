@@ -1,6 +1,12 @@
 #pragma once
 
+#include "SeerThreadModel.h"
 #include <QtWidgets/QWidget>
+#include <QtCore/QTimer>
+#include <QtCore/QModelIndex>
+#include <QtCore/QList>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
 #include <QtCore/QString>
 #include "ui_SeerThreadFramesBrowserWidget.h"
 
@@ -18,17 +24,18 @@ class SeerThreadFramesBrowserWidget : public QWidget, protected Ui::SeerThreadFr
         void                refresh                         ();
 
     protected slots:
-        void                handleItemClicked               (QTreeWidgetItem* item, int column);
-        void                handleItemEntered               (QTreeWidgetItem* item, int column);
+        void                handleItemClicked               (const QModelIndex& index);
         void                handleGdbNextToolButton         ();
         void                handleGdbStepToolButton         ();
         void                handleGdbFinishToolButton       ();
         void                handleGdbContinueToolButton     ();
         void                handleGdbInterruptToolButton    ();
+        void                scheduleFetch                   ();
+        void                fetchVisibleThreads             ();
 
     signals:
-        void                refreshThreadFrames             ();
         void                refreshThreadIds                ();
+        void                refreshThreadFrame              (int id, int threadid);
         void                selectedFile                    (QString file, QString fullname, int lineno);
         void                selectedFrame                   (int frameno);
         void                selectedThread                  (int threadid);
@@ -42,5 +49,12 @@ class SeerThreadFramesBrowserWidget : public QWidget, protected Ui::SeerThreadFr
         void                showEvent                       (QShowEvent* event);
 
     private:
+        void                resizeColumns                   ();
+        QList<int>          selectedThreadIds               () const;
+
+        SeerThreadModel*    _threadModel;
+        QTimer*             _fetchTimer;
+        QHash<int,int>      _pendingIds;                    // Command id to the thread it asks about.
+        QSet<int>           _pendingThreads;
 };
 
@@ -1,9 +1,8 @@
 #include "SeerThreadIdsBrowserWidget.h"
 #include "SeerUtl.h"
-#include <QtWidgets/QTreeWidget>
-#include <QtWidgets/QTreeWidgetItemIterator>
+#include <QtWidgets/QTreeView>
 #include <QtWidgets/QApplication>
-#include <QtGui/QFont>
+#include <QtCore/QItemSelectionModel>
 #include <QtCore/QDebug>
 
 SeerThreadIdsBrowserWidget::SeerThreadIdsBrowserWidget (QWidget* parent) : QWidget(parent) {
@@ -12,13 +11,22 @@ SeerThreadIdsBrowserWidget::SeerThreadIdsBrowserWidget (QWidget* parent) : QWidg
     setupUi(this);
 
     // Setup the widgets
-    idsTreeWidget->setSortingEnabled(false);
-    idsTreeWidget->resizeColumnToContents(0); // id
+    _threadModel = new SeerThreadModel(this);
 
-    idsTreeWidget->clear();
+    idsTreeView->setModel(_threadModel);
+    idsTreeView->setSortingEnabled(false);
+    idsTreeView->setUniformRowHeights(true);
+    idsTreeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    // Only the id is shown.
+    for (int c=SeerThreadModel::IdColumn+1; c<SeerThreadModel::ColumnCount; c++) {
+        idsTreeView->setColumnHidden(c, true);
+    }
+
+    idsTreeView->resizeColumnToContents(SeerThreadModel::IdColumn);
 
     // Connect things.
-    QObject::connect(idsTreeWidget,             &QTreeWidget::itemClicked,          this, &SeerThreadIdsBrowserWidget::handleItemClicked);
+    QObject::connect(idsTreeView,               &QTreeView::clicked,                this, &SeerThreadIdsBrowserWidget::handleItemClicked);
     QObject::connect(gdbNextToolButton,         &QToolButton::clicked,              this, &SeerThreadIdsBrowserWidget::handleGdbNextToolButton);
     QObject::connect(gdbStepToolButton,         &QToolButton::clicked,              this, &SeerThreadIdsBrowserWidget::handleGdbStepToolButton);
     QObject::connect(gdbFinishToolButton,       &QToolButton::clicked,              this, &SeerThreadIdsBrowserWidget::handleGdbFinishToolButton);
@@ -49,52 +57,40 @@ void SeerThreadIdsBrowserWidget::handleText (const QString& text) {
         //    current-thread-id=\"1\",
         //    number-of-threads=\"2\"
 
-        idsTreeWidget->clear();
-
         QString threadids_text       = Seer::parseFirst(newtext,   "thread-ids=",        '{', '}', false);
         QStringList threadids_list   = Seer::parse(threadids_text, "thread-id=",         '"', '"', false);
         QString currentthreadid_text = Seer::parseFirst(newtext,   "current-thread-id=", '"', '"', false);
 
-        // Add the thread-ids.
-        for ( const auto& threadid_text : threadids_list  ) {
+        // Only the threads that came or went change. The current thread-id is in bold.
+        _threadModel->setThreadIds(threadids_list);
+        _threadModel->setCurrentThread(currentthreadid_text != "" ? currentthreadid_text.toInt() : -1);
 
-            //qDebug() << threadid_text;
+        // Select the one for the current thread-id.
+        int row = _threadModel->threadRow(_threadModel->currentThread());
 
-            // Construct the item
-            QTreeWidgetItem* item = new QTreeWidgetItem;
-            item->setText(0, threadid_text);
+        if (row >= 0 && idsTreeView->currentIndex().row() != row) {
+            idsTreeView->selectionModel()->setCurrentIndex(_threadModel->index(row, 0), QItemSelectionModel::ClearAndSelect | QItemSelectionModel::Rows);
+        }
 
-            // Set the text to bold if the ID is the same as the CURRENT ID.
-            QFont fnormal = item->font(0); fnormal.setBold(false);
-            QFont fbold   = item->font(0); fbold.setBold(true);
+        idsTreeView->resizeColumnToContents(SeerThreadModel::IdColumn);
 
-            if (threadid_text == currentthreadid_text) {
-                item->setFont(0, fbold);
-            }else{
-                item->setFont(0, fnormal);
-            }
+    }else if (text.startsWith("=thread-created,id=")) {
 
-            // Add the frame to the tree.
-            idsTreeWidget->addTopLevelItem(item);
-        }
+        // =thread-created,id="2",group-id="i2"
+        _threadModel->addThread(Seer::parseFirst(text, "id=", '"', '"', false).toInt());
 
-        // Clear the selection and select the one for the current thread-id.
-        idsTreeWidget->clearSelection();
+    }else if (text.startsWith("=thread-exited,id=")) {
 
-        QList<QTreeWidgetItem*> matches = idsTreeWidget->findItems(currentthreadid_text, Qt::MatchExactly, 0);
-        if (matches.size() > 0) {
-            idsTreeWidget->setCurrentItem(matches.first());
-        }
+        // =thread-exited,id="2",group-id="i2"
+        _threadModel->removeThread(Seer::parseFirst(text, "id=", '"', '"', false).toInt());
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
-        idsTreeWidget->clear();
+        _threadModel->clear();
 
     }else{
         // Ignore others.
     }
 
-    idsTreeWidget->resizeColumnToContents(0);
-
     QApplication::restoreOverrideCursor();
 }
 
@@ -103,11 +99,9 @@ void SeerThreadIdsBrowserWidget::handleStoppingPointReached () {
     refresh();
 }
 
-void SeerThreadIdsBrowserWidget::handleItemClicked (QTreeWidgetItem* item, int column) {
+void SeerThreadIdsBrowserWidget::handleItemClicked (const QModelIndex& index) {
 
-    Q_UNUSED(column);
-
-    emit selectedThread(item->text(0).toInt());
+    emit selectedThread(_threadModel->threadId(index.row()));
 }
 
 void SeerThreadIdsBrowserWidget::refresh () {
@@ -122,70 +116,45 @@ void SeerThreadIdsBrowserWidget::refresh () {
 
 void SeerThreadIdsBrowserWidget::handleGdbNextToolButton () {
 
-    QList<QTreeWidgetItem*> items = idsTreeWidget->selectedItems();
-
-    QList<QTreeWidgetItem*>::iterator i;
-
-    for (i = items.begin(); i != items.end(); ++i) {
-
-        int threadid = (*i)->text(0).toInt();
+    QList<int> threadids = selectedThreadIds();
 
+    for (int threadid : threadids) {
         emit nextThreadId(threadid);
     }
 }
 
 void SeerThreadIdsBrowserWidget::handleGdbStepToolButton () {
 
-    QList<QTreeWidgetItem*> items = idsTreeWidget->selectedItems();
-
-    QList<QTreeWidgetItem*>::iterator i;
-
-    for (i = items.begin(); i != items.end(); ++i) {
-
-        int threadid = (*i)->text(0).toInt();
+    QList<int> threadids = selectedThreadIds();
 
+    for (int threadid : threadids) {
         emit stepThreadId(threadid);
     }
 }
 
 void SeerThreadIdsBrowserWidget::handleGdbFinishToolButton () {
 
-    QList<QTreeWidgetItem*> items = idsTreeWidget->selectedItems();
-
-    QList<QTreeWidgetItem*>::iterator i;
-
-    for (i = items.begin(); i != items.end(); ++i) {
-
-        int threadid = (*i)->text(0).toInt();
+    QList<int> threadids = selectedThreadIds();
 
+    for (int threadid : threadids) {
         emit finishThreadId(threadid);
     }
 }
 
 void SeerThreadIdsBrowserWidget::handleGdbContinueToolButton () {
 
-    QList<QTreeWidgetItem*> items = idsTreeWidget->selectedItems();
-
-    QList<QTreeWidgetItem*>::iterator i;
-
-    for (i = items.begin(); i != items.end(); ++i) {
-
-        int threadid = (*i)->text(0).toInt();
+    QList<int> threadids = selectedThreadIds();
 
+    for (int threadid : threadids) {
         emit continueThreadId(threadid);
     }
 }
 
 void SeerThreadIdsBrowserWidget::handleGdbInterruptToolButton () {
 
-    QList<QTreeWidgetItem*> items = idsTreeWidget->selectedItems();
-
-    QList<QTreeWidgetItem*>::iterator i;
-
-    for (i = items.begin(); i != items.end(); ++i) {
-
-        int threadid = (*i)->text(0).toInt();
+    QList<int> threadids = selectedThreadIds();
 
+    for (int threadid : threadids) {
         emit interruptThreadId(threadid);
     }
 }
@@ -197,3 +166,14 @@ void SeerThreadIdsBrowserWidget::showEvent (QShowEvent* event) {
     refresh();
 }
 
+QList<int> SeerThreadIdsBrowserWidget::selectedThreadIds () const {
+
+    QModelIndexList indexes = idsTreeView->selectionModel()->selectedRows();
+    QList<int>      threadids;
+
+    for (const QModelIndex& index : indexes) {
+        threadids.append(_threadModel->threadId(index.row()));
+    }
+
+    return threadids;
+}
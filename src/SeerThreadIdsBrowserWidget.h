@@ -1,6 +1,9 @@
 #pragma once
 
+#include "SeerThreadModel.h"
 #include <QtWidgets/QWidget>
+#include <QtCore/QModelIndex>
+#include <QtCore/QList>
 #include <QtCore/QString>
 #include "ui_SeerThreadIdsBrowserWidget.h"
 
@@ -18,7 +21,7 @@ class SeerThreadIdsBrowserWidget : public QWidget, protected Ui::SeerThreadIdsBr
         void                refresh                         ();
 
     protected slots:
-        void                handleItemClicked               (QTreeWidgetItem* item, int column);
+        void                handleItemClicked               (const QModelIndex& index);
         void                handleGdbNextToolButton         ();
         void                handleGdbStepToolButton         ();
         void                handleGdbFinishToolButton       ();
@@ -38,5 +41,8 @@ class SeerThreadIdsBrowserWidget : public QWidget, protected Ui::SeerThreadIdsBr
         void                showEvent                       (QShowEvent* event);
 
     private:
+        QList<int>          selectedThreadIds               () const;
+
+        SeerThreadModel*    _threadModel;
 };
 
@@ -0,0 +1,410 @@
+#include "SeerThreadModel.h"
+#include "SeerUtl.h"
+#include <QtGui/QFont>
+#include <QtCore/QFileInfo>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+SeerThreadModel::SeerThreadModel (QObject* parent) : QAbstractTableModel(parent) {
+
+    _currentThread = -1;
+}
+
+SeerThreadModel::~SeerThreadModel () {
+}
+
+int SeerThreadModel::rowCount (const QModelIndex& parent) const {
+
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return _threads.size();
+}
+
+int SeerThreadModel::columnCount (const QModelIndex& parent) const {
+
+    if (parent.isValid()) {
+        return 0;
+    }
+
+    return ColumnCount;
+}
+
+QVariant SeerThreadModel::data (const QModelIndex& index, int role) const {
+
+    if (index.isValid() == false || index.row() >= _threads.size()) {
+        return QVariant();
+    }
+
+    const Thread& thread = _threads[index.row()];
+
+    if (role == Qt::DisplayRole) {
+        return thread.columns[index.column()];
+    }
+
+    if (role == Qt::ToolTipRole) {
+        return thread.columns[IdColumn]   + " : " + thread.columns[StateColumn] + " : " + thread.columns[FuncColumn] + " : " +
+               thread.columns[FileColumn] + " : " + thread.columns[LineColumn];
+    }
+
+    // The current thread is in bold.
+    if (role == Qt::FontRole && index.column() == IdColumn && thread.id == _currentThread) {
+        QFont font;
+        font.setBold(true);
+        return font;
+    }
+
+    return QVariant();
+}
+
+QVariant SeerThreadModel::headerData (int section, Qt::Orientation orientation, int role) const {
+
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (section) {
+        case IdColumn:       return tr("Thread Id");
+        case StateColumn:    return tr("State");
+        case TargetIdColumn: return tr("Target Id");
+        case FuncColumn:     return tr("Function");
+        case FileColumn:     return tr("File");
+        case LineColumn:     return tr("Line");
+        case FullnameColumn: return tr("Fullname");
+        case ArgsColumn:     return tr("Arguments");
+        case NameColumn:     return tr("Name");
+        case LevelColumn:    return tr("Level");
+        case AddrColumn:     return tr("Address");
+        case ArchColumn:     return tr("Arch");
+        case CoreColumn:     return tr("Core");
+    }
+
+    return QVariant();
+}
+
+void SeerThreadModel::setThreads (const QString& threads_text) {
+
+    QVector<Thread> threads = parseThreads(threads_text);
+
+    merge(threads, false);
+}
+
+void SeerThreadModel::setThreadIds (const QStringList& threadids) {
+
+    QVector<Thread> threads;
+
+    threads.reserve(threadids.size());
+
+    for (const auto& threadid_text : threadids) {
+
+        Thread thread;
+        thread.id                = threadid_text.toInt();
+        thread.loaded            = false;
+        thread.columns[IdColumn] = threadid_text;
+
+        threads.append(thread);
+    }
+
+    // Only membership. Leave what's known about the threads that stay.
+    merge(threads, true);
+}
+
+void SeerThreadModel::updateThreads (const QString& threads_text) {
+
+    // Details of some of the threads. Threads that aren't in the list are left alone.
+    QVector<Thread> threads = parseThreads(threads_text);
+
+    for (const Thread& thread : threads) {
+
+        int row = threadRow(thread.id);
+
+        if (row >= 0) {
+            updateRow(row, thread);
+        }
+    }
+}
+
+void SeerThreadModel::addThread (int threadid) {
+
+    int row = lowerBound(threadid);
+
+    if (row < _threads.size() && _threads[row].id == threadid) {
+        return;
+    }
+
+    // The rest of the columns are filled in by the next list.
+    Thread thread;
+    thread.id                   = threadid;
+    thread.loaded               = false;
+    thread.columns[IdColumn]    = QString::number(threadid);
+    thread.columns[StateColumn] = "running";
+
+    beginInsertRows(QModelIndex(), row, row);
+    _threads.insert(row, thread);
+    endInsertRows();
+}
+
+void SeerThreadModel::removeThread (int threadid) {
+
+    int row = threadRow(threadid);
+
+    if (row < 0) {
+        return;
+    }
+
+    beginRemoveRows(QModelIndex(), row, row);
+    _threads.remove(row);
+    endRemoveRows();
+}
+
+void SeerThreadModel::setThreadState (int threadid, const QString& state) {
+
+    // A thread id of -1 is all threads.
+    int first = 0;
+    int last  = _threads.size() - 1;
+
+    if (threadid >= 0) {
+        first = last = threadRow(threadid);
+    }
+
+    if (first < 0 || last < first) {
+        return;
+    }
+
+    for (int row=first; row<=last; row++) {
+        _threads[row].columns[StateColumn] = state;
+    }
+
+    emit dataChanged(index(first, StateColumn), index(last, StateColumn));
+}
+
+void SeerThreadModel::setCurrentThread (int threadid) {
+
+    if (_currentThread == threadid) {
+        return;
+    }
+
+    int oldrow = threadRow(_currentThread);
+    int newrow = threadRow(threadid);
+
+    _currentThread = threadid;
+
+    if (oldrow >= 0) {
+        emit dataChanged(index(oldrow, IdColumn), index(oldrow, IdColumn));
+    }
+
+    if (newrow >= 0) {
+        emit dataChanged(index(newrow, IdColumn), index(newrow, IdColumn));
+    }
+}
+
+void SeerThreadModel::invalidateThread (int threadid) {
+
+    // A thread id of -1 is all threads. What's shown stays until it's replaced.
+    if (threadid < 0) {
+        for (Thread& thread : _threads) {
+            thread.loaded = false;
+        }
+        return;
+    }
+
+    int row = threadRow(threadid);
+
+    if (row >= 0) {
+        _threads[row].loaded = false;
+    }
+}
+
+void SeerThreadModel::clear () {
+
+    if (_threads.isEmpty()) {
+        _currentThread = -1;
+        return;
+    }
+
+    beginResetModel();
+    _threads.clear();
+    _currentThread = -1;
+    endResetModel();
+}
+
+int SeerThreadModel::threadRow (int threadid) const {
+
+    int row = lowerBound(threadid);
+
+    if (row < _threads.size() && _threads[row].id == threadid) {
+        return row;
+    }
+
+    return -1;
+}
+
+int SeerThreadModel::threadId (int row) const {
+
+    if (row < 0 || row >= _threads.size()) {
+        return -1;
+    }
+
+    return _threads[row].id;
+}
+
+int SeerThreadModel::currentThread () const {
+
+    return _currentThread;
+}
+
+bool SeerThreadModel::isLoaded (int row) const {
+
+    if (row < 0 || row >= _threads.size()) {
+        return false;
+    }
+
+    return _threads[row].loaded;
+}
+
+QString SeerThreadModel::text (int row, int column) const {
+
+    if (row < 0 || row >= _threads.size() || column < 0 || column >= ColumnCount) {
+        return QString();
+    }
+
+    return _threads[row].columns[column];
+}
+
+QVector<SeerThreadModel::Thread> SeerThreadModel::parseThreads (const QString& threads_text) {
+
+    //
+    // The inside of a -thread-info reply's threads=[...]. See
+    // SeerThreadFramesBrowserWidget::handleText().
+    //
+    QStringList     threads_list = Seer::parse(threads_text, "", '{', '}', false);
+    QVector<Thread> threads;
+
+    threads.reserve(threads_list.size());
+
+    for (const auto& thread_text : threads_list) {
+
+        QString frame_text = Seer::parseFirst(thread_text, "frame=", '{', '}', false);
+
+        Thread thread;
+        thread.columns[IdColumn]       = Seer::parseFirst(thread_text, "id=",        '"', '"', false);
+        thread.columns[StateColumn]    = Seer::parseFirst(thread_text, "state=",     '"', '"', false);
+        thread.columns[TargetIdColumn] = Seer::parseFirst(thread_text, "target-id=", '"', '"', false);
+        thread.columns[FuncColumn]     = Seer::parseFirst(frame_text,  "func=",      '"', '"', false);
+        thread.columns[FileColumn]     = QFileInfo(Seer::parseFirst(frame_text, "file=", '"', '"', false)).fileName();
+        thread.columns[LineColumn]     = Seer::parseFirst(frame_text,  "line=",      '"', '"', false);
+        thread.columns[FullnameColumn] = Seer::parseFirst(frame_text,  "fullname=",  '"', '"', false);
+        thread.columns[ArgsColumn]     = Seer::parseFirst(frame_text,  "args=",      '[', ']', false);
+        thread.columns[NameColumn]     = Seer::parseFirst(thread_text, "name=",      '"', '"', false);
+        thread.columns[LevelColumn]    = Seer::parseFirst(frame_text,  "level=",     '"', '"', false);
+        thread.columns[AddrColumn]     = Seer::parseFirst(frame_text,  "addr=",      '"', '"', false);
+        thread.columns[ArchColumn]     = Seer::parseFirst(frame_text,  "arch=",      '"', '"', false);
+        thread.columns[CoreColumn]     = Seer::parseFirst(thread_text, "core=",      '"', '"', false);
+        thread.id                      = thread.columns[IdColumn].toInt();
+        thread.loaded                  = true;
+
+        threads.append(thread);
+    }
+
+    return threads;
+}
+
+void SeerThreadModel::updateRow (int row, const Thread& thread) {
+
+    // Report only the columns that changed.
+    Thread& old   = _threads[row];
+    int     first = ColumnCount;
+    int     last  = -1;
+
+    old.loaded = thread.loaded;
+
+    for (int c=0; c<ColumnCount; c++) {
+        if (old.columns[c] != thread.columns[c]) {
+            old.columns[c] = thread.columns[c];
+            first = qMin(first, c);
+            last  = qMax(last,  c);
+        }
+    }
+
+    if (last >= 0) {
+        emit dataChanged(index(row, first), index(row, last));
+    }
+}
+
+void SeerThreadModel::merge (QVector<Thread>& threads, bool idsOnly) {
+
+    // gdb lists threads in id order, but don't count on it.
+    std::stable_sort(threads.begin(), threads.end(), [](const Thread& a, const Thread& b) { return a.id < b.id; });
+
+    // Remove the threads that are gone, a run of rows at a time. Work from the end so
+    // the rows still to look at don't move.
+    int row = _threads.size() - 1;
+    int i   = threads.size() - 1;
+
+    while (row >= 0) {
+
+        while (i >= 0 && threads[i].id > _threads[row].id) {
+            i--;
+        }
+
+        if (i >= 0 && threads[i].id == _threads[row].id) {
+            row--;
+            continue;
+        }
+
+        int last = row;
+
+        while (row > 0 && (i < 0 || threads[i].id < _threads[row-1].id)) {
+            row--;
+        }
+
+        beginRemoveRows(QModelIndex(), row, last);
+        _threads.remove(row, last - row + 1);
+        endRemoveRows();
+
+        row--;
+    }
+
+    // Every row left is in the new list. Insert the new threads, a run at a time, and
+    // report the columns that changed in the others.
+    row = 0;
+    i   = 0;
+
+    while (i < threads.size()) {
+
+        if (row < _threads.size() && _threads[row].id == threads[i].id) {
+
+            if (idsOnly == false) {
+                updateRow(row, threads[i]);
+            }
+
+            row++;
+            i++;
+            continue;
+        }
+
+        int first = i;
+
+        while (i < threads.size() && (row >= _threads.size() || threads[i].id < _threads[row].id)) {
+            i++;
+        }
+
+        beginInsertRows(QModelIndex(), row, row + (i - first) - 1);
+        _threads.insert(row, i - first, Thread());
+        for (int j=first; j<i; j++) {
+            _threads[row + (j - first)] = threads[j];
+        }
+        endInsertRows();
+
+        row += i - first;
+    }
+}
+
+int SeerThreadModel::lowerBound (int threadid) const {
+
+    QVector<Thread>::const_iterator it = std::lower_bound(_threads.constBegin(), _threads.constEnd(), threadid, [](const Thread& thread, int id) { return thread.id < id; });
+
+    return int(it - _threads.constBegin());
+}
+
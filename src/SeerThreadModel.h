@@ -0,0 +1,87 @@
+#pragma once
+
+#include <QtCore/QAbstractTableModel>
+#include <QtCore/QModelIndex>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtCore/QStringList>
+#include <QtCore/QString>
+
+//
+// The threads of the program, one row per thread, kept in thread id order.
+//
+// A new list from gdb is merged into the rows: threads that are gone are removed,
+// new ones are inserted and the rest only report the columns that changed. Views
+// keep their selection and scroll position, and only redraw what changed. The
+// =thread-created and =thread-exited events add and remove single rows, so the
+// list doesn't have to be asked for again.
+//
+// A thread's frame details can be filled in separately, a few threads at a time,
+// and are marked stale when the thread resumes. The thread frames browser only asks
+// gdb about the threads that are on screen.
+//
+// Used with all columns by the thread frames browser, and with just the id by the
+// thread ids browser.
+//
+class SeerThreadModel : public QAbstractTableModel {
+
+    Q_OBJECT
+
+    public:
+        enum Column {
+            IdColumn        = 0,
+            StateColumn     = 1,
+            TargetIdColumn  = 2,
+            FuncColumn      = 3,
+            FileColumn      = 4,
+            LineColumn      = 5,
+            FullnameColumn  = 6,
+            ArgsColumn      = 7,
+            NameColumn      = 8,
+            LevelColumn     = 9,
+            AddrColumn      = 10,
+            ArchColumn      = 11,
+            CoreColumn      = 12,
+            ColumnCount     = 13
+        };
+
+        explicit SeerThreadModel (QObject* parent = 0);
+       ~SeerThreadModel ();
+
+        int                                 rowCount                (const QModelIndex& parent = QModelIndex()) const override;
+        int                                 columnCount             (const QModelIndex& parent = QModelIndex()) const override;
+        QVariant                            data                    (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant                            headerData              (int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+        void                                setThreads              (const QString& threads_text);
+        void                                setThreadIds            (const QStringList& threadids);
+        void                                updateThreads           (const QString& threads_text);
+        void                                addThread               (int threadid);
+        void                                removeThread            (int threadid);
+        void                                setThreadState          (int threadid, const QString& state);
+        void                                setCurrentThread        (int threadid);
+        void                                invalidateThread        (int threadid);
+        void                                clear                   ();
+
+        int                                 threadRow               (int threadid) const;
+        int                                 threadId                (int row) const;
+        int                                 currentThread           () const;
+        bool                                isLoaded                (int row) const;
+        QString                             text                    (int row, int column) const;
+
+    private:
+        struct Thread {
+            int                             id;
+            bool                            loaded;                 // The columns are up to date. Cleared when the thread resumes.
+            QString                         columns[ColumnCount];
+        };
+
+        static QVector<Thread>              parseThreads            (const QString& threads_text);
+        void                                updateRow               (int row, const Thread& thread);
+        void                                merge                   (QVector<Thread>& threads, bool idsOnly);
+        int                                 lowerBound              (int threadid) const;
+
+        QVector<Thread>                     _threads;               // Ascending by id.
+        int                                 _currentThread;
+};
+
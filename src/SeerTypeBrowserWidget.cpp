@@ -1,37 +1,47 @@
 #include "SeerTypeBrowserWidget.h"
 #include "SeerUtl.h"
-#include <QtWidgets/QTreeWidget>
-#include <QtWidgets/QTreeWidgetItemIterator>
-#include <QtWidgets/QLabel>
-#include <QtWidgets/QApplication>
-#include <QtCore/QFileInfo>
+#include <QtWidgets/QTreeView>
+#include <QtWidgets/QHeaderView>
 #include <QtCore/Qt>
-#include <QtCore/QMap>
 #include <QtCore/QDebug>
 
 SeerTypeBrowserWidget::SeerTypeBrowserWidget (QWidget* parent) : QWidget(parent) {
 
     // Set the state.
-    _id = Seer::createID();
+    _id              = Seer::createID();
+    _indexGeneration = 0;
+    _indexLoading    = false;
+    _indexStale      = false;   // Nothing to ask for until a program is loaded. See invalidate().
+    _librariesLoaded = false;
 
     // Construct the UI.
     setupUi(this);
 
     // Setup the widgets
-    typeSearchLineEdit->setPlaceholderText("Search regex...");
+    _indexLoader = new SeerSymbolIndexLoader(this);
+    _symbolModel = new SeerSymbolModel(this);
+    _symbolModel->setColumns({SeerSymbolModel::NameField, SeerSymbolModel::FilenameField, SeerSymbolModel::LineField, SeerSymbolModel::FullnameField},
+                             {"Type", "File", "Line", "Full Name"}, 1);
+
+    _searchTimer = new QTimer(this);
+    _searchTimer->setSingleShot(true);
+    _searchTimer->setInterval(SearchInterval);
+
+    typeSearchLineEdit->setPlaceholderText("Search types...");
     typeSearchLineEdit->setClearButtonEnabled(true);
-    typeTreeWidget->setMouseTracking(true);
-  //typeTreeWidget->resizeColumnToContents(0);
-    typeTreeWidget->resizeColumnToContents(1);
-    typeTreeWidget->resizeColumnToContents(2);
-    typeTreeWidget->resizeColumnToContents(3);
-    typeTreeWidget->clear();
-    typeTreeWidget->setSortingEnabled(false);
+    typeTreeView->setModel(_symbolModel);
+    typeTreeView->setRootIsDecorated(false);
+    typeTreeView->setUniformRowHeights(true);
+    typeTreeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+    typeTreeView->header()->setSortIndicator(-1, Qt::AscendingOrder); // Best matches first, until a column is clicked.
+    typeTreeView->setSortingEnabled(true);
 
     // Connect things.
-    QObject::connect(typeTreeWidget,      &QTreeWidget::itemDoubleClicked,    this,  &SeerTypeBrowserWidget::handleItemDoubleClicked);
-    QObject::connect(typeTreeWidget,      &QTreeWidget::itemEntered,          this,  &SeerTypeBrowserWidget::handleItemEntered);
-    QObject::connect(typeSearchLineEdit,  &QLineEdit::returnPressed,          this,  &SeerTypeBrowserWidget::handleSearchLineEdit);
+    QObject::connect(typeTreeView,        &QTreeView::doubleClicked,                    this,          &SeerTypeBrowserWidget::handleItemDoubleClicked);
+    QObject::connect(typeSearchLineEdit,  &QLineEdit::returnPressed,                    this,          &SeerTypeBrowserWidget::handleSearchLineEdit);
+    QObject::connect(typeSearchLineEdit,  &QLineEdit::textChanged,                      this,          &SeerTypeBrowserWidget::handleSearchChanged);
+    QObject::connect(_searchTimer,        &QTimer::timeout,                             this,          &SeerTypeBrowserWidget::handleSearchLineEdit);
+    QObject::connect(_indexLoader,        &SeerSymbolIndexLoader::loaded,               this,          &SeerTypeBrowserWidget::handleIndexLoaded);
 }
 
 SeerTypeBrowserWidget::~SeerTypeBrowserWidget () {
@@ -39,122 +49,144 @@ SeerTypeBrowserWidget::~SeerTypeBrowserWidget () {
 
 void SeerTypeBrowserWidget::handleText (const QString& text) {
 
-    QApplication::setOverrideCursor(Qt::BusyCursor);
-
     if (text.startsWith(QString::number(_id) + "^done,symbols={") && text.endsWith("}")) {
 
-        typeTreeWidget->clear();
-        typeTreeWidget->setSortingEnabled(false);
-        typeTreeWidget->sortByColumn(-1, Qt::AscendingOrder);
-
-        // -symbol-info-types [--name name_regexp]
-        //                    [--max-results limit]
         //
-        // ^done,symbols={
-        //          debug=[
-        //                  {
-        //                      filename="/peak/rel/include/CnvLib.h",fullname="/home/erniep/Development/Peak/rel/include/CnvLib.h",
-        //                      symbols=[
-        //                                  {
-        //                                      line="8",
-        //                                      name="Cnv"
-        //                                  }
-        //                              ]
-        //                  },
-        //                  ...
-        //                 ]
-        //               }
+        // The program's types. Index them off the GUI thread. See handleIndexLoaded().
+        // See SeerSymbolIndex::parse() for the format.
+        //
+        _indexGeneration++;
 
-        QString debug_text = Seer::parseFirst(text, "debug=", '[', ']', false);
+        _indexLoader->load(_indexGeneration, text);
 
-        QStringList filenames_list = Seer::parse(debug_text, "", '{', '}', false);
+    }else if (text.startsWith(QString::number(_id) + "^error,")) {
 
-        for (const auto& filename_entry : filenames_list) {
+        // Try again on the next search.
+        _indexLoading = false;
+        _indexStale   = true;
 
-            QString filename_text = Seer::parseFirst(filename_entry, "filename=", '"', '"', false);
-            QString fullname_text = Seer::parseFirst(filename_entry, "fullname=", '"', '"', false);
+        typeSearchLineEdit->setPlaceholderText("Search types...");
 
-            QString symbols_text = Seer::parseFirst(filename_entry, "symbols=", '[', ']', false);
+    }else if (text.startsWith("=library-loaded,") || text.startsWith("=library-unloaded,")) {
 
-            QStringList symbols_list = Seer::parse(symbols_text, "", '{', '}', false);
+        // The library's types aren't in the index. A program can load many libraries
+        // before it stops, so wait for the stop and ask for them all at once.
+        _librariesLoaded = true;
 
-            for (const auto& symbol_entry : symbols_list) {
+    }else{
+        // Ignore others.
+    }
+}
 
-                QString line_text = Seer::parseFirst(symbol_entry, "line=", '"', '"', false);
-                QString name_text = Seer::parseFirst(symbol_entry, "name=", '"', '"', false);
+void SeerTypeBrowserWidget::handleIndexLoaded () {
 
-                // Skip type entries that have no line number.
-                if (line_text == "") {
-                    continue;
-                }
+    SeerSymbolIndex index;
 
-                // Add the type to the tree.
-                QTreeWidgetItem* item = new QTreeWidgetItem;
+    int generation = _indexLoader->result(index);
 
-                QFont f0 = item->font(0);
-                f0.setBold(true);
-                item->setFont(0,f0);
+    // A newer list is on its way.
+    if (generation != _indexGeneration) {
+        return;
+    }
 
-                item->setText(0, name_text);
-                item->setText(1, filename_text);
-                item->setText(2, line_text);
-                item->setText(3, fullname_text);
+    _indexLoading = false;
 
-                typeTreeWidget->addTopLevelItem(item);
-            }
-        }
+    typeSearchLineEdit->setPlaceholderText("Search types...");
 
-    }else{
-        // Ignore others.
-    }
+    _symbolModel->setIndex(index);
+
+    handleSearchLineEdit();
+}
+
+void SeerTypeBrowserWidget::handleItemDoubleClicked (const QModelIndex& index) {
 
-  //typeTreeWidget->resizeColumnToContents(0);
-    typeTreeWidget->resizeColumnToContents(1);
-    typeTreeWidget->resizeColumnToContents(2);
-    typeTreeWidget->resizeColumnToContents(3);
-    typeTreeWidget->sortByColumn(0, Qt::AscendingOrder);
-    typeTreeWidget->setSortingEnabled(true);
+    const SeerSymbol* symbol = _symbolModel->symbol(index);
 
-    QApplication::restoreOverrideCursor();
+    if (symbol == 0) {
+        return;
+    }
+
+    emit selectedFile(symbol->filename, symbol->fullname, symbol->line);
 }
 
-void SeerTypeBrowserWidget::handleItemDoubleClicked (QTreeWidgetItem* item, int column) {
+void SeerTypeBrowserWidget::handleSearchLineEdit () {
 
-    Q_UNUSED(column);
+    _searchTimer->stop();
+
+    if (_indexStale == true) {
+        loadIndex();
+    }
 
-    emit selectedFile(item->text(1), item->text(3), item->text(2).toInt());
+    // Searched here, not by gdb. The index from before a reload is used until the new one is ready.
+    _symbolModel->setRows(_symbolModel->symbolIndex().search(typeSearchLineEdit->text(), QString()));
+
+  //typeTreeView->resizeColumnToContents(0);
+    typeTreeView->resizeColumnToContents(1);
+    typeTreeView->resizeColumnToContents(2);
+    typeTreeView->resizeColumnToContents(3);
 }
 
-void SeerTypeBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
+void SeerTypeBrowserWidget::handleSearchChanged () {
 
-    Q_UNUSED(column);
+    _searchTimer->start();
+}
 
-    QString tip = QString("Type: %1\nFile: %2\nLine: %3\nFullname: %4").arg(item->text(0)).arg(item->text(1)).arg(item->text(2)).arg(item->text(3));
+void SeerTypeBrowserWidget::refresh () {
 
-    item->setToolTip(0, tip);
+    _indexStale = true;
 
-    for (int i=1; i<typeTreeWidget->columnCount(); i++) { // Copy tooltip to the other columns.
-        item->setToolTip(i, item->toolTip(0));
+    if (isVisible()) {
+        loadIndex();
     }
 }
 
-void SeerTypeBrowserWidget::handleSearchLineEdit () {
+void SeerTypeBrowserWidget::handleStoppingPointReached () {
 
-    typeTreeWidget->clear();
-    typeTreeWidget->setSortingEnabled(false);
-    typeTreeWidget->sortByColumn(-1, Qt::AscendingOrder);
+    if (_librariesLoaded == false) {
+        return;
+    }
 
-  //typeTreeWidget->resizeColumnToContents(0);
-    typeTreeWidget->resizeColumnToContents(1);
-    typeTreeWidget->resizeColumnToContents(2);
-    typeTreeWidget->resizeColumnToContents(3);
+    _librariesLoaded = false;
+    _indexStale      = true;
+}
 
-    if (typeSearchLineEdit->text() != "") {
-        emit refreshTypeList(_id, typeSearchLineEdit->text());
+void SeerTypeBrowserWidget::invalidate () {
+
+    // A new program. Forget the old one's types, and any list still on its way.
+    _indexGeneration++;
+    _indexLoading    = false;
+    _indexStale      = true;
+    _librariesLoaded = false;
+
+    _symbolModel->clear();
+
+    if (isVisible()) {
+        loadIndex();
     }
 }
 
-void SeerTypeBrowserWidget::refresh () {
-    handleSearchLineEdit();
+void SeerTypeBrowserWidget::loadIndex () {
+
+    if (_indexLoading == true) {
+        return;
+    }
+
+    // An empty regex asks gdb for all of the types, once.
+    _indexLoading    = true;
+    _indexStale      = false;
+    _librariesLoaded = false;
+
+    typeSearchLineEdit->setPlaceholderText("Loading types...");
+
+    emit refreshTypeList(_id, "");
+}
+
+void SeerTypeBrowserWidget::showEvent (QShowEvent* event) {
+
+    QWidget::showEvent(event);
+
+    if (_indexStale == true) {
+        loadIndex();
+    }
 }
 
@@ -650,16 +650,14 @@ namespace Seer {
         // output: ""
         //
 
-        // Break the string into parts, delimited by a '.'.
-        QStringList parts = str.split('.');
+        // Everything before the last '.'.
+        int dot = str.lastIndexOf('.');
 
-        // Remove the last part.
-        if (parts.isEmpty() == false) {
-            parts.removeLast();
+        if (dot < 0) {
+            return QString();
         }
 
-        // Return a string that has the parts rejoined.
-        return parts.join('.');
+        return str.left(dot);
     }
 
     //
@@ -668,6 +666,18 @@ namespace Seer {
 
     bool matchesWildcard (const QStringList& patterns, const QString& string) {
 
+        return matchesWildcard(wildcardExpressions(patterns), string);
+    }
+
+    QVector<QRegularExpression> wildcardExpressions (const QStringList& patterns) {
+
+        //
+        // Convert the patterns once, for matching many strings against them.
+        //
+        QVector<QRegularExpression> expressions;
+
+        expressions.reserve(patterns.size());
+
         foreach (auto pattern, patterns) {
 
 #if QT_VERSION >= 0x060000
@@ -694,12 +704,20 @@ namespace Seer {
             //    }
             //}
 
-            // qDebug() << pattern << string;
-
             // QRegularExpression re = QRegularExpression(QRegularExpression::wildcardToRegularExpression(pattern));
             QRegularExpression re = QRegularExpression(pattern);
 #endif
 
+            expressions.append(re);
+        }
+
+        return expressions;
+    }
+
+    bool matchesWildcard (const QVector<QRegularExpression>& expressions, const QString& string) {
+
+        for (const auto& re : expressions) {
+
             if (re.match(string).hasMatch()) {
                 return true;
             }
@@ -3,6 +3,8 @@
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QMap>
+#include <QtCore/QVector>
+#include <QtCore/QRegularExpression>
 #include <QtCore/Qt>
 
 namespace Seer {
@@ -27,6 +29,8 @@ namespace Seer {
     QStringList                 quoteChars          (const QStringList& strings, const QString& chars);
     QString                     varObjParent        (const QString& str);
     bool                        matchesWildcard     (const QStringList& regexpatterns, const QString& string);
+    QVector<QRegularExpression> wildcardExpressions (const QStringList& regexpatterns);
+    bool                        matchesWildcard     (const QVector<QRegularExpression>& expressions, const QString& string);
     QString                     elideText           (const QString& str, Qt::TextElideMode mode, int length);
 
     int                         createID            ();
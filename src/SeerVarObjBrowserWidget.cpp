@@ -0,0 +1,139 @@
+#include "SeerVarObjBrowserWidget.h"
+#include <QtWidgets/QTreeWidget>
+#include <QtCore/QSettings>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+SeerVarObjBrowserWidget::SeerVarObjBrowserWidget (QWidget* parent) : QWidget(parent) {
+
+    // Initialize private data
+    _registry = 0;
+
+    // Construct the UI.
+    setupUi(this);
+
+    // Setup the widgets
+    varObjsTreeWidget->setSortingEnabled(false);
+    varObjsTreeWidget->setRootIsDecorated(false);
+    varObjsTreeWidget->setUniformRowHeights(true);
+    varObjsTreeWidget->clear();
+
+    _refreshTimer = new QTimer(this);
+    _refreshTimer->setSingleShot(true);
+    _refreshTimer->setInterval(250);
+
+    readSettings();
+
+    // Connect things.
+    QObject::connect(_refreshTimer,     &QTimer::timeout,                                this,  &SeerVarObjBrowserWidget::refresh);
+    QObject::connect(limitSpinBox,      QOverload<int>::of(&QSpinBox::valueChanged),     this,  &SeerVarObjBrowserWidget::handleLimitSpinBox);
+}
+
+SeerVarObjBrowserWidget::~SeerVarObjBrowserWidget () {
+}
+
+void SeerVarObjBrowserWidget::setRegistry (SeerVarObjRegistry* registry) {
+
+    _registry = registry;
+
+    if (_registry == 0) {
+        return;
+    }
+
+    _registry->setLimit(limitSpinBox->value());
+
+    QObject::connect(_registry, &SeerVarObjRegistry::changed, this, &SeerVarObjBrowserWidget::handleRegistryChanged);
+
+    refresh();
+}
+
+void SeerVarObjBrowserWidget::refresh () {
+
+    if (_registry == 0) {
+        return;
+    }
+
+    summaryLabel->setText(QString("%1 live varobjs. %2 roots, %3 children.").arg(_registry->liveCount()).arg(_registry->rootCount()).arg(_registry->childCount()));
+
+    if (_registry->updateCount() > 0) {
+        updateLabel->setText(QString("Last update took %1 ms for %2 changes. Average of %3 updates is %4 ms.")
+                                .arg(_registry->lastUpdateTime()).arg(_registry->lastUpdateChanges()).arg(_registry->updateCount()).arg(_registry->averageUpdateTime()));
+    }else{
+        updateLabel->setText("No updates yet.");
+    }
+
+    // The roots, most recently used first.
+    QVector<SeerVarObjRegistry::VarObj> varobjs = _registry->varObjs();
+
+    std::sort(varobjs.begin(), varobjs.end(), [](const SeerVarObjRegistry::VarObj& a, const SeerVarObjRegistry::VarObj& b) { return a.lastUsed > b.lastUsed; });
+
+    QList<QTreeWidgetItem*> items;
+
+    for (const auto& varobj : varobjs) {
+
+        QTreeWidgetItem* item = new QTreeWidgetItem;
+        item->setText(0, varobj.name);
+        item->setText(1, varobj.ownerName);
+        item->setText(2, varobj.expression);
+        item->setText(3, QString::number(varobj.children.size()));
+        item->setText(4, QString::number(varobj.refs));
+
+        items.append(item);
+    }
+
+    varObjsTreeWidget->clear();
+    varObjsTreeWidget->addTopLevelItems(items);
+
+    for (int i=0; i<varObjsTreeWidget->columnCount(); i++) {
+        varObjsTreeWidget->resizeColumnToContents(i);
+    }
+}
+
+void SeerVarObjBrowserWidget::handleRegistryChanged () {
+
+    // Nothing is shown while hidden. Catch up when shown.
+    if (isHidden()) {
+        return;
+    }
+
+    if (_refreshTimer->isActive() == false) {
+        _refreshTimer->start();
+    }
+}
+
+void SeerVarObjBrowserWidget::handleLimitSpinBox (int limit) {
+
+    // Keyboard tracking is off. A limit typed in comes here once, when it's done.
+    // Not digit by digit, which would evict down to each partial number.
+    if (_registry) {
+        _registry->setLimit(limit);
+    }
+
+    writeSettings();
+}
+
+void SeerVarObjBrowserWidget::showEvent (QShowEvent* event) {
+
+    QWidget::showEvent(event);
+
+    refresh();
+}
+
+void SeerVarObjBrowserWidget::writeSettings () {
+
+    QSettings settings;
+
+    settings.beginGroup("varobjbrowserwindow"); {
+        settings.setValue("limit", limitSpinBox->value());
+    } settings.endGroup();
+}
+
+void SeerVarObjBrowserWidget::readSettings () {
+
+    QSettings settings;
+
+    settings.beginGroup("varobjbrowserwindow"); {
+        limitSpinBox->setValue(settings.value("limit", 2000).toInt());
+    } settings.endGroup();
+}
+
@@ -0,0 +1,39 @@
+#pragma once
+
+#include "SeerVarObjRegistry.h"
+#include <QtWidgets/QWidget>
+#include <QtCore/QTimer>
+#include "ui_SeerVarObjBrowserWidget.h"
+
+//
+// Shows the varobjs Seer has in gdb, from the varobj registry: how many are
+// live, which widget made each root, and how long gdb took for "-var-update".
+// The limit on live varobjs is set here.
+//
+class SeerVarObjBrowserWidget : public QWidget, protected Ui::SeerVarObjBrowserWidgetForm {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerVarObjBrowserWidget (QWidget* parent = 0);
+       ~SeerVarObjBrowserWidget ();
+
+        void                setRegistry                         (SeerVarObjRegistry* registry);
+
+    public slots:
+        void                refresh                             ();
+
+    private slots:
+        void                handleRegistryChanged               ();
+        void                handleLimitSpinBox                  (int limit);
+
+    protected:
+        void                showEvent                           (QShowEvent* event);
+        void                writeSettings                       ();
+        void                readSettings                        ();
+
+    private:
+        SeerVarObjRegistry*     _registry;
+        QTimer*                 _refreshTimer;                  // Many changes come at once. Show them together.
+};
+
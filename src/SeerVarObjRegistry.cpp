@@ -0,0 +1,410 @@
+#include "SeerVarObjRegistry.h"
+#include "SeerUtl.h"
+#include <QtCore/QRegularExpression>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+SeerVarObjRegistry::SeerVarObjRegistry (QObject* parent) : QObject(parent) {
+
+    _tick              = 0;
+    _children          = 0;
+    _limit             = 2000;
+    _deleteId          = Seer::createID();
+    _updateCount       = 0;
+    _updateTotalTime   = 0;
+    _lastUpdateTime    = 0;
+    _lastUpdateChanges = 0;
+}
+
+SeerVarObjRegistry::~SeerVarObjRegistry () {
+}
+
+void SeerVarObjRegistry::add (QObject* owner, int id, const QString& objname, const QString& expression, bool frozen) {
+
+    // Forgotten again if gdb can't make it.
+    _creates.insert(id, objname);
+
+    if (frozen) {
+        _freezes.insert(id);
+    }else{
+        _freezes.remove(id);
+    }
+
+    // The same name again is another reference to it.
+    QHash<QString,VarObj>::iterator it = _varObjs.find(objname);
+
+    if (it != _varObjs.end()) {
+        it->refs++;
+        it->lastUsed = ++_tick;
+        emit changed();
+        return;
+    }
+
+    VarObj varobj;
+    varobj.name       = objname;
+    varobj.expression = expression;
+    varobj.ownerName  = (owner != 0 ? QString(owner->metaObject()->className()) : QString());
+    varobj.owner      = owner;
+    varobj.refs       = 1;
+    varobj.lastUsed   = ++_tick;
+
+    _varObjs.insert(objname, varobj);
+
+    // Delete what an owner leaves behind when it goes away.
+    if (owner != 0) {
+
+        if (_owners.contains(owner) == false) {
+            QObject::connect(owner, &QObject::destroyed, this, &SeerVarObjRegistry::handleOwnerDestroyed);
+        }
+
+        _owners[owner].append(objname);
+    }
+
+    evict(objname);
+
+    emit changed();
+}
+
+void SeerVarObjRegistry::release (const QString& objname) {
+
+    // The owner deletes it in gdb. Deleting a root deletes its children too.
+    QHash<QString,VarObj>::iterator it = _varObjs.find(objname);
+
+    if (it == _varObjs.end()) {
+        return;
+    }
+
+    if (--it->refs > 0) {
+        return;
+    }
+
+    _children -= it->children.size();
+
+    if (it->owner != 0) {
+        _owners[it->owner].removeOne(objname);
+    }
+
+    _varObjs.erase(it);
+
+    emit changed();
+}
+
+void SeerVarObjRegistry::releaseChildren (const QString& objname) {
+
+    // "-var-delete -c" deletes the children of a varobj, but not the varobj.
+    QHash<QString,VarObj>::iterator it = _varObjs.find(rootName(objname));
+
+    if (it == _varObjs.end()) {
+        return;
+    }
+
+    QString              prefix = objname + ".";
+    QSet<QString>::iterator cit = it->children.begin();
+
+    while (cit != it->children.end()) {
+        if (cit->startsWith(prefix)) {
+            cit = it->children.erase(cit);
+            _children--;
+        }else{
+            ++cit;
+        }
+    }
+
+    emit changed();
+}
+
+void SeerVarObjRegistry::touch (const QString& objname) {
+
+    QHash<QString,VarObj>::iterator it = _varObjs.find(rootName(objname));
+
+    if (it != _varObjs.end()) {
+        it->lastUsed = ++_tick;
+    }
+}
+
+void SeerVarObjRegistry::touchOwner (QObject* owner) {
+
+    // "-var-update *" uses all of an owner's varobjs at once.
+    for (const auto& objname : _owners.value(owner)) {
+        touch(objname);
+    }
+}
+
+void SeerVarObjRegistry::updateSent (int id) {
+
+    _updates.insert(id, QDateTime::currentMSecsSinceEpoch());
+}
+
+void SeerVarObjRegistry::clear () {
+
+    // gdb was restarted. Its varobjs went with it.
+    _varObjs.clear();
+    _creates.clear();
+    _freezes.clear();
+    _updates.clear();
+    _children = 0;
+
+    // Owners stay connected. They'll make new ones.
+    QHash<QObject*,QStringList>::iterator it;
+
+    for (it = _owners.begin(); it != _owners.end(); ++it) {
+        it->clear();
+    }
+
+    emit changed();
+}
+
+void SeerVarObjRegistry::setLimit (int limit) {
+
+    _limit = limit;
+
+    evict(QString());
+
+    emit changed();
+}
+
+int SeerVarObjRegistry::limit () const {
+
+    return _limit;
+}
+
+int SeerVarObjRegistry::rootCount () const {
+
+    return _varObjs.size();
+}
+
+int SeerVarObjRegistry::childCount () const {
+
+    return _children;
+}
+
+int SeerVarObjRegistry::liveCount () const {
+
+    return _varObjs.size() + _children;
+}
+
+QVector<SeerVarObjRegistry::VarObj> SeerVarObjRegistry::varObjs () const {
+
+    QVector<VarObj> varobjs;
+
+    varobjs.reserve(_varObjs.size());
+
+    QHash<QString,VarObj>::const_iterator it;
+
+    for (it = _varObjs.constBegin(); it != _varObjs.constEnd(); ++it) {
+        varobjs.append(it.value());
+    }
+
+    return varobjs;
+}
+
+int SeerVarObjRegistry::updateCount () const {
+
+    return _updateCount;
+}
+
+qint64 SeerVarObjRegistry::lastUpdateTime () const {
+
+    return _lastUpdateTime;
+}
+
+int SeerVarObjRegistry::lastUpdateChanges () const {
+
+    return _lastUpdateChanges;
+}
+
+qint64 SeerVarObjRegistry::averageUpdateTime () const {
+
+    if (_updateCount == 0) {
+        return 0;
+    }
+
+    return _updateTotalTime / _updateCount;
+}
+
+QString SeerVarObjRegistry::rootName (const QString& objname) {
+
+    //
+    // input:  "seer4.public.location"
+    // output: "seer4"
+    //
+    int dot = objname.indexOf('.');
+
+    if (dot < 0) {
+        return objname;
+    }
+
+    return objname.left(dot);
+}
+
+void SeerVarObjRegistry::handleText (const QString& text) {
+
+    static const QRegularExpression id_re("^([0-9]+)\\^");
+    static const QRegularExpression child_re("child=\\{name=\"([^\"]+)\"");
+
+    QRegularExpressionMatch id_match = id_re.match(text);
+
+    if (id_match.hasMatch() == false) {
+        return;
+    }
+
+    int id = id_match.captured(1).toInt();
+
+    // The answer to a create. An error means there's no varobj.
+    if (_creates.contains(id)) {
+
+        QString objname = _creates.take(id);
+        bool    frozen  = _freezes.remove(id);
+
+        if (text.contains("^error,")) {
+            release(objname);
+            return;
+        }
+
+        // Not if it was deleted or evicted while gdb was making it.
+        if (frozen && _varObjs.contains(objname)) {
+            emit freezeVarObj(objname);
+        }
+
+        return;
+    }
+
+    //
+    // How long gdb took to answer an update, and how much changed.
+    //
+    // "4^done,changelist=[{name=\"seer4.public.age\",value=\"60\",in_scope=\"true\",type_changed=\"false\",has_more=\"0\"},...]"
+    //
+    if (_updates.contains(id) && (text.contains("^done,changelist=") || text.contains("^error,"))) {
+
+        _lastUpdateTime     = QDateTime::currentMSecsSinceEpoch() - _updates.take(id);
+        _lastUpdateChanges  = text.count("{name=");
+        _updateTotalTime   += _lastUpdateTime;
+        _updateCount++;
+
+        emit changed();
+
+        return;
+    }
+
+    //
+    // The children gdb made for a list. They live until their root is deleted.
+    //
+    // "4^done,numchild=\"1\",children=[child={name=\"seer4.public\",exp=\"public\",numchild=\"4\",thread-id=\"1\"}],has_more=\"0\""
+    //
+    if (text.contains("^done,numchild=") && text.contains("children=[")) {
+
+        QString                         root;
+        QRegularExpressionMatchIterator it = child_re.globalMatch(text);
+
+        while (it.hasNext()) {
+
+            QString                         name   = it.next().captured(1);
+            QHash<QString,VarObj>::iterator varobj = _varObjs.find(rootName(name));
+
+            if (varobj == _varObjs.end()) {
+                continue;
+            }
+
+            if (varobj->children.contains(name) == false) {
+                varobj->children.insert(name);
+                _children++;
+            }
+
+            root = varobj->name;
+        }
+
+        if (root != "") {
+            evict(root);
+            emit changed();
+        }
+    }
+}
+
+void SeerVarObjRegistry::handleOwnerDestroyed (QObject* owner) {
+
+    // The owner went away without deleting these. Delete them for it.
+    QStringList objnames = _owners.take(owner);
+
+    for (const auto& objname : objnames) {
+
+        QHash<QString,VarObj>::iterator it = _varObjs.find(objname);
+
+        if (it == _varObjs.end()) {
+            continue;
+        }
+
+        _children -= it->children.size();
+
+        _varObjs.erase(it);
+
+        emit deleteVarObj(_deleteId, objname);
+    }
+
+    emit changed();
+}
+
+void SeerVarObjRegistry::evict (const QString& keep) {
+
+    //
+    // Delete the roots used least recently until there are no more live varobjs
+    // than the limit. Never the one just made or listed, nor the few roots its
+    // owner used most recently. The owner's other roots go like anyone else's.
+    //
+    QSet<QString> exempt;
+
+    if (_varObjs.contains(keep)) {
+
+        exempt.insert(keep);
+
+        QObject* owner = _varObjs[keep].owner;
+
+        if (owner != 0) {
+
+            QStringList roots = _owners.value(owner);
+
+            std::sort(roots.begin(), roots.end(), [this](const QString& a, const QString& b) {
+                return _varObjs.value(a).lastUsed > _varObjs.value(b).lastUsed;
+            });
+
+            for (int i=0; i<roots.size() && i<WorkingSet; i++) {
+                exempt.insert(roots[i]);
+            }
+        }
+    }
+
+    while (liveCount() > _limit) {
+
+        QHash<QString,VarObj>::iterator oldest = _varObjs.end();
+        QHash<QString,VarObj>::iterator it;
+
+        for (it = _varObjs.begin(); it != _varObjs.end(); ++it) {
+
+            if (exempt.contains(it.key())) {
+                continue;
+            }
+
+            if (oldest == _varObjs.end() || it->lastUsed < oldest->lastUsed) {
+                oldest = it;
+            }
+        }
+
+        if (oldest == _varObjs.end()) {
+            return;
+        }
+
+        QString objname = oldest->name;
+
+        _children -= oldest->children.size();
+
+        if (oldest->owner != 0) {
+            _owners[oldest->owner].removeOne(objname);
+        }
+
+        _varObjs.erase(oldest);
+
+        emit deleteVarObj(_deleteId, objname);
+        emit evicted(objname);
+    }
+}
+
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QVector>
+#include <QtCore/QStringList>
+#include <QtCore/QString>
+
+//
+// Keeps count of the variable objects (varobjs) Seer has made in gdb.
+//
+// Each root varobj is recorded with the widget that made it, when it was last
+// used and the children gdb has listed for it. Every root and child costs gdb
+// time in each "-var-update" that covers it, and stays until it is deleted.
+//
+// A root is deleted in gdb when its owner deletes it, or when the owner is
+// destroyed without doing so. If there are more live varobjs than the limit,
+// the roots that were used least recently are deleted and evicted() is emitted,
+// so their owners can make them again when they need them. The root being made
+// or listed, and the few its owner used last, are left alone.
+//
+// A root added as frozen is frozen once gdb says it made it. freezeVarObj() is
+// emitted then, so a create that failed isn't followed by a freeze that fails.
+//
+// The time gdb takes to answer each "-var-update" is kept, for the varobj panel.
+//
+class SeerVarObjRegistry : public QObject {
+
+    Q_OBJECT
+
+    public:
+        struct VarObj {
+            QString                         name;
+            QString                         expression;
+            QString                         ownerName;              // The owner's class, for showing.
+            QObject*                        owner;
+            int                             refs;
+            quint64                         lastUsed;               // Ticks, not time. Larger is more recent.
+            QSet<QString>                   children;               // The children gdb has listed. They live as long as the root.
+        };
+
+        explicit SeerVarObjRegistry (QObject* parent = 0);
+       ~SeerVarObjRegistry ();
+
+        void                                add                     (QObject* owner, int id, const QString& objname, const QString& expression, bool frozen = false);
+        void                                release                 (const QString& objname);
+        void                                releaseChildren         (const QString& objname);
+        void                                touch                   (const QString& objname);
+        void                                touchOwner              (QObject* owner);
+        void                                updateSent              (int id);
+        void                                clear                   ();
+
+        void                                setLimit                (int limit);
+        int                                 limit                   () const;
+
+        int                                 rootCount               () const;
+        int                                 childCount              () const;
+        int                                 liveCount               () const;
+        QVector<VarObj>                     varObjs                 () const;
+
+        int                                 updateCount             () const;
+        qint64                              lastUpdateTime          () const;
+        int                                 lastUpdateChanges       () const;
+        qint64                              averageUpdateTime       () const;
+
+        static QString                      rootName                (const QString& objname);
+
+    signals:
+        void                                deleteVarObj            (int id, QString objname);
+        void                                freezeVarObj            (QString objname);
+        void                                evicted                 (QString objname);
+        void                                changed                 ();
+
+    public slots:
+        void                                handleText              (const QString& text);
+
+    private slots:
+        void                                handleOwnerDestroyed    (QObject* owner);
+
+    private:
+        static const int                    WorkingSet = 16;        // Roots of the owner being served that are never evicted.
+
+        void                                evict                   (const QString& keep);
+
+        QHash<QString,VarObj>               _varObjs;               // By root name.
+        QHash<QObject*,QStringList>         _owners;                // The roots each owner has.
+        QHash<int,QString>                  _creates;               // "-var-create" id to the varobj, until gdb answers.
+        QSet<int>                           _freezes;               // The creates to freeze once gdb has made them.
+        QHash<int,qint64>                   _updates;               // "-var-update" id to when it was sent.
+        quint64                             _tick;
+        int                                 _children;
+        int                                 _limit;
+        int                                 _deleteId;
+
+        int                                 _updateCount;
+        qint64                              _updateTotalTime;
+        qint64                              _lastUpdateTime;
+        int                                 _lastUpdateChanges;
+};
+
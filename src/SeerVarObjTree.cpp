@@ -0,0 +1,259 @@
+#include "SeerVarObjTree.h"
+#include "SeerUtl.h"
+#include <QtGui/QFontDatabase>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QDebug>
+
+SeerVarObjTree::SeerVarObjTree (QTreeWidget* tree, const QString& prefix, int nameColumn, int valueColumn, QObject* parent) : QObject(parent) {
+
+    _tree        = tree;
+    _prefix      = prefix;
+    _nameColumn  = nameColumn;
+    _valueColumn = valueColumn;
+    _updateId    = Seer::createID();
+    _valid       = true;
+
+    QObject::connect(_tree, &QTreeWidget::itemExpanded,     this, &SeerVarObjTree::handleItemExpanded);
+}
+
+SeerVarObjTree::~SeerVarObjTree () {
+}
+
+QString SeerVarObjTree::addRoot (QTreeWidgetItem* item, int frame, const QString& expression) {
+
+    int     id      = Seer::createID();
+    QString objname = _prefix + QString::number(id);
+
+    _roots.append(objname);
+    _items.insert(objname, item);
+    _names.insert(item, objname);
+    _pending.insert(id, objname);
+
+    item->setFont(_valueColumn, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+    emit varObjCreate(id, objname, frame, expression);
+
+    return objname;
+}
+
+void SeerVarObjTree::update () {
+
+    // Each root is updated on its own. Updating "*" would take the changes of
+    // varobjs that belong to the visualizers.
+    for (const auto& objname : _roots) {
+        emit varObjUpdate(_updateId, objname);
+    }
+}
+
+void SeerVarObjTree::clear () {
+
+    // Deleting a root deletes its children in gdb too.
+    for (const auto& objname : _roots) {
+        emit varObjDelete(_updateId, objname);
+    }
+
+    _roots.clear();
+    _items.clear();
+    _names.clear();
+    _pending.clear();
+
+    _valid = true;
+}
+
+void SeerVarObjTree::handleVarObjEvicted (const QString& objname) {
+
+    // gdb deleted one of the roots to stay under the varobj limit. The owner makes
+    // new ones at its next refresh, when it sees the tree isn't valid. Not now. If
+    // the view needs more than the limit, making them again would evict others of
+    // its own, which would make those again, and so on.
+    if (_roots.contains(objname) == false) {
+        return;
+    }
+
+    _roots.removeAll(objname);
+
+    QTreeWidgetItem* item = _items.value(objname, 0);
+
+    if (item != 0) {
+        forgetChildren(item);
+        item->setText(_valueColumn, "");
+    }
+
+    _valid = false;
+}
+
+int SeerVarObjTree::rootCount () const {
+
+    return _roots.size();
+}
+
+bool SeerVarObjTree::isValid () const {
+
+    return _valid;
+}
+
+bool SeerVarObjTree::handleText (const QString& text) {
+
+    static const QRegularExpression id_re("^([0-9]+)\\^");
+
+    QRegularExpressionMatch match = id_re.match(text);
+
+    if (match.hasMatch() == false) {
+        return false;
+    }
+
+    int id = match.captured(1).toInt();
+
+    if (id == _updateId) {
+
+        if (text.contains("^done,changelist=")) {
+
+            // 12^done,changelist=[{name="seerlocal7",value="42",in_scope="true",type_changed="false",has_more="0"}]
+            QString     changelist_text = Seer::parseFirst(text,            "changelist=", '[', ']', false);
+            QStringList change_list     = Seer::parse(changelist_text,      "",            '{', '}', false);
+
+            for (const auto& change_text : change_list) {
+
+                QString name_text        = Seer::parseFirst(change_text, "name=",             '"', '"', false);
+                QString value_text       = Seer::parseFirst(change_text, "value=",            '"', '"', false);
+                QString inscope_text     = Seer::parseFirst(change_text, "in_scope=",         '"', '"', false);
+                QString typechanged_text = Seer::parseFirst(change_text, "type_changed=",     '"', '"', false);
+                QString numchild_text    = Seer::parseFirst(change_text, "new_num_children=", '"', '"', false);
+
+                QTreeWidgetItem* item = _items.value(name_text, 0);
+
+                if (item == 0) {
+                    continue;
+                }
+
+                // The varobj's frame is gone, or the program was restarted. Its value won't come back.
+                if (inscope_text == "false" || inscope_text == "invalid") {
+                    item->setText(_valueColumn, "<out of scope>");
+
+                    if (_valid) {
+                        _valid = false;
+                        emit invalidated();
+                    }
+
+                    continue;
+                }
+
+                // gdb dropped the children of a varobj whose type changed. Drop their items.
+                if (typechanged_text == "true") {
+                    forgetChildren(item);
+                    setPlaceholder(item, numchild_text.toInt());
+                }
+
+                item->setText(_valueColumn, Seer::filterEscapes(value_text));
+            }
+        }
+
+        // Replies to deletes and errors of updates have nothing to show.
+        return true;
+    }
+
+    if (_pending.contains(id) == false) {
+        return false;
+    }
+
+    QString          objname = _pending.take(id);
+    QTreeWidgetItem* item    = _items.value(objname, 0);
+    QString          token   = QString::number(id);
+
+    if (item == 0) {
+        return true;
+    }
+
+    if (text.startsWith(token + "^done,name=")) {
+
+        // 12^done,name="seerlocal12",numchild="3",value="{...}",type="Person",thread-id="1",has_more="0"
+        QString numchild_text = Seer::parseFirst(text, "numchild=", '"', '"', false);
+        QString value_text    = Seer::parseFirst(text, "value=",    '"', '"', false);
+
+        item->setText(_valueColumn, Seer::filterEscapes(value_text));
+
+        setPlaceholder(item, numchild_text.toInt());
+
+    }else if (text.startsWith(token + "^done,numchild=")) {
+
+        // 13^done,numchild="2",children=[child={name="seerlocal12.age",exp="age",numchild="0",value="60",type="int",thread-id="1"},...],has_more="0"
+        QString     children_text = Seer::parseFirst(text,          "children=", '[', ']', false);
+        QStringList child_list    = Seer::parse(children_text,      "child=",    '{', '}', false);
+
+        // Replace the placeholder.
+        forgetChildren(item);
+
+        for (const auto& child_text : child_list) {
+
+            QString name_text     = Seer::parseFirst(child_text, "name=",     '"', '"', false);
+            QString exp_text      = Seer::parseFirst(child_text, "exp=",      '"', '"', false);
+            QString numchild_text = Seer::parseFirst(child_text, "numchild=", '"', '"', false);
+            QString value_text    = Seer::parseFirst(child_text, "value=",    '"', '"', false);
+
+            QTreeWidgetItem* child = new QTreeWidgetItem;
+            child->setText(_nameColumn,  exp_text);
+            child->setText(_valueColumn, Seer::filterEscapes(value_text));
+            child->setFont(_valueColumn, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+
+            item->addChild(child);
+
+            _items.insert(name_text, child);
+            _names.insert(child, name_text);
+
+            setPlaceholder(child, numchild_text.toInt());
+        }
+
+    }else if (text.startsWith(token + "^error,msg=")) {
+
+        item->setText(_valueColumn, Seer::filterEscapes(Seer::parseFirst(text, "msg=", '"', '"', false)));
+    }
+
+    return true;
+}
+
+void SeerVarObjTree::handleItemExpanded (QTreeWidgetItem* item) {
+
+    QString objname = _names.value(item);
+
+    if (objname == "") {
+        return;
+    }
+
+    // Only the placeholder is there. List the children.
+    if (item->childCount() != 1 || _names.contains(item->child(0))) {
+        return;
+    }
+
+    int id = Seer::createID();
+
+    _pending.insert(id, objname);
+
+    emit varObjListChildren(id, objname);
+}
+
+void SeerVarObjTree::setPlaceholder (QTreeWidgetItem* item, int numchild) {
+
+    if (numchild <= 0 || item->childCount() > 0) {
+        return;
+    }
+
+    QTreeWidgetItem* placeholder = new QTreeWidgetItem;
+    placeholder->setText(_nameColumn, "{...}");
+
+    item->addChild(placeholder);
+}
+
+void SeerVarObjTree::forgetChildren (QTreeWidgetItem* item) {
+
+    QList<QTreeWidgetItem*> children = item->takeChildren();
+
+    for (int i=0; i<children.size(); i++) {
+
+        forgetChildren(children[i]);
+
+        _items.remove(_names.take(children[i]));
+    }
+
+    qDeleteAll(children);
+}
+
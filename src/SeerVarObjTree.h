@@ -0,0 +1,67 @@
+#pragma once
+
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QTreeWidgetItem>
+#include <QtCore/QObject>
+#include <QtCore/QHash>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+//
+// Shows the values of gdb variable objects (varobjs) in a QTreeWidget.
+//
+// The owner adds a tree item for each variable with addRoot(). A varobj is
+// created for it and its value shown in 'valueColumn'. Structs, arrays and
+// pointers get a placeholder child. Their children are listed when the item
+// is expanded. update() asks gdb for what changed since the last update, so
+// only changed values are sent back, and only their items are touched.
+//
+// Commands go out through the signals. Replies come back through handleText().
+// They carry the ids this tree asked with, so other widgets ignore them.
+// When gdb reports a varobj as out of scope, invalidated() is emitted once, so
+// the owner can make new ones. An evicted root only makes the tree not valid.
+// The owner makes new ones at its next refresh.
+//
+class SeerVarObjTree : public QObject {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerVarObjTree (QTreeWidget* tree, const QString& prefix, int nameColumn, int valueColumn, QObject* parent = 0);
+       ~SeerVarObjTree ();
+
+        QString                             addRoot                 (QTreeWidgetItem* item, int frame, const QString& expression);
+        void                                update                  ();
+        void                                clear                   ();
+        int                                 rootCount               () const;
+        bool                                isValid                 () const;
+
+        bool                                handleText              (const QString& text);
+        void                                handleVarObjEvicted     (const QString& objname);
+
+    signals:
+        void                                varObjCreate            (int id, QString objname, int frame, QString expression);
+        void                                varObjListChildren      (int id, QString objname);
+        void                                varObjUpdate            (int id, QString objname);
+        void                                varObjDelete            (int id, QString objname);
+        void                                invalidated             ();
+
+    private slots:
+        void                                handleItemExpanded      (QTreeWidgetItem* item);
+
+    private:
+        void                                setPlaceholder          (QTreeWidgetItem* item, int numchild);
+        void                                forgetChildren          (QTreeWidgetItem* item);
+
+        QTreeWidget*                        _tree;
+        QString                             _prefix;
+        int                                 _nameColumn;
+        int                                 _valueColumn;
+        int                                 _updateId;
+        bool                                _valid;                 // False once gdb reports a varobj out of scope or invalid.
+        QStringList                         _roots;
+        QHash<QString,QTreeWidgetItem*>     _items;                 // Varobj name to item.
+        QHash<QTreeWidgetItem*,QString>     _names;                 // Item to varobj name.
+        QHash<int,QString>                  _pending;               // Command id to the varobj it was for.
+};
+
@@ -12,6 +12,10 @@
 #include <QtCore/QTimer>
 #include <QtCore/QSettings>
 #include <QtCore/QDebug>
+#include <limits>
+
+// Marks the "show next" and "show all" items at the end of a partly listed level. The number of children they ask for, -1 for all.
+static const int MoreRole = Qt::UserRole;
 
 SeerVarVisualizerWidget::SeerVarVisualizerWidget (QWidget* parent) : QWidget(parent) {
 
@@ -75,6 +79,7 @@ SeerVarVisualizerWidget::SeerVarVisualizerWidget (QWidget* parent) : QWidget(par
     QObject::connect(variableTreeWidget,            &QTreeWidget::itemEntered,                   this,  &SeerVarVisualizerWidget::handleItemEntered);
     QObject::connect(variableTreeWidget,            &QTreeWidget::itemExpanded,                  this,  &SeerVarVisualizerWidget::handleItemExpanded);
     QObject::connect(variableTreeWidget,            &QTreeWidget::itemCollapsed,                 this,  &SeerVarVisualizerWidget::handleItemCollapsed);
+    QObject::connect(variableTreeWidget,            &QTreeWidget::itemClicked,                   this,  &SeerVarVisualizerWidget::handleItemClicked);
     QObject::connect(expandSelectedToolButton,      &QToolButton::clicked,                       this,  &SeerVarVisualizerWidget::handleExpandSelected);
     QObject::connect(collapseSelectedToolButton,    &QToolButton::clicked,                       this,  &SeerVarVisualizerWidget::handleCollapseSelected);
     QObject::connect(editDelegate,                  &QAllowEditDelegate::editingStarted,         this,  &SeerVarVisualizerWidget::handleIndexEditingStarted);
@@ -110,7 +115,7 @@ void SeerVarVisualizerWidget::setVariableName (const QString& name) {
     }
 
     // Create the initial variable in the tree.
-    variableTreeWidget->clear();
+    clearItems();
 
     if (variableNameLineEdit->text() != "") {
 
@@ -189,11 +194,13 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
                 topItem->setText(0, exp_text);
             }
 
+            _varObjItems.insert(name_text, topItem);
+
             //XXX Ask for its editable attributes.
             //XXX emit varObjAttributes (varObjID, name_text);
 
-            // If there are children, add a placeholder.
-            if (numchild_text != "0") {
+            // If there are children, add a placeholder. A pretty-printed container says so with 'has_more'.
+            if (numchild_text != "0" || hasmore_text == "1") {
                 if (type_text.endsWith('*')) {
                     if (Seer::filterEscapes(value_text) != "0x0") {
                         // If it is a pointer that is not null, add a placeholder.  How universal is this for other languages?
@@ -226,7 +233,7 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
     }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,numchild="))) {
 
         //
-        // "-var-list-children --all-values x2112.public"
+        // "-var-list-children --all-values x2112.public 0 200"
         //
         // "4^done,numchild="1", children=[
         //         ------------
@@ -245,6 +252,9 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
             QStringList child_list    = Seer::parse(children_text, "child=",    '{', '}', false);
             QString     hasmore_text  = Seer::parseFirst(text,     "has_more=", '"', '"', false);
 
+            // The items given children by this reply.
+            QList<QTreeWidgetItem*> parentItems;
+
             for (const auto& child_text : child_list) {
 
                 QString name_text     = Seer::parseFirst(child_text, "name=",      '"', '"', false);
@@ -253,9 +263,10 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
                 QString value_text    = Seer::parseFirst(child_text, "value=",     '"', '"', false);
                 QString type_text     = Seer::parseFirst(child_text, "type=",      '"', '"', false);
                 QString threadid_text = Seer::parseFirst(child_text, "thread-id=", '"', '"', false);
+                QString dynamic_text  = Seer::parseFirst(child_text, "dynamic=",   '"', '"', false);
 
                 // Do we have an existing item to add to?
-                QTreeWidgetItem* matchItem = findItem(Seer::varObjParent(name_text), Qt::MatchExactly|Qt::MatchRecursive, 3);
+                QTreeWidgetItem* matchItem = varObjParentItem(name_text);
 
                 // No, just add to the top level.
                 if (matchItem == 0) {
@@ -266,6 +277,12 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
                 // Yes, add to it.
                 }else{
 
+                    // The "show more" items go back at the end, after this page.
+                    if (parentItems.contains(matchItem) == false) {
+                        parentItems.append(matchItem);
+                        removeMoreItems(matchItem);
+                    }
+
                     // See if item has a "{...}" child. If so, remove it and any other siblings.
                     if (matchItem->childCount() > 0) {
                         QTreeWidgetItem* childItem = matchItem->child(0);
@@ -298,10 +315,11 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
                     //XXX Ask for its editable attributes.
                     //XXX emit varObjAttributes (varObjID, name_text);
 
-                    // If there are children, add a placeholder.
+                    // If there are children, add a placeholder. A pretty-printed container may have
+                    // children without saying how many.
                     bool expandItem = false;
 
-                    if (numchild_text != "0") {
+                    if (numchild_text != "0" || dynamic_text == "1") {
                         if (type_text.endsWith('*')) {
                             if (Seer::filterEscapes(value_text) != "0x0") {
                                 // If it is a pointer that is not null, add a placeholder.  How universal is this for other languages?
@@ -329,11 +347,24 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
 
                     matchItem->addChild(item);
 
+                    _varObjItems.insert(name_text, item);
+
                     if (expandItem == true && expandRecursiveCheckBox->isChecked()) {
                         item->setExpanded(true);
                     }
                 }
             }
+
+            for (auto parentItem : parentItems) {
+
+                int count = childItemCount(parentItem);
+
+                // Have "-var-update" only report the children that are shown.
+                emit varObjSetUpdateRange(_variableId, parentItem->text(3), 0, count);
+
+                // Offer the rest, if there is more.
+                addMoreItems(parentItem, count, hasmore_text == "1");
+            }
         }
 
 
@@ -368,7 +399,7 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
                 QString hasmore_text      = Seer::parseFirst(child_text, "has_more=",      '"', '"', false);
 
                 // Do we have an existing item to add to?
-                QTreeWidgetItem* matchItem = findItem(name_text, Qt::MatchExactly|Qt::MatchRecursive, 3);
+                QTreeWidgetItem* matchItem = varObjItem(name_text);
 
                 // No, just add to the top level.
                 if (matchItem == 0) {
@@ -456,7 +487,7 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
 
             if (_previousEditName != "") {
 
-                QTreeWidgetItem* matchItem = findItem(_previousEditName, Qt::MatchExactly|Qt::MatchRecursive, 3);
+                QTreeWidgetItem* matchItem = varObjItem(_previousEditName);
                 if (matchItem) {
                     matchItem->setText(1, _previousEditValue);
                 }
@@ -465,7 +496,7 @@ void SeerVarVisualizerWidget::handleText (const QString& text) {
 
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
-        variableTreeWidget->clear();
+        clearItems();
 
     // At a stopping point, refresh.
     }else if (text.startsWith("*stopped,reason=\"")) {
@@ -486,7 +517,7 @@ void SeerVarVisualizerWidget::handleContextMenu (const QPoint& pos) {
 
     QTreeWidgetItem* item = variableTreeWidget->itemAt(pos);
 
-    if (item == 0) {
+    if (item == 0 || item->data(0, MoreRole).isValid()) {
         return;
     }
 
@@ -712,8 +743,8 @@ void SeerVarVisualizerWidget::handleItemEntered (QTreeWidgetItem* item, int colu
 
 void SeerVarVisualizerWidget::handleItemExpanded (QTreeWidgetItem* item) {
 
-    // Ask for the children.
-    emit varObjListChildren(_variableId, item->text(3));
+    // Ask for the first page of children.
+    emit varObjListChildrenRange(_variableId, item->text(3), 0, PageSize);
 
     // Resize columns in a sec.
     // Have to schedule the resize later. Doing it immediatedly messes up the
@@ -723,9 +754,14 @@ void SeerVarVisualizerWidget::handleItemExpanded (QTreeWidgetItem* item) {
 
 void SeerVarVisualizerWidget::handleItemCollapsed (QTreeWidgetItem* item) {
 
-    // Delete all children items.
+    // Delete all children items, and their varobjs in gdb. They're listed again when expanded.
     deleteItems(item->takeChildren());
 
+    emit varObjDeleteChildren(_variableId, item->text(3));
+
+    // None of them are shown now.
+    emit varObjSetUpdateRange(_variableId, item->text(3), 0, 0);
+
     // If there are children, add a placeholder.
     if (item->text(5) != "0") {
         if (item->text(2).endsWith('*')) {
@@ -754,6 +790,38 @@ void SeerVarVisualizerWidget::handleItemCollapsed (QTreeWidgetItem* item) {
     QTimer::singleShot(100, this, &SeerVarVisualizerWidget::handleResizeColumns);
 }
 
+void SeerVarVisualizerWidget::handleItemClicked (QTreeWidgetItem* item, int column) {
+
+    Q_UNUSED(column);
+
+    QVariant more = item->data(0, MoreRole);
+
+    if (more.isValid() == false || item->parent() == 0) {
+        return;
+    }
+
+    // Ask for the next children of the level. The "show more" items come back
+    // with the reply, if there are still more.
+    QTreeWidgetItem* parentItem = item->parent();
+    int              from       = childItemCount(parentItem);
+    int              numchild   = parentItem->text(6).toInt();
+    int              to         = 0;
+
+    if (more.toInt() > 0) {
+        to = from + more.toInt();
+    }else if (numchild > from) {
+        to = numchild;
+    }else{
+        to = std::numeric_limits<int>::max(); // A pretty-printed container doesn't say how many it has.
+    }
+
+    QString objname = parentItem->text(3);
+
+    removeMoreItems(parentItem);
+
+    emit varObjListChildrenRange(_variableId, objname, from, to);
+}
+
 void SeerVarVisualizerWidget::handleExpandSelected () {
 
     // Expand the current item, if selected.
@@ -815,12 +883,38 @@ void SeerVarVisualizerWidget::handleHideDebugColumns (bool flag) {
 
 void SeerVarVisualizerWidget::handleRefreshButton () {
 
+    // The varobj was evicted. Make it again.
+    if (_variableName == "" && variableNameLineEdit->text() != "") {
+        setVariableName(variableNameLineEdit->text());
+        return;
+    }
+
     // Send signal to get variable result.
     if (_variableName != "") {
         emit varObjUpdate(_variableId, _variableName);
     }
 }
 
+void SeerVarVisualizerWidget::handleVarObjEvicted (QString objname) {
+
+    if (objname != _variableName) {
+        return;
+    }
+
+    // gdb deleted the varobj, and its children, to stay under the varobj limit.
+    _variableName = "";
+
+    QTreeWidgetItem* topItem = variableTreeWidget->topLevelItem(0);
+
+    if (topItem == 0) {
+        return;
+    }
+
+    deleteItems(topItem->takeChildren());
+
+    topItem->setText(1, "<deleted to stay under the varobj limit, refresh to show it again>");
+}
+
 void SeerVarVisualizerWidget::handleHelpButton () {
 
     SeerHelpPageDialog* help = new SeerHelpPageDialog;
@@ -1031,6 +1125,110 @@ void SeerVarVisualizerWidget::deleteItems (QList<QTreeWidgetItem*> items) {
 
     // Loop through the list and delete the items.
     // Note, the list will still contain pointers, but they will be invalid.
-    foreach (auto item, items) delete item;
+    foreach (auto item, items) {
+        forgetItem(item);
+        delete item;
+    }
 }
 
+void SeerVarVisualizerWidget::clearItems () {
+
+    _varObjItems.clear();
+
+    variableTreeWidget->clear();
+}
+
+void SeerVarVisualizerWidget::forgetItem (QTreeWidgetItem* item) {
+
+    // Take the item and its children out of the name lookup. A placeholder has its
+    // parent's name, so only remove the entry if it is for this item.
+    QHash<QString,QTreeWidgetItem*>::iterator it = _varObjItems.find(item->text(3));
+
+    if (it != _varObjItems.end() && it.value() == item) {
+        _varObjItems.erase(it);
+    }
+
+    for (int i=0; i<item->childCount(); i++) {
+        forgetItem(item->child(i));
+    }
+}
+
+QTreeWidgetItem* SeerVarVisualizerWidget::varObjItem (const QString& name) const {
+
+    return _varObjItems.value(name, nullptr);
+}
+
+QTreeWidgetItem* SeerVarVisualizerWidget::varObjParentItem (const QString& name) const {
+
+    //
+    // "seer4.public.location" is a child of "seer4.public". The parent's name is the
+    // front of the child's, so look it up in place rather than making a copy.
+    //
+    int dot = name.lastIndexOf('.');
+
+    if (dot <= 0) {
+        return nullptr;
+    }
+
+    return _varObjItems.value(QString::fromRawData(name.constData(), dot), nullptr);
+}
+
+int SeerVarVisualizerWidget::childItemCount (QTreeWidgetItem* item) const {
+
+    // The children listed so far. Not the placeholders.
+    int count = 0;
+
+    for (int i=0; i<item->childCount(); i++) {
+
+        QTreeWidgetItem* child = item->child(i);
+
+        if (child->data(0, MoreRole).isValid() == false && child->text(0) != "{...}") {
+            count++;
+        }
+    }
+
+    return count;
+}
+
+void SeerVarVisualizerWidget::addMoreItems (QTreeWidgetItem* item, int count, bool hasMore) {
+
+    //
+    // A level is listed a page at a time. If there are children left, end it with
+    // an item to show the next page and one to show the rest. A pretty-printed
+    // container says it has more with 'has_more'. Others with 'numchild'.
+    //
+    int numchild = item->text(6).toInt();
+
+    if (hasMore == false && numchild <= count) {
+        return;
+    }
+
+    int next = PageSize;
+
+    if (hasMore == false) {
+        next = qMin(next, numchild - count);
+    }
+
+    QTreeWidgetItem* nextItem = new QTreeWidgetItem;
+    nextItem->setText(0, QString("Show next %1").arg(next));
+    nextItem->setText(1, (hasMore ? QString("%1 shown").arg(count) : QString("%1 of %2 shown").arg(count).arg(numchild)));
+    nextItem->setText(3, item->text(3));
+    nextItem->setData(0, MoreRole, next);
+
+    QTreeWidgetItem* allItem = new QTreeWidgetItem;
+    allItem->setText(0, "Show all");
+    allItem->setText(3, item->text(3));
+    allItem->setData(0, MoreRole, -1);
+
+    item->addChild(nextItem);
+    item->addChild(allItem);
+}
+
+void SeerVarVisualizerWidget::removeMoreItems (QTreeWidgetItem* item) {
+
+    for (int i=item->childCount()-1; i>=0; i--) {
+        if (item->child(i)->data(0, MoreRole).isValid()) {
+            delete item->takeChild(i);
+        }
+    }
+}
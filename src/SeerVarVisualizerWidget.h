@@ -2,6 +2,8 @@
 
 #include <QtWidgets/QWidget>
 #include <QtGui/QKeyEvent>
+#include <QtCore/QHash>
+#include <QtCore/QString>
 #include "ui_SeerVarVisualizerWidget.h"
 
 class SeerVarVisualizerWidget : public QWidget, protected Ui::SeerVarVisualizerWidgetForm {
@@ -9,6 +11,8 @@ class SeerVarVisualizerWidget : public QWidget, protected Ui::SeerVarVisualizerW
     Q_OBJECT
 
     public:
+        static const int    PageSize = 200;                     // Children asked for at a time.
+
         explicit SeerVarVisualizerWidget (QWidget* parent = 0);
        ~SeerVarVisualizerWidget ();
 
@@ -17,9 +21,11 @@ class SeerVarVisualizerWidget : public QWidget, protected Ui::SeerVarVisualizerW
 
     signals:
         void                varObjCreate                        (int expressionid, QString expression);
-        void                varObjListChildren                  (int expressionid, QString objname);
+        void                varObjListChildrenRange             (int expressionid, QString objname, int from, int to);
+        void                varObjSetUpdateRange                (int expressionid, QString objname, int from, int to);
         void                varObjUpdate                        (int expressionid, QString objname);
         void                varObjDelete                        (int expressionid, QString objname);
+        void                varObjDeleteChildren                (int expressionid, QString objname);
         void                varObjAssign                        (int expressionid, QString objname, QString value);
         void                varObjAttributes                    (int objid,        QString objname);
         void                addMemoryVisualize                  (QString expression);
@@ -28,6 +34,7 @@ class SeerVarVisualizerWidget : public QWidget, protected Ui::SeerVarVisualizerW
 
     public slots:
         void                handleText                          (const QString& text);
+        void                handleVarObjEvicted                 (QString objname);
 
     protected slots:
         void                handleRefreshButton                 ();
@@ -40,6 +47,7 @@ class SeerVarVisualizerWidget : public QWidget, protected Ui::SeerVarVisualizerW
         void                handleItemEntered                   (QTreeWidgetItem* item, int column);
         void                handleItemExpanded                  (QTreeWidgetItem* item);
         void                handleItemCollapsed                 (QTreeWidgetItem* item);
+        void                handleItemClicked                   (QTreeWidgetItem* item, int column);
         void                handleExpandSelected                ();
         void                handleCollapseSelected              ();
         void                handleResizeColumns                 ();
@@ -58,10 +66,18 @@ class SeerVarVisualizerWidget : public QWidget, protected Ui::SeerVarVisualizerW
         QString             toolTipText                         (QTreeWidgetItem* item);
         void                debug                               (QString message,  QTreeWidgetItem* item);
         void                deleteItems                         (QList<QTreeWidgetItem*> items);
+        void                clearItems                          ();
+        void                forgetItem                          (QTreeWidgetItem* item);
+        QTreeWidgetItem*    varObjItem                          (const QString& name) const;
+        QTreeWidgetItem*    varObjParentItem                    (const QString& name) const;
+        int                 childItemCount                      (QTreeWidgetItem* item) const;
+        void                addMoreItems                        (QTreeWidgetItem* item, int count, bool hasMore);
+        void                removeMoreItems                     (QTreeWidgetItem* item);
 
         int                 _variableId;
         QString             _variableName;
         QString             _previousEditName;
         QString             _previousEditValue;
+        QHash<QString,QTreeWidgetItem*> _varObjItems;           // Varobj name to its item. Not the "{...}" placeholders.
 };
 
@@ -0,0 +1,552 @@
+#include "SeerVariableLogModel.h"
+#include "SeerUtl.h"
+#include <QtGui/QFontDatabase>
+#include <QtCore/QDateTime>
+#include <QtCore/QDebug>
+#include <algorithm>
+
+SeerVariableLogModel::Member::~Member () {
+
+    qDeleteAll(children);
+}
+
+SeerVariableLogModel::SeerVariableLogModel (QObject* parent) : QAbstractItemModel(parent) {
+
+    _head          = 0;
+    _count         = 0;
+    _capacity      = 100000;
+    _firstSequence = 0;
+}
+
+SeerVariableLogModel::~SeerVariableLogModel () {
+
+    qDeleteAll(_members);
+}
+
+QModelIndex SeerVariableLogModel::index (int row, int column, const QModelIndex& parent) const {
+
+    if (hasIndex(row, column, parent) == false) {
+        return QModelIndex();
+    }
+
+    // A sample.
+    if (parent.isValid() == false) {
+        return createIndex(row, column);
+    }
+
+    // A member of a sample, or of a member.
+    Member* member = (parent.internalPointer() != 0 ? static_cast<Member*>(parent.internalPointer()) : root(parent.row()));
+
+    parse(member);
+
+    return createIndex(row, column, member->children[row]);
+}
+
+QModelIndex SeerVariableLogModel::parent (const QModelIndex& index) const {
+
+    if (index.isValid() == false || index.internalPointer() == 0) {
+        return QModelIndex();
+    }
+
+    Member* member = static_cast<Member*>(index.internalPointer());
+
+    // A member of the sample itself.
+    if (member->parent->parent == 0) {
+        return createIndex(int(member->sequence - _firstSequence), 0);
+    }
+
+    return createIndex(member->parent->row, 0, member->parent);
+}
+
+int SeerVariableLogModel::rowCount (const QModelIndex& parent) const {
+
+    if (parent.column() > 0) {
+        return 0;
+    }
+
+    if (parent.isValid() == false) {
+        return _count;
+    }
+
+    Member* member = (parent.internalPointer() != 0 ? static_cast<Member*>(parent.internalPointer()) : root(parent.row()));
+
+    parse(member);
+
+    return member->children.size();
+}
+
+int SeerVariableLogModel::columnCount (const QModelIndex& parent) const {
+
+    Q_UNUSED(parent);
+
+    return 3;
+}
+
+bool SeerVariableLogModel::hasChildren (const QModelIndex& parent) const {
+
+    if (parent.isValid() == false) {
+        return _count > 0;
+    }
+
+    if (parent.column() > 0) {
+        return false;
+    }
+
+    // Answered without parsing, so the view can draw the rows cheaply.
+    if (parent.internalPointer() != 0) {
+        return Seer::hasBookends(static_cast<Member*>(parent.internalPointer())->value, '{', '}');
+    }
+
+    int s = slot(parent.row());
+
+    return _names[s] >= 0 && Seer::hasBookends(_values[s], '{', '}');
+}
+
+QVariant SeerVariableLogModel::data (const QModelIndex& index, int role) const {
+
+    if (index.isValid() == false) {
+        return QVariant();
+    }
+
+    const Member* member = static_cast<const Member*>(index.internalPointer());
+    int           row    = (member != 0 ? int(member->sequence - _firstSequence) : index.row());
+
+    if (row < 0 || row >= _count) {
+        return QVariant();
+    }
+
+    int s = slot(row);
+
+    if (role == Qt::DisplayRole || role == Qt::ToolTipRole) {
+
+        QString time_text  = QDateTime::fromMSecsSinceEpoch(_times[s]).time().toString(Qt::TextDate);
+        QString name_text  = (member != 0 ? member->name : sampleName(row));
+        QString value_text;
+
+        if (member != 0) {
+            value_text = displayValue(member->value);
+        }else if (_names[s] < 0) {
+            value_text = Seer::filterEscapes(_values[s]);
+        }else{
+            value_text = displayValue(_values[s]);
+        }
+
+        if (role == Qt::ToolTipRole) {
+            return time_text + " : " + name_text + " : " + Seer::elideText(value_text, Qt::ElideRight, 100);
+        }
+
+        switch (index.column()) {
+            case 0:
+                return time_text;
+            case 1:
+                return name_text;
+            case 2:
+                return value_text;
+            default:
+                return QVariant();
+        }
+    }
+
+    if (role == Qt::FontRole && index.column() == 2) {
+        return QFontDatabase::systemFont(QFontDatabase::FixedFont);
+    }
+
+    return QVariant();
+}
+
+QVariant SeerVariableLogModel::headerData (int section, Qt::Orientation orientation, int role) const {
+
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+        return QVariant();
+    }
+
+    switch (section) {
+        case 0:
+            return QString("Timestamp");
+        case 1:
+            return QString("Name");
+        case 2:
+            return QString("Value");
+        default:
+            return QVariant();
+    }
+}
+
+void SeerVariableLogModel::addSample (int id, const QString& expression) {
+
+    // Full. Make room.
+    if (_count == _capacity) {
+        dropOldest();
+    }
+
+    int name = _nameIndex.value(expression, -1);
+
+    if (name < 0) {
+        name = _nameTable.size();
+        _nameTable.append(expression);
+        _nameIndex.insert(expression, name);
+    }
+
+    beginInsertRows(QModelIndex(), _count, _count);
+
+    // The columns grow until they reach the capacity. Until then, the oldest sample is in slot 0.
+    if (_times.size() < _capacity) {
+        _times.append(QDateTime::currentMSecsSinceEpoch());
+        _names.append(name);
+        _values.append(QString());
+
+    }else{
+        int s = slot(_count);
+
+        _times[s]  = QDateTime::currentMSecsSinceEpoch();
+        _names[s]  = name;
+        _values[s] = QString();
+    }
+
+    _pending.insert(id, _firstSequence + quint32(_count));
+
+    _count++;
+
+    endInsertRows();
+}
+
+bool SeerVariableLogModel::setSampleValue (int id, const QString& value) {
+
+    if (_pending.contains(id) == false) {
+        return false;
+    }
+
+    quint32 sequence = _pending.take(id);
+
+    // Dropped while gdb was working on it.
+    if (sequence < _firstSequence) {
+        return true;
+    }
+
+    int row = int(sequence - _firstSequence);
+
+    _values[slot(row)] = value;
+
+    delete _members.take(sequence);
+
+    emit dataChanged(index(row, 0), index(row, 2));
+
+    return true;
+}
+
+bool SeerVariableLogModel::setSampleError (int id, const QString& message) {
+
+    if (_pending.contains(id) == false) {
+        return false;
+    }
+
+    quint32 sequence = _pending.take(id);
+
+    if (sequence < _firstSequence) {
+        return true;
+    }
+
+    int row = int(sequence - _firstSequence);
+    int s   = slot(row);
+
+    // The expression isn't a valid name. Don't show it as one.
+    _names[s]  = -1;
+    _values[s] = message;
+
+    delete _members.take(sequence);
+
+    emit dataChanged(index(row, 0), index(row, 2));
+
+    return true;
+}
+
+bool SeerVariableLogModel::isPending (int id) const {
+
+    return _pending.contains(id);
+}
+
+void SeerVariableLogModel::removeSamples (QList<int> rows) {
+
+    if (rows.size() == 0) {
+        return;
+    }
+
+    std::sort(rows.begin(), rows.end());
+
+    beginResetModel();
+
+    QVector<qint64>  times;
+    QVector<int>     names;
+    QVector<QString> values;
+    QVector<int>     newRows(_count, -1);
+
+    times.reserve(_count);
+    names.reserve(_count);
+    values.reserve(_count);
+
+    int next = 0;
+
+    for (int row=0; row<_count; row++) {
+
+        if (next < rows.size() && rows[next] == row) {
+            while (next < rows.size() && rows[next] == row) {
+                next++;
+            }
+            continue;
+        }
+
+        int s = slot(row);
+
+        newRows[row] = times.size();
+
+        times.append(_times[s]);
+        names.append(_names[s]);
+        values.append(_values[s]);
+    }
+
+    // Renumber the samples still waiting for gdb.
+    QHash<int,quint32>::iterator it = _pending.begin();
+
+    while (it != _pending.end()) {
+
+        int row = int(it.value() - _firstSequence);
+
+        if (it.value() < _firstSequence || newRows[row] < 0) {
+            it = _pending.erase(it);
+            continue;
+        }
+
+        it.value() = _firstSequence + quint32(newRows[row]);
+        ++it;
+    }
+
+    _times  = times;
+    _names  = names;
+    _values = values;
+    _head   = 0;
+    _count  = times.size();
+
+    qDeleteAll(_members);
+    _members.clear();
+
+    endResetModel();
+}
+
+void SeerVariableLogModel::clear () {
+
+    beginResetModel();
+
+    _times.clear();
+    _names.clear();
+    _values.clear();
+    _head  = 0;
+    _count = 0;
+
+    _nameTable.clear();
+    _nameIndex.clear();
+    _pending.clear();
+
+    qDeleteAll(_members);
+    _members.clear();
+
+    endResetModel();
+}
+
+void SeerVariableLogModel::setCapacity (int samples) {
+
+    samples = qMax(samples, 1);
+
+    if (_capacity == samples) {
+        return;
+    }
+
+    // Only the newest samples fit.
+    if (_count > samples) {
+
+        beginResetModel();
+
+        linearize(samples);
+
+        qDeleteAll(_members);
+        _members.clear();
+
+        endResetModel();
+
+    }else{
+        linearize(_count);
+    }
+
+    _capacity = samples;
+}
+
+int SeerVariableLogModel::capacity () const {
+
+    return _capacity;
+}
+
+qint64 SeerVariableLogModel::sampleTime (int row) const {
+
+    return _times[slot(row)];
+}
+
+QString SeerVariableLogModel::sampleName (int row) const {
+
+    int name = _names[slot(row)];
+
+    return (name < 0 ? QString() : _nameTable[name]);
+}
+
+QString SeerVariableLogModel::sampleValue (int row) const {
+
+    return _values[slot(row)];
+}
+
+bool SeerVariableLogModel::sampleIsError (int row) const {
+
+    return _names[slot(row)] < 0;
+}
+
+int SeerVariableLogModel::sampleRow (const QModelIndex& index) const {
+
+    if (index.isValid() == false) {
+        return -1;
+    }
+
+    if (index.internalPointer() == 0) {
+        return index.row();
+    }
+
+    return int(static_cast<Member*>(index.internalPointer())->sequence - _firstSequence);
+}
+
+QString SeerVariableLogModel::memberName (const QModelIndex& index) const {
+
+    // "expression.member.member", for the visualizers.
+    if (index.isValid() == false) {
+        return QString();
+    }
+
+    if (index.internalPointer() == 0) {
+        return sampleName(index.row());
+    }
+
+    Member* member = static_cast<Member*>(index.internalPointer());
+    QString name   = member->name;
+
+    for (member = member->parent; member->parent != 0; member = member->parent) {
+        name = member->name + "." + name;
+    }
+
+    return member->name + "." + name;
+}
+
+QString SeerVariableLogModel::displayValue (const QString& value) {
+
+    // Structs are shown without their braces.
+    if (Seer::hasBookends(value, '{', '}')) {
+        return Seer::filterEscapes(Seer::filterBookends(value, '{', '}'));
+    }
+
+    return Seer::filterEscapes(value);
+}
+
+int SeerVariableLogModel::slot (int row) const {
+
+    return (_head + row) % _times.size();
+}
+
+SeerVariableLogModel::Member* SeerVariableLogModel::root (int row) const {
+
+    quint32 sequence = _firstSequence + quint32(row);
+    Member* member   = _members.value(sequence, 0);
+
+    if (member == 0) {
+        member           = new Member;
+        member->parent   = 0;
+        member->sequence = sequence;
+        member->row      = row;
+        member->name     = sampleName(row);
+        member->value    = _values[slot(row)];
+        member->parsed   = false;
+
+        _members.insert(sequence, member);
+    }
+
+    return member;
+}
+
+void SeerVariableLogModel::parse (Member* member) const {
+
+    if (member->parsed) {
+        return;
+    }
+
+    member->parsed = true;
+
+    if (Seer::hasBookends(member->value, '{', '}') == false) {
+        return;
+    }
+
+    // Convert to a list of name/value pairs.
+    QStringList nv_pairs = Seer::parseCommaList(Seer::filterBookends(member->value, '{', '}'), '{', '}');
+
+    for (const auto& nv : nv_pairs) {
+
+        QStringPair pair = Seer::parseNameValue(nv, '=');
+
+        Member* child   = new Member;
+        child->parent   = member;
+        child->sequence = member->sequence;
+        child->row      = member->children.size();
+        child->name     = pair.first;
+        child->value    = pair.second;
+        child->parsed   = false;
+
+        member->children.append(child);
+    }
+}
+
+void SeerVariableLogModel::dropOldest () {
+
+    beginRemoveRows(QModelIndex(), 0, 0);
+
+    delete _members.take(_firstSequence);
+
+    _values[_head] = QString();
+    _head = (_head + 1) % _times.size();
+    _count--;
+    _firstSequence++;
+
+    endRemoveRows();
+}
+
+void SeerVariableLogModel::linearize (int keep) {
+
+    // Keep the newest 'keep' samples, oldest first, starting at slot 0.
+    int drop = _count - keep;
+
+    QVector<qint64>  times(keep);
+    QVector<int>     names(keep);
+    QVector<QString> values(keep);
+
+    for (int i=0; i<keep; i++) {
+
+        int s = slot(drop + i);
+
+        times[i]  = _times[s];
+        names[i]  = _names[s];
+        values[i] = _values[s];
+    }
+
+    for (int i=0; i<drop; i++) {
+        delete _members.take(_firstSequence + quint32(i));
+    }
+
+    _times          = times;
+    _names          = names;
+    _values         = values;
+    _head           = 0;
+    _count          = keep;
+    _firstSequence += quint32(drop);
+}
+
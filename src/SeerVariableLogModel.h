@@ -0,0 +1,91 @@
+#pragma once
+
+#include <QtCore/QAbstractItemModel>
+#include <QtCore/QModelIndex>
+#include <QtCore/QVariant>
+#include <QtCore/QVector>
+#include <QtCore/QHash>
+#include <QtCore/QList>
+#include <QtCore/QStringList>
+#include <QtCore/QString>
+
+//
+// The values logged by the variable logger.
+//
+// Kept in columns, in a ring buffer: when a sample's time, which expression it is
+// for, and its value. Expressions are stored once and referred to by index. At
+// 'capacity' samples, each new one drops the oldest.
+//
+// A sample is added when its expression is sent to gdb, and its value is filled
+// in when gdb answers. Struct values are shown as a tree. The members are only
+// parsed when the sample is expanded, and are let go when it is dropped.
+//
+class SeerVariableLogModel : public QAbstractItemModel {
+
+    Q_OBJECT
+
+    public:
+        explicit SeerVariableLogModel (QObject* parent = 0);
+       ~SeerVariableLogModel ();
+
+        QModelIndex                         index                   (int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+        QModelIndex                         parent                  (const QModelIndex& index) const override;
+        int                                 rowCount                (const QModelIndex& parent = QModelIndex()) const override;
+        int                                 columnCount             (const QModelIndex& parent = QModelIndex()) const override;
+        bool                                hasChildren             (const QModelIndex& parent = QModelIndex()) const override;
+        QVariant                            data                    (const QModelIndex& index, int role = Qt::DisplayRole) const override;
+        QVariant                            headerData              (int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+        void                                addSample               (int id, const QString& expression);
+        bool                                setSampleValue          (int id, const QString& value);
+        bool                                setSampleError          (int id, const QString& message);
+        bool                                isPending               (int id) const;
+        void                                removeSamples           (QList<int> rows);
+        void                                clear                   ();
+
+        void                                setCapacity             (int samples);
+        int                                 capacity                () const;
+
+        qint64                              sampleTime              (int row) const;
+        QString                             sampleName              (int row) const;
+        QString                             sampleValue             (int row) const;
+        bool                                sampleIsError           (int row) const;
+        int                                 sampleRow               (const QModelIndex& index) const;
+        QString                             memberName              (const QModelIndex& index) const;
+
+        static QString                      displayValue            (const QString& value);
+
+    private:
+        struct Member {
+                                           ~Member                  ();
+
+            Member*                         parent;
+            quint32                         sequence;               // The sample the member is of.
+            int                             row;
+            QString                         name;
+            QString                         value;                  // As gdb sent it.
+            QVector<Member*>                children;
+            bool                            parsed;
+        };
+
+        int                                 slot                    (int row) const;
+        Member*                             root                    (int row) const;
+        void                                parse                   (Member* member) const;
+        void                                dropOldest              ();
+        void                                linearize               (int keep);
+
+        QVector<qint64>                     _times;                 // Milliseconds since the epoch.
+        QVector<int>                        _names;                 // Index into _nameTable. -1 for an error.
+        QVector<QString>                    _values;                // The value, or the error message.
+        int                                 _head;                  // Slot of the oldest sample.
+        int                                 _count;
+        int                                 _capacity;
+        quint32                             _firstSequence;         // Sequence number of the oldest sample.
+
+        QStringList                         _nameTable;
+        QHash<QString,int>                  _nameIndex;
+        QHash<int,quint32>                  _pending;               // Expression id to the sample waiting for it.
+
+        mutable QHash<quint32,Member*>      _members;               // Parsed struct members, by sample.
+};
+
@@ -1,12 +1,21 @@
 #include "SeerVariableLoggerBrowserWidget.h"
 #include "SeerUtl.h"
-#include <QtWidgets/QTreeWidget>
-#include <QtWidgets/QTreeWidgetItemIterator>
+#include "QZoomChartView.h"
+#include <QtWidgets/QTreeView>
+#include <QtWidgets/QHeaderView>
 #include <QtWidgets/QApplication>
 #include <QtWidgets/QMenu>
-#include <QtGui/QFontDatabase>
+#include <QtWidgets/QFileDialog>
+#include <QtWidgets/QMessageBox>
 #include <QtGui/QClipboard>
-#include <QtCore/QTime>
+#include <QtCharts/QChart>
+#include <QtCharts/QLineSeries>
+#include <QtCharts/QValueAxis>
+#include <QtCore/QFile>
+#include <QtCore/QTextStream>
+#include <QtCore/QDateTime>
+#include <QtCore/QHash>
+#include <QtCore/QSettings>
 #include <QtCore/QDebug>
 #include <QAction>
 
@@ -15,27 +24,31 @@ SeerVariableLoggerBrowserWidget::SeerVariableLoggerBrowserWidget (QWidget* paren
     // Construct the UI.
     setupUi(this);
 
+    _logModel = new SeerVariableLogModel(this);
+
     // Setup the widgets
-    variablesTreeWidget->setMouseTracking(true);
-    variablesTreeWidget->setSortingEnabled(false);
-    variablesTreeWidget->setContextMenuPolicy(Qt::CustomContextMenu);
-    variablesTreeWidget->setSelectionMode(QAbstractItemView::ExtendedSelection);
-    variablesTreeWidget->resizeColumnToContents(0); // timestamp
-    variablesTreeWidget->resizeColumnToContents(1); // name
-    variablesTreeWidget->resizeColumnToContents(2); // value
-    variablesTreeWidget->resizeColumnToContents(3); // id
-    variablesTreeWidget->setColumnHidden(3, true);  // Hide the 'id' column.
-    variablesTreeWidget->clear();
+    variablesTreeView->setModel(_logModel);
+    variablesTreeView->setMouseTracking(true);
+    variablesTreeView->setSortingEnabled(false);
+    variablesTreeView->setUniformRowHeights(true);
+    variablesTreeView->setContextMenuPolicy(Qt::CustomContextMenu);
+    variablesTreeView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+    variablesTreeView->setSelectionBehavior(QAbstractItemView::SelectRows);
+
+    resizeColumns();
 
     // Connect things.
-    QObject::connect(this,                           &SeerVariableLoggerBrowserWidget::evaluateVariableExpression,      this, &SeerVariableLoggerBrowserWidget::handleEvaluateVariableExpression);
     QObject::connect(variableAddLineEdit,            &QLineEdit::returnPressed,                                         this, &SeerVariableLoggerBrowserWidget::handleAddLineEdit);
     QObject::connect(variableDeleteToolButton,       &QToolButton::clicked,                                             this, &SeerVariableLoggerBrowserWidget::handleDeleteToolButton);
     QObject::connect(variableDeleteAllToolButton,    &QToolButton::clicked,                                             this, &SeerVariableLoggerBrowserWidget::handleDeleteAllToolButton);
-    QObject::connect(variablesTreeWidget,            &QTreeWidget::itemCollapsed,                                       this, &SeerVariableLoggerBrowserWidget::handleItemCollapsed);
-    QObject::connect(variablesTreeWidget,            &QTreeWidget::itemExpanded,                                        this, &SeerVariableLoggerBrowserWidget::handleItemExpanded);
-    QObject::connect(variablesTreeWidget,            &QTreeWidget::itemEntered,                                         this, &SeerVariableLoggerBrowserWidget::handleItemEntered);
-    QObject::connect(variablesTreeWidget,            &QTreeWidget::customContextMenuRequested,                          this, &SeerVariableLoggerBrowserWidget::handleContextMenu);
+    QObject::connect(variableExportToolButton,       &QToolButton::clicked,                                             this, &SeerVariableLoggerBrowserWidget::handleExportToolButton);
+    QObject::connect(variablePlotToolButton,         &QToolButton::clicked,                                             this, &SeerVariableLoggerBrowserWidget::handlePlotToolButton);
+    QObject::connect(variablesTreeView,              &QTreeView::collapsed,                                             this, &SeerVariableLoggerBrowserWidget::handleItemCollapsed);
+    QObject::connect(variablesTreeView,              &QTreeView::expanded,                                              this, &SeerVariableLoggerBrowserWidget::handleItemExpanded);
+    QObject::connect(variablesTreeView,              &QTreeView::customContextMenuRequested,                            this, &SeerVariableLoggerBrowserWidget::handleContextMenu);
+
+    // Restore settings.
+    readSettings();
 }
 
 SeerVariableLoggerBrowserWidget::~SeerVariableLoggerBrowserWidget () {
@@ -43,8 +56,6 @@ SeerVariableLoggerBrowserWidget::~SeerVariableLoggerBrowserWidget () {
 
 void SeerVariableLoggerBrowserWidget::handleText (const QString& text) {
 
-    QApplication::setOverrideCursor(Qt::BusyCursor);
-
     if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
 
         // "6^done,value=\"\\\"abc\\\"\""
@@ -52,26 +63,11 @@ void SeerVariableLoggerBrowserWidget::handleText (const QString& text) {
         QString id_text    = text.section('^', 0,0);
         QString value_text = Seer::parseFirst(text, "value=", '"', '"', false);
 
-        if (_ids.contains(id_text.toInt()) == false) {
-            QApplication::restoreOverrideCursor();
+        // Not one of ours.
+        if (_logModel->setSampleValue(id_text.toInt(), value_text) == false) {
             return;
         }
 
-        QList<QTreeWidgetItem*> matches = variablesTreeWidget->findItems(id_text, Qt::MatchExactly, 3);
-
-        if (matches.size() > 0) {
-
-            QTreeWidgetItem* match = matches[0];
-
-            Q_ASSERT(match->parent() == NULL);
-
-            QString timestamp_text = match->text(0);
-            QString name_text      = match->text(1);
-
-            // Populate the tree.
-            handleItemCreate(match, id_text, timestamp_text, name_text, value_text);
-        }
-
     }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
 
         // "1^error,msg=\"No symbol \\\"j\\\" in current context.\""
@@ -79,60 +75,23 @@ void SeerVariableLoggerBrowserWidget::handleText (const QString& text) {
         QString id_text  = text.section('^', 0,0);
         QString msg_text = Seer::parseFirst(text, "msg=", '"', '"', false);
 
-        if (_ids.contains(id_text.toInt()) == true) {
-
-            QList<QTreeWidgetItem*> matches = variablesTreeWidget->findItems(id_text, Qt::MatchExactly, 3);
-
-            if (matches.size() > 0) {
-                matches.first()->setText(1, ""); // Overwrite "name" with "" because it's not a valid "name".
-                matches.first()->setText(2, Seer::filterEscapes(msg_text));
-            }
+        if (_logModel->setSampleError(id_text.toInt(), msg_text) == false) {
+            return;
         }
 
     }else if (text.startsWith("^error,msg=\"No registers.\"")) {
 
-        variablesTreeWidget->clear();
+        _logModel->clear();
 
     }else{
         // Ignore others.
-    }
-
-    // Resize columns.
-    variablesTreeWidget->resizeColumnToContents(0);
-    variablesTreeWidget->resizeColumnToContents(1);
-    variablesTreeWidget->resizeColumnToContents(2);
-    variablesTreeWidget->resizeColumnToContents(3);
-
-    // Scroll to the bottom.
-    QTreeWidgetItem* lastItem = variablesTreeWidget->topLevelItem(variablesTreeWidget->topLevelItemCount()-1);
-    if (lastItem) {
-        variablesTreeWidget->scrollToItem(lastItem);
-    }
-
-    // Set the cursor back.
-    QApplication::restoreOverrideCursor();
-}
-
-void SeerVariableLoggerBrowserWidget::handleEvaluateVariableExpression (int expressionid, QString expression) {
-
-    QString id_text = QString::number(expressionid);
-
-    if (_ids.contains(id_text.toInt()) == false) {
         return;
     }
 
-    // Add new item. Will be filled in by handleText().
-    QTreeWidgetItem* item = new QTreeWidgetItem;
-    item->setText(0, QTime::currentTime().toString(Qt::TextDate));
-    item->setText(1, expression);
-    item->setText(2, "");
-    item->setText(3, id_text);
-
-    item->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
-
-    variablesTreeWidget->addTopLevelItem(item);
+    resizeColumns();
 
-    // Resize columns done later in handleText().
+    // Scroll to the bottom.
+    variablesTreeView->scrollToBottom();
 }
 
 void SeerVariableLoggerBrowserWidget::addVariableExpression (QString expression) {
@@ -141,7 +100,8 @@ void SeerVariableLoggerBrowserWidget::addVariableExpression (QString expression)
 
         int id = Seer::createID();
 
-        _ids.insert(id); // Keep track of which ones are entered.
+        // Keep track of which ones are entered.
+        _logModel->addSample(id, expression);
 
         emit evaluateVariableExpression(id, expression);
     }
@@ -153,121 +113,187 @@ void SeerVariableLoggerBrowserWidget::handleAddLineEdit () {
 
     variableAddLineEdit->clear();
 
-    if (expression != "") {
-
-        int id = Seer::createID();
-
-        _ids.insert(id); // Keep track of which ones are entered.
-
-        emit evaluateVariableExpression(id, expression);
-    }
+    addVariableExpression(expression);
 }
 
 void SeerVariableLoggerBrowserWidget::handleDeleteToolButton () {
 
-    // Get selected tree items.
-    QList<QTreeWidgetItem*> items = variablesTreeWidget->selectedItems();
+    // Get the selected samples. Selecting a member selects its sample.
+    QModelIndexList indexes = variablesTreeView->selectionModel()->selectedRows();
+    QList<int>      rows;
 
-    // Remove them.
-    for(int i=0; i<items.size(); i++){
-        delete items[i];
+    for (int i=0; i<indexes.size(); i++) {
+        rows.append(_logModel->sampleRow(indexes[i]));
     }
 
-    // Resize columns.
-    variablesTreeWidget->resizeColumnToContents(0);
-    variablesTreeWidget->resizeColumnToContents(1);
-    variablesTreeWidget->resizeColumnToContents(2);
-    variablesTreeWidget->resizeColumnToContents(3);
+    // Remove them.
+    _logModel->removeSamples(rows);
+
+    resizeColumns();
 }
 
 void SeerVariableLoggerBrowserWidget::handleDeleteAllToolButton () {
 
     // Remove all.
-    variablesTreeWidget->clear();
+    _logModel->clear();
 
-    // Resize columns.
-    variablesTreeWidget->resizeColumnToContents(0);
-    variablesTreeWidget->resizeColumnToContents(1);
-    variablesTreeWidget->resizeColumnToContents(2);
-    variablesTreeWidget->resizeColumnToContents(3);
+    resizeColumns();
 }
 
-void SeerVariableLoggerBrowserWidget::handleItemExpanded (QTreeWidgetItem* item) {
+void SeerVariableLoggerBrowserWidget::handleExportToolButton () {
+
+    if (_logModel->rowCount() == 0) {
+        return;
+    }
+
+    QString fname = QFileDialog::getSaveFileName(this, "Export the logged values.", "seergdb-variables.csv", "CSV files (*.csv);;All files (*.*)", nullptr, QFileDialog::DontUseNativeDialog);
 
-    Q_UNUSED(item);
+    if (fname == "") {
+        return;
+    }
 
-    variablesTreeWidget->resizeColumnToContents(0);
-    variablesTreeWidget->resizeColumnToContents(1);
-    variablesTreeWidget->resizeColumnToContents(2);
-    variablesTreeWidget->resizeColumnToContents(3);
-}
+    QFile file(fname);
 
-void SeerVariableLoggerBrowserWidget::handleItemCollapsed (QTreeWidgetItem* item) {
+    if (file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text) == false) {
+        QMessageBox::warning(this, "Seer", QString("Can't write '%1'.\n\n%2").arg(fname).arg(file.errorString()), QMessageBox::Ok);
+        return;
+    }
 
-    Q_UNUSED(item);
+    QTextStream stream(&file);
 
-    variablesTreeWidget->resizeColumnToContents(0);
-    variablesTreeWidget->resizeColumnToContents(1);
-    variablesTreeWidget->resizeColumnToContents(2);
-    variablesTreeWidget->resizeColumnToContents(3);
-}
+    // Quote each field. Double any quotes in it.
+    auto csv = [](const QString& field) {
+        return "\"" + QString(field).replace("\"", "\"\"") + "\"";
+    };
 
-void SeerVariableLoggerBrowserWidget::handleItemEntered (QTreeWidgetItem* item, int column) {
+    stream << "timestamp,name,value\n";
 
-    Q_UNUSED(column);
+    for (int row=0; row<_logModel->rowCount(); row++) {
 
-    item->setToolTip(0, item->text(0) + " : " + item->text(1) + " : " + Seer::elideText(item->text(2), Qt::ElideRight, 100));
+        QString time_text = QDateTime::fromMSecsSinceEpoch(_logModel->sampleTime(row)).toString(Qt::ISODateWithMs);
 
-    for (int i=1; i<variablesTreeWidget->columnCount(); i++) { // Copy tooltip to other columns.
-        item->setToolTip(i, item->toolTip(0));
+        stream << csv(time_text) << ',' << csv(_logModel->sampleName(row)) << ',' << csv(SeerVariableLogModel::displayValue(_logModel->sampleValue(row))) << '\n';
     }
 }
 
-void SeerVariableLoggerBrowserWidget::handleItemCreate (QTreeWidgetItem* parentItem, const QString& id_text, const QString& timestamp_text, const QString& name_text, const QString& value_text) {
+void SeerVariableLoggerBrowserWidget::handlePlotToolButton () {
 
-    // Add the complex entry to the tree.
-    if (Seer::hasBookends(value_text, '{', '}')) {
+    // Plot the selected expressions. Or all of them, if none are selected.
+    QModelIndexList indexes = variablesTreeView->selectionModel()->selectedRows();
+    QStringList     names;
 
-        // Remove bookends
-        QString text = Seer::filterBookends(value_text, '{', '}');
+    for (int i=0; i<indexes.size(); i++) {
 
-        // Set the flatvalue text.
-        parentItem->setText(0, timestamp_text);
-        parentItem->setText(1, name_text);
-        parentItem->setText(2, Seer::filterEscapes(text));
-        parentItem->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
-        parentItem->setText(3, id_text);
+        QString name = _logModel->sampleName(_logModel->sampleRow(indexes[i]));
 
-        // Convert to a list of name/value pairs.
-        QStringList nv_pairs = Seer::parseCommaList(text, '{', '}');
+        if (name != "" && names.contains(name) == false) {
+            names.append(name);
+        }
+    }
 
-        // Go through each pair and add the name and its value to the tree.
-        for (const auto& nv : nv_pairs) {
+    //
+    // One line per expression. X is seconds since the first sample. Values that
+    // aren't numbers (structs, strings, errors) are skipped. A char's "65 'A'" plots as 65.
+    //
+    QHash<QString,QLineSeries*> series;
+    qint64                      start = (_logModel->rowCount() > 0 ? _logModel->sampleTime(0) : 0);
 
-            QStringPair pair = Seer::parseNameValue(nv, '=');
+    for (int row=0; row<_logModel->rowCount(); row++) {
 
-            // Create a new item and attach it to the parent.
-            QTreeWidgetItem* item = new QTreeWidgetItem;
+        if (_logModel->sampleIsError(row)) {
+            continue;
+        }
 
-            handleItemCreate(item, id_text, timestamp_text, pair.first, pair.second);
+        QString name = _logModel->sampleName(row);
 
-            parentItem->addChild(item);
+        if (names.size() > 0 && names.contains(name) == false) {
+            continue;
         }
 
-    // Add the simple entry to the tree.
-    }else{
-        parentItem->setText(0, timestamp_text);
-        parentItem->setText(1, name_text);
-        parentItem->setText(2, Seer::filterEscapes(value_text));
-        parentItem->setFont(2, QFontDatabase::systemFont(QFontDatabase::FixedFont));
-        parentItem->setText(3, id_text);
+        bool   ok    = false;
+        double value = _logModel->sampleValue(row).section(' ', 0, 0).toDouble(&ok);
+
+        if (ok == false) {
+            continue;
+        }
+
+        QLineSeries* line = series.value(name, 0);
+
+        if (line == 0) {
+            line = new QLineSeries;
+            line->setName(name);
+            line->setPointsVisible(true);
+
+            series.insert(name, line);
+        }
+
+        line->append((_logModel->sampleTime(row) - start) / 1000.0, value);
+    }
+
+    if (series.size() == 0) {
+        QMessageBox::information(this, "Seer", "There are no numeric values to plot.", QMessageBox::Ok);
+        return;
+    }
+
+    QChart* chart = new QChart;
+    chart->setTitle("Logged values");
+    chart->legend()->setVisible(true);
+
+    for (QLineSeries* line : series) {
+        chart->addSeries(line);
+    }
+
+    chart->createDefaultAxes();
+
+    QList<QAbstractAxis*> axes = chart->axes(Qt::Horizontal);
+
+    if (axes.size() > 0) {
+        axes[0]->setTitleText("Seconds");
     }
+
+    QZoomChartView* view = new QZoomChartView(chart);
+    view->setAttribute(Qt::WA_DeleteOnClose);
+    view->setRenderHint(QPainter::Antialiasing);
+    view->setFocusPolicy(Qt::StrongFocus);
+    view->setWindowTitle("Seer - Variable Logger Plot");
+    view->resize(800, 500);
+    view->show();
+}
+
+void SeerVariableLoggerBrowserWidget::handleItemExpanded (const QModelIndex& index) {
+
+    Q_UNUSED(index);
+
+    resizeColumns();
+}
+
+void SeerVariableLoggerBrowserWidget::handleItemCollapsed (const QModelIndex& index) {
+
+    Q_UNUSED(index);
+
+    resizeColumns();
+}
+
+void SeerVariableLoggerBrowserWidget::resizeColumns () {
+
+    variablesTreeView->resizeColumnToContents(0);
+    variablesTreeView->resizeColumnToContents(1);
+    variablesTreeView->resizeColumnToContents(2);
+}
+
+void SeerVariableLoggerBrowserWidget::readSettings () {
+
+    QSettings settings;
+
+    settings.beginGroup("variableloggerwindow"); {
+        _logModel->setCapacity(settings.value("capacity", 100000).toInt());
+    } settings.endGroup();
 }
 
 void SeerVariableLoggerBrowserWidget::handleContextMenu (const QPoint& pos) {
 
     // Get the item at the cursor.
-    QTreeWidgetItem* item = variablesTreeWidget->itemAt(pos);
+    QModelIndex index = variablesTreeView->indexAt(pos);
 
     // Construct the menu.
     QAction* addMemoryVisualizerAction           = new QAction();
@@ -304,20 +330,12 @@ void SeerVariableLoggerBrowserWidget::handleContextMenu (const QPoint& pos) {
     QAction* copyAllAction = menu.addAction("Copy all");
 
     QString actionText;
-    if (item != 0) {
-        actionText = item->text(1);
+    if (index.isValid()) {
+        actionText = index.sibling(index.row(), 1).data().toString();
     }
 
-    QString variable;
-    if (item != 0) {
-        // Build up a variable string, incase it is a nested struct.
-        QTreeWidgetItem* i = item;
-        variable = item->text(1);
-        while (i->parent() != 0) {
-            variable = i->parent()->text(1) + "." + variable;
-            i = i->parent();
-        }
-    }
+    // Build up a variable string, incase it is a nested struct.
+    QString variable = _logModel->memberName(index);
 
     addMemoryVisualizerAction->setText(QString("\"%1\"").arg(actionText));
     addMemoryAsteriskVisualizerAction->setText(QString("\"*%1\"").arg(actionText));
@@ -331,7 +349,7 @@ void SeerVariableLoggerBrowserWidget::handleContextMenu (const QPoint& pos) {
 
 
     // If no selected item, disable everything but allow 'copyall'.
-    if (item == 0) {
+    if (index.isValid() == false) {
         memoryVisualizerMenu.setEnabled(false);
         arrayVisualizerMenu.setEnabled(false);
         structVisualizerMenu.setEnabled(false);
@@ -339,44 +357,51 @@ void SeerVariableLoggerBrowserWidget::handleContextMenu (const QPoint& pos) {
     }
 
     // Execute the menu. Return if nothing.
-    QAction* action = menu.exec(variablesTreeWidget->mapToGlobal(pos));
+    QAction* action = menu.exec(variablesTreeView->mapToGlobal(pos));
 
     if (action == 0) {
         return;
     }
 
-    if (action == copyAction || action == copyAction) {
-        // Get selected tree items.
-        QList<QTreeWidgetItem*> items;
+    if (action == copyAction || action == copyAllAction) {
+
+        QString text;
 
         // Get list of 'select' items.
         if (action == copyAction) {
-            items = variablesTreeWidget->selectedItems();
+
+            QModelIndexList indexes = variablesTreeView->selectionModel()->selectedRows();
+
+            for (int i=0; i<indexes.size(); i++) {
+
+                if (i != 0) {
+                    text += '\n';
+                }
+
+                text += indexes[i].sibling(indexes[i].row(), 1).data().toString() + ":" + indexes[i].sibling(indexes[i].row(), 2).data().toString();
+            }
         }
 
         // Get list of 'all' items.
         if (action == copyAllAction) {
-            items = variablesTreeWidget->findItems(QString("*"), Qt::MatchWrap | Qt::MatchWildcard);
+
+            for (int row=0; row<_logModel->rowCount(); row++) {
+
+                if (row != 0) {
+                    text += '\n';
+                }
+
+                text += _logModel->sampleName(row) + ":" + SeerVariableLogModel::displayValue(_logModel->sampleValue(row));
+            }
         }
 
         // Populate the clipboard.
-        if (items.size() == 0) {
+        if (text == "") {
             return;
         }
 
         QClipboard* clipboard = QGuiApplication::clipboard();
 
-        QString text;
-
-        for (int i=0; i<items.size(); i++) {
-
-            if (i != 0) {
-                text += '\n';
-            }
-
-            text += items[i]->text(1) + ":" + items[i]->text(2);
-        }
-
         clipboard->setText(text, QClipboard::Clipboard);
         clipboard->setText(text, QClipboard::Selection);
     }
@@ -1,8 +1,9 @@
 #pragma once
 
+#include "SeerVariableLogModel.h"
 #include <QtWidgets/QWidget>
+#include <QtCore/QModelIndex>
 #include <QtCore/QString>
-#include <QtCore/QSet>
 #include "ui_SeerVariableLoggerBrowserWidget.h"
 
 class SeerVariableLoggerBrowserWidget : public QWidget, protected Ui::SeerVariableLoggerBrowserWidgetForm {
@@ -15,16 +16,16 @@ class SeerVariableLoggerBrowserWidget : public QWidget, protected Ui::SeerVariab
 
     public slots:
         void                handleText                          (const QString& text);
-        void                handleEvaluateVariableExpression    (int expressionid, QString expression);
         void                addVariableExpression               (QString expression);
 
     private slots:
         void                handleAddLineEdit                   ();
         void                handleDeleteToolButton              ();
         void                handleDeleteAllToolButton           ();
-        void                handleItemEntered                   (QTreeWidgetItem* item, int column);
-        void                handleItemExpanded                  (QTreeWidgetItem* item);
-        void                handleItemCollapsed                 (QTreeWidgetItem* item);
+        void                handleExportToolButton              ();
+        void                handlePlotToolButton                ();
+        void                handleItemExpanded                  (const QModelIndex& index);
+        void                handleItemCollapsed                 (const QModelIndex& index);
         void                handleContextMenu                   (const QPoint& pos);
 
     signals:
@@ -34,10 +35,11 @@ class SeerVariableLoggerBrowserWidget : public QWidget, protected Ui::SeerVariab
         void                addStructVisualize                  (QString expression);
 
     protected:
-        void                handleItemCreate                    (QTreeWidgetItem* parentItem, const QString& id_text, const QString& timestamp_text, const QString& name_text, const QString& value_text);
+        void                readSettings                        ();
+        void                resizeColumns                       ();
 
     private:
-        QSet<int>           _ids;
+        SeerVariableLogModel*   _logModel;
 
 };
 
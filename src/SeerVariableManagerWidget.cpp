@@ -20,10 +20,12 @@ SeerVariableManagerWidget::SeerVariableManagerWidget (QWidget* parent) : QWidget
     _variableLoggerBrowserWidget  = new SeerVariableLoggerBrowserWidget(this);
     _variableTrackerBrowserWidget = new SeerVariableTrackerBrowserWidget(this);
     _registerValuesBrowserWidget  = new SeerRegisterValuesBrowserWidget(this);
+    _varObjBrowserWidget          = new SeerVarObjBrowserWidget(this);
 
     tabWidget->addTab(_variableLoggerBrowserWidget,  "Logger");
     tabWidget->addTab(_variableTrackerBrowserWidget, "Tracker");
     tabWidget->addTab(_registerValuesBrowserWidget,  "Registers");
+    tabWidget->addTab(_varObjBrowserWidget,          "VarObjs");
 
     QToolButton* refreshToolButton = new QToolButton(tabWidget);
     refreshToolButton->setIcon(QIcon(":/seer/resources/RelaxLightIcons/view-refresh.svg"));
@@ -65,10 +67,15 @@ SeerRegisterValuesBrowserWidget* SeerVariableManagerWidget::registerValuesBrowse
     return _registerValuesBrowserWidget;
 }
 
+SeerVarObjBrowserWidget* SeerVariableManagerWidget::varObjBrowserWidget () {
+    return _varObjBrowserWidget;
+}
+
 void SeerVariableManagerWidget::handleRefreshToolButtonClicked () {
 
     variableTrackerBrowserWidget()->refresh();
     registerValuesBrowserWidget()->refresh();
+    varObjBrowserWidget()->refresh();
 }
 
 void SeerVariableManagerWidget::handleHelpToolButtonClicked () {
@@ -3,6 +3,7 @@
 #include "SeerVariableTrackerBrowserWidget.h"
 #include "SeerVariableLoggerBrowserWidget.h"
 #include "SeerRegisterValuesBrowserWidget.h"
+#include "SeerVarObjBrowserWidget.h"
 
 #include <QtWidgets/QWidget>
 
@@ -19,6 +20,7 @@ class SeerVariableManagerWidget : public QWidget, protected Ui::SeerVariableMana
         SeerVariableTrackerBrowserWidget*               variableTrackerBrowserWidget        ();
         SeerVariableLoggerBrowserWidget*                variableLoggerBrowserWidget           ();
         SeerRegisterValuesBrowserWidget*                registerValuesBrowserWidget         ();
+        SeerVarObjBrowserWidget*                        varObjBrowserWidget                 ();
 
     protected:
         void                                            writeSettings                       ();
@@ -34,5 +36,6 @@ class SeerVariableManagerWidget : public QWidget, protected Ui::SeerVariableMana
         SeerVariableTrackerBrowserWidget*               _variableTrackerBrowserWidget;
         SeerVariableLoggerBrowserWidget*                _variableLoggerBrowserWidget;
         SeerRegisterValuesBrowserWidget*                _registerValuesBrowserWidget;
+        SeerVarObjBrowserWidget*                        _varObjBrowserWidget;
 };
 
@@ -7,6 +7,7 @@
 #include <QtGui/QFontDatabase>
 #include <QtGui/QClipboard>
 #include <QtCore/QTimer>
+#include <QtCore/QRegularExpression>
 #include <QtCore/QDebug>
 #include <iostream>
 
@@ -28,6 +29,8 @@ SeerVariableTrackerBrowserWidget::SeerVariableTrackerBrowserWidget (QWidget* par
     variablesTreeWidget->setColumnHidden(3, true);  // Hide the 'used' column.
     variablesTreeWidget->clear();
 
+    _updateId = Seer::createID();
+
     // Connect things.
     QObject::connect(variableAddLineEdit,            &QLineEdit::returnPressed,                     this, &SeerVariableTrackerBrowserWidget::handleAddLineEdit);
     QObject::connect(variableDeleteToolButton,       &QToolButton::clicked,                         this, &SeerVariableTrackerBrowserWidget::handleDeleteToolButton);
@@ -43,6 +46,109 @@ SeerVariableTrackerBrowserWidget::~SeerVariableTrackerBrowserWidget () {
 
 void SeerVariableTrackerBrowserWidget::handleText (const QString& text) {
 
+    static const QRegularExpression id_re("^([0-9]+)\\^");
+
+    //
+    // Where the program stopped. The expressions gdb couldn't make a varobj for
+    // are only tried again when it stops in another function or thread.
+    //
+    // "*stopped,reason=\"end-stepping-range\",frame={addr=\"0x...\",func=\"main\",...},thread-id=\"1\",..."
+    //
+    if (text.startsWith("*stopped")) {
+
+        QString frame_text    = Seer::parseFirst(text,       "frame=",     '{', '}', false);
+        QString func_text     = Seer::parseFirst(frame_text, "func=",      '"', '"', false);
+        QString threadid_text = Seer::parseFirst(text,       "thread-id=", '"', '"', false);
+        QString scope         = threadid_text + ":" + func_text;
+
+        if (scope != _stopScope) {
+            _stopScope = scope;
+            retryVarObjs();
+        }
+
+        return;
+    }
+
+    //
+    // Replies to creating a varobj and listing its children. Take them even
+    // when hidden, so a varobj isn't left half made.
+    //
+    QRegularExpressionMatch id_match = id_re.match(text);
+
+    if (id_match.hasMatch() && _pendingVarObjs.contains(id_match.captured(1).toInt())) {
+
+        int              id   = id_match.captured(1).toInt();
+        QTreeWidgetItem* item = _idItems.value(id, 0);
+
+        _pendingVarObjs.remove(id);
+
+        if (text.startsWith(QString::number(id) + "^done,name=")) {
+
+            // "5^done,name=\"seertrack5\",numchild=\"0\",value=\"42\",type=\"int\",thread-id=\"1\",has_more=\"0\""
+            QString name_text     = Seer::parseFirst(text, "name=",     '"', '"', false);
+            QString numchild_text = Seer::parseFirst(text, "numchild=", '"', '"', false);
+            QString value_text    = Seer::parseFirst(text, "value=",    '"', '"', false);
+
+            _varObjs.insert(id);
+
+            if (item != 0) {
+
+                forgetChildren(item);
+
+                // A struct's varobj only says "{...}". Its members are the varobj's children.
+                if (numchild_text.toInt() > 0) {
+                    _composites.insert(id);
+
+                    item->setText(1, Seer::filterEscapes(value_text));
+                    item->setText(3, "reused");
+
+                    listChildren(name_text);
+
+                }else{
+                    _composites.remove(id);
+
+                    handleItemCreate(item, value_text);
+                }
+            }
+
+        }else if (text.startsWith(QString::number(id) + "^error,msg=")) {
+
+            // Not valid here. Tried again in another frame or function. See retryVarObjs().
+            _failedVarObjs.insert(id);
+
+            if (item != 0) {
+
+                QString msg_text = Seer::parseFirst(text, "msg=", '"', '"', false);
+
+                forgetChildren(item);
+
+                item->setText(1, Seer::filterEscapes(msg_text));
+                item->setText(3, "used");
+            }
+        }
+
+        variablesTreeWidget->resizeColumnToContents(1);
+
+        return;
+    }
+
+    if (id_match.hasMatch() && _listIds.contains(id_match.captured(1).toInt())) {
+
+        int              id      = id_match.captured(1).toInt();
+        QString          objname = _listIds.take(id);
+        QTreeWidgetItem* item    = varObjItem(objname);
+
+        // An error leaves the item as it is.
+        if (item != 0 && text.startsWith(QString::number(id) + "^done,numchild=")) {
+            setChildren(item, text);
+        }
+
+        variablesTreeWidget->resizeColumnToContents(0);
+        variablesTreeWidget->resizeColumnToContents(1);
+
+        return;
+    }
+
     // Don't do any work if the widget is hidden.
     if (isHidden()) {
         return;
@@ -69,19 +175,7 @@ void SeerVariableTrackerBrowserWidget::handleText (const QString& text) {
             QString id_text         = Seer::parseFirst(entry_text, "id=",         '"', '"', false);
             QString expression_text = Seer::parseFirst(entry_text, "expression=", '"', '"', false);
 
-            QList<QTreeWidgetItem*> matches = variablesTreeWidget->findItems(id_text, Qt::MatchExactly, 2);
-
-            if (matches.count() == 0) {
-
-                QTreeWidgetItem* topItem = new QTreeWidgetItem;
-                topItem->setText(0, expression_text);
-                topItem->setText(1, "");
-                topItem->setFont(1, QFontDatabase::systemFont(QFontDatabase::FixedFont));
-                topItem->setText(2, id_text);
-                topItem->setText(3, "new");
-
-                variablesTreeWidget->addTopLevelItem(topItem);
-            }
+            addItem(id_text, expression_text);
         }
 
     }else if (text.startsWith("^done,DataExpressionAdded={") && text.endsWith("}")) {
@@ -95,19 +189,7 @@ void SeerVariableTrackerBrowserWidget::handleText (const QString& text) {
         QString id_text         = Seer::parseFirst(frame_text, "id=",                  '"', '"', false);
         QString expression_text = Seer::parseFirst(frame_text, "expression=",          '"', '"', false);
 
-        QList<QTreeWidgetItem*> matches = variablesTreeWidget->findItems(id_text, Qt::MatchExactly, 2);
-
-        if (matches.count() == 0) {
-
-            QTreeWidgetItem* topItem = new QTreeWidgetItem;
-            topItem->setText(0, expression_text);
-            topItem->setText(1, "");
-            topItem->setFont(1, QFontDatabase::systemFont(QFontDatabase::FixedFont));
-            topItem->setText(2, id_text);
-            topItem->setText(3, "new");
-
-            variablesTreeWidget->addTopLevelItem(topItem);
-        }
+        addItem(id_text, expression_text);
 
     }else if (text.startsWith("^done,DataExpressionDeleted={") && text.endsWith("}")) {
 
@@ -126,86 +208,149 @@ void SeerVariableTrackerBrowserWidget::handleText (const QString& text) {
             QString id_text         = Seer::parseFirst(entry_text, "id=",         '"', '"', false);
             QString expression_text = Seer::parseFirst(entry_text, "expression=", '"', '"', false);
 
-            QList<QTreeWidgetItem*> matches = variablesTreeWidget->findItems(id_text, Qt::MatchExactly, 2);
+            int id = id_text.toInt();
+
+            deleteVarObj(id);
+
+            _composites.remove(id);
+            _failedVarObjs.remove(id);
 
-            qDeleteAll(matches);
+            delete _idItems.take(id);
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^done,value="))) {
+    }else if (text.startsWith(QString::number(_updateId) + "^done,changelist=[")) {
 
-        // "6^done,value=\"\\\"abc\\\"\""
+        handleChangeList(text);
 
-        QString id_text    = text.section('^', 0,0);
-        QString value_text = Seer::parseFirst(text, "value=", '"', '"', false);
+    }else if (text.startsWith("^error,msg=\"No registers.\"")) {
 
-        // Find the ones that match our 'id'.
-        QList<QTreeWidgetItem*> matches = variablesTreeWidget->findItems(id_text, Qt::MatchExactly, 2);
+        // The program is gone. So are the values the varobjs had.
+        QList<int> ids = _varObjs.values();
 
-        if (matches.count() == 1) {
+        for (int i=0; i<ids.size(); i++) {
+            deleteVarObj(ids[i]);
+        }
 
-            Q_ASSERT(matches.count() == 1);
+        variablesTreeWidget->clear();
 
-            // There should be only one.
-            QTreeWidgetItem* item = matches[0];
+        _idItems.clear();
+        _varObjs.clear();
+        _pendingVarObjs.clear();
+        _failedVarObjs.clear();
+        _composites.clear();
+        _childItems.clear();
+        _childNames.clear();
+        _listIds.clear();
+        _stopScope = "";
 
-            // Mark each entry initially as "unused".
-            // Later, some will be marked as "reused" or "new". Then the "unused" ones will
-            // be deleted.
-            QTreeWidgetItemIterator itmark(item);
-            while (*itmark) {
-                (*itmark)->setText(3, "unused");
-                ++itmark;
-            }
+    }else{
+        // Ignore others.
+        QApplication::restoreOverrideCursor();
+        return;
+    }
 
-            // Set the value.
-            handleItemCreate (item, value_text);
+    variablesTreeWidget->resizeColumnToContents(0);
+    variablesTreeWidget->resizeColumnToContents(1);
+    variablesTreeWidget->resizeColumnToContents(2);
+    variablesTreeWidget->resizeColumnToContents(3);
 
-            // At this point, there are some new entries, some reused entries, and some unused ones.
-            // For now, don't bother deleting 'unused' ones.
+    QApplication::restoreOverrideCursor();
+}
+
+void SeerVariableTrackerBrowserWidget::handleChangeList (const QString& text) {
+
+    // "12^done,changelist=[{name=\"seertrack5\",value=\"43\",in_scope=\"true\",type_changed=\"false\",has_more=\"0\"},...]"
+    //
+    // The update was for all varobjs. Other widgets freeze theirs, so only ours are here.
+
+    QString     changelist_text = Seer::parseFirst(text,            "changelist=", '[', ']', false);
+    QStringList change_list     = Seer::parse(changelist_text,      "",            '{', '}', false);
+
+    for (const auto& change_text : change_list) {
+
+        QString name_text = Seer::parseFirst(change_text, "name=", '"', '"', false);
+
+        if (name_text.startsWith("seertrack") == false) {
+            continue;
         }
 
-    }else if (text.contains(QRegularExpression("^([0-9]+)\\^error,msg="))) {
+        QString value_text       = Seer::parseFirst(change_text, "value=",            '"', '"', false);
+        QString inscope_text     = Seer::parseFirst(change_text, "in_scope=",         '"', '"', false);
+        QString typechanged_text = Seer::parseFirst(change_text, "type_changed=",     '"', '"', false);
+        QString numchild_text    = Seer::parseFirst(change_text, "new_num_children=", '"', '"', false);
 
-        // "1^error,msg=\"No symbol \\\"j\\\" in current context.\""
+        // A member of a struct, listed before. "seertrack5.location.city"
+        if (name_text.contains('.')) {
 
-        QString id_text  = text.section('^', 0,0);
-        QString msg_text = Seer::parseFirst(text, "msg=", '"', '"', false);
+            QTreeWidgetItem* child = _childItems.value(name_text, 0);
 
-        // Find the ones that match our 'id'.
-        QList<QTreeWidgetItem*> matches = variablesTreeWidget->findItems(id_text, Qt::MatchExactly, 2);
+            if (child == 0) {
+                continue;
+            }
 
-        if (matches.count() == 1) {
+            // gdb dropped the children of a varobj whose type changed. Drop their items.
+            if (typechanged_text == "true") {
+                forgetChildren(child);
+                setPlaceholder(child, numchild_text.toInt());
+            }
 
-            // There should be only one.
-            QTreeWidgetItem* item = matches[0];
+            child->setText(1, Seer::filterEscapes(value_text));
 
-            // Remove any children.
-            QList<QTreeWidgetItem*> children = item->takeChildren();
+            continue;
+        }
 
-            qDeleteAll(children);
+        int              id   = name_text.mid(9).toInt();
+        QTreeWidgetItem* item = _idItems.value(id, 0);
 
-            // Set the text with the error message.
-            item->setText(1, Seer::filterEscapes(msg_text));
-            item->setText(3, "used");
+        if (item == 0) {
+            continue;
         }
 
-    }else if (text.startsWith("^error,msg=\"No registers.\"")) {
-        variablesTreeWidget->clear();
+        // Can't be evaluated where the program is now.
+        if (inscope_text == "false") {
+            forgetChildren(item);
+            item->setText(1, "<out of scope>");
+            continue;
+        }
 
-    }else{
-        // Ignore others.
-    }
+        // The program was restarted, or the like. Make the varobj again.
+        if (inscope_text == "invalid") {
+            deleteVarObj(id);
+            createVarObj(id);
+            continue;
+        }
 
-    variablesTreeWidget->resizeColumnToContents(0);
-    variablesTreeWidget->resizeColumnToContents(1);
-    variablesTreeWidget->resizeColumnToContents(2);
-    variablesTreeWidget->resizeColumnToContents(3);
+        if (typechanged_text == "true") {
 
-    QApplication::restoreOverrideCursor();
+            forgetChildren(item);
+
+            if (numchild_text.toInt() > 0) {
+                _composites.insert(id);
+            }else{
+                _composites.remove(id);
+            }
+        }
+
+        // A struct's members come from its children. They're listed again if it was out of scope.
+        if (_composites.contains(id)) {
+
+            item->setText(1, Seer::filterEscapes(value_text));
+
+            if (item->childCount() == 0) {
+                listChildren(name_text);
+            }
+
+            continue;
+        }
+
+        handleItemCreate(item, value_text);
+    }
 }
 
 void SeerVariableTrackerBrowserWidget::handleStoppingPointReached () {
 
+    _frameKey = "";
+
     // Don't do any work if the widget is hidden.
     if (isHidden()) {
         return;
@@ -214,13 +359,228 @@ void SeerVariableTrackerBrowserWidget::handleStoppingPointReached () {
     refresh();
 }
 
+void SeerVariableTrackerBrowserWidget::handleSelectedFrameChanged (int threadid, int frameno) {
+
+    QString key = QString::number(threadid) + ":" + QString::number(frameno);
+
+    // Just stopped here. The values are already being fetched.
+    if (_frameKey == "" || _frameKey == key) {
+        _frameKey = key;
+        return;
+    }
+
+    _frameKey = key;
+
+    // What failed in the old frame may be there in this one.
+    retryVarObjs();
+
+    // Don't do any work if the widget is hidden.
+    if (isHidden()) {
+        return;
+    }
+
+    // The expressions are the same. Their values are in the new frame's scope.
+    refreshValues();
+}
+
+void SeerVariableTrackerBrowserWidget::handleVarObjEvicted (QString objname) {
+
+    // gdb deleted the varobj to stay under the varobj limit. The next refresh makes it again.
+    if (objname.startsWith("seertrack") == false) {
+        return;
+    }
+
+    int              id   = objname.mid(9).toInt();
+    QTreeWidgetItem* item = _idItems.value(id, 0);
+
+    // Its children went with it.
+    if (item != 0) {
+        forgetChildren(item);
+    }
+
+    _varObjs.remove(id);
+    _composites.remove(id);
+}
+
 void SeerVariableTrackerBrowserWidget::refresh () {
     emit refreshVariableTrackerNames();
-    emit refreshVariableTrackerValues();
+    refreshValues();
 }
 
 void SeerVariableTrackerBrowserWidget::refreshValues () {
-    emit refreshVariableTrackerValues();
+
+    // Nothing is asked for while hidden. The first update after being shown
+    // reports everything that changed since the last one.
+    if (isHidden()) {
+        return;
+    }
+
+    // Make the varobjs that were evicted, or not made while hidden. Not the ones
+    // gdb couldn't make. They wait for another frame or function.
+    QHash<int,QTreeWidgetItem*>::const_iterator it;
+
+    for (it = _idItems.constBegin(); it != _idItems.constEnd(); ++it) {
+
+        if (_varObjs.contains(it.key()) || _pendingVarObjs.contains(it.key()) || _failedVarObjs.contains(it.key())) {
+            continue;
+        }
+
+        createVarObj(it.key());
+    }
+
+    // One update for all of them and the struct members that were listed. gdb only sends back what changed.
+    emit varObjUpdateAll(_updateId);
+}
+
+void SeerVariableTrackerBrowserWidget::retryVarObjs () {
+
+    // While hidden, the next refresh makes them.
+    QList<int> ids = _failedVarObjs.values();
+
+    _failedVarObjs.clear();
+
+    if (isHidden()) {
+        return;
+    }
+
+    for (int i=0; i<ids.size(); i++) {
+
+        if (_varObjs.contains(ids[i]) || _pendingVarObjs.contains(ids[i])) {
+            continue;
+        }
+
+        createVarObj(ids[i]);
+    }
+}
+
+void SeerVariableTrackerBrowserWidget::addItem (const QString& id_text, const QString& expression_text) {
+
+    int id = id_text.toInt();
+
+    if (_idItems.contains(id)) {
+        return;
+    }
+
+    QTreeWidgetItem* topItem = new QTreeWidgetItem;
+    topItem->setText(0, expression_text);
+    topItem->setText(1, "");
+    topItem->setFont(1, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+    topItem->setText(2, id_text);
+    topItem->setText(3, "new");
+
+    variablesTreeWidget->addTopLevelItem(topItem);
+
+    _idItems.insert(id, topItem);
+
+    createVarObj(id);
+}
+
+void SeerVariableTrackerBrowserWidget::createVarObj (int id) {
+
+    QTreeWidgetItem* item = _idItems.value(id, 0);
+
+    if (item == 0) {
+        return;
+    }
+
+    // Floating, so it's evaluated in whatever frame is selected.
+    _pendingVarObjs.insert(id);
+
+    emit varObjCreate(id, QString("seertrack%1").arg(id), item->text(0));
+}
+
+void SeerVariableTrackerBrowserWidget::deleteVarObj (int id) {
+
+    QTreeWidgetItem* item = _idItems.value(id, 0);
+
+    // Deleting the varobj deletes its children in gdb too.
+    if (item != 0) {
+        forgetChildren(item);
+    }
+
+    _pendingVarObjs.remove(id);
+
+    if (_varObjs.remove(id)) {
+        emit varObjDelete(_updateId, QString("seertrack%1").arg(id));
+    }
+}
+
+void SeerVariableTrackerBrowserWidget::listChildren (const QString& objname) {
+
+    int id = Seer::createID();
+
+    _listIds.insert(id, objname);
+
+    emit varObjListChildren(id, objname);
+}
+
+void SeerVariableTrackerBrowserWidget::setChildren (QTreeWidgetItem* item, const QString& text) {
+
+    // "13^done,numchild=\"2\",children=[child={name=\"seertrack5.age\",exp=\"age\",numchild=\"0\",value=\"60\",type=\"int\",thread-id=\"1\"},...],has_more=\"0\""
+    QString     children_text = Seer::parseFirst(text,          "children=", '[', ']', false);
+    QStringList child_list    = Seer::parse(children_text,      "child=",    '{', '}', false);
+
+    // Replace the placeholder, or what was listed before.
+    forgetChildren(item);
+
+    for (const auto& child_text : child_list) {
+
+        QString name_text     = Seer::parseFirst(child_text, "name=",     '"', '"', false);
+        QString exp_text      = Seer::parseFirst(child_text, "exp=",      '"', '"', false);
+        QString numchild_text = Seer::parseFirst(child_text, "numchild=", '"', '"', false);
+        QString value_text    = Seer::parseFirst(child_text, "value=",    '"', '"', false);
+
+        QTreeWidgetItem* child = new QTreeWidgetItem;
+        child->setText(0, exp_text);
+        child->setText(1, Seer::filterEscapes(value_text));
+        child->setFont(1, QFontDatabase::systemFont(QFontDatabase::FixedFont));
+        child->setText(2, item->text(2));
+        child->setText(3, "new");
+
+        item->addChild(child);
+
+        _childItems.insert(name_text, child);
+        _childNames.insert(child, name_text);
+
+        setPlaceholder(child, numchild_text.toInt());
+    }
+}
+
+void SeerVariableTrackerBrowserWidget::setPlaceholder (QTreeWidgetItem* item, int numchild) {
+
+    // Members of members are listed when their item is expanded.
+    if (numchild <= 0 || item->childCount() > 0) {
+        return;
+    }
+
+    QTreeWidgetItem* placeholder = new QTreeWidgetItem;
+    placeholder->setText(0, "{...}");
+
+    item->addChild(placeholder);
+}
+
+void SeerVariableTrackerBrowserWidget::forgetChildren (QTreeWidgetItem* item) {
+
+    QList<QTreeWidgetItem*> children = item->takeChildren();
+
+    for (int i=0; i<children.size(); i++) {
+
+        forgetChildren(children[i]);
+
+        _childItems.remove(_childNames.take(children[i]));
+    }
+
+    qDeleteAll(children);
+}
+
+QTreeWidgetItem* SeerVariableTrackerBrowserWidget::varObjItem (const QString& objname) const {
+
+    // "seertrack5" is an expression's item. "seertrack5.age" is one of its members.
+    if (objname.contains('.')) {
+        return _childItems.value(objname, 0);
+    }
+
+    return _idItems.value(objname.mid(9).toInt(), 0);
 }
 
 void SeerVariableTrackerBrowserWidget::handleAddLineEdit () {
@@ -271,7 +631,10 @@ void SeerVariableTrackerBrowserWidget::handleDeleteAllToolButton () {
 
 void SeerVariableTrackerBrowserWidget::handleItemExpanded (QTreeWidgetItem* item) {
 
-    Q_UNUSED(item);
+    // Only the placeholder is there. List the members.
+    if (_childNames.contains(item) && item->childCount() == 1 && _childNames.contains(item->child(0)) == false) {
+        listChildren(_childNames.value(item));
+    }
 
     variablesTreeWidget->resizeColumnToContents(0);
     variablesTreeWidget->resizeColumnToContents(1);
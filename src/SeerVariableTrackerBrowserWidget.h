@@ -2,6 +2,8 @@
 
 #include <QtWidgets/QWidget>
 #include <QtCore/QString>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
 #include "ui_SeerVariableTrackerBrowserWidget.h"
 
 class SeerVariableTrackerBrowserWidget : public QWidget, protected Ui::SeerVariableTrackerBrowserWidgetForm {
@@ -15,6 +17,8 @@ class SeerVariableTrackerBrowserWidget : public QWidget, protected Ui::SeerVaria
     public slots:
         void                handleText                      (const QString& text);
         void                handleStoppingPointReached      ();
+        void                handleSelectedFrameChanged      (int threadid, int frameno);
+        void                handleVarObjEvicted             (QString objname);
         void                refresh                         ();
         void                refreshValues                   ();
 
@@ -29,7 +33,10 @@ class SeerVariableTrackerBrowserWidget : public QWidget, protected Ui::SeerVaria
 
     signals:
         void                refreshVariableTrackerNames     ();
-        void                refreshVariableTrackerValues    ();
+        void                varObjCreate                    (int id, QString objname, QString expression);
+        void                varObjUpdateAll                 (int id);
+        void                varObjDelete                    (int id, QString objname);
+        void                varObjListChildren              (int id, QString objname);
         void                addVariableExpression           (QString expression);
         void                deleteVariableExpressions       (QString expressionids);
         void                addMemoryVisualize              (QString expression);
@@ -40,8 +47,28 @@ class SeerVariableTrackerBrowserWidget : public QWidget, protected Ui::SeerVaria
         void                handleItemCreate                (QTreeWidgetItem* item,       const QString& value_text);
         void                handleItemCreate                (QTreeWidgetItem* parentItem, const QString& id_text, const QString& name_text, const QString& value_text);
         void                showEvent                       (QShowEvent* event);
+        void                addItem                         (const QString& id_text, const QString& expression_text);
+        void                createVarObj                    (int id);
+        void                deleteVarObj                    (int id);
+        void                retryVarObjs                    ();
+        void                listChildren                    (const QString& objname);
+        void                setChildren                     (QTreeWidgetItem* item, const QString& text);
+        void                setPlaceholder                  (QTreeWidgetItem* item, int numchild);
+        void                forgetChildren                  (QTreeWidgetItem* item);
+        QTreeWidgetItem*    varObjItem                      (const QString& objname) const;
+        void                handleChangeList                (const QString& text);
 
     private:
-
+        QHash<int,QTreeWidgetItem*>     _idItems;           // Expression id to its top level item.
+        QSet<int>                       _varObjs;           // Expressions with a varobj.
+        QSet<int>                       _pendingVarObjs;    // Expressions whose varobj is being created.
+        QSet<int>                       _failedVarObjs;     // Expressions gdb couldn't make a varobj for. See retryVarObjs().
+        QSet<int>                       _composites;        // Expressions with children. Shown through the varobj's children.
+        QHash<QString,QTreeWidgetItem*> _childItems;        // Listed child varobj name to its item.
+        QHash<QTreeWidgetItem*,QString> _childNames;        // Item to its child varobj name.
+        QHash<int,QString>              _listIds;           // "-var-list-children" id to the varobj, until gdb answers.
+        int                             _updateId;
+        QString                         _frameKey;          // "thread:level" the values are of. "" until told, after a stop.
+        QString                         _stopScope;         // "thread:function" of the last stop.
 };
 
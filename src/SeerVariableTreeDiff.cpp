@@ -0,0 +1,146 @@
+#include "SeerVariableTreeDiff.h"
+#include <QtCore/QList>
+#include <QtCore/QDebug>
+
+SeerVariableTreeDiff::SeerVariableTreeDiff (QTreeWidget* tree, int topKeyColumn, int childKeyColumn) {
+
+    _tree           = tree;
+    _topKeyColumn   = topKeyColumn;
+    _childKeyColumn = childKeyColumn;
+}
+
+SeerVariableTreeDiff::~SeerVariableTreeDiff () {
+}
+
+void SeerVariableTreeDiff::begin () {
+
+    _items.clear();
+    _paths.clear();
+    _occurrences.clear();
+    _visited.clear();
+
+    // Index what's in the tree now. Top-down, so a parent's path is known before its children's.
+    QHash<QString,int> occurrences;
+
+    for (int i=0; i<_tree->topLevelItemCount(); i++) {
+
+        QTreeWidgetItem* top = _tree->topLevelItem(i);
+
+        indexItem(top, childPath(0, top->text(_topKeyColumn), occurrences));
+    }
+
+    QList<QTreeWidgetItem*> parents = _items.values();
+
+    while (parents.isEmpty() == false) {
+
+        QTreeWidgetItem* parent = parents.takeLast();
+
+        for (int i=0; i<parent->childCount(); i++) {
+
+            QTreeWidgetItem* child = parent->child(i);
+
+            indexItem(child, childPath(parent, child->text(_childKeyColumn), occurrences));
+
+            parents.append(child);
+        }
+    }
+}
+
+QTreeWidgetItem* SeerVariableTreeDiff::item (QTreeWidgetItem* parent, const QString& key, bool* created) {
+
+    QString          path = childPath(parent, key, _occurrences);
+    QTreeWidgetItem* item = _items.value(path, 0);
+
+    if (created) {
+        *created = (item == 0);
+    }
+
+    // A new variable. Add it after its siblings.
+    if (item == 0) {
+
+        item = new QTreeWidgetItem;
+        item->setText(parent ? _childKeyColumn : _topKeyColumn, key);
+
+        if (parent) {
+            parent->addChild(item);
+        }else{
+            _tree->addTopLevelItem(item);
+        }
+
+        indexItem(item, path);
+    }
+
+    _visited.insert(item);
+
+    return item;
+}
+
+void SeerVariableTreeDiff::end () {
+
+    //
+    // Delete the items that weren't looked up. Deleting an item deletes its
+    // children, so skip the ones whose parent goes too.
+    //
+    QList<QTreeWidgetItem*> stale;
+
+    for (QHash<QString,QTreeWidgetItem*>::const_iterator it = _items.constBegin(); it != _items.constEnd(); ++it) {
+
+        QTreeWidgetItem* item = it.value();
+
+        if (_visited.contains(item)) {
+            continue;
+        }
+
+        if (item->parent() && _visited.contains(item->parent()) == false) {
+            continue;
+        }
+
+        stale.append(item);
+    }
+
+    _items.clear();
+    _paths.clear();
+    _occurrences.clear();
+    _visited.clear();
+
+    qDeleteAll(stale);
+}
+
+void SeerVariableTreeDiff::clear () {
+
+    _items.clear();
+    _paths.clear();
+    _occurrences.clear();
+    _visited.clear();
+
+    _tree->clear();
+}
+
+void SeerVariableTreeDiff::setText (QTreeWidgetItem* item, int column, const QString& text) {
+
+    // Setting the same text still has the view redo the item.
+    if (item->text(column) != text) {
+        item->setText(column, text);
+    }
+}
+
+QString SeerVariableTreeDiff::childPath (QTreeWidgetItem* parent, const QString& key, QHash<QString,int>& occurrences) const {
+
+    // The parent's path and the key, apart by a character that can't be in a name.
+    QString path = (parent ? _paths.value(parent) : QString()) + QChar(0x1F) + key;
+
+    int n = occurrences[path]++;
+
+    if (n > 0) {
+        path += QChar(0x1F) + QString::number(n);
+    }
+
+    return path;
+}
+
+void SeerVariableTreeDiff::indexItem (QTreeWidgetItem* item, const QString& path) {
+
+    _items.insert(path, item);
+    _paths.insert(item, path);
+}
+
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <QtWidgets/QTreeWidget>
+#include <QtWidgets/QTreeWidgetItem>
+#include <QtCore/QHash>
+#include <QtCore/QSet>
+#include <QtCore/QString>
+
+//
+// Updates a tree of variables in place from a fresh list of them.
+//
+// begin() indexes the items already in the tree by their name path. Each
+// variable of the new list is then looked up with item(), which reuses the
+// item with the same path or creates one. end() deletes the items that were
+// not looked up, in one pass. Reused items keep their expanded state, and
+// setText() only touches columns whose text changed.
+//
+// A name that appears more than once under the same parent (a shadowed local)
+// gets its own item for each occurrence, in order.
+//
+class SeerVariableTreeDiff {
+
+    public:
+        explicit SeerVariableTreeDiff (QTreeWidget* tree, int topKeyColumn, int childKeyColumn);
+       ~SeerVariableTreeDiff ();
+
+        void                                begin                   ();
+        QTreeWidgetItem*                    item                    (QTreeWidgetItem* parent, const QString& key, bool* created = 0);
+        void                                end                     ();
+        void                                clear                   ();
+
+        static void                         setText                 (QTreeWidgetItem* item, int column, const QString& text);
+
+    private:
+        QString                             childPath               (QTreeWidgetItem* parent, const QString& key, QHash<QString,int>& occurrences) const;
+        void                                indexItem               (QTreeWidgetItem* item, const QString& path);
+
+        QTreeWidget*                        _tree;
+        int                                 _topKeyColumn;
+        int                                 _childKeyColumn;
+        QHash<QString,QTreeWidgetItem*>     _items;                 // Name path to item, as of begin().
+        QHash<QTreeWidgetItem*,QString>     _paths;                 // Item to name path.
+        QHash<QString,int>                  _occurrences;           // Times each path was looked up since begin().
+        QSet<QTreeWidgetItem*>              _visited;
+};
+
@@ -0,0 +1,64 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//
+// Write lots of text to stdout, as fast as possible.
+//
+//      helloflood [megabytes] [linelength]
+//
+// Prints the rate it managed to stderr when done.
+//
+
+int main (int argc, char* argv[]) {
+
+    long megabytes  = 500;
+    long linelength = 100;
+
+    if (argc > 1) {
+        megabytes = atol(argv[1]);
+    }
+
+    if (argc > 2) {
+        linelength = atol(argv[2]);
+    }
+
+    if (megabytes < 1 || linelength < 20) {
+        std::cerr << "usage: helloflood [megabytes] [linelength >= 20]" << std::endl;
+        return 1;
+    }
+
+    std::string filler(linelength, 'x');
+
+    long long total = megabytes * 1024LL * 1024LL;
+    long long count = 0;
+    long long line  = 0;
+
+    auto start = std::chrono::steady_clock::now();
+
+    while (count < total) {
+
+        // Line number, then filler up to 'linelength' including the newline.
+        char prefix[32];
+        int  n = snprintf(prefix, sizeof(prefix), "%012lld ", line++);
+
+        fwrite(prefix, 1, n, stdout);
+        fwrite(filler.data(), 1, linelength - n - 1, stdout);
+        fputc('\n', stdout);
+
+        count += linelength;
+    }
+
+    fflush(stdout);
+
+    auto   end     = std::chrono::steady_clock::now();
+    double seconds = std::chrono::duration<double>(end - start).count();
+
+    std::cerr << "helloflood: " << line << " lines, " << megabytes << " MB in " << seconds << " seconds, " << (megabytes / seconds) << " MB/s" << std::endl;
+
+    return 0;
+}
+
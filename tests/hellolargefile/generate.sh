@@ -0,0 +1,41 @@
+#!/bin/sh
+#
+# Write a C++ source file with about N lines to stdout.
+#
+#   % ./generate.sh 100000 > hellolargefile.cpp
+#
+
+lines=${1:-100000}
+functions=$((lines / 10))
+
+echo "#include <iostream>"
+echo ""
+
+i=0
+while [ $i -lt $functions ]; do
+    echo "int function$i (int value) {"
+    echo ""
+    echo "    int result = value;"
+    echo ""
+    echo "    for (int j=0; j<4; j++) {"
+    echo "        result += j * $i;"
+    echo "    }"
+    echo ""
+    echo "    return result;"
+    echo "}"
+    i=$((i + 1))
+done
+
+echo ""
+echo "int main (int argc, char* argv[]) {"
+echo ""
+echo "    int total = 0;"
+echo ""
+echo "    total += function0(argc);"
+echo "    total += function$((functions / 2))(argc);"
+echo "    total += function$((functions - 1))(argc);"
+echo ""
+echo "    std::cout << \"Total: \" << total << std::endl;"
+echo ""
+echo "    return 0;"
+echo "}"